@@ -1659,6 +1659,9 @@ MythContext::~MythContext()
     SSDP::Shutdown();
     TaskQueue::Shutdown();
 
+    // Summarise where this run spent its database time (with -v database)
+    gCoreContext->GetDBManager()->LogQueryStats();
+
     LOG(VB_GENERAL, LOG_INFO, "Exiting");
 
     logStop();
@@ -3628,6 +3628,68 @@ void ProgramInfo::QueryPositionMap(
         posMap[query.value(0).toULongLong()] = query.value(1).toULongLong();
 }
 
+/**
+ *  \brief Loads a position map into a flat sorted vector.
+ *
+ *  This avoids building a QMap node per keyframe, which dominates the
+ *  load time of the seek table of long recordings.
+ */
+void ProgramInfo::QueryPositionMap(
+    frm_pos_vec_t &posVec, MarkTypes type) const
+{
+    posVec.clear();
+
+    if (m_positionMapDBReplacement)
+    {
+        QMutexLocker locker(m_positionMapDBReplacement->lock);
+        const frm_pos_map_t &posMap = m_positionMapDBReplacement->map[type];
+        posVec.reserve(posMap.size());
+        for (auto it = posMap.cbegin(); it != posMap.cend(); ++it)
+            posVec.emplace_back(it.key(), *it);
+        return;
+    }
+
+    MSqlQuery query(MSqlQuery::InitCon());
+
+    if (IsVideo())
+    {
+        query.prepare("SELECT mark, offset FROM filemarkup"
+                      " WHERE filename = :PATH"
+                      " AND type = :TYPE"
+                      " ORDER BY filename, type, mark;");
+        query.bindValue(":PATH", StorageGroup::GetRelativePathname(m_pathname));
+    }
+    else if (IsRecording())
+    {
+        query.prepare("SELECT mark, offset FROM recordedseek"
+                      " WHERE chanid = :CHANID"
+                      " AND starttime = :STARTTIME"
+                      " AND type = :TYPE"
+                      " ORDER BY chanid, starttime, type, mark;");
+        query.bindValue(":CHANID", m_chanId);
+        query.bindValue(":STARTTIME", m_recStartTs);
+    }
+    else
+    {
+        return;
+    }
+    query.bindValue(":TYPE", type);
+
+    if (!query.exec())
+    {
+        MythDB::DBError("QueryPositionMap", query);
+        return;
+    }
+
+    if (query.size() > 0)
+        posVec.reserve(query.size());
+    while (query.next())
+    {
+        posVec.emplace_back(query.value(0).toULongLong(),
+                            query.value(1).toULongLong());
+    }
+}
+
 void ProgramInfo::ClearPositionMap(MarkTypes type) const
 {
     if (m_positionMapDBReplacement)
@@ -3664,6 +3726,8 @@ void ProgramInfo::ClearPositionMap(MarkTypes type) const
 
     if (!query.exec())
         MythDB::DBError("clear position map", query);
+
+    RemoveSeekIndex(type);
 }
 
 void ProgramInfo::SavePositionMap(
@@ -3712,9 +3776,16 @@ void ProgramInfo::SavePositionMap(
         return;
     }
 
+    if (!IsVideo() && !IsRecording())
+        return;
+
     MSqlQuery query(MSqlQuery::InitCon());
     QString comp;
 
+    // The tables are MyISAM, which has no transactions. The table is not
+    // locked for the whole rewrite either, as that would stall every other
+    // recorder and player using it. Each DELETE and batched INSERT holds
+    // the table only for that statement.
     if (min_frame >= 0)
         comp += " AND mark >= :MIN_FRAME ";
     if (max_frame >= 0)
@@ -3731,7 +3802,7 @@ void ProgramInfo::SavePositionMap(
                       + comp + ';');
         query.bindValue(":PATH", videoPath);
     }
-    else if (IsRecording())
+    else
     {
         query.prepare("DELETE FROM recordedseek"
                       " WHERE chanid = :CHANID"
@@ -3741,10 +3812,6 @@ void ProgramInfo::SavePositionMap(
         query.bindValue(":CHANID", m_chanId);
         query.bindValue(":STARTTIME", m_recStartTs);
     }
-    else
-    {
-        return;
-    }
 
     query.bindValue(":TYPE", type);
     if (min_frame >= 0)
@@ -3753,61 +3820,16 @@ void ProgramInfo::SavePositionMap(
         query.bindValue(":MAX_FRAME", (quint64)max_frame);
 
     if (!query.exec())
-        MythDB::DBError("position map clear", query);
-
-    if (posMap.isEmpty())
-        return;
-
-    // Use the multi-value insert syntax to reduce database I/O
-    QStringList q("INSERT INTO ");
-    QString qfields;
-    if (IsVideo())
     {
-        q << "filemarkup (filename, type, mark, offset)";
-        qfields = QString("('%1',%2,") .
-            // ideally, this should be escaped
-            arg(videoPath) .
-            arg(type);
-    }
-    else // if (IsRecording())
-    {
-        q << "recordedseek (chanid, starttime, type, mark, offset)";
-        qfields = QString("(%1,'%2',%3,") .
-            arg(m_chanId) .
-            arg(m_recStartTs.toString(Qt::ISODate)) .
-            arg(type);
-    }
-    q << " VALUES ";
-
-    bool add_comma = false;
-    frm_pos_map_t::iterator it;
-    for (it = posMap.begin(); it != posMap.end(); ++it)
-    {
-        uint64_t frame = it.key();
-
-        if ((min_frame >= 0) && (frame < (uint64_t)min_frame))
-            continue;
-
-        if ((max_frame >= 0) && (frame > (uint64_t)max_frame))
-            continue;
-
-        uint64_t offset = *it;
-
-        if (add_comma)
-        {
-            q << ",";
-        }
-        else
-        {
-            add_comma = true;
-        }
-        q << qfields << QString("%1,%2)").arg(frame).arg(offset);
+        MythDB::DBError("position map clear", query);
     }
-    query.prepare(q.join(""));
-    if (!query.exec())
+    else if (!posMap.isEmpty() &&
+             !InsertPositionMapRows(query, posMap, type, min_frame, max_frame))
     {
         MythDB::DBError("position map insert", query);
     }
+
+    RemoveSeekIndex(type);
 }
 
 void ProgramInfo::SavePositionMapDelta(
@@ -3826,55 +3848,132 @@ void ProgramInfo::SavePositionMapDelta(
         return;
     }
 
-    // Use the multi-value insert syntax to reduce database I/O
-    QStringList q("INSERT INTO ");
-    QString qfields;
+    if (!IsVideo() && !IsRecording())
+        return;
+
+    MSqlQuery query(MSqlQuery::InitCon());
+    if (!InsertPositionMapRows(query, posMap, type, -1, -1))
+        MythDB::DBError("delta position map insert", query);
+}
+
+/**
+ *  \brief Deletes the recording's sidecar seek index for \p type.
+ *
+ *  Called whenever the seek table is cleared or rewritten, e.g. by
+ *  mythcommflag --rebuild or mythtranscode --buildindex, neither of which
+ *  touches the recording itself, so the sidecar can't be left holding the
+ *  old table.  The names must match SeekIndexFile::IndexFilename().
+ */
+void ProgramInfo::RemoveSeekIndex(MarkTypes type) const
+{
+    if (!IsRecording())
+        return;
+
+    QString index = GetPlaybackURL(false, true);
+    index += (type == MARK_DURATION_MS) ? ".dur.sidx" : ".sidx";
+
+    if (index.startsWith("myth://"))
+    {
+        if (RemoteFile::Exists(index) && !RemoteFile::DeleteFile(index))
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                QString("Unable to delete seek index %1").arg(index));
+    }
+    else if (QFile::exists(index) && !QFile::remove(index))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Unable to delete seek index %1").arg(index));
+    }
+}
+
+/**
+ *  \brief Writes position map rows using multi-row prepared INSERTs.
+ *
+ *  Rows are sent in chunks of a fixed size so that every full chunk uses
+ *  the same statement text, and therefore the same server side prepared
+ *  statement, and the key values are bound rather than spliced into SQL.
+ *  Only entries in [min_frame, max_frame] are written when those are >= 0.
+ */
+bool ProgramInfo::InsertPositionMapRows(
+    MSqlQuery &query, const frm_pos_map_t &posMap, MarkTypes type,
+    int64_t min_frame, int64_t max_frame) const
+{
+    static constexpr int kRowsPerInsert = 500;
+
+    QString table;
+    QString keyvals;
     if (IsVideo())
     {
-        q << "filemarkup (filename, type, mark, offset)";
-        qfields = QString("('%1',%2,") .
-            // ideally, this should be escaped
-            arg(StorageGroup::GetRelativePathname(m_pathname)) .
-            arg(type);
+        table   = "filemarkup (filename, type, mark, offset)";
+        keyvals = "(:PATH,:TYPE,";
     }
     else if (IsRecording())
     {
-        q << "recordedseek (chanid, starttime, type, mark, offset)";
-        qfields = QString("(%1,'%2',%3,") .
-            arg(m_chanId) .
-            arg(m_recStartTs.toString(Qt::ISODate)) .
-            arg(type);
+        table   = "recordedseek (chanid, starttime, type, mark, offset)";
+        keyvals = "(:CHANID,:STARTTIME,:TYPE,";
     }
     else
     {
-        return;
+        return false;
     }
-    q << " VALUES ";
 
-    bool add_comma = false;
-    frm_pos_map_t::iterator it;
-    for (it = posMap.begin(); it != posMap.end(); ++it)
+    QString videoPath;
+    if (IsVideo())
+        videoPath = StorageGroup::GetRelativePathname(m_pathname);
+
+    auto begin = posMap.cbegin();
+    if (min_frame >= 0)
+        begin = posMap.lowerBound(min_frame);
+    auto end = posMap.cend();
+    if (max_frame >= 0)
+        end = posMap.upperBound(max_frame);
+    if ((min_frame >= 0) && (max_frame >= 0) && (max_frame < min_frame))
+        return true;
+
+    QString chunkSql;
+    int     chunkRows = 0;
+    auto it = begin;
+    while (it != end)
     {
-        uint64_t frame  = it.key();
-        uint64_t offset = *it;
+        int rows = 0;
+        for (auto rit = it; rit != end && rows < kRowsPerInsert; ++rit)
+            rows++;
+
+        if (rows != chunkRows)
+        {
+            QStringList values;
+            values.reserve(rows);
+            for (int i = 0; i < rows; i++)
+                values << keyvals + QString(":M%1,:O%1)").arg(i, 3, 10, QChar('0'));
+            chunkSql = "INSERT INTO " + table + " VALUES " + values.join(",");
+            chunkRows = rows;
+        }
 
-        if (add_comma)
+        if (!query.prepare(chunkSql))
+            return false;
+
+        if (IsVideo())
         {
-            q << ",";
+            query.bindValue(":PATH", videoPath);
         }
         else
         {
-            add_comma = true;
+            query.bindValue(":CHANID", m_chanId);
+            query.bindValue(":STARTTIME", m_recStartTs);
         }
-        q << qfields << QString("%1,%2)").arg(frame).arg(offset);
-    }
+        query.bindValue(":TYPE", type);
 
-    MSqlQuery query(MSqlQuery::InitCon());
-    query.prepare(q.join(""));
-    if (!query.exec())
-    {
-        MythDB::DBError("delta position map insert", query);
+        for (int i = 0; i < rows; ++i, ++it)
+        {
+            QString idx = QString("%1").arg(i, 3, 10, QChar('0'));
+            query.bindValue(":M" + idx, (quint64)it.key());
+            query.bindValue(":O" + idx, (quint64)*it);
+        }
+
+        if (!query.exec())
+            return false;
     }
+
+    return true;
 }
 
 static const char *from_filemarkup_offset_asc =
@@ -649,6 +649,7 @@ class MPUBLIC ProgramInfo
 
     // Keyframe positions map
     void QueryPositionMap(frm_pos_map_t &posMap, MarkTypes type) const;
+    void QueryPositionMap(frm_pos_vec_t &posVec, MarkTypes type) const;
     void ClearPositionMap(MarkTypes type) const;
     void SavePositionMap(frm_pos_map_t &posMap, MarkTypes type,
                          int64_t min_frame = -1, int64_t max_frame = -1) const;
@@ -737,6 +738,11 @@ class MPUBLIC ProgramInfo
         uint chanid, const QDateTime &recstartts,
         frm_dir_map_t &marks, MarkTypes type, bool merge = false);
 
+    bool InsertPositionMapRows(MSqlQuery &query, const frm_pos_map_t &posMap,
+                               MarkTypes type, int64_t min_frame,
+                               int64_t max_frame) const;
+    void RemoveSeekIndex(MarkTypes type) const;
+
     static int InitStatics(void);
 
   protected:
@@ -15,6 +15,8 @@
 // C++ headers
 #include <cstdint> // for [u]int[32,64]_t
 #include <deque>
+#include <utility>
+#include <vector>
 
 // Qt headers
 #include <QString>
@@ -44,6 +46,8 @@ MPUBLIC extern const char *kCCExtractorInUseID;
 
 /// Frame # -> File offset map
 using frm_pos_map_t = QMap<long long, long long>;
+/// Frame # -> File offset pairs, sorted by frame #
+using frm_pos_vec_t = std::vector<std::pair<uint64_t, uint64_t> >;
 
 enum MarkTypes {
     MARK_ALL           = -100,
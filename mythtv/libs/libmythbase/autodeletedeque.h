@@ -67,6 +67,7 @@ class AutoDeleteDeque
     size_t size(void) const { return m_list.size(); }
     void push_front(T info) { m_list.push_front(info); }
     void push_back( T info) { m_list.push_back( info); }
+    iterator insert(iterator it, T info) { return m_list.insert(it, info); }
 
     // compatibility with old Q3PtrList
     void setAutoDelete(bool auto_delete) { m_autodelete = auto_delete; }
@@ -13,6 +13,7 @@ QMAKE_CLEAN += $(TARGET) $(TARGETA) $(TARGETD) $(TARGET0) $(TARGET1) $(TARGET2)
 HEADERS += mthread.h mthreadpool.h
 HEADERS += mythsocket.h mythsocket_cb.h
 HEADERS += mythbaseexp.h mythdbcon.h mythdb.h mythdbparams.h
+HEADERS += mythdbwritequeue.h mythmetrics.h
 HEADERS += verbosedefs.h mythversion.h compat.h mythconfig.h
 HEADERS += mythobservable.h mythevent.h
 HEADERS += mythtimer.h mythsignalingtimer.h mythdirs.h exitcodes.h
@@ -40,6 +41,7 @@ HEADERS += mythpower.h
 SOURCES += mthread.cpp mthreadpool.cpp
 SOURCES += mythsocket.cpp
 SOURCES += mythdbcon.cpp mythdb.cpp mythdbparams.cpp
+SOURCES += mythdbwritequeue.cpp mythmetrics.cpp
 SOURCES += mythobservable.cpp mythevent.cpp
 SOURCES += mythtimer.cpp mythsignalingtimer.cpp mythdirs.cpp
 SOURCES += lcddevice.cpp mythstorage.cpp remotefile.cpp
@@ -80,6 +82,7 @@ mingw | win32-msvc* {
 # Install headers to same location as libmyth to make things easier
 inc.path = $${PREFIX}/include/mythtv/
 inc.files += mythdbcon.h mythdbparams.h mythbaseexp.h mythdb.h
+inc.files += mythdbwritequeue.h mythmetrics.h
 inc.files += compat.h mythversion.h mythconfig.h mythconfig.mak version.h
 inc.files += mythobservable.h mythevent.h verbosedefs.h
 inc.files += mythtimer.h lcddevice.h exitcodes.h mythdirs.h mythstorage.h
@@ -10,7 +10,13 @@
 #include <QMap>
 #include <QRegularExpression>
 #include <QVariantMap>
+#include <QThread>
+#include <QVector>
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <iostream>
+#include <vector>
 
 using namespace std;
 
@@ -64,7 +70,6 @@ extern "C" {
 #endif
 
 static QMutex                  logQueueMutex;
-static QQueue<LoggingItem *>   logQueue;
 static QRegExp                 logRegExp = QRegExp("[%]{1,2}");
 
 static LoggerThread           *logThread = nullptr;
@@ -77,6 +82,287 @@ static QHash<uint64_t, int64_t> logThreadTidHash;
 static bool                    logThreadFinished = false;
 static bool                    debugRegistration = false;
 
+static QMutex                  logInternMutex;
+static QHash<QByteArray, const char *> logInternHash;
+
+/// \brief Returns a copy of \p str that is never freed, the same copy for
+///        equal strings.  This is only called the first time each thread
+///        logs from a given file or function.
+static const char *log_intern(const char *str)
+{
+    QByteArray key(str);
+    QMutexLocker locker(&logInternMutex);
+    const char *&interned = logInternHash[key];
+    if (interned == nullptr)
+        interned = strdup(str);
+    return interned;
+}
+
+/// \brief Returns the operating system's ID for the calling thread
+/// \note  In different platforms, the actual value returned here will vary.
+///        The intention is to get a thread ID that will map well to what is
+///        shown in gdb.
+static int64_t log_current_tid(void)
+{
+#if defined(Q_OS_ANDROID)
+    return (int64_t)gettid();
+#elif defined(linux)
+    return syscall(SYS_gettid);
+#elif defined(__FreeBSD__)
+    long lwpid;
+    int dummy = thr_self( &lwpid );
+    (void)dummy;
+    return (int64_t)lwpid;
+#elif CONFIG_DARWIN
+    return (int64_t)mach_thread_self();
+#else
+    return 0;
+#endif
+}
+
+/// \brief Lock free queue of the LogRecords made by one thread.
+///
+/// Only the owning thread pushes and only the thread emptying the rings
+/// pops, so neither needs a lock.  If the logging thread falls behind and
+/// the ring fills up, records go to a locked overflow queue instead until
+/// the ring has been emptied, so nothing is lost or reordered.
+class LogRing
+{
+  public:
+    static constexpr uint kSize = 256; // must be a power of two
+
+    LogRing() :
+        m_threadId((uint64_t)(QThread::currentThreadId())),
+        m_tid(log_current_tid()) {}
+
+    /// \brief Returns an interned copy of a __FILE__ or __FUNCTION__ string.
+    ///        Owning thread only.
+    const char *Intern(const char *str)
+    {
+        const char *&interned = m_interned[str];
+        if (interned == nullptr)
+            interned = log_intern(str);
+        return interned;
+    }
+
+    /// \brief Queues \p record, leaving it empty.  Owning thread only.
+    void Push(LogRecord &record)
+    {
+        if (!m_overflowing.load(std::memory_order_acquire) && TryPush(record))
+            return;
+
+        QMutexLocker locker(&m_overflowLock);
+        if (m_overflowing.load(std::memory_order_relaxed) || !TryPush(record))
+        {
+            m_overflow.enqueue(std::move(record));
+            m_overflowing.store(true, std::memory_order_release);
+        }
+    }
+
+    /// \brief Appends all queued records to \p records, oldest first
+    void PopAll(QVector<LogRecord> &records)
+    {
+        PopRing(records);
+
+        if (!m_overflowing.load(std::memory_order_acquire))
+            return;
+
+        QMutexLocker locker(&m_overflowLock);
+        // Anything still in the ring was pushed before the overflow started
+        PopRing(records);
+        while (!m_overflow.isEmpty())
+            records.append(m_overflow.dequeue());
+        m_overflowing.store(false, std::memory_order_release);
+    }
+
+    bool IsEmpty(void) const
+    {
+        return (m_tail.load(std::memory_order_acquire) ==
+                m_head.load(std::memory_order_acquire)) &&
+            !m_overflowing.load(std::memory_order_acquire);
+    }
+
+    const uint64_t        m_threadId;
+    const int64_t         m_tid;
+    std::atomic<bool>     m_orphaned     {false}; ///< The thread has exited
+
+  private:
+    bool TryPush(LogRecord &record)
+    {
+        uint head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) >= kSize)
+            return false;
+        // Swaps with the empty record left behind by PopRing()
+        m_records[head & (kSize - 1)] = std::move(record);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    void PopRing(QVector<LogRecord> &records)
+    {
+        uint tail = m_tail.load(std::memory_order_relaxed);
+        uint head = m_head.load(std::memory_order_acquire);
+        for (; tail != head; ++tail)
+        {
+            records.append(LogRecord());
+            std::swap(records.last(), m_records[tail & (kSize - 1)]);
+        }
+        m_tail.store(tail, std::memory_order_release);
+    }
+
+    std::array<LogRecord, kSize>       m_records;
+    std::atomic<uint>                  m_head         {0}; ///< Next to push
+    std::atomic<uint>                  m_tail         {0}; ///< Next to pop
+    QHash<const char *, const char *>  m_interned;         ///< Owning thread only
+
+    QMutex                             m_overflowLock;
+    QQueue<LogRecord>                  m_overflow;         ///< Protected by m_overflowLock
+    std::atomic<bool>                  m_overflowing  {false};
+};
+
+/// \brief Hands a thread's ring over to the logging thread when the thread
+///        exits.
+class LogRingOwner
+{
+  public:
+    ~LogRingOwner()
+    {
+        if (m_ring)
+            m_ring->m_orphaned.store(true, std::memory_order_release);
+        m_ring = nullptr;
+    }
+    LogRing *m_ring {nullptr};
+};
+
+static QMutex                  logRingsMutex;
+static QList<LogRing *>        logRings;      ///< Protected by logRingsMutex
+static thread_local LogRingOwner logRingOwner;
+
+/// \brief Returns the calling thread's ring, creating it if needed
+static LogRing *log_ring(void)
+{
+    LogRing *ring = logRingOwner.m_ring;
+    if (ring == nullptr)
+    {
+        ring = new LogRing;
+        logRingOwner.m_ring = ring;
+        QMutexLocker locker(&logRingsMutex);
+        logRings.append(ring);
+    }
+    return ring;
+}
+
+/// \brief Puts a record on the calling thread's ring.  This is the only
+///        work LOG() does in the calling thread.
+static void log_push(const char *file, const char *function, int line,
+                     LogLevel_t level, LoggingType type, QString message)
+{
+    LogRing *ring = log_ring();
+
+    LogRecord record;
+    record.m_message  = std::move(message);
+    record.m_file     = ring->Intern(file);
+    record.m_function = ring->Intern(function);
+    loggingGetTimeStamp(&record.m_epoch, &record.m_usec);
+    record.m_line     = line;
+    record.m_level    = level;
+    record.m_type     = type;
+    record.m_threadId = ring->m_threadId;
+    record.m_tid      = ring->m_tid;
+
+    ring->Push(record);
+}
+
+static bool log_earlier(const LogRecord &a, const LogRecord &b)
+{
+    return (a.m_epoch < b.m_epoch) ||
+        ((a.m_epoch == b.m_epoch) && (a.m_usec < b.m_usec));
+}
+
+/// \brief Empties every ring, and frees the rings of exited threads.
+/// \return The records, merged by time.  The records of each thread stay in
+///         the order they were logged even if the clock steps back.
+/// \note   Only one thread may empty the rings at a time.
+static QVector<LogRecord> log_take_records(void)
+{
+    QVector<QVector<LogRecord> > lists;
+
+    {
+        QMutexLocker locker(&logRingsMutex);
+        for (auto it = logRings.begin(); it != logRings.end(); )
+        {
+            LogRing *ring = *it;
+            // Checked first, an exited thread's ring is complete
+            bool orphaned = ring->m_orphaned.load(std::memory_order_acquire);
+
+            QVector<LogRecord> records;
+            ring->PopAll(records);
+            if (!records.isEmpty())
+                lists.append(std::move(records));
+
+            if (orphaned)
+            {
+                it = logRings.erase(it);
+                delete ring;
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    if (lists.size() <= 1)
+        return lists.isEmpty() ? QVector<LogRecord>() : lists.takeFirst();
+
+    QVector<LogRecord> merged;
+    std::vector<int> next(lists.size(), 0);
+    while (true)
+    {
+        int best = -1;
+        for (int i = 0; i < lists.size(); ++i)
+        {
+            if (next[i] < lists[i].size() &&
+                (best < 0 || log_earlier(lists[i][next[i]],
+                                         lists[best][next[best]])))
+            {
+                best = i;
+            }
+        }
+        if (best < 0)
+            break;
+        merged.append(std::move(lists[best][next[best]++]));
+    }
+    return merged;
+}
+
+static bool log_rings_empty(void)
+{
+    QMutexLocker locker(&logRingsMutex);
+    return std::all_of(logRings.cbegin(), logRings.cend(),
+                       [](const LogRing *ring) { return ring->IsEmpty(); });
+}
+
+/// \brief Intended for use only by the test harness.  Puts \p message on
+///        the calling thread's ring, as LOG() does.
+void logTestPush(const QString &message)
+{
+    log_push(__FILE__, __FUNCTION__, __LINE__, LOG_INFO, kMessage, message);
+}
+
+/// \brief Intended for use only by the test harness.
+QVector<LogRecord> logTestTakeRecords(void)
+{
+    return log_take_records();
+}
+
+/// \brief Intended for use only by the test harness.
+int logTestRingCount(void)
+{
+    QMutexLocker locker(&logRingsMutex);
+    return logRings.size();
+}
+
 struct LogPropagateOpts {
     bool    m_propagate;
     int     m_quiet;
@@ -104,6 +390,7 @@ const char    *verboseDefaultStr = " general";
 uint64_t verboseMask = verboseDefaultInt;
 QString verboseString = QString(verboseDefaultStr);
 ComponentLogLevelMap componentLogLevel;
+uint64_t componentLogMask = 0;
 
 uint64_t     userDefaultValueInt = verboseDefaultInt;
 QString      userDefaultValueStr = QString(verboseDefaultStr);
@@ -122,6 +409,8 @@ void resetLogging(void)
     userDefaultValueInt = verboseDefaultInt;
     userDefaultValueStr = QString(verboseDefaultStr);
     haveUserDefaultValues = false;
+    componentLogLevel.clear();
+    componentLogMask = 0;
 
     verboseInit();
 }
@@ -157,6 +446,22 @@ LoggingItem::LoggingItem(const char *_file, const char *_function,
     setThreadTid();
 }
 
+LoggingItem::LoggingItem(LogRecord &record) :
+        ReferenceCounter("LoggingItem", false),
+        m_tid(record.m_tid), m_threadId(record.m_threadId),
+        m_usec(record.m_usec), m_line(record.m_line), m_type(record.m_type),
+        m_level(record.m_level), m_epoch(record.m_epoch),
+        m_file(strdup(record.m_file)), m_function(strdup(record.m_function)),
+        m_message(std::move(record.m_message))
+{
+    // Registration records carry the thread's name as their message
+    if (m_type & kRegistering)
+    {
+        setThreadName(m_message);
+        m_message.clear();
+    }
+}
+
 LoggingItem::~LoggingItem()
 {
     free(m_file);
@@ -215,20 +520,7 @@ void LoggingItem::setThreadTid(void)
     m_tid = logThreadTidHash.value(m_threadId, -1);
     if (m_tid == -1)
     {
-        m_tid = 0;
-
-#if defined(Q_OS_ANDROID)
-        m_tid = (int64_t)gettid();
-#elif defined(linux)
-        m_tid = syscall(SYS_gettid);
-#elif defined(__FreeBSD__)
-        long lwpid;
-        int dummy = thr_self( &lwpid );
-        (void)dummy;
-        m_tid = (int64_t)lwpid;
-#elif CONFIG_DARWIN
-        m_tid = (int64_t)mach_thread_self();
-#endif
+        m_tid = log_current_tid();
         logThreadTidHash[m_threadId] = m_tid;
     }
 }
@@ -312,29 +604,28 @@ void LoggerThread::run(void)
 
     QMutexLocker qLock(&logQueueMutex);
 
-    while (!m_aborted || !logQueue.isEmpty())
+    while (true)
     {
         qLock.unlock();
         qApp->processEvents(QEventLoop::AllEvents, 10);
         qApp->sendPostedEvents(nullptr, QEvent::DeferredDelete);
 
+        QVector<LogRecord> records = log_take_records();
         qLock.relock();
-        if (logQueue.isEmpty())
+
+        if (!records.isEmpty())
         {
-            m_waitEmpty->wakeAll();
-            m_waitNotEmpty->wait(qLock.mutex(), 100);
+            qLock.unlock();
+            handleRecords(records);
+            qLock.relock();
             continue;
         }
 
-        LoggingItem *item = logQueue.dequeue();
-        qLock.unlock();
-
-        fillItem(item);
-        handleItem(item);
-        logConsole(item);
-        item->DecrRef();
+        if (m_aborted && log_rings_empty())
+            break;
 
-        qLock.relock();
+        m_waitEmpty->wakeAll();
+        m_waitNotEmpty->wait(qLock.mutex(), 100);
     }
 
     qLock.unlock();
@@ -361,7 +652,10 @@ void LoggerThread::handleItem(LoggingItem *item)
 {
     if (item->m_type & kRegistering)
     {
-        item->m_tid = item->getThreadTid();
+        {
+            QMutexLocker locker(&logThreadTidMutex);
+            logThreadTidHash[item->m_threadId] = item->m_tid;
+        }
 
         QMutexLocker locker(&logThreadMutex);
         if (logThreadHash.contains(item->m_threadId))
@@ -408,18 +702,20 @@ void LoggerThread::handleItem(LoggingItem *item)
     }
 
     if (!item->m_message.isEmpty())
+        logForwardMessage(item);
+}
+
+/// \brief  Turns records taken from the rings into LoggingItems and hands
+///         them to the console and the other loggers.
+void LoggerThread::handleRecords(QVector<LogRecord> &records)
+{
+    for (auto &record : records)
     {
-        /// TODO: This converts the LoggingItem to json for sending to
-        /// the log server.  Now that the log server is gone, it just
-        /// passed the json to the logForwardThread, where it will
-        /// eventually be converted back to a LoggingItem.  It should
-        /// be possible to eliminate the double conversion now that
-        /// the log server is gone and all logging happens in one
-        /// process.
-        QList<QByteArray> list;
-        list.append(QByteArray());
-        list.append(item->toByteArray());
-        logForwardMessage(list);
+        LoggingItem *item = LoggingItem::create(record);
+        fillItem(item);
+        handleItem(item);
+        logConsole(item);
+        item->DecrRef();
     }
 }
 
@@ -533,21 +829,22 @@ void LoggerThread::stop(void)
     m_waitNotEmpty->wakeAll();
 }
 
-/// \brief  Wait for the queue to be flushed (up to a timeout)
-/// \param  timeoutMS   The number of ms to wait for the queue to flush
-/// \return true if the queue is empty, false otherwise
+/// \brief  Wait for the rings to be emptied (up to a timeout)
+/// \param  timeoutMS   The number of ms to wait for the rings to empty
+/// \return true if the rings are empty, false otherwise
+/// \note   Must be called with logQueueMutex held
 bool LoggerThread::flush(int timeoutMS)
 {
     QElapsedTimer t;
     t.start();
-    while (!m_aborted && !logQueue.isEmpty() && !t.hasExpired(timeoutMS))
+    while (!m_aborted && !log_rings_empty() && !t.hasExpired(timeoutMS))
     {
         m_waitNotEmpty->wakeAll();
         int left = timeoutMS - t.elapsed();
         if (left > 0)
             m_waitEmpty->wait(&logQueueMutex, left);
     }
-    return logQueue.isEmpty();
+    return log_rings_empty();
 }
 
 void LoggerThread::fillItem(LoggingItem *item)
@@ -581,6 +878,14 @@ LoggingItem *LoggingItem::create(const char *_file,
     return item;
 }
 
+/// \brief  Create a new LoggingItem from a record taken from a ring
+/// \param  record  The record, its message is moved into the item
+/// \return LoggingItem that was created
+LoggingItem *LoggingItem::create(LogRecord &record)
+{
+    return new LoggingItem(record);
+}
+
 LoggingItem *LoggingItem::create(QByteArray &buf)
 {
     // Deserialize buffer
@@ -593,8 +898,10 @@ LoggingItem *LoggingItem::create(QByteArray &buf)
 }
 
 
-/// \brief  Format and send a log message into the queue.  This is called from
-///         the LOG() macro.  The intention is minimal blocking of the caller.
+/// \brief  Queue a log message for the logging thread.  This is called from
+///         the LOG() macro.  The caller never blocks, the message is put on a
+///         ring belonging to the calling thread and everything else,
+///         including formatting, is left to the logging thread.
 /// \param  mask    Verbosity mask of the message (VB_*)
 /// \param  level   Log level of this message (LOG_* - matching syslog levels)
 /// \param  file    Filename of source code logging the message
@@ -607,36 +914,25 @@ void LogPrintLine( uint64_t mask, LogLevel_t level, const char *file, int line,
     int type = kMessage;
     type |= (mask & VB_FLUSH) ? kFlush : 0;
     type |= (mask & VB_STDIO) ? kStandardIO : 0;
-    LoggingItem *item = LoggingItem::create(file, function, line, level,
-                                            (LoggingType)type);
-    if (!item)
-        return;
-
-    item->m_message = std::move(message);
-
-    QMutexLocker qLock(&logQueueMutex);
 
 #if defined( _MSC_VER ) && defined( _DEBUG )
-        OutputDebugStringA( qPrintable(item->m_message) );
+        OutputDebugStringA( qPrintable(message) );
         OutputDebugStringA( "\n" );
 #endif
 
-    logQueue.enqueue(item);
+    log_push(file, function, line, level, (LoggingType)type,
+             std::move(message));
 
     if (logThread && logThreadFinished && !logThread->isRunning())
     {
-        while (!logQueue.isEmpty())
-        {
-            item = logQueue.dequeue();
-            qLock.unlock();
-            logThread->handleItem(item);
-            logThread->logConsole(item);
-            item->DecrRef();
-            qLock.relock();
-        }
+        // Nothing empties the rings any more, so do it here
+        QMutexLocker qLock(&logQueueMutex);
+        QVector<LogRecord> records = log_take_records();
+        logThread->handleRecords(records);
     }
     else if (logThread && !logThreadFinished && (type & kFlush))
     {
+        QMutexLocker qLock(&logQueueMutex);
         logThread->flush();
     }
 }
@@ -772,16 +1068,7 @@ void loggingRegisterThread(const QString &name)
     if (logThreadFinished)
         return;
 
-    QMutexLocker qLock(&logQueueMutex);
-
-    LoggingItem *item = LoggingItem::create(__FILE__, __FUNCTION__,
-                                            __LINE__, LOG_DEBUG,
-                                            kRegistering);
-    if (item)
-    {
-        item->setThreadName((char *)name.toLocal8Bit().constData());
-        logQueue.enqueue(item);
-    }
+    log_push(__FILE__, __FUNCTION__, __LINE__, LOG_DEBUG, kRegistering, name);
 }
 
 /// \brief  Deregister the current thread's name.  This is triggered by the
@@ -791,13 +1078,8 @@ void loggingDeregisterThread(void)
     if (logThreadFinished)
         return;
 
-    QMutexLocker qLock(&logQueueMutex);
-
-    LoggingItem *item = LoggingItem::create(__FILE__, __FUNCTION__, __LINE__,
-                                            LOG_DEBUG,
-                                            kDeregistering);
-    if (item)
-        logQueue.enqueue(item);
+    log_push(__FILE__, __FUNCTION__, __LINE__, LOG_DEBUG, kDeregistering,
+             QString());
 }
 
 
@@ -1082,7 +1364,10 @@ int verboseArgParse(const QString& arg)
                     {
                         LogLevel_t level = logLevelGet(optionLevel);
                         if (level != LOG_UNKNOWN)
+                        {
                             componentLogLevel[item->mask] = level;
+                            componentLogMask |= item->mask;
+                        }
                     }
                 }
             }
@@ -4,6 +4,7 @@
 #include <QMutexLocker>
 #include <QMutex>
 #include <QQueue>
+#include <QVector>
 #include <QPointer>
 #include <QCoreApplication>
 
@@ -51,6 +52,27 @@ class LoggerThread;
 
 using tmType = struct tm;
 
+/// \brief One LOG() call, as put on the calling thread's ring.  It is only
+///        turned into a LoggingItem by the logging thread.
+struct LogRecord
+{
+    QString      m_message;            ///< Moved in from LOG(), not copied
+    const char  *m_file     {nullptr}; ///< Interned, never freed
+    const char  *m_function {nullptr}; ///< Interned, never freed
+    qlonglong    m_epoch    {0};
+    uint         m_usec     {0};
+    int          m_line     {0};
+    LogLevel_t   m_level    {LOG_INFO};
+    LoggingType  m_type     {kMessage};
+    qulonglong   m_threadId {UINT64_MAX};
+    qlonglong    m_tid      {0};
+};
+
+// Intended for use only by the test harness
+MBASE_PUBLIC void logTestPush(const QString &message);
+MBASE_PUBLIC QVector<LogRecord> logTestTakeRecords(void);
+MBASE_PUBLIC int logTestRingCount(void);
+
 #define SET_LOGGING_ARG(arg){ \
                                 free(arg); \
                                 (arg) = strdup(val.toLocal8Bit().constData()); \
@@ -90,6 +112,7 @@ class LoggingItem: public QObject, public ReferenceCounter
     static LoggingItem *create(const char *_file, const char *_function, int _line, LogLevel_t _level,
                                LoggingType _type);
     static LoggingItem *create(QByteArray &buf);
+    static LoggingItem *create(LogRecord &record);
     QByteArray toByteArray(void);
     QString getTimestamp(void) const;
     QString getTimestampUs(void) const;
@@ -159,6 +182,7 @@ class LoggingItem: public QObject, public ReferenceCounter
         : ReferenceCounter("LoggingItem", false) {};
     LoggingItem(const char *_file, const char *_function,
                 int _line, LogLevel_t _level, LoggingType _type);
+    explicit LoggingItem(LogRecord &record);
     ~LoggingItem() override;
     Q_DISABLE_COPY(LoggingItem);
 };
@@ -180,15 +204,16 @@ class LoggerThread : public QObject, public MThread
     bool flush(int timeoutMS = 200000);
     static void handleItem(LoggingItem *item);
     void fillItem(LoggingItem *item);
+    void handleRecords(QVector<LogRecord> &records);
   private:
     Q_DISABLE_COPY(LoggerThread);
     QWaitCondition *m_waitNotEmpty {nullptr};
-                                    ///< Condition variable for waiting
-                                    ///  for the queue to not be empty
+                                    ///< Condition variable for waking
+                                    ///  the thread to empty the rings
                                     ///  Protected by logQueueMutex
     QWaitCondition *m_waitEmpty    {nullptr};
                                     ///< Condition variable for waiting
-                                    ///  for the queue to be empty
+                                    ///  for the rings to be empty
                                     ///  Protected by logQueueMutex
     bool    m_aborted {false};      ///< Flag to abort the thread.
                                     ///  Protected by logQueueMutex
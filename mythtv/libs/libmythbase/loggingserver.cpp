@@ -691,10 +691,10 @@ void LogForwardThread::run(void)
             while (!logMsgList.isEmpty())
             {
                 processed++;
-                LogMessage *msg = logMsgList.takeFirst();
+                LoggingItem *item = logMsgList.takeFirst();
                 lock.unlock();
-                forwardMessage(msg);
-                delete msg;
+                forwardMessage(item);
+                item->DecrRef();
 
                 // Force a processEvents every 128 messages so a busy queue
                 // doesn't preclude timer notifications, etc.
@@ -742,31 +742,10 @@ void LogForwardThread::handleSigHup(void)
 #endif
 }
 
-void LogForwardThread::forwardMessage(LogMessage *msg)
+void LogForwardThread::forwardMessage(LoggingItem *item)
 {
-#ifdef DUMP_PACKET
-    QList<QByteArray>::const_iterator it = msg->begin();
-    int i = 0;
-    for (; it != msg->end(); ++it, i++)
-    {
-        QByteArray buf = *it;
-        cout << i << ":\t" << buf.size() << endl << "\t"
-             << buf.toHex().constData() << endl << "\t"
-             << buf.constData() << endl;
-    }
-#endif
-
-    // First section is the client id
-    QByteArray clientBa = msg->first();
-    QString clientId = QString(clientBa.toHex());
-
-    QByteArray json     = msg->at(1);
-
-    if (json.size() == 0)
-    {
-        // cout << "invalid msg, no json data " << qPrintable(clientId) << endl;
-        return;
-    }
+    // All messages come from this process now, so there is one client
+    QString clientId;
 
     QMutexLocker lock(&logClientMapMutex);
     LoggerListItem *logItem = logClientMap.value(clientId, nullptr);
@@ -778,8 +757,6 @@ void LogForwardThread::forwardMessage(LogMessage *msg)
     }
     else
     {
-        LoggingItem *item = LoggingItem::create(json);
-
         logClientCount.ref();
         LOG(VB_FILE, LOG_DEBUG, QString("New Logging Client: ID: %1 (#%2)")
             .arg(clientId).arg(logClientCount.fetchAndAddOrdered(0)));
@@ -857,18 +834,12 @@ void LogForwardThread::forwardMessage(LogMessage *msg)
         loggingGetTimeStamp(&logItem->m_itemEpoch, nullptr);
         logItem->m_itemList = loggers;
         logClientMap.insert(clientId, logItem);
-
-        item->DecrRef();
     }
 
     if (logItem && logItem->m_itemList && !logItem->m_itemList->isEmpty())
     {
-        LoggingItem *item = LoggingItem::create(json);
-        if (!item)
-            return;
         for (auto *it : qAsConst(*logItem->m_itemList))
             it->logmsg(item);
-        item->DecrRef();
     }
 }
 
@@ -903,13 +874,15 @@ void logForwardStop(void)
     }
 }
 
-void logForwardMessage(const QList<QByteArray> &msg)
+/// \brief Queues \p item for the file, syslog, journal and database loggers.
+///        The item must not be changed after this.
+void logForwardMessage(LoggingItem *item)
 {
-    auto *message = new LogMessage(msg);
+    item->IncrRef();
     QMutexLocker lock(&logMsgListMutex);
 
     bool wasEmpty = logMsgList.isEmpty();
-    logMsgList.append(message);
+    logMsgList.append(item);
 
     if (wasEmpty)
         logMsgListNotEmpty.wakeAll();
@@ -124,8 +124,7 @@ class DatabaseLogger : public LoggerBase
                                        ///  (in ms)
 };
 
-using LogMessage = QList<QByteArray>;
-using LogMessageList = QList<LogMessage *>;
+using LogMessageList = QList<LoggingItem *>;
 
 /// \brief The logging thread that forwards received messages to the consuming
 ///        loggers via ZeroMQ
@@ -142,7 +141,7 @@ class LogForwardThread : public QObject, public MThread
   private:
     bool m_aborted {false};          ///< Flag to abort the thread.
 
-    static void forwardMessage(LogMessage *msg);
+    static void forwardMessage(LoggingItem *item);
   signals:
     void incomingSigHup(void);
   protected slots:
@@ -151,7 +150,7 @@ class LogForwardThread : public QObject, public MThread
 
 MBASE_PUBLIC bool logForwardStart(void);
 MBASE_PUBLIC void logForwardStop(void);
-MBASE_PUBLIC void logForwardMessage(const QList<QByteArray> &msg);
+MBASE_PUBLIC void logForwardMessage(LoggingItem *item);
 
 
 class QWaitCondition;
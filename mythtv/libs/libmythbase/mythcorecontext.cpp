@@ -37,6 +37,7 @@ using namespace std;
 #include "compat.h"
 #include "mythconfig.h"       // for CONFIG_DARWIN
 #include "mythdownloadmanager.h"
+#include "mythdbwritequeue.h"
 #include "mythcorecontext.h"
 #include "mythsocket.h"
 #include "mythsystemlegacy.h"
@@ -173,6 +174,9 @@ MythCoreContextPrivate::~MythCoreContextPrivate()
     if (m_power)
         MythPower::AcquireRelease(this, false);
 
+    // Write out anything still queued while the DB is available
+    ShutdownMythDBWriteQueue();
+
     MThreadPool::StopAllPools();
 
     {
@@ -3,6 +3,10 @@
 // ANSI C
 #include <cstdlib>
 
+// C++
+#include <algorithm>
+#include <atomic>
+
 // Qt
 #include <QCoreApplication>
 #include <QElapsedTimer>
@@ -11,6 +15,7 @@
 #include <QSqlError>
 #include <QSqlField>
 #include <QSqlRecord>
+#include <QTextStream>
 #include <QVector>
 #include <utility>
 
@@ -26,6 +31,7 @@
 #include "mythdate.h"
 #include "portchecker.h"
 #include "mythmiscutil.h"
+#include "mythmetrics.h"
 
 #define DEBUG_RECONNECT 0
 #if DEBUG_RECONNECT
@@ -33,6 +39,20 @@
 #endif
 
 static const uint kPurgeTimeout = 60 * 60;
+static const int  kMaxQueryStats = 2000;
+
+// Statement cache counters, shared by all connections
+static std::atomic<quint64> s_stmtHits   {0};
+static std::atomic<quint64> s_stmtMisses {0};
+
+/// Query statistics recorded by a single thread, see MDBManager::RecordQuery()
+struct MSqlQueryStatsShard
+{
+    QMutex            m_lock; ///< only contended while the stats are read
+    MSqlQueryStatsMap m_stats;
+};
+
+static std::atomic<quint64> s_nextStatsId {1};
 
 bool TestDatabase(const QString& dbHostName,
                   const QString& dbUserName,
@@ -97,6 +117,8 @@ MSqlDatabase::MSqlDatabase(QString name)
 
 MSqlDatabase::~MSqlDatabase()
 {
+    ClearStatementCache();
+
     if (m_db.isOpen())
     {
         m_db.close();
@@ -244,13 +266,18 @@ bool MSqlDatabase::KickDatabase(void)
     m_lastDBKick = MythDate::current().addSecs(-60);
 
     if (!m_db.isOpen())
+    {
+        // Statements prepared on the old session are gone
+        ClearStatementCache();
         m_db.open();
+    }
 
     return m_db.isOpen();
 }
 
 bool MSqlDatabase::Reconnect()
 {
+    ClearStatementCache();
     m_db.close();
     m_db.open();
 
@@ -272,12 +299,123 @@ void MSqlDatabase::InitSessionVars()
     m_db.exec("SET @@session.sql_mode=''");
 }
 
+/**
+ *  \brief Hands out an idle cached prepared statement for this query text.
+ *
+ *  On success \p query shares the server side statement with the cache and
+ *  the entry is marked in use until ReleaseCachedStatement() is called, so
+ *  nested queries on the same connection never share a result set.
+ */
+bool MSqlDatabase::TakeCachedStatement(const QString &sql, QSqlQuery &query)
+{
+    auto it = m_stmtCache.find(sql);
+    if (it == m_stmtCache.end() || it->m_inUse)
+    {
+        ++s_stmtMisses;
+        return false;
+    }
+
+    it->m_inUse = true;
+    query = it->m_query;
+    query.finish();
+
+    if (m_stmtLRU.first() != sql)
+    {
+        m_stmtLRU.removeOne(sql);
+        m_stmtLRU.prepend(sql);
+    }
+
+    ++s_stmtHits;
+    return true;
+}
+
+/// \brief Adds a freshly prepared statement, marked in use, to the cache.
+void MSqlDatabase::CacheStatement(const QString &sql, const QSqlQuery &query)
+{
+    if (m_stmtCache.contains(sql))
+        return;
+
+    // Evict the least recently used statement that nobody is using
+    while (m_stmtCache.size() >= kPreparedStatementCacheSize)
+    {
+        auto victim = std::find_if(m_stmtLRU.rbegin(), m_stmtLRU.rend(),
+            [this](const QString &key){ return !m_stmtCache[key].m_inUse; });
+        if (victim == m_stmtLRU.rend())
+            return;
+        QString key = *victim;
+        m_stmtCache.remove(key);
+        m_stmtLRU.removeOne(key);
+    }
+
+    CachedStatement entry;
+    entry.m_query = query;
+    entry.m_inUse = true;
+    m_stmtCache.insert(sql, entry);
+    m_stmtLRU.prepend(sql);
+}
+
+void MSqlDatabase::ReleaseCachedStatement(const QString &sql)
+{
+    auto it = m_stmtCache.find(sql);
+    if (it == m_stmtCache.end())
+        return;
+    it->m_inUse = false;
+    // Free the result set but keep the statement prepared on the server
+    it->m_query.finish();
+}
+
+void MSqlDatabase::ClearStatementCache(void)
+{
+    if (!m_stmtCache.isEmpty())
+    {
+        LOG(VB_DATABASE, LOG_DEBUG,
+            QString("[%1] Dropping %2 cached prepared statements")
+                .arg(m_name).arg(m_stmtCache.size()));
+    }
+    m_stmtCache.clear();
+    m_stmtLRU.clear();
+}
+
 // -----------------------------------------------------------------------
 
 
 
+MDBManager::MDBManager()
+  : m_statsId(s_nextStatsId++)
+{
+    MythMetrics::AddCollector("database", [this](QTextStream &os)
+    {
+        MSqlPoolStats stats = GetPoolStats();
+
+        MythMetrics::PrintFamily(os, "mythtv_db_connections", "gauge",
+                                 "Pooled database connections");
+        os << "mythtv_db_connections{state=\"open\"} "
+           << stats.m_totalConnections << "\n"
+           << "mythtv_db_connections{state=\"idle\"} "
+           << stats.m_idleConnections << "\n"
+           << "mythtv_db_connections{state=\"peak\"} "
+           << stats.m_peakConnections << "\n";
+
+        MythMetrics::PrintFamily(os, "mythtv_db_connections_opened_total",
+                                 "counter", "Database connections opened");
+        os << "mythtv_db_connections_opened_total "
+           << stats.m_connectionsOpened << "\n";
+
+        MythMetrics::PrintFamily(os, "mythtv_db_prepared_statements_total",
+                                 "counter",
+                                 "Statements prepared, by whether the "
+                                 "statement cache had them");
+        os << "mythtv_db_prepared_statements_total{cache=\"hit\"} "
+           << stats.m_statementHits << "\n"
+           << "mythtv_db_prepared_statements_total{cache=\"miss\"} "
+           << stats.m_statementMisses << "\n";
+    });
+}
+
 MDBManager::~MDBManager()
 {
+    MythMetrics::RemoveCollector("database");
+
     CloseDatabases();
 
     if (m_connCount != 0 || m_schedCon || m_channelCon)
@@ -318,6 +456,8 @@ MSqlDatabase *MDBManager::popConnection(bool reuse)
     {
         db = new MSqlDatabase("DBManager" + QString::number(m_nextConnID++));
         ++m_connCount;
+        ++m_connOpened;
+        m_peakConnCount = std::max(m_peakConnCount, m_connCount);
         LOG(VB_DATABASE, LOG_INFO,
                 QString("New DB connection, total: %1").arg(m_connCount));
     }
@@ -397,6 +537,7 @@ void MDBManager::PurgeIdleConnections(bool leaveOne)
         MSqlDatabase *entry = *it;
         it = list.erase(it);
         --m_connCount;
+        ++m_connPurged;
         purgedConnections++;
 
         // Qt's MySQL driver apparently keeps track of the number of
@@ -416,6 +557,7 @@ void MDBManager::PurgeIdleConnections(bool leaveOne)
             newDb = new MSqlDatabase("DBManager" +
                                      QString::number(m_nextConnID++));
             ++m_connCount;
+            ++m_connOpened;
             LOG(VB_GENERAL, LOG_INFO,
                     QString("New DB connection, total: %1").arg(m_connCount));
             newDb->m_lastDBKick = MythDate::current();
@@ -476,6 +618,7 @@ void MDBManager::CloseDatabases()
     {
         LOG(VB_DATABASE, LOG_INFO,
             "Closing DB connection named '" + conn->m_name + "'");
+        conn->ClearStatementCache();
         conn->m_db.close();
         delete conn;
         m_connCount--;
@@ -488,6 +631,7 @@ void MDBManager::CloseDatabases()
         MSqlDatabase *db = slist.takeFirst();
         LOG(VB_DATABASE, LOG_INFO,
             "Closing DB connection named '" + db->m_name + "'");
+        db->ClearStatementCache();
         db->m_db.close();
         delete db;
 
@@ -499,6 +643,141 @@ void MDBManager::CloseDatabases()
     m_lock.unlock();
 }
 
+MSqlPoolStats MDBManager::GetPoolStats(void)
+{
+    MSqlPoolStats stats;
+
+    QMutexLocker locker(&m_lock);
+    stats.m_totalConnections  = m_connCount;
+    stats.m_peakConnections   = m_peakConnCount;
+    stats.m_connectionsOpened = m_connOpened;
+    stats.m_connectionsPurged = m_connPurged;
+    for (const auto &list : qAsConst(m_pool))
+        stats.m_idleConnections += list.size();
+    stats.m_statementHits   = s_stmtHits;
+    stats.m_statementMisses = s_stmtMisses;
+
+    return stats;
+}
+
+static void add_query_stats(MSqlQueryStatsMap &map, const QString &sql,
+                            const MSqlQueryStats &stats)
+{
+    // Ad hoc queries built with string concatenation would grow the map
+    // without bound, fold them into a single bucket once it is full.
+    static const QString kOtherQueries("<other queries>");
+    const QString &key = (map.size() < kMaxQueryStats ||
+                          map.contains(sql)) ? sql : kOtherQueries;
+    MSqlQueryStats &total = map[key];
+    total.m_count   += stats.m_count;
+    total.m_failed  += stats.m_failed;
+    total.m_totalMs += stats.m_totalMs;
+    total.m_maxMs    = std::max(total.m_maxMs, stats.m_maxMs);
+}
+
+/**
+ *  \brief Returns a copy of the per call site query statistics.
+ *
+ *  A call site is identified by the text of the query it executes, which
+ *  is unique for practically all of the prepared queries in MythTV.
+ */
+MSqlQueryStatsMap MDBManager::GetQueryStats(void)
+{
+    QMutexLocker locker(&m_statsLock);
+    MSqlQueryStatsMap result = m_retiredStats;
+
+    for (auto it = m_statsShards.begin(); it != m_statsShards.end(); )
+    {
+        // Once a thread has exited, only this list holds its shard. Fold
+        // it into m_retiredStats so short lived threads don't accumulate.
+        bool retired = it->use_count() == 1;
+        {
+            QMutexLocker shardLocker(&(*it)->m_lock);
+            const MSqlQueryStatsMap &stats = (*it)->m_stats;
+            for (auto s = stats.cbegin(); s != stats.cend(); ++s)
+            {
+                add_query_stats(result, s.key(), s.value());
+                if (retired)
+                    add_query_stats(m_retiredStats, s.key(), s.value());
+            }
+        }
+        if (retired)
+            it = m_statsShards.erase(it);
+        else
+            ++it;
+    }
+
+    return result;
+}
+
+void MDBManager::ResetQueryStats(void)
+{
+    QMutexLocker locker(&m_statsLock);
+    m_retiredStats.clear();
+    for (const auto &shard : qAsConst(m_statsShards))
+    {
+        QMutexLocker shardLocker(&shard->m_lock);
+        shard->m_stats.clear();
+    }
+}
+
+void MDBManager::RecordQuery(const QString &sql, qint64 elapsed, bool ok)
+{
+    // The shard is owned by both this thread and m_statsShards, and keyed
+    // by manager so a replacement MDBManager gets shards of its own.
+    static thread_local std::shared_ptr<MSqlQueryStatsShard> tls_shard;
+    static thread_local quint64 tls_statsId {0};
+
+    if (tls_statsId != m_statsId)
+    {
+        tls_shard = std::make_shared<MSqlQueryStatsShard>();
+        tls_statsId = m_statsId;
+        QMutexLocker locker(&m_statsLock);
+        m_statsShards.append(tls_shard);
+    }
+
+    MSqlQueryStats stats;
+    stats.m_count   = 1;
+    stats.m_failed  = ok ? 0 : 1;
+    stats.m_totalMs = elapsed;
+    stats.m_maxMs   = elapsed;
+
+    QMutexLocker locker(&tls_shard->m_lock);
+    add_query_stats(tls_shard->m_stats, sql, stats);
+}
+
+/// \brief Logs pool statistics and the call sites with most time spent
+void MDBManager::LogQueryStats(uint maxEntries)
+{
+    if (!VERBOSE_LEVEL_CHECK(VB_DATABASE, LOG_INFO))
+        return;
+
+    MSqlPoolStats pool = GetPoolStats();
+    LOG(VB_DATABASE, LOG_INFO,
+        QString("DB pool: %1 open (%2 idle, peak %3), %4 opened, %5 purged, "
+                "prepared statement cache %6 hits / %7 misses")
+            .arg(pool.m_totalConnections).arg(pool.m_idleConnections)
+            .arg(pool.m_peakConnections).arg(pool.m_connectionsOpened)
+            .arg(pool.m_connectionsPurged).arg(pool.m_statementHits)
+            .arg(pool.m_statementMisses));
+
+    MSqlQueryStatsMap stats = GetQueryStats();
+    QStringList keys = stats.keys();
+    std::sort(keys.begin(), keys.end(),
+              [&stats](const QString &a, const QString &b)
+              { return stats[a].m_totalMs > stats[b].m_totalMs; });
+
+    for (uint i = 0; i < maxEntries && i < (uint)keys.size(); ++i)
+    {
+        const MSqlQueryStats &s = stats[keys[i]];
+        LOG(VB_DATABASE, LOG_INFO,
+            QString("DB query: %1 calls, %2 failed, %3ms total, %4ms avg, "
+                    "%5ms max: %6")
+                .arg(s.m_count).arg(s.m_failed).arg(s.m_totalMs)
+                .arg(s.m_count ? s.m_totalMs / (qint64)s.m_count : 0)
+                .arg(s.m_maxMs).arg(keys[i].simplified().left(200)));
+    }
+}
 
 // -----------------------------------------------------------------------
 
@@ -521,6 +800,8 @@ MSqlQuery::MSqlQuery(const MSqlQueryInfo &qi)
 
 MSqlQuery::~MSqlQuery()
 {
+    releaseCachedStatement();
+
     if (m_returnConnection)
     {
         MDBManager *dbmanager = GetMythDB()->GetDBManager();
@@ -600,6 +881,18 @@ MSqlQueryInfo MSqlQuery::ChannelCon()
     return qi;
 }
 
+static void record_query_metrics(qint64 elapsedUs, bool ok)
+{
+    static auto *s_latency = MythMetrics::Histogram(
+        "mythtv_db_query_seconds", "Time taken to execute database queries");
+    static auto *s_failed = MythMetrics::Counter(
+        "mythtv_db_query_failures_total", "Database queries that failed");
+
+    s_latency->Record(elapsedUs);
+    if (!ok)
+        s_failed->Add();
+}
+
 bool MSqlQuery::exec()
 {
     if (!m_db)
@@ -637,6 +930,7 @@ bool MSqlQuery::exec()
 
     bool result = QSqlQuery::exec();
     qint64 elapsed = timer.elapsed();
+    qint64 elapsedUs = timer.nsecsElapsed() / 1000;
 
     // if the query failed with "MySQL server has gone away"
     // Close and reopen the database connection and retry the query if it
@@ -668,6 +962,7 @@ bool MSqlQuery::exec()
             timer.restart();
             result = QSqlQuery::exec();
             elapsed = timer.elapsed();
+            elapsedUs = timer.nsecsElapsed() / 1000;
         }
         if (result)
         {
@@ -678,6 +973,11 @@ bool MSqlQuery::exec()
         }
     }
 
+    MDBManager *dbmanager = GetMythDB()->GetDBManager();
+    if (dbmanager)
+        dbmanager->RecordQuery(m_lastPreparedQuery, elapsed, result);
+    record_query_metrics(elapsedUs, result);
+
     if (VERBOSE_LEVEL_CHECK(VB_DATABASE, LOG_INFO))
     {
         QString str = lastQuery();
@@ -725,6 +1025,12 @@ bool MSqlQuery::exec(const QString &query)
         return false;
     }
 
+    // QSqlQuery::exec(QString) detaches from any cached statement
+    releaseCachedStatement();
+
+    QElapsedTimer timer;
+    timer.start();
+
     bool result = QSqlQuery::exec(query);
 
     // if the query failed with "MySQL server has gone away"
@@ -735,6 +1041,11 @@ bool MSqlQuery::exec(const QString &query)
         && Reconnect())
         result = QSqlQuery::exec(query);
 
+    MDBManager *dbmanager = GetMythDB()->GetDBManager();
+    if (dbmanager)
+        dbmanager->RecordQuery(query, timer.elapsed(), result);
+    record_query_metrics(timer.nsecsElapsed() / 1000, result);
+
     LOG(VB_DATABASE, LOG_INFO,
             QString("MSqlQuery::exec(%1) %2%3")
                     .arg(m_db->MSqlDatabase::GetConnectionName()).arg(query)
@@ -813,6 +1124,8 @@ bool MSqlQuery::prepare(const QString& query)
         return false;
     }
 
+    releaseCachedStatement();
+
     m_lastPreparedQuery = query;
 
     if (!m_db->isOpen() && !Reconnect())
@@ -821,6 +1134,14 @@ bool MSqlQuery::prepare(const QString& query)
         return false;
     }
 
+    // Reuse the server side statement if this connection has prepared
+    // the same query before and nobody else is using it right now.
+    if (m_db->TakeCachedStatement(query, *this))
+    {
+        m_cachedStatement = true;
+        return true;
+    }
+
     // QT docs indicate that there are significant speed ups and a reduction
     // in memory usage by enabling forward-only cursors
     //
@@ -830,6 +1151,12 @@ bool MSqlQuery::prepare(const QString& query)
 
     bool ok = QSqlQuery::prepare(query);
 
+    if (ok && driver() && driver()->hasFeature(QSqlDriver::PreparedQueries))
+    {
+        m_db->CacheStatement(query, *this);
+        m_cachedStatement = true;
+    }
+
     // if the prepare failed with "MySQL server has gone away"
     // Close and reopen the database connection and retry the query if it
     // connects again
@@ -890,8 +1217,19 @@ QVariant MSqlQuery::lastInsertId()
     return QSqlQuery::lastInsertId();
 }
 
+void MSqlQuery::releaseCachedStatement(void)
+{
+    if (!m_cachedStatement)
+        return;
+    m_cachedStatement = false;
+    if (m_db)
+        m_db->ReleaseCachedStatement(m_lastPreparedQuery);
+}
+
 bool MSqlQuery::Reconnect(void)
 {
+    // The reconnect drops the statement cache, re-prepare privately
+    m_cachedStatement = false;
     if (!m_db->Reconnect())
         return false;
     if (!m_lastPreparedQuery.isEmpty())
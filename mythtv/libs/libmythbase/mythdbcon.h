@@ -1,6 +1,8 @@
 #ifndef MYTHDBCON_H_
 #define MYTHDBCON_H_
 
+#include <memory>
+
 #include <QSqlDatabase>
 #include <QSqlRecord>
 #include <QSqlError>
@@ -10,12 +12,17 @@
 #include <QDateTime>
 #include <QMutex>
 #include <QList>
+#include <QHash>
+#include <QStringList>
 
 #include "mythbaseexp.h"
 #include "mythdbparams.h"
 
 #define REUSE_CONNECTION 1
 
+/// Maximum number of prepared statements kept alive per DB connection
+static constexpr int kPreparedStatementCacheSize { 32 };
+
 MBASE_PUBLIC bool TestDatabase(const QString& dbHostName,
                                const QString& dbUserName,
                                QString dbPassword,
@@ -42,24 +49,66 @@ class MSqlDatabase
     bool Reconnect(void);
     void InitSessionVars(void);
 
+    bool TakeCachedStatement(const QString &sql, QSqlQuery &query);
+    void CacheStatement(const QString &sql, const QSqlQuery &query);
+    void ReleaseCachedStatement(const QString &sql);
+    void ClearStatementCache(void);
+
   private:
+    /// A server side prepared statement kept alive between MSqlQuery uses.
+    struct CachedStatement
+    {
+        QSqlQuery m_query;
+        bool      m_inUse {false};
+    };
+
     QString m_name;
     QSqlDatabase m_db;
     QDateTime m_lastDBKick;
     DatabaseParams m_dbparms;
+    QHash<QString, CachedStatement> m_stmtCache;
+    QStringList m_stmtLRU; // most recently used at the front
+};
+
+/// \brief Connection pool statistics, see MDBManager::GetPoolStats()
+struct MSqlPoolStats
+{
+    int     m_totalConnections  {0}; ///< pooled connections currently open
+    int     m_idleConnections   {0}; ///< open but not handed out
+    int     m_peakConnections   {0}; ///< high water mark of m_totalConnections
+    quint64 m_connectionsOpened {0};
+    quint64 m_connectionsPurged {0};
+    quint64 m_statementHits     {0}; ///< prepare() served from the cache
+    quint64 m_statementMisses   {0}; ///< prepare() sent to the server
 };
 
+/// \brief Per call site query statistics, see MDBManager::GetQueryStats()
+struct MSqlQueryStats
+{
+    quint64 m_count   {0};
+    quint64 m_failed  {0};
+    qint64  m_totalMs {0};
+    qint64  m_maxMs   {0};
+};
+using MSqlQueryStatsMap = QHash<QString, MSqlQueryStats>;
+struct MSqlQueryStatsShard;
+
 /// \brief DB connection pool, used by MSqlQuery. Do not use directly.
 class MBASE_PUBLIC MDBManager
 {
   friend class MSqlQuery;
   public:
-    MDBManager(void) = default;
+    MDBManager(void);
     ~MDBManager(void);
 
     void CloseDatabases(void);
     void PurgeIdleConnections(bool leaveOne = false);
 
+    MSqlPoolStats GetPoolStats(void);
+    MSqlQueryStatsMap GetQueryStats(void);
+    void ResetQueryStats(void);
+    void LogQueryStats(uint maxEntries = 20);
+
   protected:
     MSqlDatabase *popConnection(bool reuse);
     void pushConnection(MSqlDatabase *db);
@@ -67,6 +116,8 @@ class MBASE_PUBLIC MDBManager
     MSqlDatabase *getSchedCon(void);
     MSqlDatabase *getChannelCon(void);
 
+    void RecordQuery(const QString &sql, qint64 elapsed, bool ok);
+
   private:
     MSqlDatabase *getStaticCon(MSqlDatabase **dbcon, const QString& name);
 
@@ -80,6 +131,17 @@ class MBASE_PUBLIC MDBManager
 
     int m_nextConnID         {0};
     int m_connCount          {0};
+    int m_peakConnCount      {0};
+    quint64 m_connOpened     {0};
+    quint64 m_connPurged     {0};
+
+    // Each thread records its queries in its own shard, so executing a
+    // query never waits for another thread. The shards are only merged
+    // when the statistics are read.
+    quint64 m_statsId;
+    QMutex m_statsLock;
+    QList<std::shared_ptr<MSqlQueryStatsShard>> m_statsShards; // protected by m_statsLock
+    MSqlQueryStatsMap m_retiredStats; // protected by m_statsLock, from exited threads
 
     MSqlDatabase *m_schedCon {nullptr};
     MSqlDatabase *m_channelCon {nullptr};
@@ -234,10 +296,12 @@ class MBASE_PUBLIC MSqlQuery : private QSqlQuery
 
     bool seekDebug(const char *type, bool result,
                    int where, bool relative) const;
+    void releaseCachedStatement(void);
 
     MSqlDatabase *m_db               {nullptr};
     bool          m_isConnected      {false};
     bool          m_returnConnection {false};
+    bool          m_cachedStatement  {false}; ///< query is shared with m_db's statement cache
     QString       m_lastPreparedQuery; // holds a copy of the last prepared query
 };
 
@@ -0,0 +1,232 @@
+// C++ headers
+#include <algorithm>
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QTextStream>
+
+// MythTV headers
+#include "mythdbwritequeue.h"
+#include "mythdb.h"
+#include "mythlogging.h"
+#include "mythmetrics.h"
+
+#define LOC QString("DBWriteQueue: ")
+
+static QMutex            s_queueCreateLock;
+static MythDBWriteQueue *s_queue = nullptr;
+
+MythDBWriteQueue::MythDBWriteQueue()
+    : MThread("DBWriteQueue")
+{
+    MythMetrics::AddCollector("dbwritequeue", [this](QTextStream &os)
+    {
+        MythDBWriteQueueStats stats = GetStats();
+
+        MythMetrics::PrintFamily(os, "mythtv_dbwritequeue_depth", "gauge",
+                                 "Database writes waiting to be flushed");
+        os << "mythtv_dbwritequeue_depth " << stats.m_depth << "\n";
+
+        MythMetrics::PrintFamily(os, "mythtv_dbwritequeue_writes_total",
+                                 "counter",
+                                 "Database writes handed to the write queue, "
+                                 "by outcome");
+        os << "mythtv_dbwritequeue_writes_total{result=\"written\"} "
+           << stats.m_written << "\n"
+           << "mythtv_dbwritequeue_writes_total{result=\"failed\"} "
+           << stats.m_failed << "\n"
+           << "mythtv_dbwritequeue_writes_total{result=\"coalesced\"} "
+           << stats.m_coalesced << "\n"
+           << "mythtv_dbwritequeue_writes_total{result=\"dropped\"} "
+           << stats.m_dropped << "\n";
+
+        MythMetrics::PrintFamily(os, "mythtv_dbwritequeue_last_flush_seconds",
+                                 "gauge", "Time taken by the last flush");
+        os << "mythtv_dbwritequeue_last_flush_seconds "
+           << (stats.m_lastFlushMs / 1000.0) << "\n";
+    });
+}
+
+MythDBWriteQueue::~MythDBWriteQueue()
+{
+    MythMetrics::RemoveCollector("dbwritequeue");
+
+    {
+        QMutexLocker locker(&m_lock);
+        m_running = false;
+        m_wait.wakeAll();
+    }
+    wait();
+}
+
+/// \brief Queues a single prepared statement with its bindings.
+bool MythDBWriteQueue::Enqueue(const QString &key, const QString &sql,
+                               const MSqlBindings &bindings)
+{
+    return Enqueue(key, [sql, bindings]()
+    {
+        MSqlQuery query(MSqlQuery::InitCon());
+        query.prepare(sql);
+        query.bindValues(bindings);
+        if (!query.exec())
+        {
+            MythDB::DBError("DBWriteQueue", query);
+            return false;
+        }
+        return true;
+    });
+}
+
+/**
+ *  \brief Queues an arbitrary write, run later on the queue's thread.
+ *
+ *  \p func should use MSqlQuery::InitCon() for its queries, so they run on
+ *  the queue's connection.
+ *  \return false if the queue was full and the write was dropped.
+ */
+bool MythDBWriteQueue::Enqueue(const QString &key, const WriteFunc &func)
+{
+    QMutexLocker locker(&m_lock);
+
+    m_stats.m_enqueued++;
+
+    if (!key.isEmpty())
+    {
+        auto it = m_keyIndex.constFind(key);
+        if (it != m_keyIndex.constEnd())
+        {
+            m_pending[*it].m_func = func;
+            m_stats.m_coalesced++;
+            return true;
+        }
+    }
+
+    if (m_pending.size() >= kMaxPending)
+    {
+        // Log the first drop and then every 1000th, not each one
+        if ((m_stats.m_dropped++ % 1000) == 0)
+        {
+            LOG(VB_GENERAL, LOG_WARNING, LOC +
+                QString("Queue full, %1 writes dropped so far")
+                    .arg(m_stats.m_dropped));
+        }
+        return false;
+    }
+
+    if (!key.isEmpty())
+        m_keyIndex.insert(key, m_pending.size());
+    m_pending.append({key, func});
+
+    m_stats.m_depth    = m_pending.size();
+    m_stats.m_maxDepth = std::max(m_stats.m_maxDepth, m_stats.m_depth);
+
+    return true;
+}
+
+/// \brief Writes everything queued so far and waits until it is done.
+void MythDBWriteQueue::Flush(void)
+{
+    QMutexLocker locker(&m_lock);
+    if (!m_running)
+        return;
+    m_flushWanted = true;
+    m_wait.wakeAll();
+    while (m_running && (m_busy || !m_pending.isEmpty()))
+        m_flushed.wait(&m_lock);
+}
+
+MythDBWriteQueueStats MythDBWriteQueue::GetStats(void)
+{
+    QMutexLocker locker(&m_lock);
+    return m_stats;
+}
+
+void MythDBWriteQueue::run(void)
+{
+    RunProlog();
+
+    QMutexLocker locker(&m_lock);
+    while (true)
+    {
+        if (m_running && !m_flushWanted)
+            m_wait.wait(&m_lock, kFlushIntervalMs);
+
+        QList<Write> batch;
+        batch.swap(m_pending);
+        m_keyIndex.clear();
+        m_stats.m_depth = 0;
+        m_flushWanted = false;
+        bool running = m_running;
+
+        if (!batch.isEmpty())
+        {
+            m_busy = true;
+            locker.unlock();
+            ExecuteBatch(batch);
+            locker.relock();
+            m_busy = false;
+        }
+        m_flushed.wakeAll();
+
+        if (!running && m_pending.isEmpty())
+            break;
+    }
+    locker.unlock();
+
+    RunEpilog();
+}
+
+void MythDBWriteQueue::ExecuteBatch(const QList<Write> &batch)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    // Holding this query keeps the thread's connection checked out, so
+    // every write in the batch shares it.  The tables written to are
+    // MyISAM, so there is no transaction to group them in.
+    MSqlQuery query(MSqlQuery::InitCon());
+
+    quint64 failed = 0;
+    for (const auto &write : batch)
+    {
+        if (!write.m_func())
+            failed++;
+    }
+
+    qint64 elapsed = timer.elapsed();
+
+    LOG(VB_DATABASE, LOG_DEBUG, LOC +
+        QString("Flushed %1 writes (%2 failed) in %3ms")
+            .arg(batch.size()).arg(failed).arg(elapsed));
+
+    QMutexLocker locker(&m_lock);
+    m_stats.m_written    += batch.size() - failed;
+    m_stats.m_failed     += failed;
+    m_stats.m_flushes++;
+    m_stats.m_lastFlushMs = elapsed;
+    m_stats.m_maxFlushMs  = std::max(m_stats.m_maxFlushMs, elapsed);
+}
+
+/** \brief Gets the MythDBWriteQueue singleton, starting it if needed.
+ */
+MythDBWriteQueue *GetMythDBWriteQueue(void)
+{
+    QMutexLocker locker(&s_queueCreateLock);
+    if (!s_queue)
+    {
+        s_queue = new MythDBWriteQueue();
+        s_queue->start();
+    }
+    return s_queue;
+}
+
+/** \brief Writes any queued DB writes and stops the queue.
+ *
+ *  Must be called while the database is still available.
+ */
+void ShutdownMythDBWriteQueue(void)
+{
+    QMutexLocker locker(&s_queueCreateLock);
+    delete s_queue;
+    s_queue = nullptr;
+}
@@ -0,0 +1,97 @@
+#ifndef MYTHDBWRITEQUEUE_H
+#define MYTHDBWRITEQUEUE_H
+
+#include <functional>
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QWaitCondition>
+
+#include "mythbaseexp.h"
+#include "mthread.h"
+#include "mythdbcon.h"
+
+/// \brief Write-behind queue statistics, see MythDBWriteQueue::GetStats()
+struct MythDBWriteQueueStats
+{
+    int     m_depth         {0}; ///< writes waiting to be flushed
+    int     m_maxDepth      {0}; ///< high water mark of m_depth
+    quint64 m_enqueued      {0};
+    quint64 m_coalesced     {0}; ///< replaced a pending write with the same key
+    quint64 m_dropped       {0}; ///< not queued, the queue was full
+    quint64 m_written       {0};
+    quint64 m_failed        {0};
+    quint64 m_flushes       {0};
+    qint64  m_lastFlushMs   {0};
+    qint64  m_maxFlushMs    {0};
+};
+
+/** \class MythDBWriteQueue
+ *  \brief Write-behind queue for non-critical, high frequency DB writes.
+ *
+ *  Recorder threads must never wait on MySQL, e.g. while the database is
+ *  being optimized or backed up.  Writes handed to this queue are executed
+ *  later, in batches, by a dedicated thread using its own connection.
+ *
+ *  Enqueue() only ever holds the queue mutex for a constant time list or
+ *  hash update; the flush thread swaps the whole pending list out under
+ *  the same mutex and does all DB work without it.  So enqueueing never
+ *  blocks on the database, however slow it is.
+ *
+ *  Writes with a non-empty key are coalesced: a newer write replaces a
+ *  pending one with the same key (e.g. "the file size of recording N"),
+ *  keeping the older one's place in the queue.  Writes without a key are
+ *  executed in order.
+ *
+ *  If the queue is full a new write, one that can't be coalesced, is
+ *  dropped, counted and logged, and Enqueue() returns false so the caller
+ *  can keep the data and try again later.  The caller never waits on the
+ *  database.
+ */
+class MBASE_PUBLIC MythDBWriteQueue : public MThread
+{
+  public:
+    using WriteFunc = std::function<bool(void)>;
+
+    MythDBWriteQueue();
+    ~MythDBWriteQueue() override;
+
+    bool Enqueue(const QString &key, const QString &sql,
+                 const MSqlBindings &bindings);
+    bool Enqueue(const QString &key, const WriteFunc &func);
+    void Flush(void);
+
+    MythDBWriteQueueStats GetStats(void);
+
+    static constexpr int kMaxPending      = 20000;
+    static constexpr int kFlushIntervalMs = 1000;
+
+  protected:
+    void run(void) override; // MThread
+
+  private:
+    struct Write
+    {
+        QString   m_key;
+        WriteFunc m_func;
+    };
+
+    void ExecuteBatch(const QList<Write> &batch);
+
+    QMutex              m_lock;
+    QWaitCondition      m_wait;
+    QWaitCondition      m_flushed;
+    QList<Write>        m_pending;   // protected by m_lock
+    QHash<QString, int> m_keyIndex;  // key -> index in m_pending
+    bool                m_running      {true};
+    bool                m_flushWanted  {false};
+    bool                m_busy         {false}; // a batch is being written
+    MythDBWriteQueueStats m_stats;              // protected by m_lock
+};
+
+MBASE_PUBLIC MythDBWriteQueue *GetMythDBWriteQueue(void);
+MBASE_PUBLIC void ShutdownMythDBWriteQueue(void);
+
+#endif // MYTHDBWRITEQUEUE_H
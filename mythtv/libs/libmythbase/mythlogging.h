@@ -9,20 +9,29 @@
 #include "mythbaseexp.h"  //  MBASE_PUBLIC , etc.
 #include "verbosedefs.h"
 
-// Helper for checking verbose mask & level outside of LOG macro
+// Messages less important than this are compiled out of LOG() entirely,
+// e.g. DEFINES += MYTH_LOG_MAX_LEVEL=LOG_INFO drops all LOG_DEBUG calls.
+#ifndef MYTH_LOG_MAX_LEVEL
+#define MYTH_LOG_MAX_LEVEL LOG_DEBUG
+#endif
+
+// Helper for checking verbose mask & level outside of LOG macro.  The
+// componentLogLevel map is only searched for masks that could be in it.
 #define VERBOSE_LEVEL_NONE        (verboseMask == 0)
 #define VERBOSE_LEVEL_CHECK(_MASK_, _LEVEL_) \
-    (componentLogLevel.contains(_MASK_) ?                               \
+    (((((_MASK_) & ~componentLogMask) == 0) &&                          \
+      componentLogLevel.contains(_MASK_)) ?                             \
      (*(componentLogLevel.find(_MASK_)) >= (_LEVEL_)) :                   \
      (((verboseMask & (_MASK_)) == (_MASK_)) && logLevel >= (_LEVEL_)))
 
 #define VERBOSE please_use_LOG_instead_of_VERBOSE
 
-// This doesn't lock the calling thread other than momentarily to put
-// the log message onto a queue.
+// This doesn't lock the calling thread, the message is put on a ring
+// belonging to the calling thread and formatted by the logging thread.
 #define LOG(_MASK_, _LEVEL_, _QSTRING_)                                 \
     do {                                                                \
-        if (VERBOSE_LEVEL_CHECK((_MASK_), (_LEVEL_)) && ((_LEVEL_)>=0)) \
+        if (((_LEVEL_) <= MYTH_LOG_MAX_LEVEL) && ((_LEVEL_)>=0) &&      \
+            VERBOSE_LEVEL_CHECK((_MASK_), (_LEVEL_)))                   \
         {                                                               \
             LogPrintLine(_MASK_, _LEVEL_,                               \
                          __FILE__, __LINE__, __FUNCTION__,              \
@@ -40,6 +49,8 @@ extern MBASE_PUBLIC LogLevel_t logLevel;
 extern MBASE_PUBLIC uint64_t   verboseMask;
 
 extern MBASE_PUBLIC ComponentLogLevelMap componentLogLevel;
+/// All the masks that have an entry in componentLogLevel
+extern MBASE_PUBLIC uint64_t             componentLogMask;
 
 extern MBASE_PUBLIC QStringList logPropagateArgList;
 extern MBASE_PUBLIC QString     logPropagateArgs;
@@ -0,0 +1,264 @@
+// C++ headers
+#include <algorithm>
+#include <cmath>
+
+// Qt headers
+#include <QMap>
+#include <QMutex>
+#include <QTextStream>
+#include <QtAlgorithms>
+
+// MythTV headers
+#include "mythmetrics.h"
+#include "mythlogging.h"
+
+#define LOC QString("Metrics: ")
+
+static const std::array<double,4> kQuantiles { 0.5, 0.9, 0.99, 0.999 };
+
+static QString add_label(const QString &labels, const QString &label)
+{
+    if (labels.isEmpty())
+        return "{" + label + "}";
+    return "{" + labels + "," + label + "}";
+}
+
+static QString braces(const QString &labels)
+{
+    return labels.isEmpty() ? QString() : "{" + labels + "}";
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void MythMetricCounter::Print(QTextStream &os, const QString &name,
+                              const QString &labels) const
+{
+    os << name << braces(labels) << " " << Value() << "\n";
+}
+
+void MythMetricGauge::Print(QTextStream &os, const QString &name,
+                            const QString &labels) const
+{
+    os << name << braces(labels) << " " << Value() << "\n";
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+int MythMetricHistogram::BucketIndex(uint64_t value)
+{
+    if (value < static_cast<uint64_t>(kSubBuckets))
+        return static_cast<int>(value);
+
+    // Group 1 is [kSubBuckets, 2 * kSubBuckets), each group after that
+    // covers twice the range with the same number of buckets.
+    int msb   = 63 - static_cast<int>(qCountLeadingZeroBits(static_cast<quint64>(value)));
+    int group = msb - kSubBucketBits + 1;
+    int sub   = static_cast<int>(value >> (msb - kSubBucketBits)) - kSubBuckets;
+    return (group * kSubBuckets) + sub;
+}
+
+uint64_t MythMetricHistogram::BucketLowest(int index)
+{
+    int group = index / kSubBuckets;
+    int sub   = index % kSubBuckets;
+    if (group == 0)
+        return sub;
+    return static_cast<uint64_t>(kSubBuckets + sub) << (group - 1);
+}
+
+uint64_t MythMetricHistogram::BucketHighest(int index)
+{
+    int group = index / kSubBuckets;
+    if (group == 0)
+        return BucketLowest(index);
+    return BucketLowest(index) + ((1ULL << (group - 1)) - 1);
+}
+
+/**
+ *  \brief Returns the value below which a fraction \p q of the recorded
+ *         values lie.
+ *
+ *  The result is the highest value of the bucket the quantile falls in,
+ *  so it is never lower than the exact quantile and at most 1/kSubBuckets
+ *  higher.
+ */
+uint64_t MythMetricHistogram::Quantile(double q) const
+{
+    uint64_t total = Count();
+    if (total == 0)
+        return 0;
+
+    auto target = static_cast<uint64_t>(std::ceil(q * total));
+    target = std::clamp<uint64_t>(target, 1, total);
+
+    uint64_t seen = 0;
+    for (int i = 0; i < kBuckets; ++i)
+    {
+        seen += m_counts[i].load(std::memory_order_relaxed);
+        if (seen >= target)
+            return std::min(BucketHighest(i), Max());
+    }
+
+    // Values recorded while we were counting
+    return Max();
+}
+
+void MythMetricHistogram::Print(QTextStream &os, const QString &name,
+                                const QString &labels) const
+{
+    for (double q : kQuantiles)
+    {
+        os << name << add_label(labels, MythMetrics::Label("quantile", QString::number(q)))
+           << " " << (Quantile(q) / m_scale) << "\n";
+    }
+    os << name << "_sum" << braces(labels) << " " << (Sum() / m_scale) << "\n"
+       << name << "_count" << braces(labels) << " " << Count() << "\n";
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+struct MetricFamily
+{
+    QString                      m_type;
+    QString                      m_help;
+    QMap<QString, MythMetric *>  m_metrics; // by labels
+};
+
+static QMutex                                 s_lock;
+static QMap<QString, MetricFamily>            s_families;    // protected by s_lock
+static QMutex                                 s_collectLock;
+static QMap<QString, MythMetrics::Collector>  s_collectors;  // protected by s_collectLock
+
+template <typename T, typename... Args>
+static T *find_or_add(const QString &name, const QString &type,
+                      const QString &help, const QString &labels,
+                      Args... args)
+{
+    QMutexLocker locker(&s_lock);
+
+    MetricFamily &family = s_families[name];
+    if (family.m_type.isEmpty())
+    {
+        family.m_type = type;
+        family.m_help = help;
+    }
+    else if (family.m_type != type)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("%1 is a %2, not a %3, it will not be exported")
+                .arg(name, family.m_type, type));
+        return new T(args...);
+    }
+
+    MythMetric *&metric = family.m_metrics[labels];
+    if (metric == nullptr)
+        metric = new T(args...);
+    return static_cast<T *>(metric);
+}
+
+/// \brief Returns the counter called \p name with \p labels, adding it if needed
+MythMetricCounter *MythMetrics::Counter(const QString &name,
+                                        const QString &help,
+                                        const QString &labels)
+{
+    return find_or_add<MythMetricCounter>(name, "counter", help, labels);
+}
+
+/// \brief Returns the gauge called \p name with \p labels, adding it if needed
+MythMetricGauge *MythMetrics::Gauge(const QString &name,
+                                    const QString &help,
+                                    const QString &labels)
+{
+    return find_or_add<MythMetricGauge>(name, "gauge", help, labels);
+}
+
+/**
+ *  \brief Returns the histogram called \p name with \p labels, adding it if
+ *         needed.
+ *
+ *  \param scale Recorded values are divided by this when exported. The
+ *               default suits durations recorded in microseconds, which
+ *               Prometheus expects in seconds.
+ */
+MythMetricHistogram *MythMetrics::Histogram(const QString &name,
+                                            const QString &help,
+                                            const QString &labels,
+                                            double scale)
+{
+    return find_or_add<MythMetricHistogram>(name, "summary", help, labels,
+                                            scale);
+}
+
+/**
+ *  \brief Calls \p collector on every export, to add statistics that are
+ *         kept elsewhere.
+ *
+ *  A collector with the same \p id is replaced. Collectors may look up
+ *  metrics, but must not add or remove collectors.
+ */
+void MythMetrics::AddCollector(const QString &id, const Collector &collector)
+{
+    QMutexLocker locker(&s_collectLock);
+    s_collectors[id] = collector;
+}
+
+/// \brief Removes a collector; once this returns it is no longer running.
+void MythMetrics::RemoveCollector(const QString &id)
+{
+    QMutexLocker locker(&s_collectLock);
+    s_collectors.remove(id);
+}
+
+/// \brief Returns name="value", with the value escaped
+QString MythMetrics::Label(const QString &name, const QString &value)
+{
+    QString escaped = value;
+    escaped.replace("\\", "\\\\");
+    escaped.replace("\"", "\\\"");
+    escaped.replace("\n", "\\n");
+    return name + "=\"" + escaped + "\"";
+}
+
+void MythMetrics::PrintFamily(QTextStream &os, const QString &name,
+                              const QString &type, const QString &help)
+{
+    os << "# HELP " << name << " " << help << "\n"
+       << "# TYPE " << name << " " << type << "\n";
+}
+
+/// \brief Returns all metrics in the Prometheus text format, version 0.0.4
+QByteArray MythMetrics::Export(void)
+{
+    QByteArray text;
+    QTextStream os(&text);
+    os.setCodec("UTF-8");
+
+    {
+        QMutexLocker locker(&s_lock);
+
+        for (auto it = s_families.cbegin(); it != s_families.cend(); ++it)
+        {
+            if (it->m_metrics.isEmpty())
+                continue;
+
+            PrintFamily(os, it.key(), it->m_type, it->m_help);
+            for (auto m = it->m_metrics.cbegin(); m != it->m_metrics.cend(); ++m)
+                (*m)->Print(os, it.key(), m.key());
+        }
+    }
+
+    // Held while collecting, so RemoveCollector() can't return while the
+    // object a collector reads from is in use
+    QMutexLocker locker(&s_collectLock);
+    for (const auto &collector : qAsConst(s_collectors))
+        collector(os);
+
+    os.flush();
+    return text;
+}
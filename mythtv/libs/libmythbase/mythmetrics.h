@@ -0,0 +1,157 @@
+#ifndef MYTHMETRICS_H
+#define MYTHMETRICS_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+#include <QByteArray>
+#include <QString>
+
+#include "mythbaseexp.h"
+
+class QTextStream;
+
+/** \class MythMetric
+ *  \brief Base of the metrics kept by MythMetrics.
+ *
+ *  Only exporting is virtual; updating a metric is an inline relaxed
+ *  atomic operation, cheap enough for recorder and playback hot paths.
+ */
+class MBASE_PUBLIC MythMetric
+{
+  public:
+    virtual ~MythMetric() = default;
+
+    /// Prints the samples of the metric, without HELP or TYPE lines
+    virtual void Print(QTextStream &os, const QString &name,
+                       const QString &labels) const = 0;
+};
+
+/// \brief A value that only ever goes up, e.g. bytes written or errors
+class MBASE_PUBLIC MythMetricCounter : public MythMetric
+{
+  public:
+    void     Add(uint64_t n = 1) { m_value.fetch_add(n, std::memory_order_relaxed); }
+    uint64_t Value(void) const   { return m_value.load(std::memory_order_relaxed); }
+
+    void Print(QTextStream &os, const QString &name,
+               const QString &labels) const override;
+
+  private:
+    std::atomic<uint64_t> m_value {0};
+};
+
+/// \brief A value that goes up and down, e.g. a queue depth
+class MBASE_PUBLIC MythMetricGauge : public MythMetric
+{
+  public:
+    void    Set(int64_t value) { m_value.store(value, std::memory_order_relaxed); }
+    void    Add(int64_t n)     { m_value.fetch_add(n, std::memory_order_relaxed); }
+    int64_t Value(void) const  { return m_value.load(std::memory_order_relaxed); }
+
+    void Print(QTextStream &os, const QString &name,
+               const QString &labels) const override;
+
+  private:
+    std::atomic<int64_t> m_value {0};
+};
+
+/** \class MythMetricHistogram
+ *  \brief A high dynamic range histogram of integer values, e.g. latencies
+ *         in microseconds.
+ *
+ *  Each power of two is split into kSubBuckets linear buckets, so any
+ *  value from 0 to 2^64 is counted in a fixed array with a relative error
+ *  below 1/kSubBuckets. Recording is a few relaxed atomic adds and never
+ *  allocates or locks.
+ *
+ *  It is exported as a Prometheus summary, with the values divided by the
+ *  scale given when it was registered (e.g. 1e6 for microseconds to
+ *  seconds).
+ */
+class MBASE_PUBLIC MythMetricHistogram : public MythMetric
+{
+  public:
+    static constexpr int kSubBucketBits = 4;
+    static constexpr int kSubBuckets    = 1 << kSubBucketBits;
+    static constexpr int kBuckets       = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+    explicit MythMetricHistogram(double scale = 1.0) : m_scale(scale) {}
+
+    void Record(uint64_t value)
+    {
+        m_counts[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(value, std::memory_order_relaxed);
+        uint64_t max = m_max.load(std::memory_order_relaxed);
+        while (value > max &&
+               !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+            ;
+    }
+
+    uint64_t Count(void) const { return m_count.load(std::memory_order_relaxed); }
+    uint64_t Sum(void) const   { return m_sum.load(std::memory_order_relaxed); }
+    uint64_t Max(void) const   { return m_max.load(std::memory_order_relaxed); }
+    uint64_t Quantile(double q) const;
+
+    void Print(QTextStream &os, const QString &name,
+               const QString &labels) const override;
+
+    static int      BucketIndex(uint64_t value);
+    static uint64_t BucketLowest(int index);
+    static uint64_t BucketHighest(int index);
+
+  private:
+    double                                     m_scale;
+    std::array<std::atomic<uint64_t>,kBuckets> m_counts {};
+    std::atomic<uint64_t>                      m_count  {0};
+    std::atomic<uint64_t>                      m_sum    {0};
+    std::atomic<uint64_t>                      m_max    {0};
+};
+
+/** \class MythMetrics
+ *  \brief Process wide registry of metrics, exported in the Prometheus
+ *         text format.
+ *
+ *  Metrics are looked up by name and labels once, typically into a static
+ *  or a member pointer, and then updated without any locking:
+ *
+ *  \code
+ *  static auto *s_written = MythMetrics::Counter(
+ *      "mythtv_filewriter_written_bytes_total", "Bytes written to recordings");
+ *  s_written->Add(len);
+ *  \endcode
+ *
+ *  Metrics are never deleted, so the pointers remain valid until exit.
+ *  Statistics kept elsewhere can be exported with AddCollector().
+ */
+class MBASE_PUBLIC MythMetrics
+{
+  public:
+    /// Prints complete metric families, including HELP and TYPE lines
+    using Collector = std::function<void(QTextStream &os)>;
+
+    static MythMetricCounter   *Counter(const QString &name,
+                                        const QString &help,
+                                        const QString &labels = QString());
+    static MythMetricGauge     *Gauge(const QString &name,
+                                      const QString &help,
+                                      const QString &labels = QString());
+    static MythMetricHistogram *Histogram(const QString &name,
+                                          const QString &help,
+                                          const QString &labels = QString(),
+                                          double scale = 1e6);
+
+    static void AddCollector(const QString &id, const Collector &collector);
+    static void RemoveCollector(const QString &id);
+
+    static QString Label(const QString &name, const QString &value);
+    static void    PrintFamily(QTextStream &os, const QString &name,
+                               const QString &type, const QString &help);
+
+    static QByteArray Export(void);
+};
+
+#endif // MYTHMETRICS_H
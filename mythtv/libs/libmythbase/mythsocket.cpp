@@ -30,6 +30,7 @@ using std::vector;
 #include "mythversion.h"
 #include "mythlogging.h"
 #include "mythcorecontext.h"
+#include "mythmetrics.h"
 #include "portchecker.h"
 
 #define SLOC(a) QString("MythSocket(%1:%2): ") \
@@ -339,6 +340,31 @@ bool MythSocket::ReadStringList(QStringList &list, uint timeoutMS)
     return ret;
 }
 
+/// \brief Returns the latency histogram of the protocol command \p command
+static MythMetricHistogram *command_histogram(const QString &command)
+{
+    // Per thread, so the registry is only locked for a thread's first
+    // use of a command
+    thread_local QHash<QString, MythMetricHistogram *> tl_histograms;
+
+    MythMetricHistogram *&histogram = tl_histograms[command];
+    if (histogram == nullptr)
+    {
+        histogram = MythMetrics::Histogram(
+            "mythtv_socket_command_seconds",
+            "Round trip time of protocol commands sent by this process",
+            MythMetrics::Label("command", command));
+    }
+    return histogram;
+}
+
+static void count_socket_error(const char *reason)
+{
+    MythMetrics::Counter("mythtv_socket_command_errors_total",
+                         "Protocol commands that failed",
+                         MythMetrics::Label("reason", reason))->Add();
+}
+
 bool MythSocket::SendReceiveStringList(
     QStringList &strlist, uint min_reply_length, uint timeoutMS)
 {
@@ -354,21 +380,31 @@ bool MythSocket::SendReceiveStringList(
                                 .arg(strlist.isEmpty() ? "empty" : strlist[0]));
     }
 
+    QString command = strlist.isEmpty() ? QString("empty")
+                                        : strlist[0].section(' ', 0, 0);
+    MythTimer timer;
+    timer.start();
+
     if (!WriteStringList(strlist))
     {
         LOG(VB_GENERAL, LOG_ERR, LOC + "Failed to send command.");
+        count_socket_error("send");
         return false;
     }
 
     if (!ReadStringList(strlist, timeoutMS))
     {
         LOG(VB_GENERAL, LOG_ERR, LOC + "No response.");
+        count_socket_error("timeout");
         return false;
     }
 
+    command_histogram(command)->Record(timer.nsecsElapsed() / 1000);
+
     if (min_reply_length && ((uint)strlist.size() < min_reply_length))
     {
         LOG(VB_GENERAL, LOG_ERR, LOC + "Response too short.");
+        count_socket_error("short");
         return false;
     }
 
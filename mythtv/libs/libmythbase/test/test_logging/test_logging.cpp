@@ -271,6 +271,101 @@ void TestLogging::test_verboseArgParse_level (void)
     QCOMPARE(verboseString.trimmed(), expectedVString);
 }
 
+void TestLogging::test_verboseLevelCheck (void)
+{
+    resetLogging();
+    QCOMPARE(verboseArgParse("general,file:debug,channel"), GENERIC_EXIT_OK);
+    logLevel = LOG_INFO;
+
+    QVERIFY(componentLogMask & VB_FILE);
+    QVERIFY(VERBOSE_LEVEL_CHECK(VB_GENERAL, LOG_INFO));
+    QVERIFY(!VERBOSE_LEVEL_CHECK(VB_GENERAL, LOG_DEBUG));
+    QVERIFY(VERBOSE_LEVEL_CHECK(VB_FILE, LOG_DEBUG));
+    QVERIFY(VERBOSE_LEVEL_CHECK(VB_CHANNEL, LOG_INFO));
+    QVERIFY(!VERBOSE_LEVEL_CHECK(VB_CHANNEL, LOG_DEBUG));
+    QVERIFY(!VERBOSE_LEVEL_CHECK(VB_RECORD, LOG_ERR));
+    QVERIFY(!VERBOSE_LEVEL_CHECK(VB_FILE | VB_RECORD, LOG_ERR));
+}
+
+// More records than fit in a thread's ring (256), so some overflow
+static constexpr int kOverflowRecords = 1000;
+
+void TestLogging::test_logRingOverflow (void)
+{
+    logTestTakeRecords();
+
+    // Nothing empties the ring while these are pushed
+    for (int i = 0; i < kOverflowRecords; ++i)
+        logTestPush(QString::number(i));
+
+    QVector<LogRecord> records = logTestTakeRecords();
+    QCOMPARE(records.size(), kOverflowRecords);
+    for (int i = 0; i < kOverflowRecords; ++i)
+        QCOMPARE(records[i].m_message, QString::number(i));
+
+    // Once emptied, the ring takes records again
+    logTestPush("after");
+    records = logTestTakeRecords();
+    QCOMPARE(records.size(), 1);
+    QCOMPARE(records[0].m_message, QString("after"));
+}
+
+void TestLogging::test_logRingMergeOrder (void)
+{
+    static constexpr int kTurns = 20;
+    logTestTakeRecords();
+
+    // Two threads take turns logging, so each record is later than the
+    // one before it from the other thread
+    std::atomic<int> turn {0};
+    auto logger = [&turn](int first, const QString &prefix)
+    {
+        for (int i = first; i < kTurns; i += 2)
+        {
+            while (turn.load() != i)
+                std::this_thread::yield();
+            logTestPush(prefix + QString::number(i));
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            turn.store(i + 1);
+        }
+    };
+    std::thread even(logger, 0, "even");
+    std::thread odd(logger, 1, "odd");
+    even.join();
+    odd.join();
+
+    QVector<LogRecord> records = logTestTakeRecords();
+    QCOMPARE(records.size(), kTurns);
+    for (int i = 0; i < kTurns; ++i)
+    {
+        QString prefix = (i % 2) ? "odd" : "even";
+        QCOMPARE(records[i].m_message, prefix + QString::number(i));
+    }
+}
+
+void TestLogging::test_logRingThreadExit (void)
+{
+    logTestTakeRecords();
+    int rings = logTestRingCount();
+
+    // The thread exits, and so hands its ring over, before it is emptied
+    std::thread logger([]()
+    {
+        for (int i = 0; i < kOverflowRecords; ++i)
+            logTestPush(QString::number(i));
+    });
+    logger.join();
+    QCOMPARE(logTestRingCount(), rings + 1);
+
+    QVector<LogRecord> records = logTestTakeRecords();
+    QCOMPARE(records.size(), kOverflowRecords);
+    for (int i = 0; i < kOverflowRecords; ++i)
+        QCOMPARE(records[i].m_message, QString::number(i));
+
+    // The exited thread's ring is freed once it has been emptied
+    QCOMPARE(logTestRingCount(), rings);
+}
+
 void TestLogging::test_logPropagateCalc_data (void)
 {
     QTest::addColumn<QString>("argument");
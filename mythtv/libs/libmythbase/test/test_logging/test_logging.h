@@ -19,8 +19,11 @@
  */
 
 #include <QtTest/QtTest>
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <sstream>
+#include <thread>
 
 #include "mythsyslog.h"
 #include "exitcodes.h"
@@ -46,6 +49,10 @@ private slots:
     static void test_verboseArgParse_class(void);
     static void test_verboseArgParse_level_data(void);
     static void test_verboseArgParse_level(void);
+    static void test_verboseLevelCheck(void);
+    static void test_logRingOverflow(void);
+    static void test_logRingMergeOrder(void);
+    static void test_logRingThreadExit(void);
     static void test_logPropagateCalc_data(void);
     static void test_logPropagateCalc(void);
 };
@@ -0,0 +1,180 @@
+/*
+ *  Class TestMythMetrics
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <thread>
+#include <vector>
+
+#include <QtTest/QtTest>
+#include <QTextStream>
+
+#include "mythmetrics.h"
+
+class TestMythMetrics: public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    static void BucketsCoverTheirValues(void)
+    {
+        // Every value falls inside the bucket it is counted in
+        std::vector<uint64_t> values { 0, 1, 15, 16, 17, 31, 32, 33, 1000,
+                                       123456789, (1ULL << 40) + 12345,
+                                       UINT64_MAX };
+        for (uint64_t v : values)
+        {
+            int i = MythMetricHistogram::BucketIndex(v);
+            QVERIFY(i >= 0);
+            QVERIFY(i < MythMetricHistogram::kBuckets);
+            QVERIFY(MythMetricHistogram::BucketLowest(i) <= v);
+            QVERIFY(MythMetricHistogram::BucketHighest(i) >= v);
+        }
+    }
+
+    static void BucketsAreContiguous(void)
+    {
+        for (int i = 1; i < MythMetricHistogram::kBuckets; ++i)
+        {
+            QCOMPARE(MythMetricHistogram::BucketLowest(i),
+                     MythMetricHistogram::BucketHighest(i - 1) + 1);
+        }
+        QCOMPARE(MythMetricHistogram::BucketHighest(MythMetricHistogram::kBuckets - 1),
+                 UINT64_MAX);
+    }
+
+    static void BucketErrorIsBounded(void)
+    {
+        for (int i = MythMetricHistogram::kSubBuckets;
+             i < MythMetricHistogram::kBuckets; ++i)
+        {
+            double low  = MythMetricHistogram::BucketLowest(i);
+            double high = MythMetricHistogram::BucketHighest(i);
+            QVERIFY((high - low) / low < 1.0 / MythMetricHistogram::kSubBuckets);
+        }
+    }
+
+    static void QuantilesAreClose(void)
+    {
+        MythMetricHistogram h;
+        for (uint64_t v = 1; v <= 100000; ++v)
+            h.Record(v);
+
+        QCOMPARE(h.Count(), 100000ULL);
+        QCOMPARE(h.Sum(), 5000050000ULL);
+        QCOMPARE(h.Max(), 100000ULL);
+
+        for (double q : { 0.5, 0.9, 0.99 })
+        {
+            double exact = q * 100000;
+            double found = h.Quantile(q);
+            QVERIFY(found >= exact);
+            QVERIFY(found <= exact * (1.0 + 1.0 / MythMetricHistogram::kSubBuckets));
+        }
+        QCOMPARE(h.Quantile(1.0), 100000ULL);
+    }
+
+    static void EmptyHistogram(void)
+    {
+        MythMetricHistogram h;
+        QCOMPARE(h.Count(), 0ULL);
+        QCOMPARE(h.Quantile(0.5), 0ULL);
+    }
+
+    static void CountersAreThreadSafe(void)
+    {
+        MythMetricCounter c;
+        MythMetricHistogram h;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 8; ++t)
+        {
+            threads.emplace_back([&c, &h]()
+            {
+                for (int i = 0; i < 10000; ++i)
+                {
+                    c.Add(2);
+                    h.Record(i);
+                }
+            });
+        }
+        for (auto &t : threads)
+            t.join();
+
+        QCOMPARE(c.Value(), 160000ULL);
+        QCOMPARE(h.Count(), 80000ULL);
+        QCOMPARE(h.Max(), 9999ULL);
+    }
+
+    static void RegistryReturnsSameMetric(void)
+    {
+        auto *a = MythMetrics::Counter("test_same_total", "Same");
+        auto *b = MythMetrics::Counter("test_same_total", "Same");
+        auto *c = MythMetrics::Counter("test_same_total", "Same",
+                                       MythMetrics::Label("kind", "other"));
+        QCOMPARE(a, b);
+        QVERIFY(a != c);
+    }
+
+    static void LabelsAreEscaped(void)
+    {
+        QCOMPARE(MythMetrics::Label("path", "a\\b\"c\nd"),
+                 QString("path=\"a\\\\b\\\"c\\nd\""));
+    }
+
+    static void ExportFormat(void)
+    {
+        MythMetrics::Counter("test_export_total", "Things counted",
+                             MythMetrics::Label("kind", "a"))->Add(3);
+        MythMetrics::Gauge("test_export_depth", "Queue depth")->Set(-2);
+        MythMetrics::Histogram("test_export_seconds", "Time taken")->Record(1500000);
+
+        QString text = QString::fromUtf8(MythMetrics::Export());
+        QVERIFY(text.contains("# HELP test_export_total Things counted\n"
+                              "# TYPE test_export_total counter\n"
+                              "test_export_total{kind=\"a\"} 3\n"));
+        QVERIFY(text.contains("# TYPE test_export_depth gauge\n"
+                              "test_export_depth -2\n"));
+        QVERIFY(text.contains("# TYPE test_export_seconds summary\n"));
+        QVERIFY(text.contains("test_export_seconds{quantile=\"0.5\"} "));
+        QVERIFY(text.contains("test_export_seconds_sum 1.5\n"));
+        QVERIFY(text.contains("test_export_seconds_count 1\n"));
+    }
+
+    static void TypeMismatchIsNotExported(void)
+    {
+        MythMetrics::Counter("test_mismatch", "Counter")->Add(7);
+        auto *g = MythMetrics::Gauge("test_mismatch", "Gauge");
+        QVERIFY(g != nullptr);
+        g->Set(42);
+
+        QString text = QString::fromUtf8(MythMetrics::Export());
+        QVERIFY(text.contains("test_mismatch 7\n"));
+        QVERIFY(!text.contains("test_mismatch 42\n"));
+    }
+
+    static void Collectors(void)
+    {
+        MythMetrics::AddCollector("test", [](QTextStream &os)
+        {
+            MythMetrics::PrintFamily(os, "test_collected", "gauge", "Collected");
+            os << "test_collected 5\n";
+        });
+        QVERIFY(MythMetrics::Export().contains("test_collected 5\n"));
+
+        MythMetrics::RemoveCollector("test");
+        QVERIFY(!MythMetrics::Export().contains("test_collected"));
+    }
+};
@@ -20,9 +20,43 @@
 #include "mythtimer.h"
 #include "compat.h"
 #include "mythdate.h"
+#include "mythmetrics.h"
 
 #define LOC QString("TFW(%1:%2): ").arg(m_filename).arg(m_fd)
 
+// Shared by all writers
+static MythMetricGauge *buffered_bytes(void)
+{
+    static auto *s_gauge = MythMetrics::Gauge(
+        "mythtv_filewriter_buffered_bytes",
+        "Data waiting to be written to disk by all file writers");
+    return s_gauge;
+}
+
+static MythMetricCounter *written_bytes(void)
+{
+    static auto *s_counter = MythMetrics::Counter(
+        "mythtv_filewriter_written_bytes_total",
+        "Data written to disk by all file writers");
+    return s_counter;
+}
+
+static MythMetricCounter *buffer_full(void)
+{
+    static auto *s_counter = MythMetrics::Counter(
+        "mythtv_filewriter_buffer_full_total",
+        "Writes that found the write buffer full");
+    return s_counter;
+}
+
+static MythMetricHistogram *write_seconds(void)
+{
+    static auto *s_histogram = MythMetrics::Histogram(
+        "mythtv_filewriter_write_seconds",
+        "Time taken to write one buffer to disk");
+    return s_histogram;
+}
+
 /// \brief Runs ThreadedFileWriter::DiskLoop(void)
 void TFWWriteThread::run(void)
 {
@@ -157,6 +191,8 @@ ThreadedFileWriter::~ThreadedFileWriter()
         delete m_writeBuffers.front();
         m_writeBuffers.pop_front();
     }
+    buffered_bytes()->Add(-static_cast<int64_t>(m_totalBufferUse));
+    m_totalBufferUse = 0;
 
     while (!m_emptyBuffers.empty())
     {
@@ -206,6 +242,8 @@ int ThreadedFileWriter::Write(const void *data, uint count)
 
         if ((m_totalBufferUse + towrite) > (kMaxBufferSize * (m_blocking ? 1 : 8)))
         {
+            buffer_full()->Add();
+
             if (!m_blocking)
             {
                 LOG(VB_GENERAL, LOG_ERR, LOC +
@@ -261,6 +299,7 @@ int ThreadedFileWriter::Write(const void *data, uint count)
         }
 
         m_totalBufferUse += towrite;
+        buffered_bytes()->Add(towrite);
 
         const char *cdata = (const char*) data + written;
         buf->data.insert(buf->data.end(), cdata, cdata+towrite);
@@ -470,6 +509,7 @@ void ThreadedFileWriter::DiskLoop(void)
         TFWBuffer *buf = m_writeBuffers.front();
         m_writeBuffers.pop_front();
         m_totalBufferUse -= buf->data.size();
+        buffered_bytes()->Add(-static_cast<int64_t>(buf->data.size()));
         m_bufferWasFreed.wakeAll();
         minWriteTimer.start();
 
@@ -519,6 +559,7 @@ void ThreadedFileWriter::DiskLoop(void)
             {
                 tot += ret;
                 total_written += ret;
+                written_bytes()->Add(ret);
                 LOG(VB_FILE, LOG_DEBUG, LOC +
                     QString("total written so far: %1 bytes")
                     .arg(total_written));
@@ -542,6 +583,8 @@ void ThreadedFileWriter::DiskLoop(void)
         buf->lastUsed = MythDate::current();
         m_emptyBuffers.push_back(buf);
 
+        write_seconds()->Record(writeTimer.nsecsElapsed() / 1000);
+
         if (writeTimer.elapsed() > 1000)
         {
             LOG(VB_GENERAL, LOG_WARNING, LOC +
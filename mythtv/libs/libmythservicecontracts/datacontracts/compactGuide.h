@@ -0,0 +1,152 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: compactGuide.h
+// Created     : Oct. 19, 2026
+//
+// Purpose     : Program guide as parallel arrays rather than an object tree
+//
+// Licensed under the GPL v2 or later, see COPYING for details
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef COMPACTGUIDE_H_
+#define COMPACTGUIDE_H_
+
+#include <QDateTime>
+#include <QString>
+#include <QStringList>
+#include <QVariantList>
+
+#include "serviceexp.h"
+#include "datacontracthelper.h"
+
+namespace DTC
+{
+
+/////////////////////////////////////////////////////////////////////////////
+//
+// The guide is returned column by column.  Entry i of each Chan* list
+// describes one channel, and entry j of each Prog* list one program.
+//
+//  * Strings are sent once, in Strings, and referred to by their index,
+//    so ChanNums, ChanCallSigns, ChanNames and the program text columns
+//    are lists of ints.
+//  * ProgChannels holds the index of the program's channel, not its chanid.
+//  * ProgStarts is in seconds from StartTime, ProgDurations in seconds.
+//
+/////////////////////////////////////////////////////////////////////////////
+
+class SERVICE_PUBLIC CompactGuide : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO( "version", "1.0" );
+
+    // Q_CLASSINFO Used to augment Metadata for properties.
+    // See datacontracthelper.h for details
+
+    Q_CLASSINFO( "AsOf"          , "transient=true" );
+
+    Q_CLASSINFO( "ChanIds"       , "type=uint;name=ChanId"   );
+    Q_CLASSINFO( "ChanNums"      , "type=int;name=ChanNum"   );
+    Q_CLASSINFO( "ChanCallSigns" , "type=int;name=CallSign"  );
+    Q_CLASSINFO( "ChanNames"     , "type=int;name=ChanName"  );
+
+    Q_CLASSINFO( "ProgChannels"  , "type=int;name=Channel"   );
+    Q_CLASSINFO( "ProgStarts"    , "type=int;name=Start"     );
+    Q_CLASSINFO( "ProgDurations" , "type=int;name=Duration"  );
+    Q_CLASSINFO( "ProgTitles"    , "type=int;name=Title"     );
+    Q_CLASSINFO( "ProgSubTitles" , "type=int;name=SubTitle"  );
+    Q_CLASSINFO( "ProgCategories", "type=int;name=Category"  );
+    Q_CLASSINFO( "ProgRecStatus" , "type=int;name=RecStatus" );
+
+    Q_PROPERTY( QDateTime     StartTime      READ StartTime      WRITE setStartTime      )
+    Q_PROPERTY( QDateTime     EndTime        READ EndTime        WRITE setEndTime        )
+    Q_PROPERTY( int           ChannelCount   READ ChannelCount   WRITE setChannelCount   )
+    Q_PROPERTY( int           ProgramCount   READ ProgramCount   WRITE setProgramCount   )
+    Q_PROPERTY( QDateTime     AsOf           READ AsOf           WRITE setAsOf           )
+    Q_PROPERTY( QString       Version        READ Version        WRITE setVersion        )
+    Q_PROPERTY( QString       ProtoVer       READ ProtoVer       WRITE setProtoVer       )
+
+    Q_PROPERTY( QStringList   Strings        READ Strings        )
+
+    Q_PROPERTY( QVariantList  ChanIds        READ ChanIds        )
+    Q_PROPERTY( QVariantList  ChanNums       READ ChanNums       )
+    Q_PROPERTY( QVariantList  ChanCallSigns  READ ChanCallSigns  )
+    Q_PROPERTY( QVariantList  ChanNames      READ ChanNames      )
+
+    Q_PROPERTY( QVariantList  ProgChannels   READ ProgChannels   )
+    Q_PROPERTY( QVariantList  ProgStarts     READ ProgStarts     )
+    Q_PROPERTY( QVariantList  ProgDurations  READ ProgDurations  )
+    Q_PROPERTY( QVariantList  ProgTitles     READ ProgTitles     )
+    Q_PROPERTY( QVariantList  ProgSubTitles  READ ProgSubTitles  )
+    Q_PROPERTY( QVariantList  ProgCategories READ ProgCategories )
+    Q_PROPERTY( QVariantList  ProgRecStatus  READ ProgRecStatus  )
+
+    PROPERTYIMP       ( QDateTime   , StartTime     )
+    PROPERTYIMP       ( QDateTime   , EndTime       )
+    PROPERTYIMP       ( int         , ChannelCount  )
+    PROPERTYIMP       ( int         , ProgramCount  )
+    PROPERTYIMP       ( QDateTime   , AsOf          )
+    PROPERTYIMP       ( QString     , Version       )
+    PROPERTYIMP       ( QString     , ProtoVer      )
+
+    PROPERTYIMP_RO_REF( QStringList , Strings       );
+
+    PROPERTYIMP_RO_REF( QVariantList, ChanIds       );
+    PROPERTYIMP_RO_REF( QVariantList, ChanNums      );
+    PROPERTYIMP_RO_REF( QVariantList, ChanCallSigns );
+    PROPERTYIMP_RO_REF( QVariantList, ChanNames     );
+
+    PROPERTYIMP_RO_REF( QVariantList, ProgChannels  );
+    PROPERTYIMP_RO_REF( QVariantList, ProgStarts    );
+    PROPERTYIMP_RO_REF( QVariantList, ProgDurations );
+    PROPERTYIMP_RO_REF( QVariantList, ProgTitles    );
+    PROPERTYIMP_RO_REF( QVariantList, ProgSubTitles );
+    PROPERTYIMP_RO_REF( QVariantList, ProgCategories);
+    PROPERTYIMP_RO_REF( QVariantList, ProgRecStatus );
+
+    public:
+
+        static inline void InitializeCustomTypes();
+
+        Q_INVOKABLE explicit CompactGuide(QObject *parent = nullptr)
+            : QObject       ( parent ),
+              m_ChannelCount( 0      ),
+              m_ProgramCount( 0      )
+        {
+        }
+
+        void Copy( const CompactGuide *src )
+        {
+            m_StartTime     = src->m_StartTime     ;
+            m_EndTime       = src->m_EndTime       ;
+            m_ChannelCount  = src->m_ChannelCount  ;
+            m_ProgramCount  = src->m_ProgramCount  ;
+            m_AsOf          = src->m_AsOf          ;
+            m_Version       = src->m_Version       ;
+            m_ProtoVer      = src->m_ProtoVer      ;
+            m_Strings       = src->m_Strings       ;
+            m_ChanIds       = src->m_ChanIds       ;
+            m_ChanNums      = src->m_ChanNums      ;
+            m_ChanCallSigns = src->m_ChanCallSigns ;
+            m_ChanNames     = src->m_ChanNames     ;
+            m_ProgChannels  = src->m_ProgChannels  ;
+            m_ProgStarts    = src->m_ProgStarts    ;
+            m_ProgDurations = src->m_ProgDurations ;
+            m_ProgTitles    = src->m_ProgTitles    ;
+            m_ProgSubTitles = src->m_ProgSubTitles ;
+            m_ProgCategories= src->m_ProgCategories;
+            m_ProgRecStatus = src->m_ProgRecStatus ;
+        }
+
+    private:
+        Q_DISABLE_COPY(CompactGuide);
+};
+
+inline void CompactGuide::InitializeCustomTypes()
+{
+    qRegisterMetaType< CompactGuide* >();
+}
+
+} // namespace DTC
+
+#endif
@@ -58,6 +58,7 @@ HEADERS += datacontracts/inputList.h
 HEADERS += datacontracts/recRuleFilter.h         datacontracts/recRuleFilterList.h
 HEADERS += datacontracts/castMember.h            datacontracts/castMemberList.h
 HEADERS += datacontracts/frontend.h              datacontracts/frontendList.h
+HEADERS += datacontracts/compactGuide.h
 HEADERS += datacontracts/cutting.h               datacontracts/cutList.h
 HEADERS += datacontracts/backendInfo.h           datacontracts/envInfo.h
 HEADERS += datacontracts/buildInfo.h             datacontracts/logInfo.h
@@ -127,6 +128,7 @@ incDatacontracts.files += datacontracts/enum.h                datacontracts/enum
 incDatacontracts.files += datacontracts/cutting.h             datacontracts/cutList.h
 incDatacontracts.files += datacontracts/backendInfo.h         datacontracts/envInfo.h
 incDatacontracts.files += datacontracts/buildInfo.h           datacontracts/logInfo.h
+incDatacontracts.files += datacontracts/compactGuide.h
 
 INSTALLS += inc incServices incDatacontracts incEnums
 
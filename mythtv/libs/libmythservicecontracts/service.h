@@ -65,6 +65,10 @@ class SERVICE_PUBLIC Service : public QObject
     public:
 
         QList<QString> m_parsedParams; // lowercased
+
+        // Set when results are only serialized, as by ServiceHost, so list
+        // properties may be returned as a SerializerCursor instead.
+        bool           m_bLazyResults {false};
 };
 
 //////////////////////////////////////////////////////////////////////////////
@@ -17,6 +17,7 @@
 
 #include "service.h"
 #include "datacontracts/programGuide.h"
+#include "datacontracts/compactGuide.h"
 #include "datacontracts/programAndChannel.h"
 #include "datacontracts/channelGroupList.h"
 #include "datacontracts/programList.h"
@@ -40,7 +41,7 @@
 class SERVICE_PUBLIC GuideServices : public Service  //, public QScriptable ???
 {
     Q_OBJECT
-    Q_CLASSINFO( "version"    , "2.4" )
+    Q_CLASSINFO( "version"    , "2.5" )
     Q_CLASSINFO( "AddToChannelGroup_Method",                     "POST" )
     Q_CLASSINFO( "RemoveFromChannelGroup_Method",                "POST" )
 
@@ -52,6 +53,7 @@ class SERVICE_PUBLIC GuideServices : public Service  //, public QScriptable ???
         GuideServices( QObject *parent = nullptr ) : Service( parent )
         {
             DTC::ProgramGuide::InitializeCustomTypes();
+            DTC::CompactGuide::InitializeCustomTypes();
             DTC::ProgramList ::InitializeCustomTypes();
             DTC::Program     ::InitializeCustomTypes();
             DTC::ChannelGroup::InitializeCustomTypes();
@@ -68,6 +70,11 @@ class SERVICE_PUBLIC GuideServices : public Service  //, public QScriptable ???
                                                           int              Count,
                                                           bool             WithInvisible) = 0;
 
+        virtual DTC::CompactGuide*  GetCompactGuide     ( const QDateTime &StartTime  ,
+                                                          const QDateTime &EndTime    ,
+                                                          int              ChannelGroupId,
+                                                          bool             WithInvisible) = 0;
+
         virtual DTC::ProgramList*   GetProgramList      ( int              StartIndex,
                                                           int              Count,
                                                           const QDateTime &StartTime  ,
@@ -0,0 +1,422 @@
+// C++ headers
+#include <algorithm>
+
+// Qt headers
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+
+// MythTV headers
+#include "hlspackager.h"
+#include "mythcorecontext.h"
+#include "mythdate.h"
+#include "mythlogging.h"
+#include "programinfo.h"
+#include "seekindex.h"
+
+#define LOC QString("HLSPackager: ")
+
+static constexpr int     kTSPacketSize   = 188;
+static constexpr uint8_t kTSSyncByte     = 0x47;
+static constexpr int     kPSIScanBytes   = 4 * 1024 * 1024;
+static constexpr qint64  kMaxSegmentSize = 64LL * 1024 * 1024;
+
+static uint ts_pid(const uint8_t *pkt)
+{
+    return ((pkt[1] & 0x1f) << 8) | pkt[2];
+}
+
+/// Returns the offset of the first section byte in the packet, or -1
+static int ts_section_start(const uint8_t *pkt)
+{
+    if (!(pkt[1] & 0x40)) // payload_unit_start_indicator
+        return -1;
+
+    int pos = 4;
+    if (pkt[3] & 0x20) // adaptation field
+        pos += 1 + pkt[4];
+    if (!(pkt[3] & 0x10) || pos >= kTSPacketSize)
+        return -1;
+
+    pos += 1 + pkt[pos]; // pointer_field
+    return (pos < kTSPacketSize) ? pos : -1;
+}
+
+HLSPackager::HLSPackager(int cacheSizeKB)
+    : m_indexes(64), m_segments(cacheSizeKB)
+{
+}
+
+/// \brief Returns true if the file is a container the packager can cut.
+bool HLSPackager::CanPackage(const QString &filename)
+{
+    return filename.endsWith(".ts", Qt::CaseInsensitive);
+}
+
+/**
+ *  \brief Builds an HLS media playlist for a recording.
+ *
+ *  \param segmentUrl URL of the segments, with "%1" for the segment number
+ *  \return the playlist, or an empty array if the recording can't be
+ *          packaged.
+ */
+QByteArray HLSPackager::GetPlaylist(const ProgramInfo &pginfo,
+                                    const QString &filename,
+                                    const QString &segmentUrl)
+{
+    IndexPtr index = GetIndex(pginfo, filename);
+    if (!index || index->m_segments.empty())
+        return QByteArray();
+
+    QByteArray playlist;
+    playlist += "#EXTM3U\n";
+    playlist += "#EXT-X-VERSION:3\n";
+    playlist += QString("#EXT-X-TARGETDURATION:%1\n")
+        .arg(kMaxSegmentSecs).toLatin1();
+    playlist += "#EXT-X-MEDIA-SEQUENCE:0\n";
+    playlist += index->m_complete ? "#EXT-X-PLAYLIST-TYPE:VOD\n"
+                                  : "#EXT-X-PLAYLIST-TYPE:EVENT\n";
+
+    for (size_t i = 0; i < index->m_segments.size(); ++i)
+    {
+        // Longer segments only come from sparse keyframes or a gap in the
+        // timestamps, and players reject durations over the target
+        double duration = std::min(index->m_segments[i].m_duration,
+                                   static_cast<double>(kMaxSegmentSecs));
+        playlist += QString("#EXTINF:%1,\n")
+            .arg(duration, 0, 'f', 3).toLatin1();
+        playlist += segmentUrl.arg(i).toUtf8() + "\n";
+    }
+
+    if (index->m_complete)
+        playlist += "#EXT-X-ENDLIST\n";
+
+    return playlist;
+}
+
+/**
+ *  \brief Returns segment \p segment of a recording as a TS byte stream.
+ *  \return the segment, or an empty array if it doesn't exist (yet).
+ */
+QByteArray HLSPackager::GetSegment(const ProgramInfo &pginfo,
+                                   const QString &filename, uint segment)
+{
+    QString key = QString("%1:%2").arg(filename).arg(segment);
+
+    {
+        QMutexLocker locker(&m_lock);
+        QByteArray *cached = m_segments.object(key);
+        if (cached)
+            return *cached;
+    }
+
+    IndexPtr index = GetIndex(pginfo, filename, static_cast<int>(segment));
+    if (!index || segment >= index->m_segments.size())
+        return QByteArray();
+
+    const Segment    &range = index->m_segments[segment];
+    const QByteArray &psi   = index->m_psi;
+
+    qint64 size = range.m_end - range.m_start;
+    if (size <= 0 || size > kMaxSegmentSize)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Segment %1 of %2 has an invalid size %3")
+                .arg(segment).arg(filename).arg(size));
+        return QByteArray();
+    }
+
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly) || !file.seek(range.m_start))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + QString("Unable to read %1: %2")
+            .arg(filename).arg(file.errorString()));
+        return QByteArray();
+    }
+
+    QByteArray data;
+    data.reserve(psi.size() + size);
+    QByteArray body = file.read(size);
+
+    // Every segment must start with the tables needed to decode it
+    if (body.size() < kTSPacketSize ||
+        ts_pid(reinterpret_cast<const uint8_t*>(body.constData())) != 0)
+    {
+        data += psi;
+    }
+    data += body;
+
+    LOG(VB_HTTP, LOG_DEBUG, LOC + QString("Packaged segment %1 of %2, %3 bytes")
+        .arg(segment).arg(filename).arg(data.size()));
+
+    QMutexLocker locker(&m_lock);
+    m_segments.insert(key, new QByteArray(data),
+                      std::max(1, static_cast<int>(data.size() / 1024)));
+
+    return data;
+}
+
+/**
+ *  \brief Returns the index of a recording, building it if needed.
+ *
+ *  The index of a recording in progress is rebuilt once it is
+ *  kIndexRefreshSecs old, or when it doesn't have segment \p wantSegment yet
+ *  and is at least a second old.  So a request causes at most one build.
+ *  m_lock is not held while building, and only one thread builds the index
+ *  of a file at a time; the others wait for it and share the result.
+ */
+HLSPackager::IndexPtr HLSPackager::GetIndex(const ProgramInfo &pginfo,
+                                            const QString &filename,
+                                            int wantSegment)
+{
+    QMutexLocker locker(&m_lock);
+    while (true)
+    {
+        IndexPtr *cached = m_indexes.object(filename);
+        if (cached)
+        {
+            const IndexPtr &index = *cached;
+            qint64 age = index->m_built.msecsTo(MythDate::current());
+            bool missing = (wantSegment >= 0) &&
+                (static_cast<size_t>(wantSegment) >= index->m_segments.size());
+            if (index->m_complete ||
+                ((age < kIndexRefreshSecs * 1000) && (!missing || age < 1000)))
+            {
+                return index;
+            }
+        }
+
+        if (!m_building.contains(filename))
+            break;
+        m_indexBuilt.wait(&m_lock);
+    }
+
+    m_building.insert(filename);
+    locker.unlock();
+
+    auto *newIndex = new Index;
+    bool ok = BuildIndex(pginfo, filename, *newIndex);
+
+    locker.relock();
+    m_building.remove(filename);
+    m_indexBuilt.wakeAll();
+
+    if (!ok)
+    {
+        delete newIndex;
+        m_indexes.remove(filename);
+        return IndexPtr();
+    }
+
+    IndexPtr index(newIndex);
+    m_indexes.insert(filename, new IndexPtr(index));
+    return index;
+}
+
+/**
+ *  \brief Reads the PSI and the seek table of a recording and cuts it into
+ *  segments.
+ *
+ *  The seek table is taken from the sidecar index when that is enabled and
+ *  up to date, and from the database otherwise.
+ */
+bool HLSPackager::BuildIndex(const ProgramInfo &pginfo,
+                             const QString &filename, Index &index)
+{
+    QFileInfo info(filename);
+    if (!CanPackage(filename) || !info.exists())
+        return false;
+
+    QDateTime now = MythDate::current();
+    index.m_built    = now;
+    index.m_complete = (pginfo.GetRecordingEndTime() < now) &&
+                       (info.lastModified().secsTo(now) > 10);
+
+    if (!ReadPSI(filename, index.m_psi))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("No PAT/PMT found in %1").arg(filename));
+        return false;
+    }
+
+    bool sidecar = gCoreContext->GetBoolSetting("SeekIndexSidecar", false);
+    auto read_sidecar = [&](MarkTypes type, frm_pos_vec_t &entries)
+    {
+        SeekIndexFile sidx;
+        if (sidecar && SeekIndexFile::IsUpToDate(filename, type) &&
+            sidx.Open(SeekIndexFile::IndexFilename(filename, type)) &&
+            sidx.GetMarkType() == type)
+        {
+            sidx.ReadAll(entries);
+        }
+    };
+
+    frm_pos_vec_t keyframes;
+    read_sidecar(MARK_GOP_BYFRAME, keyframes);
+    if (keyframes.empty())
+        pginfo.QueryPositionMap(keyframes, MARK_GOP_BYFRAME);
+    if (keyframes.empty())
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("No seek table for %1").arg(filename));
+        return false;
+    }
+
+    frm_pos_vec_t durations;
+    read_sidecar(MARK_DURATION_MS, durations);
+    if (durations.empty())
+        pginfo.QueryPositionMap(durations, MARK_DURATION_MS);
+
+    double fps = pginfo.QueryAverageFrameRate() / 1000.0;
+    uint64_t totalFrames = index.m_complete ? pginfo.QueryTotalFrames() : 0;
+
+    index.m_segments = CutSegments(keyframes, durations, fps, totalFrames,
+                                   info.size(), index.m_complete);
+
+    LOG(VB_HTTP, LOG_INFO, LOC + QString("Indexed %1: %2 segments%3")
+        .arg(filename).arg(index.m_segments.size())
+        .arg(index.m_complete ? "" : " (in progress)"));
+
+    return true;
+}
+
+/**
+ *  \brief Cuts a transport stream into segments at the keyframes closest to
+ *  kTargetDurationSecs apart.
+ *
+ *  \param keyframes   keyframe number to byte offset, in frame order
+ *  \param durations   frame number to time in ms, in frame order (optional)
+ *  \param totalFrames frames in the whole recording, if known
+ *  \param complete    the recording has finished, so the tail after the
+ *                     last cut is a segment too
+ */
+std::vector<HLSPackager::Segment> HLSPackager::CutSegments(
+    const frm_pos_vec_t &keyframes, const frm_pos_vec_t &durations,
+    double fps, uint64_t totalFrames, uint64_t fileSize, bool complete)
+{
+    std::vector<Segment> segments;
+    if (keyframes.empty())
+        return segments;
+
+    if (fps <= 0.0)
+        fps = 29.97;
+
+    // Time of a frame, from the nearest preceding duration mark if any
+    auto frame_secs = [&](uint64_t frame)
+    {
+        auto it = std::upper_bound(durations.cbegin(), durations.cend(), frame,
+            [](uint64_t f, const frm_pos_vec_t::value_type &e)
+            { return f < e.first; });
+        if (it == durations.cbegin())
+            return frame / fps;
+        --it;
+        return (it->second / 1000.0) + ((frame - it->first) / fps);
+    };
+
+    auto aligned = [](uint64_t offset)
+    {
+        return offset - (offset % kTSPacketSize);
+    };
+
+    // The first segment also carries whatever precedes the first keyframe
+    uint64_t segStart  = 0;
+    double   segStartT = frame_secs(keyframes.front().first);
+    for (size_t i = 1; i < keyframes.size(); ++i)
+    {
+        double t = frame_secs(keyframes[i].first);
+        if (t - segStartT < kTargetDurationSecs)
+            continue;
+
+        uint64_t offset = aligned(keyframes[i].second);
+        if (offset <= segStart)
+            continue;
+
+        segments.push_back({segStart, offset, t - segStartT});
+        segStart  = offset;
+        segStartT = t;
+    }
+
+    // The tail after the last cut is only complete once recording is done
+    if (complete && fileSize > segStart)
+    {
+        double duration = frame_secs(keyframes.back().first) - segStartT;
+        if (totalFrames > keyframes.back().first)
+            duration = frame_secs(totalFrames) - segStartT;
+        segments.push_back({segStart, aligned(fileSize),
+                            std::max(duration, 1.0 / fps)});
+    }
+
+    return segments;
+}
+
+/**
+ *  \brief Finds the first PAT and the PMT it references near the start of
+ *  a transport stream.
+ *
+ *  Only the first program is used, and its PAT and PMT must each fit in
+ *  one packet, which is the case for everything MythTV records.
+ */
+bool HLSPackager::ReadPSI(const QString &filename, QByteArray &psi)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QByteArray buf = file.read(kPSIScanBytes);
+    const auto *data = reinterpret_cast<const uint8_t*>(buf.constData());
+    int size = buf.size();
+
+    int sync = 0;
+    while (sync < kTSPacketSize && sync + (2 * kTSPacketSize) < size &&
+           !(data[sync] == kTSSyncByte &&
+             data[sync + kTSPacketSize] == kTSSyncByte &&
+             data[sync + (2 * kTSPacketSize)] == kTSSyncByte))
+    {
+        sync++;
+    }
+
+    QByteArray pat;
+    int pmtPid = -1;
+    for (int pos = sync; pos + kTSPacketSize <= size; pos += kTSPacketSize)
+    {
+        const uint8_t *pkt = data + pos;
+        if (pkt[0] != kTSSyncByte)
+            return false;
+
+        // Only sections that fit in this packet are used
+        int section = ts_section_start(pkt);
+        if (section < 0 || section + 3 > kTSPacketSize)
+            continue;
+        int length = ((pkt[section + 1] & 0x0f) << 8) | pkt[section + 2];
+        if (section + 3 + length > kTSPacketSize)
+            continue;
+
+        uint pid = ts_pid(pkt);
+        if (pmtPid < 0 && pid == 0 && pkt[section] == 0x00) // PAT
+        {
+            // program loop is between the 8 byte section header and the CRC
+            int end = section + 3 + length - 4;
+            for (int p = section + 8; p + 4 <= end; p += 4)
+            {
+                uint program = (pkt[p] << 8) | pkt[p + 1];
+                if (program != 0)
+                {
+                    pmtPid = ((pkt[p + 2] & 0x1f) << 8) | pkt[p + 3];
+                    break;
+                }
+            }
+            if (pmtPid >= 0)
+                pat = QByteArray(reinterpret_cast<const char*>(pkt),
+                                 kTSPacketSize);
+        }
+        else if (pmtPid >= 0 && static_cast<int>(pid) == pmtPid &&
+                 pkt[section] == 0x02) // PMT
+        {
+            psi = pat + QByteArray(reinterpret_cast<const char*>(pkt),
+                                   kTSPacketSize);
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,104 @@
+#ifndef HLSPACKAGER_H
+#define HLSPACKAGER_H
+
+// C++ headers
+#include <cstdint>
+#include <vector>
+
+// Qt headers
+#include <QByteArray>
+#include <QCache>
+#include <QDateTime>
+#include <QMutex>
+#include <QSet>
+#include <QSharedPointer>
+#include <QString>
+#include <QWaitCondition>
+
+// MythTV headers
+#include "mythtvexp.h"
+#include "programtypes.h"
+
+class ProgramInfo;
+
+/** \class HLSPackager
+ *  \brief Serves MPEG-TS recordings as HLS without transcoding.
+ *
+ *  Unlike HTTPLiveStream, which runs mythtranscode to write a new set of
+ *  segments for every stream, the packager cuts the recording itself into
+ *  segments.  Segment boundaries are taken from the keyframe seek table,
+ *  so a playlist is available as soon as the seek table can be read, and
+ *  a segment is just a byte range of the recording with the stream's PAT
+ *  and PMT prepended so that every segment can be decoded on its own.
+ *
+ *  Playlists of recordings still in progress are EVENT playlists which
+ *  only list complete segments, and are rebuilt at most every
+ *  kIndexRefreshSecs.  Built segments are kept in a LRU cache bounded by
+ *  size, so several clients watching the same recording share them.
+ *
+ *  Indexes are built without holding the packager's lock, so clients of
+ *  other recordings never wait on a build.  Clients of the same recording
+ *  wait for the one build in progress and share its result.
+ *
+ *  Only recordings in a transport stream are supported.  Anything else
+ *  (e.g. program streams from hardware encoders) still needs
+ *  HTTPLiveStream.
+ */
+class MTV_PUBLIC HLSPackager
+{
+  public:
+    explicit HLSPackager(int cacheSizeKB = kDefaultCacheSizeKB);
+    ~HLSPackager() = default;
+
+    static bool CanPackage(const QString &filename);
+
+    QByteArray GetPlaylist(const ProgramInfo &pginfo, const QString &filename,
+                           const QString &segmentUrl);
+    QByteArray GetSegment(const ProgramInfo &pginfo, const QString &filename,
+                          uint segment);
+
+    static constexpr int kDefaultCacheSizeKB = 256 * 1024;
+    static constexpr int kTargetDurationSecs = 6;
+    /// Advertised as EXT-X-TARGETDURATION, which mustn't change between
+    /// refreshes of a playlist.  Segments are cut at the first keyframe
+    /// kTargetDurationSecs in, so they stay within this as long as the
+    /// keyframes are at most kTargetDurationSecs apart.
+    static constexpr int kMaxSegmentSecs     = 2 * kTargetDurationSecs;
+    static constexpr int kIndexRefreshSecs   = 5;
+
+    struct Segment
+    {
+        uint64_t m_start    {0}; ///< byte offset in the recording
+        uint64_t m_end      {0}; ///< byte offset of the next segment
+        double   m_duration {0.0};
+    };
+
+    static std::vector<Segment> CutSegments(const frm_pos_vec_t &keyframes,
+                                            const frm_pos_vec_t &durations,
+                                            double fps, uint64_t totalFrames,
+                                            uint64_t fileSize, bool complete);
+    static bool ReadPSI(const QString &filename, QByteArray &psi);
+
+  private:
+    struct Index
+    {
+        QDateTime            m_built;
+        bool                 m_complete {false}; ///< recording has finished
+        QByteArray           m_psi;              ///< PAT and PMT packets
+        std::vector<Segment> m_segments;
+    };
+    using IndexPtr = QSharedPointer<const Index>;
+
+    IndexPtr GetIndex(const ProgramInfo &pginfo, const QString &filename,
+                      int wantSegment = -1);
+    static bool BuildIndex(const ProgramInfo &pginfo, const QString &filename,
+                           Index &index);
+
+    QMutex                      m_lock;
+    QWaitCondition              m_indexBuilt;
+    QSet<QString>               m_building;  // protected by m_lock
+    QCache<QString, IndexPtr>   m_indexes;   // by filename, protected by m_lock
+    QCache<QString, QByteArray> m_segments;  // cost in KB, protected by m_lock
+};
+
+#endif // HLSPACKAGER_H
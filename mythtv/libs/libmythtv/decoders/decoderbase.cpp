@@ -5,6 +5,7 @@ using namespace std;
 #include "mythconfig.h"
 
 #include "mythplayer.h"
+#include "mythcorecontext.h"
 #include "mythlogging.h"
 #include "decoderbase.h"
 #include "programinfo.h"
@@ -12,6 +13,7 @@ using namespace std;
 #include "DVD/mythdvdbuffer.h"
 #include "Bluray/mythbdbuffer.h"
 #include "mythcodeccontext.h"
+#include "seekindex.h"
 
 #define LOC QString("Dec: ")
 
@@ -32,6 +34,7 @@ DecoderBase::DecoderBase(MythPlayer *parent, const ProgramInfo &pginfo)
 DecoderBase::~DecoderBase()
 {
     delete m_playbackInfo;
+    delete m_seekIndex;
 }
 
 void DecoderBase::SetProgramInfo(const ProgramInfo &pginfo)
@@ -93,8 +96,9 @@ bool DecoderBase::PosMapFromDb(void)
         return false;
 
     // Overwrites current positionmap with entire contents of database
-    frm_pos_map_t posMap;
+    frm_pos_vec_t posMap;
     frm_pos_map_t durMap;
+    SeekIndexFile *sparseIndex = nullptr;
 
     if (m_ringBuffer && m_ringBuffer->IsDVD())
     {
@@ -104,7 +108,8 @@ bool DecoderBase::PosMapFromDb(void)
            m_keyframeDist = 12;
         auto totframes =
             (long long)(m_ringBuffer->DVD()->GetTotalTimeOfTitle() * m_fps);
-        posMap[totframes] = m_ringBuffer->DVD()->GetTotalReadPosition();
+        posMap.emplace_back(totframes,
+                            m_ringBuffer->DVD()->GetTotalReadPosition());
     }
     else if (m_ringBuffer && m_ringBuffer->IsBD())
     {
@@ -114,7 +119,8 @@ bool DecoderBase::PosMapFromDb(void)
            m_keyframeDist = 12;
         auto totframes =
             (long long)(m_ringBuffer->BD()->GetTotalTimeOfTitle() * m_fps);
-        posMap[totframes] = m_ringBuffer->BD()->GetTotalReadPosition();
+        posMap.emplace_back(totframes,
+                            m_ringBuffer->BD()->GetTotalReadPosition());
 #if 0
         LOG(VB_PLAYBACK, LOG_DEBUG, LOC +
             QString("%1 TotalTimeOfTitle() in ticks, %2 TotalReadPosition() "
@@ -123,6 +129,10 @@ bool DecoderBase::PosMapFromDb(void)
                 .arg(m_ringBuffer->BD()->GetTotalReadPosition()).arg(m_fps));
 #endif
     }
+    else if (PosMapFromSeekIndex(posMap, durMap, sparseIndex))
+    {
+        // Loaded from the sidecar index, no need to query the database
+    }
     else if ((m_positionMapType == MARK_UNSET) ||
         (m_keyframeDist == -1))
     {
@@ -166,17 +176,22 @@ bool DecoderBase::PosMapFromDb(void)
     if (posMap.empty())
         return false; // no position map in recording
 
-    m_playbackInfo->QueryPositionMap(durMap, MARK_DURATION_MS);
+    if (durMap.isEmpty())
+        m_playbackInfo->QueryPositionMap(durMap, MARK_DURATION_MS);
 
     QMutexLocker locker(&m_positionMapLock);
+    delete m_seekIndex;
+    m_seekIndex = sparseIndex;
     m_positionMap.clear();
     m_positionMap.reserve(posMap.size());
     m_frameToDurMap.clear();
     m_durToFrameMap.clear();
 
-    for (auto it = posMap.cbegin(); it != posMap.cend(); ++it)
+    for (const auto &entry : posMap)
     {
-        PosMapEntry e = {it.key(), it.key() * m_keyframeDist, *it};
+        auto index = static_cast<long long>(entry.first);
+        PosMapEntry e = {index, index * m_keyframeDist,
+                         static_cast<long long>(entry.second)};
         m_positionMap.push_back(e);
     }
 
@@ -207,6 +222,85 @@ bool DecoderBase::PosMapFromDb(void)
     return true;
 }
 
+/** \brief Loads the position map, and the duration map if it is indexed
+ *         too, from the recording's sidecar index files.
+ *
+ *  Only used when the index is at least as recent as the recording and
+ *  holds the type of position map we expect.
+ *
+ *  For a finished recording only the first entry of each index block is
+ *  loaded, the index is returned in \p sparseIndex and seeks look up the
+ *  exact keyframe in it, see RefineFromSeekIndex().  While recording the
+ *  map is extended from the encoder, so it is loaded in full.
+ */
+bool DecoderBase::PosMapFromSeekIndex(frm_pos_vec_t &posMap,
+                                      frm_pos_map_t &durMap,
+                                      SeekIndexFile *&sparseIndex)
+{
+    if (!m_ringBuffer || m_ringBuffer->IsDisc() ||
+        !gCoreContext->GetBoolSetting("SeekIndexSidecar", false))
+        return false;
+
+    QString recording = m_ringBuffer->GetFilename();
+    if (!SeekIndexFile::IsUpToDate(recording))
+        return false;
+
+    auto *index = new SeekIndexFile();
+    if (!index->Open(SeekIndexFile::IndexFilename(recording)) ||
+        index->GetEntryCount() == 0 ||
+        (m_positionMapType != MARK_UNSET &&
+         m_positionMapType != index->GetMarkType()))
+    {
+        delete index;
+        return false;
+    }
+
+    MarkTypes type = index->GetMarkType();
+    m_positionMapType = type;
+    if (m_livetv || m_watchingRecording)
+    {
+        index->ReadAll(posMap);
+        delete index;
+    }
+    else
+    {
+        index->ReadBlockStarts(posMap);
+        sparseIndex = index;
+    }
+
+    SeekIndexFile durIndex;
+    if (SeekIndexFile::IsUpToDate(recording, MARK_DURATION_MS) &&
+        durIndex.Open(SeekIndexFile::IndexFilename(recording, MARK_DURATION_MS)) &&
+        durIndex.GetMarkType() == MARK_DURATION_MS)
+    {
+        frm_pos_vec_t durations;
+        durIndex.ReadAll(durations);
+        for (const auto &entry : durations)
+            durMap.insert(static_cast<long long>(entry.first),
+                          static_cast<long long>(entry.second));
+    }
+    if (m_keyframeDist == -1)
+    {
+        if (type == MARK_GOP_BYFRAME)
+        {
+            m_keyframeDist = 1;
+        }
+        else if (type == MARK_GOP_START)
+        {
+            m_keyframeDist = 15;
+            if (m_fps < 26 && m_fps > 24)
+                m_keyframeDist = 12;
+        }
+    }
+
+    LOG(VB_PLAYBACK, LOG_INFO, LOC +
+        QString("Position map loaded from seek index: %1 of %2 entries")
+            .arg(posMap.size()).arg(sparseIndex ?
+                 sparseIndex->GetEntryCount() : posMap.size()));
+
+    return true;
+}
+
 /** \fn DecoderBase::PosMapFromEnc(void)
  *  \brief Queries encoder for position map data
  *         that has not been committed to the DB yet.
@@ -581,6 +675,38 @@ long long DecoderBase::GetKey(const PosMapEntry &e) const
     return (m_hasKeyFrameAdjustTable) ? e.adjFrame :(e.index - m_indexOffset) * kf;
 }
 
+/** \brief Narrows the keyframes found by FindPosition() in a sparse
+ *         position map down to the nearest ones in the seek index.
+ *
+ *  Must be called with m_positionMapLock held.
+ */
+void DecoderBase::RefineFromSeekIndex(long long desiredFrame,
+                                      PosMapEntry &e_pre,
+                                      PosMapEntry &e_post) const
+{
+    if (!m_seekIndex || m_hasKeyFrameAdjustTable || m_keyframeDist < 1)
+        return;
+
+    auto desired = static_cast<uint64_t>(
+        (desiredFrame / m_keyframeDist) + m_indexOffset);
+    uint64_t keyframe = 0;
+    uint64_t offset = 0;
+
+    if (m_seekIndex->Find(desired, keyframe, offset) &&
+        static_cast<long long>(keyframe) > e_pre.index)
+    {
+        auto index = static_cast<long long>(keyframe);
+        e_pre = {index, index * m_keyframeDist, static_cast<long long>(offset)};
+    }
+
+    if (m_seekIndex->FindNext(desired, keyframe, offset) &&
+        static_cast<long long>(keyframe) < e_post.index)
+    {
+        auto index = static_cast<long long>(keyframe);
+        e_post = {index, index * m_keyframeDist, static_cast<long long>(offset)};
+    }
+}
+
 bool DecoderBase::DoRewindSeek(long long desiredFrame)
 {
     ConditionallyUpdatePosMap(desiredFrame);
@@ -607,6 +733,7 @@ bool DecoderBase::DoRewindSeek(long long desiredFrame)
         QMutexLocker locker(&m_positionMapLock);
         PosMapEntry e_pre  = m_positionMap[pre_idx];
         PosMapEntry e_post = m_positionMap[post_idx];
+        RefineFromSeekIndex(desiredFrame, e_pre, e_post);
         int pos_idx = pre_idx;
         e = e_pre;
         if (((uint64_t) (GetKey(e_post) - desiredFrame)) <= m_seekSnap &&
@@ -643,6 +770,8 @@ void DecoderBase::ResetPosMap(void)
 {
     QMutexLocker locker(&m_positionMapLock);
     m_posmapStarted = false;
+    delete m_seekIndex;
+    m_seekIndex = nullptr;
     m_positionMap.clear();
     m_frameToDurMap.clear();
     m_durToFrameMap.clear();
@@ -844,6 +973,7 @@ void DecoderBase::DoFastForwardSeek(long long desiredFrame, bool &needflush)
         QMutexLocker locker(&m_positionMapLock);
         e_pre  = m_positionMap[pre_idx];
         e_post = m_positionMap[post_idx];
+        RefineFromSeekIndex(desiredFrame, e_pre, e_post);
     }
     e = e_pre;
     if (((uint64_t) (GetKey(e_post) - desiredFrame)) <= m_seekSnap &&
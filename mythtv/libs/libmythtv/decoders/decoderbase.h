@@ -19,6 +19,7 @@ class TeletextViewer;
 class MythPlayer;
 class AudioPlayer;
 class MythCodecContext;
+class SeekIndexFile;
 
 const int kDecoderProbeBufferSize = 256 * 1024;
 using TestBufferVec = std::vector<char>;
@@ -213,6 +214,8 @@ class DecoderBase
     virtual bool SyncPositionMap(void);
     virtual bool PosMapFromDb(void);
     virtual bool PosMapFromEnc(void);
+    bool PosMapFromSeekIndex(frm_pos_vec_t &posMap, frm_pos_map_t &durMap,
+                             SeekIndexFile *&sparseIndex);
 
     virtual bool FindPosition(long long desired_value, bool search_adjusted,
                               int &lower_bound, int &upper_bound);
@@ -284,6 +287,8 @@ class DecoderBase
         long long pos;      // position in stream
     };
     long long GetKey(const PosMapEntry &entry) const;
+    void RefineFromSeekIndex(long long desiredFrame,
+                             PosMapEntry &e_pre, PosMapEntry &e_post) const;
 
     MythPlayer          *m_parent                  {nullptr};
     ProgramInfo         *m_playbackInfo            {nullptr};
@@ -328,6 +333,8 @@ class DecoderBase
     frm_pos_map_t        m_frameToDurMap; // guarded by m_positionMapLock
     frm_pos_map_t        m_durToFrameMap; // guarded by m_positionMapLock
     mutable QDateTime    m_lastPositionMapUpdate; // guarded by m_positionMapLock
+    // When set m_positionMap only holds its block starts, guarded by m_positionMapLock
+    SeekIndexFile       *m_seekIndex               {nullptr};
 
     uint64_t             m_seekSnap                {UINT64_MAX};
     bool                 m_dontSyncPositionMap     {false};
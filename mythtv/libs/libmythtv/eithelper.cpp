@@ -16,6 +16,8 @@ using namespace std;
 #include "premieredescriptors.h"
 #include "channelutil.h"        // for ChannelUtil
 #include "mythdate.h"
+#include "mythmetrics.h"
+#include "mythtimer.h"
 #include "programdata.h"
 #include "programinfo.h" // for subtitle types and audio and video properties
 #include "scheduledrecording.h" // for ScheduledRecording
@@ -24,6 +26,14 @@ using namespace std;
 const uint EITHelper::kChunkSize = 20;
 EITCache *EITHelper::s_eitCache = new EITCache();
 
+static MythMetricCounter *eit_skipped(void)
+{
+    static auto *s_counter = MythMetrics::Counter(
+        "mythtv_eit_events_skipped_total",
+        "EIT events skipped because the EIT cache had already seen them");
+    return s_counter;
+}
+
 static uint get_chan_id_from_db_atsc(uint sourceid,
                                      uint atsc_major, uint atsc_minor);
 static uint get_chan_id_from_db_dvb(uint sourceid,  uint serviceid,
@@ -68,6 +78,16 @@ uint EITHelper::ProcessEvents(void)
     if (m_dbEvents.empty())
         return 0;
 
+    static auto *s_processed = MythMetrics::Counter(
+        "mythtv_eit_events_processed_total",
+        "EIT events written to the program guide");
+    static auto *s_inserted = MythMetrics::Counter(
+        "mythtv_eit_programs_inserted_total",
+        "Programs inserted or updated from EIT events");
+    static auto *s_latency = MythMetrics::Histogram(
+        "mythtv_eit_event_update_seconds",
+        "Time taken to write one EIT event to the program guide");
+
     MSqlQuery query(MSqlQuery::InitCon());
     for (uint i = 0; (i < kChunkSize) && (!m_dbEvents.empty()); i++)
     {
@@ -76,7 +96,14 @@ uint EITHelper::ProcessEvents(void)
 
         m_eitFixup->Fix(*event);
 
-        insertCount += event->UpdateDB(query, 1000);
+        MythTimer timer;
+        timer.start();
+        uint inserted = event->UpdateDB(query, 1000);
+        s_latency->Record(timer.nsecsElapsed() / 1000);
+        s_processed->Add();
+        s_inserted->Add(inserted);
+
+        insertCount += inserted;
         m_maxStarttime = max (m_maxStarttime, event->m_starttime);
 
         delete event;
@@ -348,6 +375,7 @@ void EITHelper::AddEIT(const DVBEventInformationTable *eit)
         if (!s_eitCache->IsNewEIT(chanid, tableid, version, eit->EventID(i),
                               eit->EndTimeUnixUTC(i)))
         {
+            eit_skipped()->Add();
             continue;
         }
 
@@ -707,6 +735,7 @@ void EITHelper::AddEIT(const PremiereContentInformationTable *cit)
         // Skip event if we have already processed it before...
         if (!s_eitCache->IsNewEIT(chanid, tableid, version, contentid, endtime))
         {
+            eit_skipped()->Add();
             continue;
         }
 
@@ -31,6 +31,7 @@ using namespace std;
 #include "mythdirs.h"
 #include "mythsystemlegacy.h"
 #include "mythlogging.h"
+#include "mythmetrics.h"
 #include "mythmiscutil.h"
 
 #ifndef O_STREAMING
@@ -986,6 +987,40 @@ bool JobQueue::ChangeJobFlags(int jobID, int newFlags)
     return true;
 }
 
+/// \brief Untranslated job status for metric labels, e.g. "finished"
+static QString status_label(int status)
+{
+    switch (status)
+    {
+#define JOBSTATUS_LABEL(A,B,C) case A: return QString(#A).mid(4).toLower();
+        JOBSTATUS_MAP(JOBSTATUS_LABEL)
+        default: break;
+    }
+    return QString::number(status);
+}
+
+/// \brief Untranslated job type for metric labels, e.g. "commflag"
+static QString type_label(int jobType)
+{
+    switch (jobType)
+    {
+        case JOB_TRANSCODE: return "transcode";
+        case JOB_COMMFLAG:  return "commflag";
+        case JOB_METADATA:  return "metadata";
+        case JOB_PREVIEW:   return "preview";
+    }
+    if (jobType & JOB_USERJOB)
+        return QString("userjob%1").arg(JobQueue::UserJobTypeToIndex(jobType));
+    return QString::number(jobType);
+}
+
+static MythMetricGauge *running_jobs(void)
+{
+    static auto *s_gauge = MythMetrics::Gauge(
+        "mythtv_jobqueue_running_jobs", "Jobs running on this host");
+    return s_gauge;
+}
+
 bool JobQueue::ChangeJobStatus(int jobID, int newStatus, const QString& comment)
 {
     if (jobID < 0)
@@ -1010,6 +1045,14 @@ bool JobQueue::ChangeJobStatus(int jobID, int newStatus, const QString& comment)
         return false;
     }
 
+    if (query.numRowsAffected() > 0)
+    {
+        MythMetrics::Counter("mythtv_jobqueue_status_changes_total",
+                             "Jobs that changed to each status",
+                             MythMetrics::Label("status", status_label(newStatus)))
+            ->Add();
+    }
+
     return true;
 }
 
@@ -1731,8 +1774,10 @@ void JobQueue::ProcessJob(const JobQueueEntry& job)
     jInfo.desc    = GetJobDescription(job.type);
     jInfo.command = GetJobCommand(jobID, job.type, pginfo);
     jInfo.pginfo  = pginfo;
+    jInfo.started.start();
 
     m_runningJobs[jobID] = jInfo;
+    running_jobs()->Set(m_runningJobs.size());
 
     if (pginfo)
         pginfo->MarkAsInUse(true, kJobQueueInUseID);
@@ -1864,7 +1909,14 @@ void JobQueue::RemoveRunningJob(int id)
             delete pginfo;
         }
 
+        const RunningJobInfo &job = m_runningJobs[id];
+        MythMetrics::Histogram("mythtv_jobqueue_job_seconds",
+                               "Time taken by jobs, by type",
+                               MythMetrics::Label("type", type_label(job.type)))
+            ->Record(job.started.nsecsElapsed() / 1000);
+
         m_runningJobs.remove(id);
+        running_jobs()->Set(m_runningJobs.size());
     }
 
     m_runningJobsLock->unlock();
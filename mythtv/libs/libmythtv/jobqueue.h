@@ -5,6 +5,7 @@
 
 #include <QWaitCondition>
 #include <QDateTime>
+#include <QElapsedTimer>
 #include <QRunnable>
 #include <QObject>
 #include <QEvent>
@@ -120,6 +121,7 @@ struct RunningJobInfo {
     QString      desc;
     QString      command;
     ProgramInfo *pginfo  {nullptr};
+    QElapsedTimer started;
 };
 
 class JobQueue;
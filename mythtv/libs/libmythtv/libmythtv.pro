@@ -157,6 +157,7 @@ HEADERS += metadataimagehelper.h
 HEADERS += mythavutil.h
 HEADERS += recordingfile.h
 HEADERS += driveroption.h
+HEADERS += seekindex.h
 
 SOURCES += recordinginfo.cpp
 SOURCES += dbcheck.cpp
@@ -192,6 +193,7 @@ SOURCES += io/mythopticalbuffer.cpp
 SOURCES += metadataimagehelper.cpp
 SOURCES += mythframe.cpp            mythavutil.cpp
 SOURCES += recordingfile.cpp
+SOURCES += seekindex.cpp
 
 # DiSEqC
 HEADERS += diseqc.h                 diseqcsettings.h
@@ -365,6 +367,8 @@ HEADERS += HLS/httplivestreambuffer.h
 SOURCES += HLS/httplivestreambuffer.cpp
 HEADERS += HLS/m3u.h
 SOURCES += HLS/m3u.cpp
+HEADERS += HLS/hlspackager.h
+SOURCES += HLS/hlspackager.cpp
 using_libcrypto:DEFINES += USING_LIBCRYPTO
 using_libcrypto:LIBS    += -lcrypto
 
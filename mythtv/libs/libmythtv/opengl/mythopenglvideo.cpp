@@ -967,6 +967,8 @@ void MythOpenGLVideo::RenderFrame(VideoFrame* Frame, bool TopFieldFirst, FrameSc
     // apply scissoring
     if (tiled)
     {
+        // Draw any queued UI images first, they must not be clipped to the video
+        m_openglRender->FlushBatch();
         // N.B. It's not obvious whether this helps
         m_openglRender->glEnable(GL_SCISSOR_TEST);
         m_openglRender->glScissor(m_displayVideoRect.left() - 1, m_displayVideoRect.top() - 1,
@@ -2,17 +2,25 @@
 
 // C++ includes
 #include <algorithm>
+#include <array>
 #include <climits>
+#include <cmath>
 #include <utility>
 
 using namespace std;
 
 // Qt includes
 #include <QtCore> // for qAbs
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QRunnable>
+#include <QThread>
 
 // MythTV headers
 #include "programdata.h"
 #include "channelutil.h"
+#include "mthreadpool.h"
+#include "mythdate.h"
 #include "mythdb.h"
 #include "mythlogging.h"
 #include "dvbdescriptors.h"
@@ -1209,29 +1217,7 @@ void ProgInfo::Squeeze(void)
     m_clumpmax.squeeze();
 }
 
-/**
- *  \brief Insert a single entry into the "program" database.
- *
- *  This function is called from HandlePrograms, which is called from
- *  mythfilldatabase. It inserts a single entry into the "program"
- *  database. The data for this structure is taken from the 'this'
- *  ProgInfo object.
- *
- *  \param query  Any mysql query structure. The contents is ignored
- *                and the structure is repurposed for local queries.
- *  \param chanid The channel number for this program.
- */
-uint ProgInfo::InsertDB(MSqlQuery &query, uint chanid) const
-{
-    LOG(VB_XMLTV, LOG_DEBUG,
-        QString("Inserting new program    : %1 - %2 %3 %4")
-            .arg(m_starttime.toString(Qt::ISODate))
-            .arg(m_endtime.toString(Qt::ISODate))
-            .arg(m_channel)
-            .arg(m_title));
-
-    query.prepare(
-        "REPLACE INTO program ("
+static const QString kProgramInsertColumns =
         "  chanid,         title,          subtitle,        description, "
         "  category,       category_type,  "
         "  starttime,      endtime, "
@@ -1243,67 +1229,77 @@ uint ProgInfo::InsertDB(MSqlQuery &query, uint chanid) const
         "  seriesid,       programid,      previouslyshown, "
         "  stars,          showtype,       title_pronounce, colorcode, "
         "  season,         episode,        totalepisodes, "
-        "  inetref ) "
+        "  inetref ";
 
-        "VALUES("
-        " :CHANID,        :TITLE,         :SUBTITLE,       :DESCRIPTION, "
-        " :CATEGORY,      :CATTYPE,       "
-        " :STARTTIME,     :ENDTIME, "
-        " :CC,            :STEREO,        :HDTV,           :HASSUBTITLES, "
-        " :SUBTYPES,      :AUDIOPROP,     :VIDEOPROP, "
-        " :PARTNUMBER,    :PARTTOTAL, "
-        " :SYNDICATENO, "
-        " :AIRDATE,       :ORIGAIRDATE,   :LSOURCE, "
-        " :SERIESID,      :PROGRAMID,     :PREVSHOWN, "
-        " :STARS,         :SHOWTYPE,      :TITLEPRON,      :COLORCODE, "
-        " :SEASON,        :EPISODE,       :TOTALEPISODES, "
-        " :INETREF )");
-
-    QString cattype = myth_category_type_to_string(m_categoryType);
+/// Values for kProgramInsertColumns, each placeholder followed by \p sfx
+static QString program_insert_values(const QString &sfx)
+{
+    return QString(
+        " :CHANID%1,        :TITLE%1,         :SUBTITLE%1,       :DESCRIPTION%1, "
+        " :CATEGORY%1,      :CATTYPE%1,       "
+        " :STARTTIME%1,     :ENDTIME%1, "
+        " :CC%1,            :STEREO%1,        :HDTV%1,           :HASSUBTITLES%1, "
+        " :SUBTYPES%1,      :AUDIOPROP%1,     :VIDEOPROP%1, "
+        " :PARTNUMBER%1,    :PARTTOTAL%1, "
+        " :SYNDICATENO%1, "
+        " :AIRDATE%1,       :ORIGAIRDATE%1,   :LSOURCE%1, "
+        " :SERIESID%1,      :PROGRAMID%1,     :PREVSHOWN%1, "
+        " :STARS%1,         :SHOWTYPE%1,      :TITLEPRON%1,      :COLORCODE%1, "
+        " :SEASON%1,        :EPISODE%1,       :TOTALEPISODES%1, "
+        " :INETREF%1 ").arg(sfx);
+}
 
-    query.bindValue(":CHANID",      chanid);
-    query.bindValue(":TITLE",       denullify(m_title));
-    query.bindValue(":SUBTITLE",    denullify(m_subtitle));
-    query.bindValue(":DESCRIPTION", denullify(m_description));
-    query.bindValue(":CATEGORY",    denullify(m_category));
-    query.bindValue(":CATTYPE",     cattype);
-    query.bindValue(":STARTTIME",   m_starttime);
-    query.bindValue(":ENDTIME",     denullify(m_endtime));
-    query.bindValue(":CC",
-                    (m_subtitleType & SUB_HARDHEAR) != 0);
-    query.bindValue(":STEREO",
-                    (m_audioProps   & AUD_STEREO) != 0);
-    query.bindValue(":HDTV",
-                    (m_videoProps   & VID_HDTV) != 0);
-    query.bindValue(":HASSUBTITLES",
-                    (m_subtitleType & SUB_NORMAL) != 0);
-    query.bindValue(":SUBTYPES",    m_subtitleType);
-    query.bindValue(":AUDIOPROP",   m_audioProps);
-    query.bindValue(":VIDEOPROP",   m_videoProps);
-    query.bindValue(":PARTNUMBER",  m_partnumber);
-    query.bindValue(":PARTTOTAL",   m_parttotal);
-    query.bindValue(":SYNDICATENO", denullify(m_syndicatedepisodenumber));
-    query.bindValue(":AIRDATE",     m_airdate ? QString::number(m_airdate):"0000");
-    query.bindValue(":ORIGAIRDATE", m_originalairdate);
-    query.bindValue(":LSOURCE",     m_listingsource);
-    query.bindValue(":SERIESID",    denullify(m_seriesId));
-    query.bindValue(":PROGRAMID",   denullify(m_programId));
-    query.bindValue(":PREVSHOWN",   m_previouslyshown);
-    query.bindValue(":STARS",       m_stars);
-    query.bindValue(":SHOWTYPE",    m_showtype);
-    query.bindValue(":TITLEPRON",   m_title_pronounce);
-    query.bindValue(":COLORCODE",   m_colorcode);
-    query.bindValue(":SEASON",      m_season);
-    query.bindValue(":EPISODE",     m_episode);
-    query.bindValue(":TOTALEPISODES", m_totalepisodes);
-    query.bindValue(":INETREF",     m_inetref);
+static void bind_program_values(MSqlQuery &query, const QString &sfx,
+                                uint chanid, const ProgInfo &pi)
+{
+    QString cattype = myth_category_type_to_string(pi.m_categoryType);
 
-    if (!query.exec())
-    {
-        MythDB::DBError("program insert", query);
-        return 0;
-    }
+    query.bindValue(":CHANID" + sfx,      chanid);
+    query.bindValue(":TITLE" + sfx,       denullify(pi.m_title));
+    query.bindValue(":SUBTITLE" + sfx,    denullify(pi.m_subtitle));
+    query.bindValue(":DESCRIPTION" + sfx, denullify(pi.m_description));
+    query.bindValue(":CATEGORY" + sfx,    denullify(pi.m_category));
+    query.bindValue(":CATTYPE" + sfx,     cattype);
+    query.bindValue(":STARTTIME" + sfx,   pi.m_starttime);
+    query.bindValue(":ENDTIME" + sfx,     denullify(pi.m_endtime));
+    query.bindValue(":CC" + sfx,
+                    (pi.m_subtitleType & SUB_HARDHEAR) != 0);
+    query.bindValue(":STEREO" + sfx,
+                    (pi.m_audioProps   & AUD_STEREO) != 0);
+    query.bindValue(":HDTV" + sfx,
+                    (pi.m_videoProps   & VID_HDTV) != 0);
+    query.bindValue(":HASSUBTITLES" + sfx,
+                    (pi.m_subtitleType & SUB_NORMAL) != 0);
+    query.bindValue(":SUBTYPES" + sfx,    pi.m_subtitleType);
+    query.bindValue(":AUDIOPROP" + sfx,   pi.m_audioProps);
+    query.bindValue(":VIDEOPROP" + sfx,   pi.m_videoProps);
+    query.bindValue(":PARTNUMBER" + sfx,  pi.m_partnumber);
+    query.bindValue(":PARTTOTAL" + sfx,   pi.m_parttotal);
+    query.bindValue(":SYNDICATENO" + sfx, denullify(pi.m_syndicatedepisodenumber));
+    query.bindValue(":AIRDATE" + sfx,
+                    pi.m_airdate ? QString::number(pi.m_airdate) : "0000");
+    query.bindValue(":ORIGAIRDATE" + sfx, pi.m_originalairdate);
+    query.bindValue(":LSOURCE" + sfx,     pi.m_listingsource);
+    query.bindValue(":SERIESID" + sfx,    denullify(pi.m_seriesId));
+    query.bindValue(":PROGRAMID" + sfx,   denullify(pi.m_programId));
+    query.bindValue(":PREVSHOWN" + sfx,   pi.m_previouslyshown);
+    query.bindValue(":STARS" + sfx,       pi.m_stars);
+    query.bindValue(":SHOWTYPE" + sfx,    pi.m_showtype);
+    query.bindValue(":TITLEPRON" + sfx,   pi.m_title_pronounce);
+    query.bindValue(":COLORCODE" + sfx,   pi.m_colorcode);
+    query.bindValue(":SEASON" + sfx,      pi.m_season);
+    query.bindValue(":EPISODE" + sfx,     pi.m_episode);
+    query.bindValue(":TOTALEPISODES" + sfx, pi.m_totalepisodes);
+    query.bindValue(":INETREF" + sfx,     pi.m_inetref);
+}
 
+/**
+ *  \brief Insert the ratings, credits and genres of a program.
+ *
+ *  Any existing rows for the program must already have been removed.
+ */
+void ProgInfo::InsertDetailsDB(MSqlQuery &query, uint chanid) const
+{
     for (const auto & rating : m_ratings)
     {
         query.prepare(
@@ -1326,6 +1322,40 @@ uint ProgInfo::InsertDB(MSqlQuery &query, uint chanid) const
     }
 
     add_genres(query, m_genres, chanid, m_starttime);
+}
+
+/**
+ *  \brief Insert a single entry into the "program" database.
+ *
+ *  It inserts a single entry into the "program" database. The data for
+ *  this structure is taken from the 'this' ProgInfo object.
+ *  mythfilldatabase uses the batched ProgramData::HandlePrograms()
+ *  instead.
+ *
+ *  \param query  Any mysql query structure. The contents is ignored
+ *                and the structure is repurposed for local queries.
+ *  \param chanid The channel number for this program.
+ */
+uint ProgInfo::InsertDB(MSqlQuery &query, uint chanid) const
+{
+    LOG(VB_XMLTV, LOG_DEBUG,
+        QString("Inserting new program    : %1 - %2 %3 %4")
+            .arg(m_starttime.toString(Qt::ISODate))
+            .arg(m_endtime.toString(Qt::ISODate))
+            .arg(m_channel)
+            .arg(m_title));
+
+    query.prepare("REPLACE INTO program (" + kProgramInsertColumns + ") "
+                  "VALUES(" + program_insert_values("") + ")");
+    bind_program_values(query, "", chanid, *this);
+
+    if (!query.exec())
+    {
+        MythDB::DBError("program insert", query);
+        return 0;
+    }
+
+    InsertDetailsDB(query, chanid);
 
     return 1;
 }
@@ -1466,10 +1496,53 @@ void ProgramData::FixProgramList(QList<ProgInfo*> &fixlist)
     }
 }
 
+/** \class ProgramImportTask
+ *  \brief Imports the programs of one xmltv channel on a pool thread.
+ */
+class ProgramImportTask : public QRunnable
+{
+  public:
+    ProgramImportTask(vector<uint> chanids, QList<ProgInfo> &list,
+                      ProgramImportStats &total, QMutex &totalLock) :
+        m_chanids(std::move(chanids)), m_list(list),
+        m_total(total), m_totalLock(totalLock) {}
+
+    void run(void) override // QRunnable
+    {
+        QList<ProgInfo*> sortlist;
+        // NOLINTNEXTLINE(modernize-loop-convert)
+        for (auto it = m_list.begin(); it != m_list.end(); ++it)
+            sortlist.push_back(&(*it));
+
+        ProgramData::FixProgramList(sortlist);
+
+        ProgramImportStats stats;
+        stats.m_channels = static_cast<uint>(m_chanids.size());
+        stats.m_programs = sortlist.size() * stats.m_channels;
+
+        MSqlQuery query(MSqlQuery::InitCon());
+        for (uint chanid : m_chanids)
+            ProgramData::HandlePrograms(query, chanid, sortlist, stats);
+
+        QMutexLocker locker(&m_totalLock);
+        m_total += stats;
+    }
+
+  private:
+    vector<uint>        m_chanids;
+    QList<ProgInfo>    &m_list;
+    ProgramImportStats &m_total;
+    QMutex             &m_totalLock;
+};
+
 /**
  *  \brief Called from mythfilldatabase to bulk insert data into the
  *  program database.
  *
+ *  Each xmltv channel is compared against the existing program rows and
+ *  written on its own thread, so a large listings file is limited by the
+ *  database rather than by one connection's round trips.
+ *
  *  \param sourceid The data source identifier
  *  \param proglist A map of all program information keyed by channel
  *                  identifier
@@ -1477,90 +1550,309 @@ void ProgramData::FixProgramList(QList<ProgInfo*> &fixlist)
 void ProgramData::HandlePrograms(
     uint sourceid, QMap<QString, QList<ProgInfo> > &proglist)
 {
-    uint unchanged = 0;
-    uint updated = 0;
+    static constexpr int kMaxImportThreads = 4;
+
+    QElapsedTimer timer;
+    timer.start();
 
+    QMap<QString, vector<uint> > chanids;
     MSqlQuery query(MSqlQuery::InitCon());
+    query.prepare(
+        "SELECT xmltvid, chanid "
+        "FROM channel "
+        "WHERE deleted  IS NULL AND "
+        "      sourceid = :ID AND "
+        "      xmltvid <> ''");
+    query.bindValue(":ID", sourceid);
 
-    QMap<QString, QList<ProgInfo> >::const_iterator mapiter;
-    for (mapiter = proglist.cbegin(); mapiter != proglist.cend(); ++mapiter)
+    if (!query.exec())
     {
-        if (mapiter.key().isEmpty())
-            continue;
+        MythDB::DBError("ProgramData::HandlePrograms", query);
+        return;
+    }
 
-        query.prepare(
-            "SELECT chanid "
-            "FROM channel "
-            "WHERE deleted  IS NULL AND "
-            "      sourceid = :ID AND "
-            "      xmltvid  = :XMLTVID");
-        query.bindValue(":ID",      sourceid);
-        query.bindValue(":XMLTVID", mapiter.key());
+    while (query.next())
+        chanids[query.value(0).toString()].push_back(query.value(1).toUInt());
 
-        if (!query.exec())
-        {
-            MythDB::DBError("ProgramData::HandlePrograms", query);
-            continue;
-        }
+    ProgramImportStats stats;
+    QMutex statsLock;
+
+    MThreadPool pool("ProgramImport");
+    pool.setMaxThreadCount(
+        std::clamp(QThread::idealThreadCount(), 1, kMaxImportThreads));
 
-        vector<uint> chanids;
-        while (query.next())
-            chanids.push_back(query.value(0).toUInt());
+    for (auto it = proglist.begin(); it != proglist.end(); ++it)
+    {
+        if (it.key().isEmpty())
+            continue;
 
-        if (chanids.empty())
+        auto chanit = chanids.constFind(it.key());
+        if (chanit == chanids.constEnd())
         {
             LOG(VB_GENERAL, LOG_NOTICE,
                 QString("Unknown xmltv channel identifier: %1"
-                        " - Skipping channel.").arg(mapiter.key()));
+                        " - Skipping channel.").arg(it.key()));
             continue;
         }
 
-        QList<ProgInfo> &list = proglist[mapiter.key()];
-        QList<ProgInfo*> sortlist;
-        // NOLINTNEXTLINE(modernize-loop-convert)
-        for (auto it = list.begin(); it != list.end(); ++it)
-            sortlist.push_back(&(*it));
-
-        FixProgramList(sortlist);
-
-        for (uint chanid : chanids)
-            HandlePrograms(query, chanid, sortlist, unchanged, updated);
+        pool.start(new ProgramImportTask(*chanit, *it, stats, statsLock),
+                   "ProgramImport");
     }
 
+    pool.waitForDone();
+
+    double secs = std::max(timer.elapsed(), qint64(1)) / 1000.0;
     LOG(VB_GENERAL, LOG_INFO,
         QString("Updated programs: %1 Unchanged programs: %2")
-                .arg(updated) .arg(unchanged));
+                .arg(stats.m_inserted + stats.m_updated) .arg(stats.m_unchanged));
+    LOG(VB_GENERAL, LOG_INFO,
+        QString("Program import: %1 new, %2 changed, %3 overlapping removed; "
+                "%4 programs on %5 channels in %6s (%7 programs/s)")
+            .arg(stats.m_inserted).arg(stats.m_updated).arg(stats.m_deleted)
+            .arg(stats.m_programs).arg(stats.m_channels)
+            .arg(secs, 0, 'f', 1).arg(stats.m_programs / secs, 0, 'f', 0));
 }
 
 /**
  *  \brief Called from HandlePrograms to bulk insert data into the
  *  program database.
  *
+ *  The existing programs of the channel in the listings' time range are
+ *  read with one query and compared in memory.  Only programs that are new
+ *  or changed are written, after removing the rows they replace or
+ *  overlap, with a few multi-row statements.
+ *
  *  \param query A mysql query related to all channel ids for
  *               a given source
  *  \param chanid The specific channel id to process
  *  \param sortlist A time sorted list of ProgInfo structures
- *  \param unchanged Set to the number of unchanged programs
- *  \param updated Set to the number of updated programs
+ *  \param stats Updated with the number of unchanged, inserted,
+ *               updated and deleted programs
  */
-void ProgramData::HandlePrograms(MSqlQuery             &query,
-                                 uint                   chanid,
+void ProgramData::HandlePrograms(MSqlQuery              &query,
+                                 uint                    chanid,
                                  const QList<ProgInfo*> &sortlist,
-                                 uint &unchanged,
-                                 uint &updated)
+                                 ProgramImportStats     &stats)
 {
+    if (sortlist.isEmpty())
+        return;
+
+    QDateTime from = sortlist.front()->m_starttime;
+    QDateTime to   = from;
     for (auto *pinfo : qAsConst(sortlist))
     {
-        if (IsUnchanged(query, chanid, *pinfo))
+        to = std::max(to, pinfo->m_starttime);
+        if (pinfo->m_endtime.isValid())
+            to = std::max(to, pinfo->m_endtime);
+    }
+
+    QMap<QDateTime, ProgInfo> existing;
+    if (!LoadPrograms(query, chanid, from, to, existing))
+        return;
+
+    QList<QDateTime>       todelete;
+    QList<const ProgInfo*> toinsert;
+    for (auto *pinfo : qAsConst(sortlist))
+    {
+        auto it = existing.find(pinfo->m_starttime);
+        if (it != existing.end())
         {
-            unchanged++;
-            continue;
+            if (IsUnchanged(*pinfo, *it))
+            {
+                stats.m_unchanged++;
+                continue;
+            }
+            existing.erase(it);
+            stats.m_updated++;
+        }
+        else
+        {
+            stats.m_inserted++;
+        }
+
+        // Also clears the old program's ratings, credits and genres
+        todelete.push_back(pinfo->m_starttime);
+
+        if (pinfo->m_endtime.isValid())
+        {
+            it = existing.lowerBound(pinfo->m_starttime);
+            while (it != existing.end() && it.key() < pinfo->m_endtime)
+            {
+                LOG(VB_XMLTV, LOG_DEBUG,
+                    QString("Removing existing program: %1 - %2 %3 %4")
+                        .arg(it->m_starttime.toString(Qt::ISODate))
+                        .arg(it->m_endtime.toString(Qt::ISODate))
+                        .arg(pinfo->m_channel)
+                        .arg(it->m_title));
+                todelete.push_back(it.key());
+                stats.m_deleted++;
+                it = existing.erase(it);
+            }
+        }
+
+        toinsert.push_back(pinfo);
+    }
+
+    if (!todelete.isEmpty() && !DeletePrograms(query, chanid, todelete))
+        return;
+
+    if (!toinsert.isEmpty())
+        InsertPrograms(query, chanid, toinsert);
+}
+
+/**
+ *  \brief Reads the programs of a channel starting in [from, to] into
+ *  \p programs, keyed by start time.
+ *
+ *  Only the columns compared by IsUnchanged() are filled in.
+ */
+bool ProgramData::LoadPrograms(
+    MSqlQuery &query, uint chanid, const QDateTime &from, const QDateTime &to,
+    QMap<QDateTime, ProgInfo> &programs)
+{
+    query.prepare(
+        "SELECT starttime,      endtime,       title,      subtitle, "
+        "       description,    category,      category_type, "
+        "       airdate,        stars,         previouslyshown, "
+        "       title_pronounce, audioprop+0,  videoprop+0, "
+        "       subtitletypes+0, partnumber,   parttotal, "
+        "       seriesid,       showtype,      colorcode, "
+        "       syndicatedepisodenumber,       programid, "
+        "       season,         episode,       totalepisodes, "
+        "       inetref "
+        "FROM program "
+        "WHERE chanid     = :CHANID AND "
+        "      starttime >= :FROM   AND "
+        "      starttime <= :TO");
+    query.bindValue(":CHANID", chanid);
+    query.bindValue(":FROM",   from);
+    query.bindValue(":TO",     to);
+
+    if (!query.exec())
+    {
+        MythDB::DBError("ProgramData::LoadPrograms", query);
+        return false;
+    }
+
+    while (query.next())
+    {
+        ProgInfo pi;
+        pi.m_starttime       = MythDate::as_utc(query.value(0).toDateTime());
+        pi.m_endtime         = MythDate::as_utc(query.value(1).toDateTime());
+        pi.m_title           = query.value(2).toString();
+        pi.m_subtitle        = query.value(3).toString();
+        pi.m_description     = query.value(4).toString();
+        pi.m_category        = query.value(5).toString();
+        pi.m_categoryType    =
+            string_to_myth_category_type(query.value(6).toString());
+        pi.m_airdate         = query.value(7).toUInt();
+        pi.m_stars           = query.value(8).toFloat();
+        pi.m_previouslyshown = query.value(9).toBool();
+        pi.m_title_pronounce = query.value(10).toString();
+        pi.m_audioProps      = query.value(11).toUInt();
+        pi.m_videoProps      = query.value(12).toUInt();
+        pi.m_subtitleType    = query.value(13).toUInt();
+        pi.m_partnumber      = query.value(14).toUInt();
+        pi.m_parttotal       = query.value(15).toUInt();
+        pi.m_seriesId        = query.value(16).toString();
+        pi.m_showtype        = query.value(17).toString();
+        pi.m_colorcode       = query.value(18).toString();
+        pi.m_syndicatedepisodenumber = query.value(19).toString();
+        pi.m_programId       = query.value(20).toString();
+        pi.m_season          = query.value(21).toUInt();
+        pi.m_episode         = query.value(22).toUInt();
+        pi.m_totalepisodes   = query.value(23).toUInt();
+        pi.m_inetref         = query.value(24).toString();
+        programs.insert(pi.m_starttime, pi);
+    }
+
+    return true;
+}
+
+/**
+ *  \brief Deletes the programs of a channel with the given start times,
+ *  along with their ratings, credits and genres.
+ */
+bool ProgramData::DeletePrograms(
+    MSqlQuery &query, uint chanid, const QList<QDateTime> &starttimes)
+{
+    static const std::array<const QString,4> kTables
+        { "program", "programrating", "credits", "programgenres" };
+
+    for (int first = 0; first < starttimes.size(); first += kRowsPerStatement)
+    {
+        int rows = std::min(kRowsPerStatement, starttimes.size() - first);
+
+        QStringList placeholders;
+        placeholders.reserve(rows);
+        for (int i = 0; i < rows; ++i)
+            placeholders << QString(":S%1").arg(i, 3, 10, QChar('0'));
+
+        for (const auto &table : kTables)
+        {
+            query.prepare(QString("DELETE FROM %1 "
+                                  "WHERE chanid = :CHANID AND "
+                                  "      starttime IN (%2)")
+                          .arg(table, placeholders.join(",")));
+            query.bindValue(":CHANID", chanid);
+            for (int i = 0; i < rows; ++i)
+                query.bindValue(placeholders[i], starttimes[first + i]);
+
+            if (!query.exec())
+            {
+                MythDB::DBError("ProgramData::DeletePrograms", query);
+                return false;
+            }
         }
+    }
 
-        if (!DeleteOverlaps(query, chanid, *pinfo))
+    return true;
+}
+
+/**
+ *  \brief Inserts programs with multi-row statements, followed by their
+ *  ratings, credits and genres.
+ */
+void ProgramData::InsertPrograms(
+    MSqlQuery &query, uint chanid, const QList<const ProgInfo*> &programs)
+{
+    for (int first = 0; first < programs.size(); first += kRowsPerStatement)
+    {
+        int rows = std::min(kRowsPerStatement, programs.size() - first);
+
+        QStringList values;
+        values.reserve(rows);
+        for (int i = 0; i < rows; ++i)
+        {
+            values << "(" + program_insert_values(
+                QString("_%1").arg(i, 3, 10, QChar('0'))) + ")";
+        }
+
+        query.prepare("REPLACE INTO program (" + kProgramInsertColumns + ") "
+                      "VALUES " + values.join(","));
+        for (int i = 0; i < rows; ++i)
+        {
+            bind_program_values(query, QString("_%1").arg(i, 3, 10, QChar('0')),
+                                chanid, *programs[first + i]);
+        }
+
+        if (!query.exec())
+        {
+            MythDB::DBError("ProgramData::InsertPrograms", query);
             continue;
+        }
 
-        updated += pinfo->InsertDB(query, chanid);
+        for (int i = 0; i < rows; ++i)
+        {
+            const ProgInfo *pinfo = programs[first + i];
+            LOG(VB_XMLTV, LOG_DEBUG,
+                QString("Inserting new program    : %1 - %2 %3 %4")
+                    .arg(pinfo->m_starttime.toString(Qt::ISODate))
+                    .arg(pinfo->m_endtime.toString(Qt::ISODate))
+                    .arg(pinfo->m_channel)
+                    .arg(pinfo->m_title));
+            pinfo->InsertDetailsDB(query, chanid);
+        }
     }
 }
 
@@ -1628,120 +1920,32 @@ int ProgramData::fix_end_times(void)
     return count;
 }
 
-bool ProgramData::IsUnchanged(
-    MSqlQuery &query, uint chanid, const ProgInfo &pi)
+/// \brief Returns true if \p dbpi, read by LoadPrograms(), matches \p pi.
+bool ProgramData::IsUnchanged(const ProgInfo &pi, const ProgInfo &dbpi)
 {
-    query.prepare(
-        "SELECT count(*) "
-        "FROM program "
-        "WHERE chanid          = :CHANID     AND "
-        "      starttime       = :START      AND "
-        "      endtime         = :END        AND "
-        "      title           = :TITLE      AND "
-        "      subtitle        = :SUBTITLE   AND "
-        "      description     = :DESC       AND "
-        "      category        = :CATEGORY   AND "
-        "      category_type   = :CATEGORY_TYPE AND "
-        "      airdate         = :AIRDATE    AND "
-        "      stars >= (:STARS1 - 0.001)    AND "
-        "      stars <= (:STARS2 + 0.001)    AND "
-        "      previouslyshown = :PREVIOUSLYSHOWN AND "
-        "      title_pronounce = :TITLE_PRONOUNCE AND "
-        "      audioprop       = :AUDIOPROP  AND "
-        "      videoprop       = :VIDEOPROP  AND "
-        "      subtitletypes   = :SUBTYPES   AND "
-        "      partnumber      = :PARTNUMBER AND "
-        "      parttotal       = :PARTTOTAL  AND "
-        "      seriesid        = :SERIESID   AND "
-        "      showtype        = :SHOWTYPE   AND "
-        "      colorcode       = :COLORCODE  AND "
-        "      syndicatedepisodenumber = :SYNDICATEDEPISODENUMBER AND "
-        "      programid       = :PROGRAMID  AND "
-        "      season          = :SEASON     AND "
-        "      episode         = :EPISODE    AND "
-        "      totalepisodes   = :TOTALEPISODES AND "
-        "      inetref         = :INETREF");
-
-    QString cattype = myth_category_type_to_string(pi.m_categoryType);
-
-    query.bindValue(":CHANID",     chanid);
-    query.bindValue(":START",      pi.m_starttime);
-    query.bindValue(":END",        pi.m_endtime);
-    query.bindValue(":TITLE",      denullify(pi.m_title));
-    query.bindValue(":SUBTITLE",   denullify(pi.m_subtitle));
-    query.bindValue(":DESC",       denullify(pi.m_description));
-    query.bindValue(":CATEGORY",   denullify(pi.m_category));
-    query.bindValue(":CATEGORY_TYPE", cattype);
-    query.bindValue(":AIRDATE",    pi.m_airdate);
-    query.bindValue(":STARS1",     pi.m_stars);
-    query.bindValue(":STARS2",     pi.m_stars);
-    query.bindValue(":PREVIOUSLYSHOWN", pi.m_previouslyshown);
-    query.bindValue(":TITLE_PRONOUNCE", pi.m_title_pronounce);
-    query.bindValue(":AUDIOPROP",  pi.m_audioProps);
-    query.bindValue(":VIDEOPROP",  pi.m_videoProps);
-    query.bindValue(":SUBTYPES",   pi.m_subtitleType);
-    query.bindValue(":PARTNUMBER", pi.m_partnumber);
-    query.bindValue(":PARTTOTAL",  pi.m_parttotal);
-    query.bindValue(":SERIESID",   denullify(pi.m_seriesId));
-    query.bindValue(":SHOWTYPE",   pi.m_showtype);
-    query.bindValue(":COLORCODE",  pi.m_colorcode);
-    query.bindValue(":SYNDICATEDEPISODENUMBER",
-                    denullify(pi.m_syndicatedepisodenumber));
-    query.bindValue(":PROGRAMID",  denullify(pi.m_programId));
-    query.bindValue(":SEASON",     pi.m_season);
-    query.bindValue(":EPISODE",    pi.m_episode);
-    query.bindValue(":TOTALEPISODES", pi.m_totalepisodes);
-    query.bindValue(":INETREF",    pi.m_inetref);
-
-    if (query.exec() && query.next())
-        return query.value(0).toUInt() > 0;
-
-    return false;
-}
-
-bool ProgramData::DeleteOverlaps(
-    MSqlQuery &query, uint chanid, const ProgInfo &pi)
-{
-    if (VERBOSE_LEVEL_CHECK(VB_XMLTV, LOG_DEBUG))
-    {
-        // Get overlaps..
-        query.prepare(
-            "SELECT title,starttime,endtime "
-            "FROM program "
-            "WHERE chanid     = :CHANID AND "
-            "      starttime >= :START AND "
-            "      starttime <  :END;");
-        query.bindValue(":CHANID", chanid);
-        query.bindValue(":START",  pi.m_starttime);
-        query.bindValue(":END",    pi.m_endtime);
-
-        if (!query.exec())
-            return false;
-
-        if (!query.next())
-            return true;
-
-        do
-        {
-            LOG(VB_XMLTV, LOG_DEBUG,
-                QString("Removing existing program: %1 - %2 %3 %4")
-                .arg(MythDate::as_utc(query.value(1).toDateTime()).toString(Qt::ISODate))
-                .arg(MythDate::as_utc(query.value(2).toDateTime()).toString(Qt::ISODate))
-                .arg(pi.m_channel)
-                .arg(query.value(0).toString()));
-        } while (query.next());
-    }
-
-    if (!ClearDataByChannel(chanid, pi.m_starttime, pi.m_endtime, false))
-    {
-        LOG(VB_XMLTV, LOG_ERR,
-            QString("Program delete failed    : %1 - %2 %3 %4")
-                .arg(pi.m_starttime.toString(Qt::ISODate))
-                .arg(pi.m_endtime.toString(Qt::ISODate))
-                .arg(pi.m_channel)
-                .arg(pi.m_title));
-        return false;
-    }
-
-    return true;
+    return
+        pi.m_endtime         == dbpi.m_endtime                 &&
+        pi.m_title           == dbpi.m_title                   &&
+        pi.m_subtitle        == dbpi.m_subtitle                &&
+        pi.m_description     == dbpi.m_description             &&
+        pi.m_category        == dbpi.m_category                &&
+        pi.m_categoryType    == dbpi.m_categoryType            &&
+        pi.m_airdate         == dbpi.m_airdate                 &&
+        std::abs(pi.m_stars - dbpi.m_stars) <= 0.001F          &&
+        pi.m_previouslyshown == dbpi.m_previouslyshown         &&
+        pi.m_title_pronounce == dbpi.m_title_pronounce         &&
+        pi.m_audioProps      == dbpi.m_audioProps              &&
+        pi.m_videoProps      == dbpi.m_videoProps              &&
+        pi.m_subtitleType    == dbpi.m_subtitleType            &&
+        pi.m_partnumber      == dbpi.m_partnumber              &&
+        pi.m_parttotal       == dbpi.m_parttotal               &&
+        pi.m_seriesId        == dbpi.m_seriesId                &&
+        pi.m_showtype        == dbpi.m_showtype                &&
+        pi.m_colorcode       == dbpi.m_colorcode               &&
+        pi.m_syndicatedepisodenumber == dbpi.m_syndicatedepisodenumber &&
+        pi.m_programId       == dbpi.m_programId               &&
+        pi.m_season          == dbpi.m_season                  &&
+        pi.m_episode         == dbpi.m_episode                 &&
+        pi.m_totalepisodes   == dbpi.m_totalepisodes           &&
+        pi.m_inetref         == dbpi.m_inetref;
 }
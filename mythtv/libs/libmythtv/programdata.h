@@ -219,6 +219,7 @@ class MTV_PUBLIC ProgInfo : public DBEvent
     ProgInfo(const ProgInfo &other);
 
     uint InsertDB(MSqlQuery &query, uint chanid) const override; // DBEvent
+    void InsertDetailsDB(MSqlQuery &query, uint chanid) const;
 
     void Squeeze(void) override; // DBEvent
 
@@ -236,8 +237,32 @@ class MTV_PUBLIC ProgInfo : public DBEvent
     QString       m_clumpmax;
 };
 
+/// \brief Counters for one ProgramData::HandlePrograms() import
+struct ProgramImportStats
+{
+    uint m_channels  {0};
+    uint m_programs  {0};
+    uint m_unchanged {0};
+    uint m_inserted  {0}; ///< no program at that start time before
+    uint m_updated   {0}; ///< replaced a changed program
+    uint m_deleted   {0}; ///< existing programs overlapped by a new one
+
+    ProgramImportStats &operator+=(const ProgramImportStats &other)
+    {
+        m_channels  += other.m_channels;
+        m_programs  += other.m_programs;
+        m_unchanged += other.m_unchanged;
+        m_inserted  += other.m_inserted;
+        m_updated   += other.m_updated;
+        m_deleted   += other.m_deleted;
+        return *this;
+    }
+};
+
 class MTV_PUBLIC ProgramData
 {
+    friend class ProgramImportTask;
+
   public:
     static void HandlePrograms(uint sourceid,
                                QMap<QString, QList<ProgInfo> > &proglist);
@@ -259,11 +284,18 @@ class MTV_PUBLIC ProgramData
     static void HandlePrograms(
         MSqlQuery &query, uint chanid,
         const QList<ProgInfo*> &sortlist,
-        uint &unchanged, uint &updated);
-    static bool IsUnchanged(
-        MSqlQuery &query, uint chanid, const ProgInfo &pi);
-    static bool DeleteOverlaps(
-        MSqlQuery &query, uint chanid, const ProgInfo &pi);
+        ProgramImportStats &stats);
+    static bool LoadPrograms(
+        MSqlQuery &query, uint chanid,
+        const QDateTime &from, const QDateTime &to,
+        QMap<QDateTime, ProgInfo> &programs);
+    static bool DeletePrograms(
+        MSqlQuery &query, uint chanid, const QList<QDateTime> &starttimes);
+    static void InsertPrograms(
+        MSqlQuery &query, uint chanid, const QList<const ProgInfo*> &programs);
+    static bool IsUnchanged(const ProgInfo &pi, const ProgInfo &dbpi);
+
+    static constexpr int kRowsPerStatement = 100;
 };
 
 #endif // PROGRAMDATA_H
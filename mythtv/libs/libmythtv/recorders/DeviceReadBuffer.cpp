@@ -4,6 +4,7 @@ using namespace std;
 #include "DeviceReadBuffer.h"
 #include "mythcorecontext.h"
 #include "mythlogging.h"
+#include "mythmetrics.h"
 #include "tspacket.h"
 #include "mthread.h"
 #include "compat.h"
@@ -57,6 +58,20 @@ bool DeviceReadBuffer::Setup(const QString &streamName, int streamfd,
     m_videoDevice   = m_videoDevice.isNull() ? "" : m_videoDevice;
     m_streamFd      = streamfd;
 
+    QString label = MythMetrics::Label("device", m_videoDevice);
+    m_metricRead = MythMetrics::Counter(
+        "mythtv_devicereadbuffer_read_bytes_total",
+        "Data read from the capture device", label);
+    m_metricFull = MythMetrics::Counter(
+        "mythtv_devicereadbuffer_full_total",
+        "Reads skipped because the ring buffer was full", label);
+    m_metricOverflows = MythMetrics::Counter(
+        "mythtv_devicereadbuffer_overflows_total",
+        "Driver buffer overflows, each losing data", label);
+    m_metricUsed = MythMetrics::Gauge(
+        "mythtv_devicereadbuffer_used_bytes",
+        "Data in the ring buffer waiting to be processed", label);
+
     // Setup device ringbuffer
     m_eof           = false;
     m_error         = false;
@@ -280,6 +295,8 @@ void DeviceReadBuffer::IncrWritePointer(uint len)
     m_used     += len;
     m_writePtr += len;
     m_writePtr  = (m_writePtr >= m_endPtr) ? m_buffer + (m_writePtr - m_endPtr) : m_writePtr;
+    m_metricRead->Add(len);
+    m_metricUsed->Set(m_used);
 #if REPORT_RING_STATS
     m_maxUsed = max(m_used, m_maxUsed);
     m_avgUsed = ((m_avgUsed * m_avgBufWriteCnt) + m_used) / (m_avgBufWriteCnt+1);
@@ -294,6 +311,7 @@ void DeviceReadBuffer::IncrReadPointer(uint len)
     m_used    -= len;
     m_readPtr += len;
     m_readPtr  = (m_readPtr == m_endPtr) ? m_buffer : m_readPtr;
+    m_metricUsed->Set(m_used);
 #if REPORT_RING_STATS
     ++m_avgBufReadCnt;
 #endif
@@ -363,6 +381,10 @@ void DeviceReadBuffer::run(void)
                 IncrWritePointer(len);
                 total += len;
             }
+            else if (m_doRun && !IsPauseRequested())
+            {
+                m_metricFull->Add();
+            }
         }
         if (errcnt > 5)
             break;
@@ -568,6 +590,7 @@ bool DeviceReadBuffer::CheckForErrors(
         }
         if (EOVERFLOW == errno)
         {
+            m_metricOverflows->Add();
             LOG(VB_GENERAL, LOG_ERR, LOC + "Driver buffers overflowed");
             return false;
         }
@@ -15,6 +15,9 @@
 #include "tspacket.h"
 #include "mthread.h"
 
+class MythMetricCounter;
+class MythMetricGauge;
+
 class DeviceReaderCB
 {
   protected:
@@ -124,6 +127,12 @@ class DeviceReadBuffer : protected MThread
     size_t                  m_avgBufReadCnt         {0};
     size_t                  m_avgBufSleepCnt        {0};
     MythTimer               m_lastReport;
+
+    // metrics, per device
+    MythMetricCounter      *m_metricRead            {nullptr};
+    MythMetricCounter      *m_metricFull            {nullptr};
+    MythMetricCounter      *m_metricOverflows       {nullptr};
+    MythMetricGauge        *m_metricUsed            {nullptr};
 };
 
 #endif // DEVICEREADBUFFER_H
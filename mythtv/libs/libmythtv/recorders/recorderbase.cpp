@@ -19,6 +19,7 @@ using namespace std;
 #include "hdhrchannel.h"
 #include "iptvchannel.h"
 #include "mythsystemevent.h"
+#include "mythdbwritequeue.h"
 #include "mythlogging.h"
 #include "programinfo.h"
 #include "asichannel.h"
@@ -28,6 +29,7 @@ using namespace std;
 #include "satiprecorder.h"
 #include "ExternalChannel.h"
 #include "io/mythmediabuffer.h"
+#include "seekindex.h"
 #include "cardutil.h"
 #include "tv_rec.h"
 #include "mythdate.h"
@@ -51,6 +53,7 @@ RecorderBase::RecorderBase(TVRec *rec)
     : m_tvrec(rec)
 {
     RecorderBase::ClearStatistics();
+    m_writeSeekIndex = gCoreContext->GetBoolSetting("SeekIndexSidecar", false);
 }
 
 RecorderBase::~RecorderBase(void)
@@ -72,6 +75,10 @@ RecorderBase::~RecorderBase(void)
         delete m_nextRecording;
         m_nextRecording = nullptr;
     }
+    delete m_seekIndex;
+    m_seekIndex = nullptr;
+    delete m_durationIndex;
+    m_durationIndex = nullptr;
 }
 
 void RecorderBase::SetRingBuffer(MythMediaBuffer *Buffer)
@@ -135,7 +142,11 @@ void RecorderBase::SetNextRecording(const RecordingInfo *ri, MythMediaBuffer *Bu
     {
         m_ringBuffer->WriterFlush();
         if (m_curRecording)
+        {
+            // Don't let a queued, older file size overwrite this one
+            GetMythDBWriteQueue()->Flush();
             m_curRecording->SaveFilesize(m_ringBuffer->GetRealFileSize());
+        }
     }
 
     // Then we set the next info
@@ -437,6 +448,9 @@ void RecorderBase::FinishRecording(void)
 {
     if (m_curRecording)
     {
+        // Queued updates must not land after the final values below
+        GetMythDBWriteQueue()->Flush();
+
         if (m_primaryVideoCodec == AV_CODEC_ID_H264)
             m_curRecording->SaveVideoProperties(VID_AVC, VID_AVC);
         else if (m_primaryVideoCodec == AV_CODEC_ID_H265)
@@ -590,6 +604,10 @@ bool RecorderBase::GetKeyframeDurations(
  */
 void RecorderBase::SavePositionMap(bool force, bool finished)
 {
+    // Everything must be in the DB once the recording is done
+    if (finished)
+        GetMythDBWriteQueue()->Flush();
+
     bool needToSave = force;
     m_positionMapLock.lock();
 
@@ -620,9 +638,39 @@ void RecorderBase::SavePositionMap(bool force, bool finished)
             m_durationMapDelta.clear();
             m_positionMapLock.unlock();
 
-            m_curRecording->SavePositionMapDelta(deltaCopy, m_positionMapType);
-            m_curRecording->SavePositionMapDelta(durationDeltaCopy,
-                                               MARK_DURATION_MS);
+            if (finished)
+            {
+                m_curRecording->SavePositionMapDelta(deltaCopy,
+                                                     m_positionMapType);
+                m_curRecording->SavePositionMapDelta(durationDeltaCopy,
+                                                     MARK_DURATION_MS);
+            }
+            else
+            {
+                // Don't let a slow DB stall the recorder, write behind
+                ProgramInfo pginfo(*m_curRecording);
+                MarkTypes type = m_positionMapType;
+                bool queued = GetMythDBWriteQueue()->Enqueue(QString(),
+                    [pginfo, deltaCopy, durationDeltaCopy, type]() mutable
+                    {
+                        pginfo.SavePositionMapDelta(deltaCopy, type);
+                        pginfo.SavePositionMapDelta(durationDeltaCopy,
+                                                    MARK_DURATION_MS);
+                        return true;
+                    });
+                if (!queued)
+                {
+                    // The queue is full, keep the entries for the next save
+                    QMutexLocker locker(&m_positionMapLock);
+                    for (auto it = deltaCopy.cbegin();
+                         it != deltaCopy.cend(); ++it)
+                        m_positionMapDelta.insert(it.key(), *it);
+                    for (auto it = durationDeltaCopy.cbegin();
+                         it != durationDeltaCopy.cend(); ++it)
+                        m_durationMapDelta.insert(it.key(), *it);
+                }
+            }
+            SaveSeekIndex(deltaCopy, durationDeltaCopy);
 
             TryWriteProgStartMark(durationDeltaCopy);
         }
@@ -633,7 +681,8 @@ void RecorderBase::SavePositionMap(bool force, bool finished)
 
         if (m_ringBuffer && !finished) // Finished Recording will update the final size for us
         {
-            m_curRecording->SaveFilesize(m_ringBuffer->GetWritePosition());
+            m_curRecording->SaveFilesizeDeferred(
+                m_ringBuffer->GetWritePosition());
         }
     }
     else
@@ -654,6 +703,49 @@ void RecorderBase::SavePositionMap(bool force, bool finished)
     }
 }
 
+/** \brief Appends new seektable and duration map entries to the
+ *         recording's sidecar index files.
+ *
+ *  The index files are opened whenever the recorder moves on to a new file,
+ *  e.g. on a LiveTV ringbuffer switch.  If a file is already indexed, i.e.
+ *  the recorder was restarted, the new entries are added to the old ones.
+ */
+void RecorderBase::SaveSeekIndex(const frm_pos_map_t &delta,
+                                 const frm_pos_map_t &durationDelta)
+{
+    if (!m_writeSeekIndex || !m_ringBuffer)
+        return;
+
+    QMutexLocker locker(&m_seekIndexLock);
+
+    QString recording = m_ringBuffer->GetFilename();
+    if (!m_seekIndex || recording != m_seekIndexRecording)
+    {
+        delete m_seekIndex;
+        delete m_durationIndex;
+        m_seekIndex = new SeekIndexFile();
+        m_durationIndex = new SeekIndexFile();
+        m_seekIndexRecording = recording;
+        if (!m_seekIndex->OpenForAppend(
+                SeekIndexFile::IndexFilename(recording), m_positionMapType) ||
+            !m_durationIndex->OpenForAppend(
+                SeekIndexFile::IndexFilename(recording, MARK_DURATION_MS),
+                MARK_DURATION_MS))
+        {
+            // Don't keep retrying on every save
+            m_writeSeekIndex = false;
+            delete m_seekIndex;
+            delete m_durationIndex;
+            m_seekIndex = nullptr;
+            m_durationIndex = nullptr;
+            return;
+        }
+    }
+
+    m_seekIndex->Append(delta);
+    m_durationIndex->Append(durationDelta);
+}
+
 void RecorderBase::TryWriteProgStartMark(const frm_pos_map_t &durationDeltaCopy)
 {
     // Note: all log strings contain "progstart mark" for searching.
@@ -31,6 +31,7 @@ class DVBDBOptions;
 class RecorderBase;
 class ChannelBase;
 class MythMediaBuffer;
+class SeekIndexFile;
 class TVRec;
 
 class FrameRate
@@ -239,6 +240,8 @@ class MTV_PUBLIC RecorderBase : public QRunnable
     /** \brief Save the seektable to the DB
      */
     void SavePositionMap(bool force = false, bool finished = false);
+    void SaveSeekIndex(const frm_pos_map_t &delta,
+                       const frm_pos_map_t &durationDelta);
 
     enum AspectRatio {
         ASPECT_UNKNOWN       = 0x00,
@@ -361,6 +364,13 @@ class MTV_PUBLIC RecorderBase : public QRunnable
     frm_pos_map_t  m_durationMapDelta;
     MythTimer      m_positionMapTimer;
 
+    // Sidecar seek index support
+    bool           m_writeSeekIndex       {false};
+    QMutex         m_seekIndexLock;
+    SeekIndexFile *m_seekIndex            {nullptr};
+    SeekIndexFile *m_durationIndex        {nullptr};
+    QString        m_seekIndexRecording;
+
     // ProgStart mark support
     qint64         m_estimatedProgStartMS {0};
     long long      m_lastSavedKeyframe    {0};
@@ -17,6 +17,7 @@
 #include "programinfoupdater.h"
 #include "jobqueue.h"
 #include "mythdb.h"
+#include "mythdbwritequeue.h"
 #include "mythlogging.h"
 
 #define LOC      QString("RecordingInfo(%1): ").arg(GetBasename())
@@ -1660,6 +1661,55 @@ void RecordingInfo::SaveFilesize(uint64_t fsize)
     ProgramInfo::SaveFilesize(fsize); // Temporary
 }
 
+/** \brief Like SaveFilesize(), but the DB is updated later by the
+ *         DB write queue, so the caller never waits on the database.
+ *
+ *  Repeated updates for the same recording are coalesced.
+ */
+void RecordingInfo::SaveFilesizeDeferred(uint64_t fsize)
+{
+    if (!GetRecordingFile())
+        LoadRecordingFile();
+
+    RecordingFile *recFile = GetRecordingFile();
+    if (recFile->m_fileId == 0)
+    {
+        // The recordedfile row hasn't been created yet, do it now
+        SaveFilesize(fsize);
+        return;
+    }
+
+    recFile->m_fileSize = fsize;
+    ProgramInfo::SetFilesize(fsize);
+
+    MythDBWriteQueue *queue = GetMythDBWriteQueue();
+
+    // Only the size is written, so that a pending update never overwrites
+    // the rest of the row with older values
+    MSqlBindings filebindings;
+    filebindings[":FILESIZE"] = (quint64)fsize;
+    filebindings[":FILEID"]   = recFile->m_fileId;
+    queue->Enqueue(QString("recordedfile.filesize:%1").arg(recFile->m_fileId),
+                   "UPDATE recordedfile "
+                   "SET filesize = :FILESIZE "
+                   "WHERE id = :FILEID",
+                   filebindings);
+
+    MSqlBindings bindings;
+    bindings[":FILESIZE"]  = (quint64)fsize;
+    bindings[":CHANID"]    = m_chanId;
+    bindings[":STARTTIME"] = m_recStartTs;
+    queue->Enqueue(QString("recorded.filesize:%1_%2")
+                       .arg(m_chanId).arg(m_recStartTs.toString(Qt::ISODate)),
+                   "UPDATE recorded "
+                   "SET filesize = :FILESIZE "
+                   "WHERE chanid    = :CHANID AND "
+                   "      starttime = :STARTTIME",
+                   bindings);
+
+    s_updater->insert(m_recordedId, kPIUpdateFileSize, fsize);
+}
+
 void RecordingInfo::SetFilesize(uint64_t fsize)
 {
     if (!GetRecordingFile())
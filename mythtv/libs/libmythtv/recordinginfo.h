@@ -270,6 +270,7 @@ class MTV_PUBLIC RecordingInfo : public ProgramInfo
     void LoadRecordingFile();
     RecordingFile *GetRecordingFile() const { return m_recordingFile; }
     void SaveFilesize(uint64_t fsize) override; // ProgramInfo
+    void SaveFilesizeDeferred(uint64_t fsize);
     void SetFilesize( uint64_t fsize ) override; // ProgramInfo
     uint64_t GetFilesize(void) const override; // ProgramInfo
 
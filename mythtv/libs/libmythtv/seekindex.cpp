@@ -0,0 +1,509 @@
+// C++ headers
+#include <algorithm>
+
+// Qt headers
+#include <QFileInfo>
+#include <QtEndian>
+
+// MythTV headers
+#include "mythlogging.h"
+#include "remotefile.h"
+#include "seekindex.h"
+
+#define LOC QString("SeekIndex(%1): ").arg(m_filename)
+
+static const QByteArray kSeekIndexMagic("MYTHSIDX");
+static constexpr uint32_t kSeekIndexVersion = 1;
+static constexpr qint64   kHeaderSize       = 16; // magic, version, type
+static constexpr qint64   kBlockHeaderSize  = 24; // count, bytes, frame, offset
+
+// Unsigned LEB128
+static void put_varint(QByteArray &buf, uint64_t val)
+{
+    while (val >= 0x80)
+    {
+        buf.append(static_cast<char>((val & 0x7f) | 0x80));
+        val >>= 7;
+    }
+    buf.append(static_cast<char>(val));
+}
+
+static bool get_varint(const uint8_t *&ptr, const uint8_t *end, uint64_t &val)
+{
+    val = 0;
+    for (int shift = 0; ptr < end && shift < 64; shift += 7)
+    {
+        uint8_t byte = *ptr++;
+        val |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+// Offsets are normally increasing but are not guaranteed to be, so they
+// are stored zigzag encoded.
+static uint64_t zigzag(int64_t val)
+{
+    return (static_cast<uint64_t>(val) << 1) ^ static_cast<uint64_t>(val >> 63);
+}
+
+static int64_t unzigzag(uint64_t val)
+{
+    return static_cast<int64_t>(val >> 1) ^ -static_cast<int64_t>(val & 1);
+}
+
+/// \brief Returns the name of the sidecar index file for a recording.
+///
+/// The duration map has its own file, any other type uses the seek index.
+QString SeekIndexFile::IndexFilename(const QString &recording, MarkTypes type)
+{
+    if (type == MARK_DURATION_MS)
+        return recording + ".dur.sidx";
+    return recording + ".sidx";
+}
+
+/**
+ *  \brief Returns true if the sidecar index for a recording can be trusted.
+ *
+ *  The recorder updates the index every few seconds while recording, so an
+ *  index noticeably older than the recording was left behind by an earlier
+ *  recording or a transcode.  This only catches changes to the recording;
+ *  a seek table rebuilt without touching the recording is handled by
+ *  ProgramInfo, which deletes the index whenever the seek table is cleared
+ *  or rewritten.
+ */
+bool SeekIndexFile::IsUpToDate(const QString &recording, MarkTypes type)
+{
+    static constexpr int kMaxLagSecs = 60;
+
+    QString index = IndexFilename(recording, type);
+    QDateTime indexTime;
+    QDateTime recTime;
+
+    if (recording.startsWith("myth://"))
+    {
+        if (!RemoteFile::Exists(index))
+            return false;
+        indexTime = RemoteFile::LastModified(index);
+        recTime   = RemoteFile::LastModified(recording);
+    }
+    else
+    {
+        QFileInfo indexInfo(index);
+        if (!indexInfo.exists())
+            return false;
+        indexTime = indexInfo.lastModified();
+        recTime   = QFileInfo(recording).lastModified();
+    }
+
+    return indexTime.isValid() && recTime.isValid() &&
+        indexTime.addSecs(kMaxLagSecs) >= recTime;
+}
+
+bool SeekIndexFile::Remove(const QString &recording)
+{
+    bool ok = true;
+    for (MarkTypes type : { MARK_UNSET, MARK_DURATION_MS })
+    {
+        QString index = IndexFilename(recording, type);
+        if (index.startsWith("myth://"))
+            ok &= !RemoteFile::Exists(index) || RemoteFile::DeleteFile(index);
+        else
+            ok &= !QFile::exists(index) || QFile::remove(index);
+    }
+    return ok;
+}
+
+/// \brief Creates (or truncates) an index file for entries of \p type.
+bool SeekIndexFile::Create(const QString &filename, MarkTypes type)
+{
+    Close();
+
+    m_filename = filename;
+    m_file.setFileName(filename);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "Unable to create index file: " +
+            m_file.errorString());
+        return false;
+    }
+
+    QByteArray header(kSeekIndexMagic);
+    header.resize(kHeaderSize);
+    qToLittleEndian<quint32>(kSeekIndexVersion, header.data() + 8);
+    qToLittleEndian<qint32>(type, header.data() + 12);
+    if (m_file.write(header) != kHeaderSize)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "Unable to write index header: " +
+            m_file.errorString());
+        Close();
+        return false;
+    }
+    m_file.flush();
+
+    m_writing = true;
+    m_type    = type;
+    return true;
+}
+
+/**
+ *  \brief Opens an index for writing, keeping the entries already in it.
+ *
+ *  Used when a recorder restarts on the same file, so the index written
+ *  before the restart isn't lost.  A block left partly written is dropped.
+ *  A missing or unreadable file, or one holding another type, is created
+ *  afresh.
+ */
+bool SeekIndexFile::OpenForAppend(const QString &filename, MarkTypes type)
+{
+    if (!QFile::exists(filename) || !Open(filename) || m_type != type)
+        return Create(filename, type);
+
+    qint64   end        = kHeaderSize;
+    if (!m_blocks.empty())
+        end = m_blocks.back().m_deltaPos + m_blocks.back().m_deltaBytes;
+    uint64_t entries    = m_entries;
+    uint64_t lastFrame  = m_lastFrame;
+    uint64_t lastOffset = m_lastOffset;
+    Close();
+
+    m_filename = filename;
+    m_file.setFileName(filename);
+    if (!m_file.open(QIODevice::ReadWrite) || !m_file.resize(end) ||
+        !m_file.seek(end))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "Unable to reopen index file: " +
+            m_file.errorString());
+        Close();
+        return false;
+    }
+
+    m_writing    = true;
+    m_type       = type;
+    m_entries    = entries;
+    m_lastFrame  = lastFrame;
+    m_lastOffset = lastOffset;
+
+    LOG(VB_RECORD, LOG_INFO, LOC +
+        QString("Appending to index, %1 entries kept").arg(m_entries));
+    return true;
+}
+
+/**
+ *  \brief Appends the entries of \p posMap past the last frame written.
+ *
+ *  Each call writes whole blocks, so a concurrent reader always sees a
+ *  consistent index up to the last completed call.
+ */
+bool SeekIndexFile::Append(const frm_pos_map_t &posMap)
+{
+    if (!m_writing)
+        return false;
+
+    // ProgramInfo deletes the index whenever the seek table is cleared or
+    // rewritten, start over rather than appending to an unlinked file.
+    if (!QFile::exists(m_filename))
+    {
+        QString   filename = m_filename;
+        MarkTypes type     = m_type;
+        if (!Create(filename, type))
+            return false;
+    }
+
+    auto it = posMap.cbegin();
+    if (m_entries)
+        it = posMap.upperBound(static_cast<long long>(m_lastFrame));
+
+    QByteArray buf;
+    while (it != posMap.cend())
+    {
+        auto firstFrame  = static_cast<uint64_t>(it.key());
+        auto firstOffset = static_cast<uint64_t>(*it);
+        uint64_t frame   = firstFrame;
+        uint64_t offset  = firstOffset;
+        uint32_t count   = 1;
+
+        QByteArray deltas;
+        for (++it; it != posMap.cend() && count < kMaxBlockEntries;
+             ++it, ++count)
+        {
+            put_varint(deltas, static_cast<uint64_t>(it.key()) - frame);
+            put_varint(deltas, zigzag(static_cast<int64_t>(*it) -
+                                      static_cast<int64_t>(offset)));
+            frame  = it.key();
+            offset = *it;
+        }
+
+        QByteArray header(kBlockHeaderSize, '\0');
+        qToLittleEndian<quint32>(count, header.data());
+        qToLittleEndian<quint32>(deltas.size(), header.data() + 4);
+        qToLittleEndian<quint64>(firstFrame, header.data() + 8);
+        qToLittleEndian<quint64>(firstOffset, header.data() + 16);
+        buf.append(header);
+        buf.append(deltas);
+
+        m_entries   += count;
+        m_lastFrame  = frame;
+        m_lastOffset = offset;
+    }
+
+    if (buf.isEmpty())
+        return true;
+
+    if (m_file.write(buf) != buf.size())
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "Failed to append to index: " +
+            m_file.errorString());
+        return false;
+    }
+    m_file.flush();
+
+    return true;
+}
+
+/// \brief Opens an existing index file, or myth:// URL, for reading.
+bool SeekIndexFile::Open(const QString &filename)
+{
+    Close();
+
+    m_filename = filename;
+
+    if (filename.startsWith("myth://"))
+    {
+        RemoteFile rf(filename, false, false, 0);
+        if (!rf.isOpen() || !rf.SaveAs(m_remoteData))
+            return false;
+        m_data = reinterpret_cast<const uint8_t*>(m_remoteData.constData());
+        m_size = m_remoteData.size();
+    }
+    else
+    {
+        m_file.setFileName(filename);
+        if (!m_file.open(QIODevice::ReadOnly) || !MapData())
+        {
+            Close();
+            return false;
+        }
+    }
+
+    if (!ParseHeader())
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "Not a valid seek index file");
+        Close();
+        return false;
+    }
+
+    ParseBlocks();
+
+    LOG(VB_PLAYBACK, LOG_INFO, LOC +
+        QString("Opened, %1 entries in %2 blocks, type %3")
+            .arg(m_entries).arg(m_blocks.size()).arg(m_type));
+
+    return true;
+}
+
+/// \brief Picks up blocks appended since the index was opened.
+bool SeekIndexFile::Refresh(void)
+{
+    if (m_writing || !m_file.isOpen())
+        return false;
+
+    if (m_file.size() == m_size)
+        return true;
+
+    if (m_data)
+        m_file.unmap(const_cast<uchar*>(m_data));
+    m_data = nullptr;
+    if (!MapData())
+        return false;
+
+    ParseBlocks();
+    return true;
+}
+
+bool SeekIndexFile::MapData(void)
+{
+    m_size = m_file.size();
+    if (m_size < kHeaderSize)
+        return false;
+    m_data = m_file.map(0, m_size);
+    return m_data != nullptr;
+}
+
+bool SeekIndexFile::ParseHeader(void)
+{
+    if (m_size < kHeaderSize ||
+        QByteArray::fromRawData(reinterpret_cast<const char*>(m_data), 8) !=
+        kSeekIndexMagic)
+    {
+        return false;
+    }
+
+    if (qFromLittleEndian<quint32>(m_data + 8) != kSeekIndexVersion)
+        return false;
+
+    m_type   = static_cast<MarkTypes>(qFromLittleEndian<qint32>(m_data + 12));
+    m_parsed = kHeaderSize;
+    return true;
+}
+
+void SeekIndexFile::ParseBlocks(void)
+{
+    while (m_parsed + kBlockHeaderSize <= m_size)
+    {
+        const uint8_t *ptr = m_data + m_parsed;
+        Block block;
+        block.m_count       = qFromLittleEndian<quint32>(ptr);
+        block.m_deltaBytes  = qFromLittleEndian<quint32>(ptr + 4);
+        block.m_firstFrame  = qFromLittleEndian<quint64>(ptr + 8);
+        block.m_firstOffset = qFromLittleEndian<quint64>(ptr + 16);
+        block.m_deltaPos    = m_parsed + kBlockHeaderSize;
+
+        if (block.m_deltaPos + block.m_deltaBytes > m_size)
+            break; // partially written block
+
+        if (block.m_count == 0 || block.m_count > kMaxBlockEntries ||
+            (!m_blocks.empty() && block.m_firstFrame <= m_lastFrame))
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                QString("Corrupt block at %1, ignoring the rest of the index")
+                    .arg(m_parsed));
+            m_parsed = m_size;
+            break;
+        }
+
+        frm_pos_vec_t entries;
+        DecodeBlock(block, entries);
+        m_lastFrame  = entries.back().first;
+        m_lastOffset = entries.back().second;
+        m_entries   += entries.size();
+
+        m_blocks.push_back(block);
+        m_parsed = block.m_deltaPos + block.m_deltaBytes;
+    }
+}
+
+void SeekIndexFile::DecodeBlock(const Block &block, frm_pos_vec_t &posVec) const
+{
+    const uint8_t *ptr = m_data + block.m_deltaPos;
+    const uint8_t *end = ptr + block.m_deltaBytes;
+
+    uint64_t frame  = block.m_firstFrame;
+    uint64_t offset = block.m_firstOffset;
+    posVec.emplace_back(frame, offset);
+
+    for (uint32_t i = 1; i < block.m_count; ++i)
+    {
+        uint64_t fdelta = 0;
+        uint64_t odelta = 0;
+        if (!get_varint(ptr, end, fdelta) || !get_varint(ptr, end, odelta))
+            break;
+        frame  += fdelta;
+        offset += unzigzag(odelta);
+        posVec.emplace_back(frame, offset);
+    }
+}
+
+/**
+ *  \brief Finds the last entry at or before \p frame.
+ *  \return false if the index is empty or \p frame precedes the first entry.
+ */
+bool SeekIndexFile::Find(uint64_t frame,
+                         uint64_t &keyframe, uint64_t &offset) const
+{
+    auto it = std::upper_bound(m_blocks.cbegin(), m_blocks.cend(), frame,
+        [](uint64_t f, const Block &b) { return f < b.m_firstFrame; });
+    if (it == m_blocks.cbegin())
+        return false;
+    --it;
+
+    frm_pos_vec_t entries;
+    entries.reserve(it->m_count);
+    DecodeBlock(*it, entries);
+
+    auto entry = std::upper_bound(entries.cbegin(), entries.cend(), frame,
+        [](uint64_t f, const frm_pos_vec_t::value_type &e)
+        { return f < e.first; });
+    --entry; // the block's first entry is <= frame
+
+    keyframe = entry->first;
+    offset   = entry->second;
+    return true;
+}
+
+/**
+ *  \brief Finds the first entry at or after \p frame.
+ *  \return false if the index is empty or \p frame follows the last entry.
+ */
+bool SeekIndexFile::FindNext(uint64_t frame,
+                             uint64_t &keyframe, uint64_t &offset) const
+{
+    if (m_blocks.empty() || frame > m_lastFrame)
+        return false;
+
+    auto it = std::upper_bound(m_blocks.cbegin(), m_blocks.cend(), frame,
+        [](uint64_t f, const Block &b) { return f < b.m_firstFrame; });
+    if (it != m_blocks.cbegin())
+        --it;
+
+    // The wanted entry is in this block, or is the first of the next one
+    frm_pos_vec_t entries;
+    entries.reserve(it->m_count + 1);
+    DecodeBlock(*it, entries);
+    if (++it != m_blocks.cend())
+        entries.emplace_back(it->m_firstFrame, it->m_firstOffset);
+
+    auto entry = std::lower_bound(entries.cbegin(), entries.cend(), frame,
+        [](const frm_pos_vec_t::value_type &e, uint64_t f)
+        { return e.first < f; });
+    if (entry == entries.cend())
+        return false;
+
+    keyframe = entry->first;
+    offset   = entry->second;
+    return true;
+}
+
+void SeekIndexFile::ReadAll(frm_pos_vec_t &posVec) const
+{
+    posVec.clear();
+    posVec.reserve(m_entries);
+    for (const auto &block : m_blocks)
+        DecodeBlock(block, posVec);
+}
+
+/**
+ *  \brief Returns the first entry of every block, and the last entry.
+ *
+ *  This is a sparse copy of the index, one entry in kMaxBlockEntries, for
+ *  callers that look the rest up with Find() and FindNext() when needed.
+ */
+void SeekIndexFile::ReadBlockStarts(frm_pos_vec_t &posVec) const
+{
+    posVec.clear();
+    posVec.reserve(m_blocks.size() + 1);
+    for (const auto &block : m_blocks)
+        posVec.emplace_back(block.m_firstFrame, block.m_firstOffset);
+    if (!posVec.empty() && posVec.back().first != m_lastFrame)
+        posVec.emplace_back(m_lastFrame, m_lastOffset);
+}
+
+void SeekIndexFile::Close(void)
+{
+    if (m_data && m_file.isOpen() && m_remoteData.isEmpty())
+        m_file.unmap(const_cast<uchar*>(m_data));
+    if (m_file.isOpen())
+        m_file.close();
+
+    m_remoteData.clear();
+    m_data       = nullptr;
+    m_size       = 0;
+    m_parsed     = 0;
+    m_writing    = false;
+    m_type       = MARK_UNSET;
+    m_entries    = 0;
+    m_lastFrame  = 0;
+    m_lastOffset = 0;
+    m_blocks.clear();
+}
@@ -0,0 +1,104 @@
+#ifndef SEEK_INDEX_H
+#define SEEK_INDEX_H
+
+// C++ headers
+#include <cstdint>
+#include <vector>
+
+// Qt headers
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+// MythTV headers
+#include "mythtvexp.h"
+#include "programtypes.h"
+
+/** \class SeekIndexFile
+ *  \brief Compact keyframe index stored in a sidecar file next to a recording.
+ *
+ *  The file holds the same keyframe -> byte offset pairs as the recordedseek
+ *  table, for a single MarkTypes value.  After a small header it is a
+ *  sequence of self contained blocks of at most kMaxBlockEntries entries.
+ *  Each block stores its first entry verbatim and the rest as variable
+ *  length deltas, so an entry costs a few bytes instead of a DB row.
+ *
+ *  Blocks are only ever appended, which lets a recorder extend the index
+ *  while the recording is being played.  A reader ignores a truncated final
+ *  block, and Find() does a binary search over the block headers followed
+ *  by a short linear decode of one block.
+ *
+ *  Local files are memory mapped.  myth:// URLs are read through RemoteFile
+ *  so remote frontends can use the index without querying the database.
+ *
+ *  The duration map (MARK_DURATION_MS) is kept in a second index file, see
+ *  IndexFilename().
+ *
+ *  The index is a cache of the DB table, not a replacement for it.
+ *  ProgramInfo::ClearPositionMap() and SavePositionMap() delete it, and a
+ *  recorder still appending to it starts a new one on its next Append().
+ */
+class MTV_PUBLIC SeekIndexFile
+{
+  public:
+    SeekIndexFile() = default;
+   ~SeekIndexFile() { Close(); }
+
+    static QString IndexFilename(const QString &recording,
+                                 MarkTypes type = MARK_UNSET);
+    static bool IsUpToDate(const QString &recording,
+                           MarkTypes type = MARK_UNSET);
+    static bool Remove(const QString &recording);
+
+    // Writing
+    bool Create(const QString &filename, MarkTypes type);
+    bool OpenForAppend(const QString &filename, MarkTypes type);
+    bool Append(const frm_pos_map_t &posMap);
+
+    // Reading
+    bool Open(const QString &filename);
+    bool Refresh(void);
+    bool Find(uint64_t frame, uint64_t &keyframe, uint64_t &offset) const;
+    bool FindNext(uint64_t frame, uint64_t &keyframe, uint64_t &offset) const;
+    void ReadAll(frm_pos_vec_t &posVec) const;
+    void ReadBlockStarts(frm_pos_vec_t &posVec) const;
+
+    void Close(void);
+
+    bool      IsOpen(void)        const { return m_file.isOpen() || m_data; }
+    MarkTypes GetMarkType(void)   const { return m_type; }
+    uint64_t  GetEntryCount(void) const { return m_entries; }
+    uint64_t  GetLastFrame(void)  const { return m_lastFrame; }
+
+    static constexpr int kMaxBlockEntries = 256;
+
+  private:
+    struct Block
+    {
+        uint64_t m_firstFrame  {0};
+        uint64_t m_firstOffset {0};
+        uint32_t m_count       {0};
+        qint64   m_deltaPos    {0}; // file position of the encoded deltas
+        uint32_t m_deltaBytes  {0};
+    };
+
+    bool MapData(void);
+    bool ParseHeader(void);
+    void ParseBlocks(void);
+    void DecodeBlock(const Block &block, frm_pos_vec_t &posVec) const;
+
+    QFile              m_file;
+    QString            m_filename;
+    QByteArray         m_remoteData;   // whole file when read over myth://
+    const uint8_t     *m_data       {nullptr};
+    qint64             m_size       {0};
+    qint64             m_parsed     {0}; // bytes covered by m_blocks
+    bool               m_writing    {false};
+    MarkTypes          m_type       {MARK_UNSET};
+    uint64_t           m_entries    {0};
+    uint64_t           m_lastFrame  {0};
+    uint64_t           m_lastOffset {0};
+    std::vector<Block> m_blocks;
+};
+
+#endif // SEEK_INDEX_H
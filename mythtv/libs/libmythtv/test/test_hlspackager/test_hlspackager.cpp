@@ -0,0 +1,183 @@
+/*
+ *  Class TestHLSPackager
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+#include "test_hlspackager.h"
+
+// 25fps with a keyframe every 12 frames, ~100kB apart
+static frm_pos_vec_t make_keyframes(int count)
+{
+    frm_pos_vec_t keyframes;
+    for (int i = 0; i < count; i++)
+        keyframes.emplace_back(i * 12, (i * 100000ULL) + 1000);
+    return keyframes;
+}
+
+// A TS packet with a section starting right after the header
+static QByteArray make_packet(uint pid, const QByteArray &section)
+{
+    QByteArray pkt(188, '\xff');
+    pkt[0] = 0x47;
+    pkt[1] = static_cast<char>(0x40 | ((pid >> 8) & 0x1f));
+    pkt[2] = static_cast<char>(pid & 0xff);
+    pkt[3] = 0x10;
+    pkt[4] = 0x00; // pointer_field
+    pkt.replace(5, section.size(), section);
+    return pkt;
+}
+
+static QByteArray make_pat(uint pmtPid)
+{
+    // table_id, section_length 13, tsid, version, section numbers,
+    // program 1 -> pmtPid, CRC (not checked)
+    return QByteArray::fromHex("00b00d0001c10000") +
+        QByteArray::fromHex("0001") +
+        QByteArray(1, static_cast<char>(0xe0 | ((pmtPid >> 8) & 0x1f))) +
+        QByteArray(1, static_cast<char>(pmtPid & 0xff)) +
+        QByteArray::fromHex("00000000");
+}
+
+void TestHLSPackager::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+}
+
+void TestHLSPackager::test_cut_segments(void)
+{
+    frm_pos_vec_t keyframes = make_keyframes(100);
+    uint64_t fileSize = (100 * 100000ULL) + 5000;
+
+    auto segments = HLSPackager::CutSegments(keyframes, {}, 25.0, 1200,
+                                             fileSize, true);
+
+    // A cut every 13 keyframes (6.24s), plus the tail
+    QCOMPARE(segments.size(), (size_t)8);
+    QCOMPARE(segments.front().m_start, (uint64_t)0);
+    for (size_t i = 0; i < segments.size(); ++i)
+    {
+        QCOMPARE(segments[i].m_start % 188, (uint64_t)0);
+        QCOMPARE(segments[i].m_end % 188, (uint64_t)0);
+        QVERIFY(segments[i].m_end > segments[i].m_start);
+        if (i > 0)
+            QCOMPARE(segments[i].m_start, segments[i - 1].m_end);
+        if (i + 1 < segments.size())
+            QCOMPARE(segments[i].m_duration, 13 * 12 / 25.0);
+    }
+    QCOMPARE(segments.back().m_end, fileSize - (fileSize % 188));
+    QCOMPARE(segments.back().m_duration, (1200 - (7 * 13 * 12)) / 25.0);
+}
+
+void TestHLSPackager::test_cut_in_progress(void)
+{
+    frm_pos_vec_t keyframes = make_keyframes(100);
+
+    // Without the tail, which is still being recorded
+    auto segments = HLSPackager::CutSegments(keyframes, {}, 25.0, 0,
+                                             100 * 100000ULL, false);
+    QCOMPARE(segments.size(), (size_t)7);
+
+    QVERIFY(HLSPackager::CutSegments({}, {}, 25.0, 0, 1000, true).empty());
+}
+
+void TestHLSPackager::test_cut_durations(void)
+{
+    frm_pos_vec_t keyframes = make_keyframes(100);
+
+    // Frame 600 is 40s in, e.g. after a gap in the stream
+    frm_pos_vec_t durations { { 0, 0 }, { 600, 40000 } };
+    auto segments = HLSPackager::CutSegments(keyframes, durations, 25.0, 0,
+                                             100 * 100000ULL, false);
+
+    bool found = false;
+    for (const auto &segment : segments)
+    {
+        QVERIFY(segment.m_duration >= HLSPackager::kTargetDurationSecs);
+        found |= segment.m_duration > 20.0;
+    }
+    QVERIFY(found);
+}
+
+void TestHLSPackager::test_read_psi(void)
+{
+    QString name = m_dir.filePath("psi.ts");
+    QByteArray pat = make_packet(0, make_pat(0x100));
+    QByteArray pmt = make_packet(0x100, QByteArray::fromHex("02b0120001c10000e101f000"));
+    QByteArray other = make_packet(0x101, QByteArray());
+    other[1] = 0x01; // no payload_unit_start_indicator
+
+    QFile file(name);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(QByteArray(5, '\0')); // not packet aligned
+    file.write(other);
+    file.write(pat);
+    file.write(other);
+    file.write(pmt);
+    file.write(other);
+    file.close();
+
+    QByteArray psi;
+    QVERIFY(HLSPackager::ReadPSI(name, psi));
+    QCOMPARE(psi, pat + pmt);
+}
+
+void TestHLSPackager::test_read_psi_missing(void)
+{
+    QString name = m_dir.filePath("nopsi.ts");
+    QByteArray other = make_packet(0x101, QByteArray());
+
+    QFile file(name);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    for (int i = 0; i < 10; i++)
+        file.write(other);
+    file.close();
+
+    QByteArray psi;
+    QVERIFY(!HLSPackager::ReadPSI(name, psi));
+    QVERIFY(!HLSPackager::ReadPSI(m_dir.filePath("missing.ts"), psi));
+}
+
+void TestHLSPackager::test_read_psi_truncated(void)
+{
+    QString name = m_dir.filePath("truncated.ts");
+
+    // A PAT starting in the last byte of the packet, and one whose
+    // section_length runs past the end of the packet
+    QByteArray last(188, '\xff');
+    last[0]   = 0x47;
+    last[1]   = 0x40;
+    last[2]   = 0x00;
+    last[3]   = 0x30;                   // adaptation field and payload
+    last[4]   = static_cast<char>(181); // adaptation field up to byte 185
+    last[186] = 0x00;                   // pointer_field
+    last[187] = 0x00;                   // table_id
+    QByteArray pat = make_packet(0, make_pat(0x100));
+    pat[6] = static_cast<char>(0xb3); // section_length 0x3ff
+    pat[7] = static_cast<char>(0xff);
+    QByteArray pmt = make_packet(0x100, QByteArray::fromHex("02b0120001c10000e101f000"));
+
+    QFile file(name);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(pat);
+    file.write(pmt);
+    file.write(last);
+    file.write(last);
+    file.close();
+
+    QByteArray psi;
+    QVERIFY(!HLSPackager::ReadPSI(name, psi));
+}
+
+QTEST_APPLESS_MAIN(TestHLSPackager)
@@ -0,0 +1,261 @@
+/*
+ *  Class TestSeekIndex
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+#include "test_seekindex.h"
+
+// A keyframe every 12 frames, ~400kB apart, with the odd backwards jump
+static frm_pos_map_t make_map(long long first, int count)
+{
+    frm_pos_map_t map;
+    for (int i = 0; i < count; i++)
+    {
+        long long frame = first + (i * 12LL);
+        long long offset = (frame * 33000) + ((i % 7 == 3) ? -5000 : 1234);
+        map[frame] = offset;
+    }
+    return map;
+}
+
+void TestSeekIndex::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+}
+
+void TestSeekIndex::test_roundtrip(void)
+{
+    QString name = m_dir.filePath("roundtrip.sidx");
+    frm_pos_map_t map = make_map(0, 1000);
+
+    SeekIndexFile writer;
+    QVERIFY(writer.Create(name, MARK_GOP_BYFRAME));
+    QVERIFY(writer.Append(map));
+    QCOMPARE(writer.GetEntryCount(), (uint64_t)1000);
+    writer.Close();
+
+    SeekIndexFile reader;
+    QVERIFY(reader.Open(name));
+    QCOMPARE(reader.GetMarkType(), MARK_GOP_BYFRAME);
+    QCOMPARE(reader.GetEntryCount(), (uint64_t)1000);
+    QCOMPARE(reader.GetLastFrame(), (uint64_t)(999 * 12));
+
+    frm_pos_vec_t vec;
+    reader.ReadAll(vec);
+    QCOMPARE((int)vec.size(), map.size());
+    auto it = map.cbegin();
+    for (const auto &entry : vec)
+    {
+        QCOMPARE((long long)entry.first, it.key());
+        QCOMPARE((long long)entry.second, *it);
+        ++it;
+    }
+
+    // The whole index is much smaller than one row per keyframe
+    QVERIFY(QFileInfo(name).size() < 1000 * 8);
+}
+
+void TestSeekIndex::test_append(void)
+{
+    QString name = m_dir.filePath("append.sidx");
+
+    SeekIndexFile writer;
+    QVERIFY(writer.Create(name, MARK_GOP_START));
+    QVERIFY(writer.Append(make_map(0, 10)));
+
+    SeekIndexFile reader;
+    QVERIFY(reader.Open(name));
+    QCOMPARE(reader.GetEntryCount(), (uint64_t)10);
+
+    // Entries already written are skipped
+    QVERIFY(writer.Append(make_map(0, 20)));
+    QVERIFY(reader.Refresh());
+    QCOMPARE(reader.GetEntryCount(), (uint64_t)20);
+    QCOMPARE(reader.GetLastFrame(), (uint64_t)(19 * 12));
+}
+
+void TestSeekIndex::test_find(void)
+{
+    QString name = m_dir.filePath("find.sidx");
+    frm_pos_map_t map = make_map(100, 2000);
+
+    SeekIndexFile writer;
+    QVERIFY(writer.Create(name, MARK_GOP_BYFRAME));
+    QVERIFY(writer.Append(map));
+    writer.Close();
+
+    SeekIndexFile reader;
+    QVERIFY(reader.Open(name));
+
+    uint64_t keyframe = 0;
+    uint64_t offset = 0;
+    QVERIFY(!reader.Find(99, keyframe, offset));
+
+    for (long long frame : { 100LL, 101LL, 111LL, 112LL, 3171LL, 3172LL,
+                             3173LL, 24087LL, 1000000LL })
+    {
+        auto expected = map.upperBound(frame);
+        --expected;
+        QVERIFY(reader.Find(frame, keyframe, offset));
+        QCOMPARE((long long)keyframe, expected.key());
+        QCOMPARE((long long)offset, *expected);
+    }
+}
+
+void TestSeekIndex::test_findnext(void)
+{
+    QString name = m_dir.filePath("findnext.sidx");
+    frm_pos_map_t map = make_map(100, 2000);
+
+    SeekIndexFile writer;
+    QVERIFY(writer.Create(name, MARK_GOP_BYFRAME));
+    QVERIFY(writer.Append(map));
+    writer.Close();
+
+    SeekIndexFile reader;
+    QVERIFY(reader.Open(name));
+
+    uint64_t keyframe = 0;
+    uint64_t offset = 0;
+    QVERIFY(!reader.FindNext(100 + (1999 * 12) + 1, keyframe, offset));
+
+    // 3172 and 3173 straddle the first block boundary
+    for (long long frame : { 0LL, 100LL, 101LL, 111LL, 112LL, 3161LL,
+                             3171LL, 3172LL, 3173LL, 24087LL, 24088LL })
+    {
+        auto expected = map.lowerBound(frame);
+        QVERIFY(reader.FindNext(frame, keyframe, offset));
+        QCOMPARE((long long)keyframe, expected.key());
+        QCOMPARE((long long)offset, *expected);
+    }
+}
+
+void TestSeekIndex::test_blockstarts(void)
+{
+    QString name = m_dir.filePath("blockstarts.sidx");
+    frm_pos_map_t map = make_map(0, 1000);
+
+    SeekIndexFile writer;
+    QVERIFY(writer.Create(name, MARK_GOP_BYFRAME));
+    QVERIFY(writer.Append(map));
+    writer.Close();
+
+    SeekIndexFile reader;
+    QVERIFY(reader.Open(name));
+
+    // One entry per block, plus the last entry
+    frm_pos_vec_t vec;
+    reader.ReadBlockStarts(vec);
+    QCOMPARE((int)vec.size(), 5);
+    for (int i = 0; i < 4; i++)
+    {
+        long long frame = i * SeekIndexFile::kMaxBlockEntries * 12LL;
+        QCOMPARE((long long)vec[i].first, frame);
+        QCOMPARE((long long)vec[i].second, map[frame]);
+    }
+    QCOMPARE((long long)vec.back().first, 999 * 12LL);
+    QCOMPARE((long long)vec.back().second, map[999 * 12LL]);
+}
+
+void TestSeekIndex::test_deleted(void)
+{
+    QString name = m_dir.filePath("deleted.sidx");
+
+    SeekIndexFile writer;
+    QVERIFY(writer.Create(name, MARK_GOP_BYFRAME));
+    QVERIFY(writer.Append(make_map(0, 10)));
+
+    // The seek table was cleared, the writer starts a new index
+    QVERIFY(QFile::remove(name));
+    QVERIFY(writer.Append(make_map(600, 5)));
+    writer.Close();
+
+    SeekIndexFile reader;
+    QVERIFY(reader.Open(name));
+    QCOMPARE(reader.GetMarkType(), MARK_GOP_BYFRAME);
+    QCOMPARE(reader.GetEntryCount(), (uint64_t)5);
+    QCOMPARE(reader.GetLastFrame(), (uint64_t)(600 + (4 * 12)));
+}
+
+void TestSeekIndex::test_reopen(void)
+{
+    QString name = m_dir.filePath("reopen.sidx");
+
+    SeekIndexFile writer;
+    QVERIFY(writer.OpenForAppend(name, MARK_GOP_BYFRAME));
+    QVERIFY(writer.Append(make_map(0, 300)));
+    writer.Close();
+
+    // A restarted recorder keeps the entries, minus a partly written block
+    QFile file(name);
+    QVERIFY(file.resize(file.size() - 10));
+    QVERIFY(writer.OpenForAppend(name, MARK_GOP_BYFRAME));
+    QCOMPARE(writer.GetEntryCount(), (uint64_t)SeekIndexFile::kMaxBlockEntries);
+    QVERIFY(writer.Append(make_map(0, 400)));
+    writer.Close();
+
+    SeekIndexFile reader;
+    QVERIFY(reader.Open(name));
+    QCOMPARE(reader.GetEntryCount(), (uint64_t)400);
+    frm_pos_vec_t vec;
+    reader.ReadAll(vec);
+    frm_pos_map_t map = make_map(0, 400);
+    auto it = map.cbegin();
+    for (const auto &entry : vec)
+    {
+        QCOMPARE((long long)entry.first, it.key());
+        QCOMPARE((long long)entry.second, *it);
+        ++it;
+    }
+    reader.Close();
+
+    // An index of another type is replaced
+    QVERIFY(writer.OpenForAppend(name, MARK_DURATION_MS));
+    QCOMPARE(writer.GetEntryCount(), (uint64_t)0);
+}
+
+void TestSeekIndex::test_truncated(void)
+{
+    QString name = m_dir.filePath("truncated.sidx");
+
+    SeekIndexFile writer;
+    QVERIFY(writer.Create(name, MARK_GOP_BYFRAME));
+    QVERIFY(writer.Append(make_map(0, SeekIndexFile::kMaxBlockEntries)));
+    QVERIFY(writer.Append(make_map(SeekIndexFile::kMaxBlockEntries * 12, 50)));
+    writer.Close();
+
+    // Simulate a reader racing the writer's second block
+    QFile file(name);
+    QVERIFY(file.resize(file.size() - 10));
+
+    SeekIndexFile reader;
+    QVERIFY(reader.Open(name));
+    QCOMPARE(reader.GetEntryCount(), (uint64_t)SeekIndexFile::kMaxBlockEntries);
+}
+
+void TestSeekIndex::test_badfile(void)
+{
+    QString name = m_dir.filePath("bad.sidx");
+    QFile file(name);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("this is not a seek index");
+    file.close();
+
+    SeekIndexFile reader;
+    QVERIFY(!reader.Open(name));
+    QVERIFY(!reader.Open(m_dir.filePath("missing.sidx")));
+}
+
+QTEST_APPLESS_MAIN(TestSeekIndex)
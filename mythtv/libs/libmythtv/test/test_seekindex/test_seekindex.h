@@ -0,0 +1,42 @@
+/*
+ *  Class TestSeekIndex
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+
+#include "seekindex.h"
+
+class TestSeekIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void test_roundtrip(void);
+    void test_append(void);
+    void test_find(void);
+    void test_findnext(void);
+    void test_blockstarts(void);
+    void test_deleted(void);
+    void test_reopen(void);
+    void test_truncated(void);
+    void test_badfile(void);
+
+private:
+    QTemporaryDir m_dir;
+};
@@ -1,4 +1,5 @@
 // C headers
+#include <algorithm>
 #include <chrono> // for milliseconds
 #include <cstdio>
 #include <cstdlib>
@@ -52,6 +53,18 @@ const uint TVRec::kSignalMonitoringRate = 50; /* msec */
 QReadWriteLock    TVRec::s_inputsLock;
 QMap<uint,TVRec*> TVRec::s_inputs;
 
+QMutex                   TVRec::s_sdtSeenLock;
+QHash<quint64,QDateTime> TVRec::s_sdtSeen;
+
+/// How long a service found in an SDT is trusted to still be there
+static const int kSDTSeenSecs = 15 * 60;
+
+static quint64 dvb_service_key(uint netid, uint tsid, uint serviceid)
+{
+    return (static_cast<quint64>(netid) << 32) |
+           (static_cast<quint64>(tsid) << 16) | serviceid;
+}
+
 static bool is_dishnet_eit(uint inputid);
 static int init_jobs(const RecordingInfo *rec, RecordingProfile &profile,
                      bool on_host, bool transcode_bfr_comm, bool on_line_comm);
@@ -157,6 +170,7 @@ bool TVRec::Init(void)
     m_eitTransportTimeout =
         max(gCoreContext->GetNumSetting("EITTransportTimeout", 5) * 60, 6);
     m_eitCrawlIdleStart = gCoreContext->GetNumSetting("EITCrawIdleStart", 60);
+    m_liveTVPreTune     = gCoreContext->GetBoolSetting("LiveTVPreTune", false);
     m_audioSampleRateDB = gCoreContext->GetNumSetting("AudioSampleRate");
     m_overRecordSecNrml = gCoreContext->GetNumSetting("RecordOverTime");
     m_overRecordSecCat  = gCoreContext->GetNumSetting("CategoryOverTime") * 60;
@@ -1057,6 +1071,15 @@ void TVRec::HandleStateChange(void)
         SET_NEXT();
     }
 
+    // The inputs tuned ahead of Live TV here are free again. As in run(),
+    // the inputs lock isn't waited for, the pre-tunings then just time out.
+    if (changed && (m_internalState == kState_WatchingLiveTV) &&
+        !m_preTunedInputs.empty() && s_inputsLock.tryLockForRead())
+    {
+        CancelPreTunes();
+        s_inputsLock.unlock();
+    }
+
     QString msg = (changed) ? "Changing from" : "Unknown state transition:";
     LOG(VB_GENERAL, LOG_INFO, LOC + msg + transMsg);
 
@@ -1940,9 +1963,29 @@ bool TVRec::SetupDTVSignalMonitor(bool EITscan)
         sm->SetDVBService(netid, tsid, progNum);
         sd->SetRecordingType(recording_type);
 
-        sm->AddFlags(SignalMonitor::kDTVSigMon_WaitForPMT |
-                     SignalMonitor::kDTVSigMon_WaitForSDT |
-                     SignalMonitor::kDVBSigMon_WaitForPos);
+        // The SDT only confirms the service is on this transport, which
+        // we already know if it was found there recently
+        bool sdt_seen = false;
+        if (!EITscan)
+        {
+            QMutexLocker locker(&s_sdtSeenLock);
+            QDateTime seen = s_sdtSeen.value(dvb_service_key(netid, tsid, progNum));
+            sdt_seen = seen.isValid() &&
+                (seen.secsTo(MythDate::current()) < kSDTSeenSecs);
+        }
+
+        uint64_t flags = SignalMonitor::kDTVSigMon_WaitForPMT |
+                         SignalMonitor::kDVBSigMon_WaitForPos;
+        if (sdt_seen)
+        {
+            LOG(VB_RECORD, LOG_INFO, LOC +
+                "Service found in an SDT recently, not waiting for the SDT");
+        }
+        else
+        {
+            flags |= SignalMonitor::kDTVSigMon_WaitForSDT;
+        }
+        sm->AddFlags(flags);
         sm->SetRotorTarget(1.0F);
 
         if (EITscan)
@@ -3160,6 +3203,69 @@ bool TVRec::QueueEITChannelChange(const QString &name)
     return ok;
 }
 
+/** \brief Queues up a channel change on this idle input, ahead of Live TV
+ *         on another input changing to the channel.
+ *
+ *   Like QueueEITChannelChange() this does not block. The channel is tuned
+ *   as for an EIT scan, and active EIT scanning is held off for one
+ *   transport timeout or until CancelPreTune() is called.
+ *
+ *  \return true if the input is tuned, or being tuned, to the channel.
+ */
+bool TVRec::QueuePreTune(const QString &name)
+{
+    bool ok = false;
+    if (m_setChannelLock.tryLock())
+    {
+        if (m_stateChangeLock.tryLock())
+        {
+            if ((m_internalState == kState_None) && m_tuningRequests.empty() &&
+                !HasFlags(kFlagEITScannerRunning) && !IsBusy(nullptr, 60))
+            {
+                ok = true;
+                if (!(m_lastTuningRequest.m_flags & kFlagPreTune) ||
+                    (m_lastTuningRequest.m_channel != name))
+                {
+                    LOG(VB_CHANNEL, LOG_INFO, LOC +
+                        QString("QueuePreTune(%1)").arg(name));
+                    m_tuningRequests.enqueue(
+                        TuningRequest(kFlagEITScan | kFlagPreTune, name));
+                }
+                m_eitScanStartTime =
+                    MythDate::current().addSecs(m_eitTransportTimeout);
+            }
+            m_stateChangeLock.unlock();
+        }
+        m_setChannelLock.unlock();
+    }
+
+    return ok;
+}
+
+/** \brief Drops a pre-tuning done by QueuePreTune(), once Live TV on the
+ *         input that asked for it has ended or moved elsewhere.
+ *
+ *   The input stays tuned, but active EIT scanning is no longer held off
+ *   and a later QueuePreTune() to the same channel tunes it again.
+ */
+void TVRec::CancelPreTune(void)
+{
+    if (!m_stateChangeLock.tryLock())
+        return;
+
+    if ((m_internalState == kState_None) &&
+        (m_lastTuningRequest.m_flags & kFlagPreTune))
+    {
+        LOG(VB_CHANNEL, LOG_INFO, LOC + QString("CancelPreTune(%1)")
+            .arg(m_lastTuningRequest.m_channel));
+        m_lastTuningRequest.m_flags &= ~kFlagPreTune;
+        if (m_scanner)
+            m_eitScanStartTime = MythDate::current();
+    }
+
+    m_stateChangeLock.unlock();
+}
+
 void TVRec::GetNextProgram(BrowseDirection direction,
                            QString &title,       QString &subtitle,
                            QString &desc,        QString &category,
@@ -3507,6 +3613,9 @@ void TVRec::HandleTuning(void)
         request.m_channel = TuningGetChanNum(request, input);
         request.m_input   = input;
 
+        if ((request.m_flags & kFlagLiveTV) && m_channel)
+            m_liveTVPrevChanNum = m_channel->GetChannelName();
+
         if (TuningOnSameMultiplex(request))
             LOG(VB_CHANNEL, LOG_INFO, LOC + "On same multiplex");
 
@@ -3560,7 +3669,102 @@ void TVRec::HandleTuning(void)
         // If we got this far it is safe to set a new starting channel...
         if (m_channel)
             m_channel->StoreInputChannels();
+
+        if (m_lastTuningRequest.m_flags & kFlagLiveTV)
+            PreTuneLikelyChannels(m_liveTVPrevChanNum);
+    }
+}
+
+/** \brief Tunes idle inputs to the channels Live TV on this input is most
+ *         likely to change to next.
+ *
+ *   These are the previous channel and the channels either side of the
+ *   current one. Each is tuned on a free input that doesn't share a tuner
+ *   with this one. That warms up the SDT cache, so changing to it here
+ *   doesn't wait for the SDT, and leaves a locked tuner ready if Live TV
+ *   moves to that input.
+ *
+ *  \note s_inputsLock must be held for reading.
+ */
+void TVRec::PreTuneLikelyChannels(const QString &prevChanNum)
+{
+    if (!m_liveTVPreTune || !GetDTVChannel())
+        return;
+
+    uint    sourceid   = m_channel->GetSourceID();
+    QString curChanNum = m_channel->GetChannelName();
+
+    QStringList predicted;
+    if (!prevChanNum.isEmpty())
+        predicted << prevChanNum;
+    for (auto direction : { CHANNEL_DIRECTION_UP, CHANNEL_DIRECTION_DOWN })
+    {
+        uint chanid = m_channel->GetNextChannel(0, direction);
+        if (chanid)
+            predicted << ChannelUtil::GetChanNum(chanid);
+    }
+    predicted.removeDuplicates();
+
+    vector<uint> ourInputs = CardUtil::GetConflictingInputs(m_inputId);
+    ourInputs.push_back(m_inputId);
+    QList<uint> used;
+
+    for (const auto &channum : qAsConst(predicted))
+    {
+        // Nothing to gain for channels on the multiplex we're tuned to
+        if (channum.isEmpty() || (channum == curChanNum) ||
+            ChannelUtil::IsOnSameMultiplex(sourceid, channum, curChanNum))
+        {
+            continue;
+        }
+
+        for (auto *rec : qAsConst(s_inputs))
+        {
+            if (used.contains(rec->m_inputId) ||
+                (rec->GetSourceID() != sourceid) ||
+                (std::find(ourInputs.cbegin(), ourInputs.cend(),
+                           rec->m_inputId) != ourInputs.cend()))
+            {
+                continue;
+            }
+
+            // Don't retune a tuner that a busy input is sharing
+            bool shared_busy = false;
+            for (uint inputid : CardUtil::GetConflictingInputs(rec->m_inputId))
+            {
+                TVRec *other = s_inputs.value(inputid);
+                shared_busy |= (other && other->IsBusy());
+            }
+
+            if (!shared_busy && rec->QueuePreTune(channum))
+            {
+                LOG(VB_CHANNEL, LOG_INFO, LOC +
+                    QString("Pre-tuning input %1 to channel %2")
+                        .arg(rec->m_inputId).arg(channum));
+                used.push_back(rec->m_inputId);
+                break;
+            }
+        }
     }
+
+    CancelPreTunes(used);
+    m_preTunedInputs = used;
+}
+
+/** \brief Cancels the pre-tunings done for Live TV on this input, except
+ *         those on the inputs in \p keep.
+ *
+ *  \note s_inputsLock must be held for reading.
+ */
+void TVRec::CancelPreTunes(const QList<uint> &keep)
+{
+    for (uint inputid : qAsConst(m_preTunedInputs))
+    {
+        TVRec *rec = s_inputs.value(inputid);
+        if (rec && !keep.contains(inputid))
+            rec->CancelPreTune();
+    }
+    m_preTunedInputs.clear();
 }
 
 /** \fn TVRec::TuningShutdowns(const TuningRequest&)
@@ -3917,6 +4121,19 @@ MPEGStreamData *TVRec::TuningSignalCheck(void)
     if (m_signalMonitor->IsAllGood())
     {
         LOG(VB_RECORD, LOG_INFO, LOC + "TuningSignalCheck: Good signal");
+
+        // Remember the service was found in the SDT, so tuning it again
+        // soon doesn't need to wait for the SDT
+        DTVChannel *dtvchan = GetDTVChannel();
+        if (dtvchan && GetDTVSignalMonitor() &&
+            GetDTVSignalMonitor()->HasFlags(SignalMonitor::kDTVSigMon_SDTMatch))
+        {
+            QMutexLocker locker(&s_sdtSeenLock);
+            s_sdtSeen[dvb_service_key(dtvchan->GetOriginalNetworkID(),
+                                      dtvchan->GetTransportID(),
+                                      dtvchan->GetProgramNumber())] = current_time;
+        }
+
         if (m_curRecording && (current_time > m_startRecordingDeadline))
         {
             newRecStatus = RecStatus::Failing;
@@ -4487,6 +4704,8 @@ QString TVRec::FlagToString(uint f)
             msg += "NeedToStartRecorder,";
         if (kFlagKillRingBuffer & f)
             msg += "KillRingBuffer,";
+        if (kFlagPreTune & f)
+            msg += "PreTune,";
     }
     if ((kFlagAnyRunning & f) == kFlagAnyRunning)
         msg += "ANYRUNNING,";
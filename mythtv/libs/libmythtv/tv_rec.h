@@ -207,6 +207,8 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
         { SetChannel(QString("NextChannel %1").arg((int)dir)); }
     void SetChannel(const QString& name, uint requestType = kFlagDetect);
     bool QueueEITChannelChange(const QString &name);
+    bool QueuePreTune(const QString &name);
+    void CancelPreTune(void);
 
     int SetSignalMonitoringRate(int rate, int notifyFrontend = 1);
     int  GetPictureAttribute(PictureAttribute attr);
@@ -298,6 +300,8 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
     void TuningRestartRecorder(void);
     QString TuningGetChanNum(const TuningRequest &request, QString &input) const;
     bool TuningOnSameMultiplex(TuningRequest &request);
+    void PreTuneLikelyChannels(const QString &prevChanNum);
+    void CancelPreTunes(const QList<uint> &keep = QList<uint>());
 
     void HandleStateChange(void);
     void ChangeState(TVState nextState);
@@ -360,6 +364,9 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
     bool               m_runJobOnHostOnly         {false};
     int                m_eitCrawlIdleStart        {60};
     int                m_eitTransportTimeout      {5*60};
+    bool               m_liveTVPreTune            {false};
+    QString            m_liveTVPrevChanNum;
+    QList<uint>        m_preTunedInputs; ///< inputs tuned ahead of Live TV here
     int                m_audioSampleRateDB        {0};
     int                m_overRecordSecNrml        {0};
     int                m_overRecordSecCat         {0};
@@ -422,6 +429,10 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
     MythMediaBuffer   *m_buffer                   {nullptr};
     QString            m_rbFileExt                {"ts"};
 
+    // DVB services recently found in an SDT, shared by all inputs
+    static QMutex                   s_sdtSeenLock;
+    static QHash<quint64,QDateTime> s_sdtSeen;
+
   public:
     static QReadWriteLock    s_inputsLock;
     static QMap<uint,TVRec*> s_inputs;
@@ -456,6 +467,8 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
 
     static const uint kFlagNoRec                = 0x0000F000;
     static const uint kFlagKillRingBuffer       = 0x00010000;
+    /// tuned ahead of Live TV on another input changing to the channel
+    static const uint kFlagPreTune              = 0x00020000;
 
     // Waiting stuff
     static const uint kFlagWaitingForRecPause   = 0x00100000;
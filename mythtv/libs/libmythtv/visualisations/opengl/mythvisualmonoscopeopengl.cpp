@@ -75,6 +75,7 @@ void MythVisualMonoScopeOpenGL::Draw(const QRect& Area, MythPainter* /*Painter*/
     }
 
     // Common calls
+    render->FlushBatch();
     render->glEnableVertexAttribArray(0);
     QPointF center { m_area.left() + static_cast<qreal>(m_area.width()) / 2,
                      m_area.top() + static_cast<qreal>(m_area.height()) / 2 };
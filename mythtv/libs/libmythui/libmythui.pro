@@ -26,7 +26,7 @@ HEADERS  = mythmainwindowprivate.h mythmainwindow.h mythpainter.h mythimage.h my
 HEADERS += mythpainterwindow.h mythpainterwindowqt.h
 HEADERS += myththemebase.h
 HEADERS += mythpainter_qt.h mythuihelper.h
-HEADERS += mythpaintergpu.h
+HEADERS += mythpaintergpu.h mythatlaspacker.h mythbitmapbatch.h
 HEADERS += mythscreenstack.h mythgesture.h mythuitype.h mythscreentype.h
 HEADERS += mythuiimage.h mythuitext.h mythuistatetype.h  xmlparsebase.h
 HEADERS += mythuibutton.h myththemedmenu.h mythdialogbox.h
@@ -51,7 +51,7 @@ SOURCES += mythpainterwindow.cpp mythpainterwindowqt.cpp
 SOURCES += myththemebase.cpp
 SOURCES += mythrender.cpp
 SOURCES += mythpainter_qt.cpp xmlparsebase.cpp mythuihelper.cpp
-SOURCES += mythpaintergpu.cpp
+SOURCES += mythpaintergpu.cpp mythatlaspacker.cpp mythbitmapbatch.cpp
 SOURCES += mythscreenstack.cpp mythgesture.cpp mythuitype.cpp mythscreentype.cpp
 SOURCES += mythuiimage.cpp mythuitext.cpp mythuifilebrowser.cpp
 SOURCES += mythuistatetype.cpp mythfontproperties.cpp
@@ -255,3 +255,10 @@ use_hidesyms {
 include ( ../libs-targetfix.pro )
 
 LIBS += $$EXTRA_LIBS $$LATE_LIBS
+
+test_clean.commands = -cd test/ && $(MAKE) -f Makefile clean
+clean.depends = test_clean
+QMAKE_EXTRA_TARGETS += test_clean clean
+test_distclean.commands = -cd test/ && $(MAKE) -f Makefile distclean
+distclean.depends = test_distclean
+QMAKE_EXTRA_TARGETS += test_distclean distclean
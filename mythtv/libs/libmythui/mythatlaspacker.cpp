@@ -0,0 +1,51 @@
+// MythTV
+#include "mythatlaspacker.h"
+
+MythAtlasPacker::MythAtlasPacker(QSize Size)
+  : m_size(Size)
+{
+}
+
+/*! \brief Reserve an area of the given size.
+ *
+ * \return The area reserved or an invalid rectangle if the page is full.
+*/
+QRect MythAtlasPacker::Add(QSize Size)
+{
+    if (Size.isEmpty() || Size.width() > m_size.width() || Size.height() > m_size.height())
+        return {};
+
+    Shelf *best = nullptr;
+    for (auto & shelf : m_shelves)
+    {
+        if (shelf.m_height < Size.height() || (m_size.width() - shelf.m_width) < Size.width())
+            continue;
+        if (!best || shelf.m_height < best->m_height)
+            best = &shelf;
+    }
+
+    // Don't waste a tall shelf on a short rectangle if there is room for a new one
+    if ((!best || best->m_height > (Size.height() * 2)) &&
+        (m_nextTop + Size.height() <= m_size.height()))
+    {
+        m_shelves.push_back({ m_nextTop, Size.height(), 0 });
+        m_nextTop += Size.height();
+        best = &m_shelves.back();
+    }
+
+    if (!best)
+        return {};
+
+    QRect result(best->m_width, best->m_top, Size.width(), Size.height());
+    best->m_width += Size.width();
+    m_used += Size.width() * Size.height();
+    return result;
+}
+
+/// \brief Release all reserved areas.
+void MythAtlasPacker::Reset(void)
+{
+    m_shelves.clear();
+    m_nextTop = 0;
+    m_used = 0;
+}
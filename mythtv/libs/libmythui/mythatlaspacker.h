@@ -0,0 +1,47 @@
+#ifndef MYTHATLASPACKER_H
+#define MYTHATLASPACKER_H
+
+// Qt
+#include <QRect>
+#include <QSize>
+
+// Std
+#include <vector>
+
+// MythTV
+#include "mythuiexp.h"
+
+/*! \class MythAtlasPacker
+ *  \brief Allocates rectangles within a fixed size texture atlas page.
+ *
+ * Rectangles are placed on horizontal shelves, each as tall as the first
+ * rectangle placed on it. A rectangle goes on the shelf that wastes the least
+ * height and a new shelf is opened when none fits. Space is only reclaimed by
+ * resetting the whole page, which suits UI images that tend to be loaded and
+ * released together with a screen.
+*/
+class MUI_PUBLIC MythAtlasPacker
+{
+  public:
+    explicit MythAtlasPacker(QSize Size);
+
+    QRect Add     (QSize Size);
+    void  Reset   (void);
+    QSize GetSize (void) const { return m_size; }
+    int   GetUsed (void) const { return m_used; }
+
+  private:
+    struct Shelf
+    {
+        int m_top    { 0 };
+        int m_height { 0 };
+        int m_width  { 0 };
+    };
+
+    QSize              m_size;
+    std::vector<Shelf> m_shelves;
+    int                m_nextTop { 0 };
+    int                m_used    { 0 };
+};
+
+#endif
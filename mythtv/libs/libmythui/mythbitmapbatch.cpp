@@ -0,0 +1,39 @@
+// MythTV
+#include "mythbitmapbatch.h"
+
+MythBitmapBatch::MythBitmapBatch(DrawFunc Draw)
+  : m_draw(std::move(Draw))
+{
+}
+
+/// \brief Add a quad, drawing the queued ones first if they can't be combined.
+void MythBitmapBatch::Queue(unsigned int Texture, unsigned int Target, const Quad &Vertices)
+{
+    if ((Texture != m_texture) || (Target != m_target) || (GetQuads() >= kMaxQuads))
+        Flush();
+    m_texture = Texture;
+    m_target  = Target;
+    m_vertices.insert(m_vertices.end(), Vertices.cbegin(), Vertices.cend());
+}
+
+/// \brief Draw the queued quads.
+void MythBitmapBatch::Flush(void)
+{
+    if (m_vertices.empty())
+        return;
+
+    // Taken first, in case drawing flushes again
+    std::vector<float> vertices;
+    vertices.swap(m_vertices);
+    m_draw(m_texture, m_target, vertices);
+    vertices.clear();
+    if (m_vertices.empty())
+        m_vertices.swap(vertices); // keep the allocation
+}
+
+/// \brief Draw the queued quads if they use a texture that is about to be deleted.
+void MythBitmapBatch::Release(unsigned int Texture)
+{
+    if (Texture == m_texture)
+        Flush();
+}
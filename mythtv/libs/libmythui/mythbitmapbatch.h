@@ -0,0 +1,46 @@
+#ifndef MYTHBITMAPBATCH_H
+#define MYTHBITMAPBATCH_H
+
+// Std
+#include <array>
+#include <functional>
+#include <vector>
+
+// MythTV
+#include "mythuiexp.h"
+
+/*! \class MythBitmapBatch
+ *  \brief Collects textured quads from one texture so they can be drawn together.
+ *
+ * The quads are handed to the draw function when Flush() is called, or before
+ * a quad from another texture is queued or the batch is full. The renderer
+ * must also flush before anything else that affects drawing, e.g. a scissor or
+ * a different framebuffer, so the order of drawing is preserved. There are no
+ * GL calls in here, so that ordering can be tested without a GPU.
+*/
+class MUI_PUBLIC MythBitmapBatch
+{
+  public:
+    static const int kVertexFloats = 8; // x, y, s, t, r, g, b, a
+    static const int kMaxQuads     = 2048;
+    using Quad     = std::array<float, kVertexFloats * 4>;
+    using DrawFunc = std::function<void(unsigned int Texture, unsigned int Target,
+                                        const std::vector<float> &Vertices)>;
+
+    explicit MythBitmapBatch(DrawFunc Draw);
+
+    void Queue   (unsigned int Texture, unsigned int Target, const Quad &Vertices);
+    void Flush   (void);
+    void Release (unsigned int Texture);
+    void Clear   (void)       { m_vertices.clear(); }
+    bool IsEmpty (void) const { return m_vertices.empty(); }
+    int  GetQuads(void) const { return static_cast<int>(m_vertices.size() / (kVertexFloats * 4)); }
+
+  private:
+    DrawFunc           m_draw;
+    std::vector<float> m_vertices;
+    unsigned int       m_texture { 0 };
+    unsigned int       m_target  { 0 };
+};
+
+#endif
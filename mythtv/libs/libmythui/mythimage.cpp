@@ -6,6 +6,7 @@
 #include <iostream>
 
 // QT headers
+#include <QBuffer>
 #include <QImageReader>
 #include <QNetworkReply>
 #include <QPainter>
@@ -293,12 +294,57 @@ bool MythImage::Load(MythImageReader *reader)
     return false;
 }
 
-bool MythImage::Load(const QString &filename)
+/**
+ *  \brief Reads an image, decoding it straight to the size it will be shown
+ *         at when that is smaller than the source.
+ *
+ *  Qt's JPEG plugin scales in the DCT while decoding, so a poster shown as
+ *  a thumbnail never exists in memory at its full resolution. Other formats
+ *  are scaled by QImageReader after decoding, as Resize() would have done.
+ */
+static bool read_image(QImageReader &reader, QImage &image,
+                       const QSize &decodeSize, bool preserveAspect)
+{
+    if (decodeSize.width() > 0 && decodeSize.height() > 0)
+    {
+        QSize source = reader.size();
+        if (source.isValid() &&
+            (source.width() > decodeSize.width() ||
+             source.height() > decodeSize.height()))
+        {
+            reader.setScaledSize(source.scaled(decodeSize,
+                preserveAspect ? Qt::KeepAspectRatio : Qt::IgnoreAspectRatio));
+        }
+    }
+
+    return reader.read(&image);
+}
+
+static bool read_image(const QByteArray &data, QImage &image,
+                       const QSize &decodeSize, bool preserveAspect)
+{
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    QImageReader reader(&buffer);
+    return read_image(reader, image, decodeSize, preserveAspect);
+}
+
+/**
+ *  \brief Load an image from a local file, theme, myth:// or internet URL
+ *
+ *  \param decodeSize     If valid and smaller than the image, decode it at
+ *                        this size, saving a full size decode and Resize()
+ *  \param preserveAspect Fit within decodeSize rather than fill it
+ */
+bool MythImage::Load(const QString &filename, const QSize &decodeSize,
+                     bool preserveAspect)
 {
     if (filename.isEmpty())
         return false;
 
-    QImage *im = nullptr;
+    QImage im;
+    bool ok = false;
     if (filename.startsWith("myth://"))
     {
         // Attempting a file transfer on a file that doesn't exist throws
@@ -321,10 +367,7 @@ bool MythImage::Load(const QString &filename)
             delete rf;
 
             if (ret)
-            {
-                im = new QImage();
-                im->loadFromData(data);
-            }
+                ok = read_image(data, im, decodeSize, preserveAspect);
         }
 #if 0
         else
@@ -340,30 +383,23 @@ bool MythImage::Load(const QString &filename)
     {
         QByteArray data;
         if (GetMythDownloadManager()->download(filename, &data))
-        {
-            im = new QImage();
-            im->loadFromData(data);
-        }
+            ok = read_image(data, im, decodeSize, preserveAspect);
     }
     else
     {
         QString path = filename;
         if (path.startsWith('/') ||
             GetMythUI()->FindThemeFile(path))
-            im = new QImage(path);
-    }
-
-    if (im && im->isNull())
-    {
-        delete im;
-        im = nullptr;
+        {
+            QImageReader reader(path);
+            ok = read_image(reader, im, decodeSize, preserveAspect);
+        }
     }
 
     SetFileName(filename);
-    if (im)
+    if (ok && !im.isNull())
     {
-        Assign(*im);
-        delete im;
+        Assign(im);
         return true;
     }
     LOG(VB_GUI, LOG_WARNING, QString("MythImage::Load(%1) failed").arg(filename));
@@ -371,6 +407,21 @@ bool MythImage::Load(const QString &filename)
     return false;
 }
 
+/**
+ *  \brief Load an image from encoded data already in memory, e.g. a copy of
+ *         a file in the image cache.
+ */
+bool MythImage::Load(const QByteArray &data, const QString &filename)
+{
+    QImage im;
+    if (!read_image(data, im, QSize(), false) || im.isNull())
+        return false;
+
+    Assign(im);
+    SetFileName(filename);
+    return true;
+}
+
 void MythImage::MakeGradient(QImage &image, const QColor &begin,
                              const QColor &end, int alpha,
                              BoundaryWanted drawBoundary,
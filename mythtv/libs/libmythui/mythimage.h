@@ -58,7 +58,9 @@ class MUI_PUBLIC MythImage : public QImage, public ReferenceCounter
     void Assign(const QPixmap &pix);
 
     bool Load(MythImageReader *reader);
-    bool Load(const QString &filename);
+    bool Load(const QString &filename, const QSize &decodeSize = QSize(),
+              bool preserveAspect = false);
+    bool Load(const QByteArray &data, const QString &filename);
 
     void Orientation(int orientation);
     void Resize(const QSize &newSize, bool preserveAspect = false);
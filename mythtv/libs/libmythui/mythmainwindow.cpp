@@ -22,6 +22,7 @@ using namespace std;
 #include <QKeySequence>
 #include <QSize>
 #include <QWindow>
+#include <QColor>
 
 // Platform headers
 #include "unistd.h"
@@ -426,6 +427,50 @@ void MythMainWindow::drawScreen(QPaintEvent* Event)
     m_repaintRegion = QRegion();
 }
 
+/*! \brief Reduce a repaint region to a few rectangles.
+ *
+ * Every rectangle is drawn by walking all of the visible screens, so
+ * neighbouring or overlapping areas are cheaper drawn as one. QRegion also
+ * splits overlapping rectangles into bands, which this undoes.
+*/
+static QVector<QRect> merge_repaint_region(const QRegion &Region)
+{
+    static constexpr int kMaxRects = 8;
+    if (Region.rectCount() > kMaxRects * 4)
+        return { Region.boundingRect() };
+
+    auto area = [](const QRect &Rect)
+        { return static_cast<int64_t>(Rect.width()) * Rect.height(); };
+
+    QVector<QRect> rects;
+    for (const QRect& rect : Region)
+        rects.append(rect);
+
+    // Merge any pair whose bounding rectangle wastes less than a quarter
+    bool merged = true;
+    while (merged && rects.size() > 1)
+    {
+        merged = false;
+        for (int i = 0; i < rects.size() && !merged; ++i)
+        {
+            for (int j = i + 1; j < rects.size() && !merged; ++j)
+            {
+                QRect united = rects[i].united(rects[j]);
+                if ((area(united) * 4) <= ((area(rects[i]) + area(rects[j])) * 5))
+                {
+                    rects[i] = united;
+                    rects.remove(j);
+                    merged = true;
+                }
+            }
+        }
+    }
+
+    if (rects.size() > kMaxRects)
+        return { Region.boundingRect() };
+    return rects;
+}
+
 void MythMainWindow::Draw(MythPainter *Painter /* = nullptr */)
 {
     if (!Painter)
@@ -435,16 +480,26 @@ void MythMainWindow::Draw(MythPainter *Painter /* = nullptr */)
 
     Painter->Begin(m_painterWin);
 
-    if (!Painter->SupportsClipping())
+    // Painters that can't clip (or have lost their previous frame) redraw
+    // everything
+    bool clipping = Painter->SupportsClipping();
+    if (!clipping)
         m_repaintRegion = QRegion(d->m_uiScreenRect);
 
-    for (const QRect& rect : m_repaintRegion)
+    static int s_redrawHue = 0;
+    s_redrawHue = (s_redrawHue + 37) % 360;
+
+    QVector<QRect> drawn;
+    for (const QRect& rect : merge_repaint_region(m_repaintRegion))
     {
         if (rect.width() == 0 || rect.height() == 0)
             continue;
 
-        if (rect != d->m_uiScreenRect)
+        if (clipping)
+        {
+            Painter->Clear(m_painterWin, rect);
             Painter->SetClipRect(rect);
+        }
 
         // The call to GetDrawOrder can apparently alter m_stackList.
         // NOLINTNEXTLINE(modernize-loop-convert)
@@ -455,8 +510,13 @@ void MythMainWindow::Draw(MythPainter *Painter /* = nullptr */)
             for (auto *screen : qAsConst(redrawList))
                 screen->Draw(Painter, 0, 0, 255, rect);
         }
+
+        drawn.append(rect);
     }
 
+    if (Painter->ShowRedraws())
+        Painter->DrawRedrawOutlines(drawn, QColor::fromHsv(s_redrawHue, 255, 255));
+
     Painter->End();
     m_repaintRegion = QRegion();
 }
@@ -601,6 +661,10 @@ void MythMainWindow::Init(bool mayReInit)
     if (!(mayReInit || d->m_firstinit))
         return;
 
+    // Cached screens were built with the old theme and painter
+    for (auto *stack : qAsConst(d->m_stackList))
+        stack->ClearCache();
+
     d->m_doesFillScreen =
         (GetMythDB()->GetNumSetting("GuiOffsetX") == 0 &&
          GetMythDB()->GetNumSetting("GuiWidth")   == 0 &&
@@ -2251,6 +2315,8 @@ void MythMainWindow::HideMouseTimeout(void)
 
 void MythMainWindow::ResetIdleTimer(void)
 {
+    d->m_lastInput.start();
+
     if (d->m_disableIdle)
         return;
 
@@ -2267,6 +2333,8 @@ void MythMainWindow::ResetIdleTimer(void)
 
 void MythMainWindow::PauseIdleTimer(bool pause)
 {
+    d->m_idlePaused = pause;
+
     if (d->m_disableIdle)
         return;
 
@@ -2288,6 +2356,18 @@ void MythMainWindow::PauseIdleTimer(bool pause)
     // ResetIdleTimer();
 }
 
+/*! \brief Has the user left the UI alone for at least the given time?
+ *
+ * Always false during playback or standby, when background work should be
+ * left alone.
+*/
+bool MythMainWindow::IsIdle(int Milliseconds) const
+{
+    if (d->m_idlePaused || d->m_standby || !d->m_drawEnabled)
+        return false;
+    return !d->m_lastInput.isValid() || d->m_lastInput.elapsed() >= Milliseconds;
+}
+
 void MythMainWindow::IdleTimeout(void)
 {
     if (d->m_disableIdle)
@@ -128,6 +128,7 @@ class MUI_PUBLIC MythMainWindow : public QWidget
 
     void ResetIdleTimer(void);
     void PauseIdleTimer(bool pause);
+    bool IsIdle(int Milliseconds) const;
     void DisableIdleTimer(bool disableIdle = true);
     void EnterStandby(bool manual = true);
     void ExitStandby(bool manual = true);
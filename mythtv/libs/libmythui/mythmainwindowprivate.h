@@ -1,6 +1,9 @@
 #ifndef MYTHMAINWINDOWPRIVATE_H
 #define MYTHMAINWINDOWPRIVATE_H
 
+// Qt
+#include <QElapsedTimer>
+
 // MythTV
 #include "mythconfig.h"
 #include "mythmainwindow.h"
@@ -95,6 +98,8 @@ class MythMainWindowPrivate
     bool             m_standby           { false   };
     bool             m_enteringStandby   { false   };
     bool             m_disableIdle       { false   };
+    bool             m_idlePaused        { false   };
+    QElapsedTimer    m_lastInput;
     bool             m_allowInput        { true    };
     bool             m_pendingUpdate     { false   };
     // window aspect
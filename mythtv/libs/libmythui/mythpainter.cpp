@@ -55,6 +55,18 @@ void MythPainter::Clear(QPaintDevice */*device*/, const QRegion &/*region*/)
 {
 }
 
+/// \brief Outline the areas drawn in this frame (see SetShowRedraws).
+void MythPainter::DrawRedrawOutlines(const QVector<QRect> &Areas,
+                                     const QColor &Colour)
+{
+    static const QBrush kNullBrush(Qt::NoBrush);
+    QPen pen(Colour);
+    pen.setWidth(2);
+    SetClipRect(QRect());
+    for (const QRect &area : Areas)
+        DrawRect(area.adjusted(1, 1, -1, -1), kNullBrush, pen, 255);
+}
+
 void MythPainter::DrawImage(int x, int y, MythImage *im, int alpha)
 {
     if (!im)
@@ -55,6 +55,8 @@ class MUI_PUBLIC MythPainter : public QObject
     virtual void SetClipRect(const QRect &clipRect);
     virtual void SetClipRegion(const QRegion &clipRegion);
     virtual void Clear(QPaintDevice *device, const QRegion &region);
+    virtual void DrawRedrawOutlines(const QVector<QRect> &Areas,
+                                    const QColor &Colour);
 
     virtual void DrawImage(const QRect &dest, MythImage *im, const QRect &src,
                            int alpha) = 0;
@@ -96,6 +98,10 @@ class MUI_PUBLIC MythPainter : public QObject
     bool ShowBorders(void) const { return m_showBorders; }
     bool ShowTypeNames(void) const { return m_showNames; }
 
+    /// Outline the areas drawn in each frame
+    void SetShowRedraws(bool Show) { m_showRedraws = Show; }
+    bool ShowRedraws(void) const { return m_showRedraws; }
+
     void SetMaximumCacheSizes(int hardware, int software);
 
   protected:
@@ -140,6 +146,7 @@ class MUI_PUBLIC MythPainter : public QObject
 
     bool m_showBorders          {false};
     bool m_showNames            {false};
+    bool m_showRedraws          {false};
 };
 
 #endif
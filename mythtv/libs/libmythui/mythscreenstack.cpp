@@ -3,6 +3,8 @@
 #include "mythscreentype.h"
 #include "mythpainter.h"
 #include "mythevent.h"
+#include "mythcorecontext.h"
+#include "mythlogging.h"
 
 #include <cassert>
 
@@ -10,7 +12,11 @@
 #include <QTimer>
 #include <QString>
 
+#define LOC QString("ScreenStack: ")
+
 const int kFadeVal = 20;
+// How long the user must leave the UI alone before a screen is preloaded
+const int kPreloadIdleMs = 5000;
 
 MythScreenStack::MythScreenStack(MythMainWindow *parent, const QString &name,
                                  bool mainstack)
@@ -22,11 +28,21 @@ MythScreenStack::MythScreenStack(MythMainWindow *parent, const QString &name,
         parent->AddScreenStack(this, mainstack);
 
     EnableEffects();
+
+    if (mainstack)
+    {
+        m_maxCached = gCoreContext->GetNumSetting("UIScreenCacheSize", 3);
+        m_preloadTimer = new QTimer(this);
+        m_preloadTimer->setSingleShot(true);
+        connect(m_preloadTimer, &QTimer::timeout, this, &MythScreenStack::doPreload);
+    }
 }
 
 MythScreenStack::~MythScreenStack()
 {
     CheckDeletes(true);
+    m_maxCached = 0;
+    ClearCache();
 
     while (!m_children.isEmpty())
     {
@@ -53,6 +69,20 @@ void MythScreenStack::AddScreen(MythScreenType *screen, bool allowFade)
 
     m_doInit = false;
 
+    if (m_preloadTimer)
+    {
+        QString name = screen->objectName();
+        for (const auto &preload : qAsConst(m_preloads))
+        {
+            if (preload.first == name)
+            {
+                m_screenUses[name]++;
+                break;
+            }
+        }
+        m_preloadTimer->start(kPreloadIdleMs);
+    }
+
     MythScreenType *old = m_topScreen;
     if (old && screen->IsFullscreen())
         old->aboutToHide();
@@ -100,8 +130,13 @@ void MythScreenStack::PopScreen(MythScreenType *screen, bool allowFade,
     MythMainWindow *mainwindow = GetMythMainWindow();
 
     screen->setParent(nullptr);
+
+    // A screen going into the cache must leave the stack now rather than
+    // once it has faded out
+    bool cache = deleteScreen && screen->IsCacheable() && m_maxCached > 0;
+
     if ((screen == m_topScreen) && allowFade && m_doTransitions
-        && !mainwindow->IsExitingToMain())
+        && !mainwindow->IsExitingToMain() && !cache)
     {
         screen->SetFullscreen(false);
         if (deleteScreen)
@@ -118,7 +153,7 @@ void MythScreenStack::PopScreen(MythScreenType *screen, bool allowFade,
             if (m_children.at(i) == screen)
                 m_children.remove(i);
         }
-        if (deleteScreen)
+        if (deleteScreen && !CacheScreen(screen))
             screen->deleteLater();
 
         screen = nullptr;
@@ -133,6 +168,9 @@ void MythScreenStack::PopScreen(MythScreenType *screen, bool allowFade,
 
     m_topScreen = nullptr;
 
+    if (m_preloadTimer)
+        m_preloadTimer->start(kPreloadIdleMs);
+
     MythScreenStack::RecalculateDrawOrder();
 
     // If we're fading it, we still want to draw it.
@@ -385,3 +423,163 @@ MythPainter* MythScreenStack::GetPainter(void)
 {
     return GetMythPainter();
 }
+
+/**
+ * \brief Keep a popped screen hidden so it can be shown again quickly.
+ *
+ * \return false if the screen can't be cached and should be deleted.
+ */
+bool MythScreenStack::CacheScreen(MythScreenType *screen)
+{
+    if (!screen->IsCacheable() || m_maxCached <= 0 ||
+        GetMythMainWindow()->IsExitingToMain())
+    {
+        return false;
+    }
+
+    // Only one copy of each screen is worth keeping
+    QString name = screen->objectName();
+    for (int i = 0; i < m_cached.size(); ++i)
+    {
+        if (m_cached.at(i)->objectName() == name)
+        {
+            m_cached.takeAt(i)->deleteLater();
+            break;
+        }
+    }
+
+    screen->SetCached(true);
+    m_cached.push_back(screen);
+    while (m_cached.size() > m_maxCached)
+        m_cached.takeFirst()->deleteLater();
+
+    LOG(VB_GUI, LOG_INFO, LOC + QString("Cached '%1' (%2 cached)")
+        .arg(name).arg(m_cached.size()));
+    return true;
+}
+
+/**
+ * \brief Show the screen called \p name from the screen cache.
+ *
+ * A cached screen was either popped earlier or loaded ahead of time while the
+ * user was idle. If it has been initialised it is asked to Refresh() itself,
+ * otherwise Init() runs as usual once it is on top.
+ *
+ * \return false if no such screen is cached, the caller should create one.
+ */
+bool MythScreenStack::ShowCachedScreen(const QString &name, bool allowFade)
+{
+    MythScreenType *screen = nullptr;
+    for (int i = 0; i < m_cached.size(); ++i)
+    {
+        if (m_cached.at(i)->objectName() == name)
+        {
+            screen = m_cached.takeAt(i);
+            break;
+        }
+    }
+
+    if (!screen)
+        return false;
+
+    LOG(VB_GUI, LOG_INFO, LOC + QString("Showing '%1' from the cache").arg(name));
+
+    screen->SetCached(false);
+    screen->setParent(this);
+    screen->SetAlpha(255);
+    AddScreen(screen, allowFade);
+    if (screen->IsInitialized())
+        screen->Refresh();
+    return true;
+}
+
+/**
+ * \brief Register a screen that may be loaded into the cache while the user
+ *        is idle.
+ *
+ * Of the registered screens the one shown most often is preloaded first.
+ * \p factory must only construct the screen, it is created and loaded here.
+ */
+void MythScreenStack::RegisterPreload(const QString &name,
+                                      const ScreenFactory &factory)
+{
+    if (!m_preloadTimer)
+        return;
+
+    for (auto &preload : m_preloads)
+    {
+        if (preload.first == name)
+        {
+            preload.second = factory;
+            return;
+        }
+    }
+
+    m_preloads.push_back(qMakePair(name, factory));
+    m_preloadTimer->start(kPreloadIdleMs);
+}
+
+/// \brief Delete all cached screens, e.g. before the theme is reloaded.
+void MythScreenStack::ClearCache(void)
+{
+    if (m_preloadTimer)
+        m_preloadTimer->stop();
+    m_preloads.clear();
+
+    while (!m_cached.isEmpty())
+        delete m_cached.takeLast();
+}
+
+void MythScreenStack::doPreload(void)
+{
+    if (m_cached.size() >= m_maxCached || m_preloads.isEmpty())
+        return;
+
+    MythMainWindow *mainwindow = GetMythMainWindow();
+    if (!mainwindow->IsIdle(kPreloadIdleMs) ||
+        (m_topScreen && m_topScreen->IsLoading()))
+    {
+        m_preloadTimer->start(kPreloadIdleMs);
+        return;
+    }
+
+    // Pick the most used screen that isn't already available
+    const QPair<QString, ScreenFactory> *best = nullptr;
+    for (const auto &preload : qAsConst(m_preloads))
+    {
+        bool available = false;
+        for (auto *screen : qAsConst(m_cached))
+            available |= screen->objectName() == preload.first;
+        for (auto *screen : qAsConst(m_children))
+            available |= screen->objectName() == preload.first;
+
+        if (!available && (!best || m_screenUses.value(preload.first) >
+                                    m_screenUses.value(best->first)))
+        {
+            best = &preload;
+        }
+    }
+
+    if (!best)
+        return;
+
+    LOG(VB_GUI, LOG_INFO, LOC + QString("Preloading '%1'").arg(best->first));
+
+    MythScreenType *screen = best->second(this);
+    if (!screen)
+        return;
+
+    // Loading happens in the background, Init() waits until it is shown
+    screen->SetCacheable(true);
+    screen->SetCached(true);
+    screen->setParent(nullptr);
+    if (!screen->Create())
+    {
+        delete screen;
+        return;
+    }
+    m_cached.push_back(screen);
+
+    // One screen at a time, so the UI stays responsive
+    m_preloadTimer->start(kPreloadIdleMs);
+}
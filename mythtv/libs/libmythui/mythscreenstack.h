@@ -1,6 +1,10 @@
 #ifndef MYTHSCREEN_STACK_H_
 #define MYTHSCREEN_STACK_H_
 
+#include <functional>
+
+#include <QMap>
+#include <QPair>
 #include <QVector>
 #include <QObject>
 
@@ -11,12 +15,15 @@ class QString;
 class MythScreenType;
 class MythMainWindow;
 class MythPainter;
+class QTimer;
 
 class MUI_PUBLIC MythScreenStack : public QObject
 {
   Q_OBJECT
 
   public:
+    using ScreenFactory = std::function<MythScreenType *(MythScreenStack *)>;
+
     MythScreenStack(MythMainWindow *parent, const QString &name,
                     bool main = false);
     ~MythScreenStack() override;
@@ -40,17 +47,23 @@ class MUI_PUBLIC MythScreenStack : public QObject
 
     static MythPainter *GetPainter(void);
 
+    bool ShowCachedScreen(const QString &name, bool allowFade = true);
+    void RegisterPreload(const QString &name, const ScreenFactory &factory);
+    void ClearCache(void);
+
   signals:
     void topScreenChanged(MythScreenType *screen);
 
   private slots:
     void doInit(void);
+    void doPreload(void);
 
   protected:
     virtual void RecalculateDrawOrder(void);
     void DoNewFadeTransition();
     void CheckNewFadeTransition();
     void CheckDeletes(bool force = false);
+    bool CacheScreen(MythScreenType *screen);
 
     QVector<MythScreenType *> m_children;
     QVector<MythScreenType *> m_drawOrder;
@@ -64,6 +77,13 @@ class MUI_PUBLIC MythScreenStack : public QObject
     MythScreenType *m_newTop    {nullptr};
 
     QVector<MythScreenType *> m_toDelete;
+
+    // Hidden screens kept for reuse, least recently used first
+    QVector<MythScreenType *> m_cached;
+    int  m_maxCached            {0};
+    QVector<QPair<QString, ScreenFactory> > m_preloads;
+    QMap<QString, int> m_screenUses;
+    QTimer *m_preloadTimer      {nullptr};
 };
 
 #endif
@@ -335,7 +335,8 @@ void MythScreenType::ReloadInBackground(void)
 
 void MythScreenType::OpenBusyPopup(const QString& message)
 {
-    if (m_busyPopup)
+    // Screens loaded ahead of time in the screen cache load silently
+    if (m_busyPopup || m_isCached)
         return;
 
     QString msg(tr("Loading..."));
@@ -399,6 +400,18 @@ void MythScreenType::Init(void)
     // Virtual
 }
 
+/**
+ * \brief Bring the screen up to date when it is shown again from the screen
+ *        cache.
+ *
+ * Init() is not called again for a cached screen, so screens that do not
+ * keep themselves current while hidden should reload whatever changed here.
+ */
+void MythScreenType::Refresh(void)
+{
+    // Virtual
+}
+
 void MythScreenType::Close(void)
 {
     CloseBusyPopup();
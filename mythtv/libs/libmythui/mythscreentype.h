@@ -81,6 +81,14 @@ class MUI_PUBLIC MythScreenType : public MythUIComposite
     bool IsLoading(void) const { return m_isLoading; }
     bool IsLoaded(void) const { return m_isLoaded; }
 
+    // if the screen may be kept hidden by the stack when popped, see
+    // MythScreenStack::ShowCachedScreen()
+    bool IsCacheable(void) const { return m_isCacheable; }
+    void SetCacheable(bool cacheable) { m_isCacheable = cacheable; }
+    bool IsCached(void) const { return m_isCached; }
+    void SetCached(bool cached) { m_isCached = cached; }
+    virtual void Refresh(void);
+
     MythPainter *GetPainter(void) override; // MythUIType
 
   public slots:
@@ -118,6 +126,8 @@ class MUI_PUBLIC MythScreenType : public MythUIComposite
     volatile bool m_isLoading        {false};
     volatile bool m_isLoaded         {false};
     bool m_isInitialized             {false};
+    bool m_isCacheable               {false};
+    bool m_isCached                  {false};
 
     MythUIType *m_currentFocusWidget {nullptr};
     //TODO We are currently dependant on the internal sorting of QMap for
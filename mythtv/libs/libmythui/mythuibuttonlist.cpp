@@ -1,5 +1,6 @@
 #include "mythuibuttonlist.h"
 
+#include <algorithm>
 #include <cmath>
 #include <utility>
 
@@ -26,6 +27,29 @@
 
 #define LOC     QString("MythUIButtonList(%1): ").arg(objectName())
 
+class NextButtonListPageEvent : public QEvent
+{
+  public:
+    NextButtonListPageEvent(int start, int pageSize) :
+        QEvent(kEventType), m_start(start), m_pageSize(pageSize) {}
+    const int m_start;
+    const int m_pageSize;
+    static Type kEventType;
+};
+
+QEvent::Type NextButtonListPageEvent::kEventType =
+    (QEvent::Type) QEvent::registerEventType();
+
+class PrefetchButtonListEvent : public QEvent
+{
+  public:
+    PrefetchButtonListEvent() : QEvent(kEventType) {}
+    static Type kEventType;
+};
+
+QEvent::Type PrefetchButtonListEvent::kEventType =
+    (QEvent::Type) QEvent::registerEventType();
+
 MythUIButtonList::MythUIButtonList(MythUIType *parent, const QString &name)
     : MythUIType(parent, name)
 {
@@ -115,6 +139,15 @@ void MythUIButtonList::Reset()
 {
     m_buttonToItem.clear();
 
+    m_provider = nullptr;
+    m_providedItems.clear();
+    if (m_prefetchPending)
+    {
+        QCoreApplication::
+            removePostedEvents(this, PrefetchButtonListEvent::kEventType);
+        m_prefetchPending = false;
+    }
+
     if (m_itemList.isEmpty())
         return;
 
@@ -1421,6 +1454,12 @@ void MythUIButtonList::CalculateArrowStates()
     else
         DistributeButtons();
 
+    if (m_provider && !m_prefetchPending)
+    {
+        m_prefetchPending = true;
+        QCoreApplication::postEvent(this, new PrefetchButtonListEvent());
+    }
+
     updateLCD();
 
     m_needsUpdate = false;
@@ -1452,8 +1491,133 @@ void MythUIButtonList::CalculateArrowStates()
 
 void MythUIButtonList::ItemVisible(MythUIButtonListItem *item)
 {
-    if (item)
-        emit itemVisible(item);
+    if (!item)
+        return;
+
+    ProvideItem(item);
+    emit itemVisible(item);
+}
+
+/**
+ * \brief Asks the provider for the content of \p item if it is empty,
+ *        and marks it as used.
+ */
+void MythUIButtonList::ProvideItem(MythUIButtonListItem *item) const
+{
+    if (!m_provider || !item)
+        return;
+
+    item->m_providedUse = ++m_providedUse;
+    if (item->m_provided)
+        return;
+
+    int row = item->m_providedRow;
+    if (row < 0 || row >= m_itemList.size() || m_itemList.at(row) != item)
+        row = m_itemList.indexOf(item);
+    if (row < 0)
+        return;
+
+    item->m_providedRow = row;
+    item->m_provided = true;
+    m_provider->FillItem(item, row);
+    m_providedItems.append(item);
+}
+
+/**
+ * \brief Fills the rows either side of the visible ones, and empties the
+ *        rows that were used longest ago.
+ *
+ * Runs from the event loop after the buttons are laid out, so that moving
+ * through the list only waits for the rows actually shown.
+ */
+void MythUIButtonList::PrefetchItems(void)
+{
+    m_prefetchPending = false;
+    if (!m_provider || m_itemList.isEmpty())
+        return;
+
+    int margin = m_prefetch > 0 ? m_prefetch : qMax(m_itemsVisible, 1);
+    int first  = qMax(m_topPosition - margin, 0);
+    int last   = qMin(m_topPosition + m_itemsVisible + margin, m_itemCount);
+    for (int row = first; row < last; ++row)
+    {
+        MythUIButtonListItem *item = m_itemList.at(row);
+        item->m_providedRow = row;
+        ProvideItem(item);
+    }
+
+    // Trim in batches, rather than one row on every step
+    int keep = qMax(4 * (m_itemsVisible + (2 * margin)), 64);
+    if (m_providedItems.size() <= keep + (keep / 4))
+        return;
+
+    std::sort(m_providedItems.begin(), m_providedItems.end(),
+              [](const MythUIButtonListItem *a, const MythUIButtonListItem *b)
+              { return a->m_providedUse > b->m_providedUse; });
+    while (m_providedItems.size() > keep)
+        m_providedItems.takeLast()->ReleaseContent();
+
+    LOG(VB_GUI, LOG_DEBUG, LOC + QString("Emptied rows, kept %1 of %2")
+        .arg(keep).arg(m_itemCount));
+}
+
+/**
+ * \brief Replaces the items with \p count rows, whose content comes from
+ *        \p provider when they are used.
+ *
+ * \param prefetch Number of rows to fill ahead of and behind the visible
+ *                 ones, defaults to one page.
+ */
+void MythUIButtonList::SetProvider(MythUIButtonListProvider *provider,
+                                   int count, int prefetch)
+{
+    SetProvidedRows(provider, count, QVariantList(), prefetch);
+}
+
+/**
+ * \brief Replaces the items with one row for each entry of \p data, whose
+ *        content comes from \p provider when they are used.
+ *
+ * Each row has its data from the start, so GetItemByData() finds a row
+ * without asking for the content of the rows before it, and the provider
+ * can find a row's model from its data even after rows are removed.
+ */
+void MythUIButtonList::SetProvider(MythUIButtonListProvider *provider,
+                                   const QVariantList &data, int prefetch)
+{
+    SetProvidedRows(provider, data.size(), data, prefetch);
+}
+
+void MythUIButtonList::SetProvidedRows(MythUIButtonListProvider *provider,
+                                       int count, const QVariantList &data,
+                                       int prefetch)
+{
+    Reset();
+
+    if (!provider || count <= 0)
+        return;
+
+    m_provider = provider;
+    m_prefetch = prefetch;
+
+    // The empty items are appended directly, InsertItem() would update the
+    // list for every one of them
+    m_itemList.reserve(count);
+    for (int row = 0; row < count; ++row)
+    {
+        auto *item = new MythUIButtonListItem(this);
+        item->m_providedRow = row;
+        if (row < data.size())
+            item->m_data = data.at(row);
+        m_itemList.append(item);
+    }
+    m_itemCount = count;
+    m_selPosition = m_topPosition = 0;
+
+    emit itemSelected(GetItemCurrent());
+    emit DependChanged(false);
+
+    Update();
 }
 
 void MythUIButtonList::InsertItem(MythUIButtonListItem *item, int listPosition)
@@ -1495,6 +1659,9 @@ void MythUIButtonList::RemoveItem(MythUIButtonListItem *item)
     if (curIndex == -1)
         return;
 
+    if (m_provider)
+        m_providedItems.removeOne(item);
+
     QMap<int, MythUIButtonListItem*>::iterator it = m_buttonToItem.begin();
     while (it != m_buttonToItem.end())
     {
@@ -1531,7 +1698,7 @@ void MythUIButtonList::RemoveItem(MythUIButtonListItem *item)
     Update();
 
     if (m_selPosition < m_itemCount)
-        emit itemSelected(m_itemList.at(m_selPosition));
+        emit itemSelected(GetItemCurrent());
     else
         emit itemSelected(nullptr);
 
@@ -1546,6 +1713,9 @@ void MythUIButtonList::SetValueByData(const QVariant& data)
 
     for (auto *item : qAsConst(m_itemList))
     {
+        // Only rows whose data comes from the provider need filling
+        if (!item->m_data.isValid())
+            ProvideItem(item);
         if (item->GetData() == data)
         {
             SetItemCurrent(item);
@@ -1593,7 +1763,9 @@ MythUIButtonListItem *MythUIButtonList::GetItemCurrent() const
         m_selPosition < 0)
         return nullptr;
 
-    return m_itemList.at(m_selPosition);
+    MythUIButtonListItem *item = m_itemList.at(m_selPosition);
+    ProvideItem(item);
+    return item;
 }
 
 int MythUIButtonList::GetIntValue() const
@@ -1635,10 +1807,11 @@ MythRect MythUIButtonList::GetButtonArea(void) const
 
 MythUIButtonListItem *MythUIButtonList::GetItemFirst() const
 {
-    if (!m_itemList.empty())
-        return m_itemList[0];
+    if (m_itemList.empty())
+        return nullptr;
 
-    return nullptr;
+    ProvideItem(m_itemList[0]);
+    return m_itemList[0];
 }
 
 MythUIButtonListItem *MythUIButtonList::GetItemNext(MythUIButtonListItem *item)
@@ -1649,7 +1822,9 @@ const
     if (!it.findNext(item))
         return nullptr;
 
-    return it.previous();
+    MythUIButtonListItem *next = it.previous();
+    ProvideItem(next);
+    return next;
 }
 
 int MythUIButtonList::GetCount() const
@@ -1678,7 +1853,24 @@ MythUIButtonListItem *MythUIButtonList::GetItemAt(int pos) const
     if (pos < 0 || pos >= m_itemList.size())
         return nullptr;
 
-    return m_itemList.at(pos);
+    MythUIButtonListItem *item = m_itemList.at(pos);
+    ProvideItem(item);
+    return item;
+}
+
+/**
+ * \brief Returns the data of the row at \p pos, without asking a provider
+ *        for the row's content when the data was given to SetProvider()
+ */
+QVariant MythUIButtonList::GetDataAt(int pos) const
+{
+    if (pos < 0 || pos >= m_itemList.size())
+        return QVariant();
+
+    MythUIButtonListItem *item = m_itemList.at(pos);
+    if (!item->m_data.isValid())
+        ProvideItem(item);
+    return item->m_data;
 }
 
 MythUIButtonListItem *MythUIButtonList::GetItemByData(const QVariant& data)
@@ -1688,8 +1880,14 @@ MythUIButtonListItem *MythUIButtonList::GetItemByData(const QVariant& data)
 
     for (auto *item : qAsConst(m_itemList))
     {
+        // Only rows whose data comes from the provider need filling
+        if (!item->m_data.isValid())
+            ProvideItem(item);
         if (item->GetData() == data)
+        {
+            ProvideItem(item);
             return item;
+        }
     }
 
     return nullptr;
@@ -2716,21 +2914,14 @@ bool MythUIButtonList::gestureEvent(MythGestureEvent *event)
     return handled;
 }
 
-class NextButtonListPageEvent : public QEvent
-{
-  public:
-    NextButtonListPageEvent(int start, int pageSize) :
-        QEvent(kEventType), m_start(start), m_pageSize(pageSize) {}
-    const int m_start;
-    const int m_pageSize;
-    static Type kEventType;
-};
-
-QEvent::Type NextButtonListPageEvent::kEventType =
-    (QEvent::Type) QEvent::registerEventType();
-
 void MythUIButtonList::customEvent(QEvent *event)
 {
+    if (event->type() == PrefetchButtonListEvent::kEventType)
+    {
+        PrefetchItems();
+        return;
+    }
+
     if (event->type() == NextButtonListPageEvent::kEventType)
     {
         auto *npe = dynamic_cast<NextButtonListPageEvent*>(event);
@@ -3261,6 +3452,39 @@ MythUIButtonListItem::~MythUIButtonListItem()
     m_images.clear();
 }
 
+/// An empty row of a list with a MythUIButtonListProvider
+MythUIButtonListItem::MythUIButtonListItem(MythUIButtonList *lbtype)
+    : m_parent(lbtype), m_checkable(false), m_state(CantCheck),
+      m_data(QVariant()), m_provided(false)
+{
+}
+
+/// Frees what the provider filled in, it is asked again when next needed
+void MythUIButtonListItem::ReleaseContent(void)
+{
+    m_text.clear();
+    m_fontState.clear();
+    m_imageFilename.clear();
+
+    if (m_image)
+    {
+        m_image->DecrRef();
+        m_image = nullptr;
+    }
+
+    for (auto *image : qAsConst(m_images))
+    {
+        if (image)
+            image->DecrRef();
+    }
+    m_images.clear();
+
+    m_strings.clear();
+    m_imageFilenames.clear();
+    m_states.clear();
+    m_provided = false;
+}
+
 void MythUIButtonListItem::SetText(const QString &text, const QString &name,
                                    const QString &state)
 {
@@ -3698,7 +3922,8 @@ void MythUIButtonListItem::SetToRealButton(MythUIStateType *button, bool selecte
 
             QString newText = text->GetTemplateText();
 
-            QRegularExpression re {R"(%(([^\|%]+)?\||\|(.))?([\w#]+)(\|(.+?))?%)",
+            // Compiled once, this runs for every text of every visible row
+            static const QRegularExpression re {R"(%(([^\|%]+)?\||\|(.))?([\w#]+)(\|(.+?))?%)",
                                    QRegularExpression::DotMatchesEverythingOption};
 
             if (!newText.isEmpty() && newText.contains(re))
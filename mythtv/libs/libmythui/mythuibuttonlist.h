@@ -122,6 +122,11 @@ class MUI_PUBLIC MythUIButtonListItem
     bool            m_isVisible     {false};
     bool            m_enabled       {true};
 
+    // Rows of a list with a MythUIButtonListProvider
+    bool            m_provided      {true};
+    int             m_providedRow   {-1};  ///< where the row was last seen
+    uint            m_providedUse   {0};   ///< when the row was last used
+
     QMap<QString, TextProperties> m_strings;
     QMap<QString, MythImage*> m_images;
     InfoMap m_imageFilenames;
@@ -129,6 +134,35 @@ class MUI_PUBLIC MythUIButtonListItem
 
     friend class MythUIButtonList;
     friend class MythGenericTree;
+
+  private:
+    explicit MythUIButtonListItem(MythUIButtonList *lbtype);
+    void ReleaseContent(void);
+};
+
+/**
+ * \class MythUIButtonListProvider
+ *
+ * \brief Supplies the rows of a MythUIButtonList as they are needed
+ *
+ * A list given a provider with MythUIButtonList::SetProvider() starts with
+ * empty items, and only asks for the content of the rows it shows, those
+ * it is about to show and those the caller looks at through GetItemAt(),
+ * GetItemCurrent() etc. Rows that haven't been used for a while are
+ * emptied again, so the list holds a few screens worth of text and
+ * artwork however long it is.
+ *
+ * The provider is the owner of the content: anything changed on an item,
+ * such as its check state, must also be changed in the provider's model
+ * or it is lost when the row is emptied.
+ */
+class MUI_PUBLIC MythUIButtonListProvider
+{
+  public:
+    virtual ~MythUIButtonListProvider() = default;
+
+    /// Sets the text, images, states and data of \p item, the row at \p index
+    virtual void FillItem(MythUIButtonListItem *item, int index) = 0;
 };
 
 /**
@@ -177,6 +211,7 @@ class MUI_PUBLIC MythUIButtonList : public MythUIType
     MythUIButtonListItem* GetItemFirst() const;
     MythUIButtonListItem* GetItemNext(MythUIButtonListItem *item) const;
     MythUIButtonListItem* GetItemAt(int pos) const;
+    QVariant GetDataAt(int pos) const;
     MythUIButtonListItem* GetItemByData(const QVariant& data);
 
     uint ItemWidth(void);
@@ -212,6 +247,11 @@ class MUI_PUBLIC MythUIButtonList : public MythUIType
     void LoadInBackground(int start = 0, int pageSize = 20);
     int  StopLoad(void);
 
+    void SetProvider(MythUIButtonListProvider *provider, int count,
+                     int prefetch = 0);
+    void SetProvider(MythUIButtonListProvider *provider,
+                     const QVariantList &data, int prefetch = 0);
+
   public slots:
     void Select();
     void Deselect();
@@ -261,6 +301,10 @@ class MUI_PUBLIC MythUIButtonList : public MythUIType
     void CalculateArrowStates(void);
     void SetScrollBarPosition(void);
     void ItemVisible(MythUIButtonListItem *item);
+    void SetProvidedRows(MythUIButtonListProvider *provider, int count,
+                         const QVariantList &data, int prefetch);
+    void ProvideItem(MythUIButtonListItem *item) const;
+    void PrefetchItems(void);
 
     void SetActive(bool active);
 
@@ -339,6 +383,12 @@ class MUI_PUBLIC MythUIButtonList : public MythUIType
     QList<MythUIButtonListItem*> m_itemList;
     int m_nextItemLoaded              {0};
 
+    MythUIButtonListProvider *m_provider {nullptr};
+    int  m_prefetch                   {0};
+    bool m_prefetchPending            {false};
+    mutable QVector<MythUIButtonListItem*> m_providedItems;
+    mutable uint m_providedUse        {0};
+
     bool m_drawFromBottom             {false};
 
     QString     m_lcdTitle;
@@ -17,6 +17,8 @@
 #include <QSize>
 #include <QFile>
 #include <QAtomicInt>
+#include <QBuffer>
+#include <QCache>
 #include <QEventLoop>
 #include <QTimer>
 #include <QScreen>
@@ -31,6 +33,7 @@
 #include "storagegroup.h"
 #include "mythdate.h"
 #include "mthreadpool.h"
+#include "mythmetrics.h"
 
 // mythui headers
 #include "mythprogressdialog.h"
@@ -141,6 +144,11 @@ public:
     QAtomicInteger<qint64> m_maxCacheSize    {30 * 1024 * 1024};
 #endif
 
+    // Encoded copies of the disk cache files, so images dropped from the
+    // cache above are decoded again without reading the disk. The cost is
+    // in KiB. Protected by m_cacheLock.
+    QCache<QString, QByteArray> m_encodedCache {16 * 1024};
+
     QString m_themecachedir;
     QString m_userThemeDir;
 
@@ -162,6 +170,22 @@ int MythUIHelperPrivate::y_override = -1;
 int MythUIHelperPrivate::w_override = -1;
 int MythUIHelperPrivate::h_override = -1;
 
+/// Looked up on every use, which is cheap next to loading an image
+static MythMetricCounter *image_cache_hits(const char *tier)
+{
+    return MythMetrics::Counter("mythtv_ui_image_cache_hits_total",
+                                "Images found in each tier of the image cache",
+                                MythMetrics::Label("tier", tier));
+}
+
+static MythMetricGauge *encoded_cache_bytes(void)
+{
+    static auto *s_bytes = MythMetrics::Gauge(
+        "mythtv_ui_image_cache_encoded_bytes",
+        "Approximate size of the encoded images kept in memory");
+    return s_bytes;
+}
+
 MythUIHelperPrivate::~MythUIHelperPrivate()
 {
     QMutableMapIterator<QString, MythImage *> i(m_imageCache);
@@ -287,9 +311,16 @@ void MythUIHelper::Init(MythUIMenuCallbacks &cbs)
     d->m_maxCacheSize.fetchAndStoreRelease(
         GetMythDB()->GetNumSetting("UIImageCacheSize", 30) * 1024 * 1024);
 
+    {
+        QMutexLocker locker(d->m_cacheLock);
+        d->m_encodedCache.setMaxCost(
+            GetMythDB()->GetNumSetting("UIImageEncodedCacheSize", 16) * 1024);
+    }
+
     LOG(VB_GUI, LOG_INFO, LOC +
-        QString("MythUI Image Cache size set to %1 bytes")
-        .arg(d->m_maxCacheSize.fetchAndAddRelease(0)));
+        QString("MythUI Image Cache size set to %1 bytes, %2 KiB encoded")
+        .arg(d->m_maxCacheSize.fetchAndAddRelease(0))
+        .arg(d->m_encodedCache.maxCost()));
 }
 
 // This init is used for showing the startup UI that is shown
@@ -376,6 +407,8 @@ void MythUIHelper::UpdateImageCache(void)
     }
 
     d->m_cacheTrack.clear();
+    d->m_encodedCache.clear();
+    encoded_cache_bytes()->Set(0);
 
     d->m_cacheSize.fetchAndStoreOrdered(0);
 
@@ -407,6 +440,31 @@ MythImage *MythUIHelper::GetImageFromCache(const QString &url)
     return nullptr;
 }
 
+/**
+ *  \brief Keep the encoded image \p data for \p url, e.g. the PNG in the
+ *         disk cache, so it can be decoded again without reading the disk.
+ */
+void MythUIHelper::CacheEncodedImage(const QString &url, const QByteArray &data)
+{
+    int cost = 1 + (data.size() / 1024);
+
+    QMutexLocker locker(d->m_cacheLock);
+    if (cost > d->m_encodedCache.maxCost())
+        return;
+    d->m_encodedCache.insert(url, new QByteArray(data), cost);
+    encoded_cache_bytes()->Set(d->m_encodedCache.totalCost() * 1024LL);
+}
+
+bool MythUIHelper::GetEncodedImage(const QString &url, QByteArray &data)
+{
+    QMutexLocker locker(d->m_cacheLock);
+    QByteArray *cached = d->m_encodedCache.object(url);
+    if (!cached)
+        return false;
+    data = *cached;
+    return true;
+}
+
 void MythUIHelper::IncludeInCacheSize(MythImage *im)
 {
     if (im)
@@ -444,8 +502,17 @@ MythImage *MythUIHelper::CacheImage(const QString &url, MythImage *im,
         LOG(VB_GUI | VB_FILE, LOG_INFO, LOC +
             QString("Saved to Cache (%1)").arg(dstfile));
 
-        // Save to disk cache
-        im->save(dstfile, "PNG");
+        // Save to disk cache, keeping the encoded copy in memory as well
+        QByteArray data;
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+        if (im->save(&buffer, "PNG"))
+        {
+            QFile file(dstfile);
+            if (file.open(QIODevice::WriteOnly))
+                file.write(data);
+            CacheEncodedImage(url, data);
+        }
     }
 
     // delete the oldest cached images until we fall below threshold.
@@ -548,6 +615,8 @@ void MythUIHelper::RemoveFromCacheByURL(const QString &url)
         d->m_imageCache.remove(url);
         d->m_cacheTrack.remove(url);
     }
+    d->m_encodedCache.remove(url);
+    encoded_cache_bytes()->Set(d->m_encodedCache.totalCost() * 1024LL);
 
     QString dstfile;
 
@@ -566,6 +635,11 @@ void MythUIHelper::RemoveFromCacheByFile(const QString &fname)
 
     d->m_cacheLock->lock();
     QList<QString> m_imageCacheKeys = d->m_imageCache.keys();
+    for (const auto &key : d->m_encodedCache.keys())
+    {
+        if (!d->m_imageCache.contains(key))
+            m_imageCacheKeys.append(key);
+    }
     d->m_cacheLock->unlock();
 
     for (it = m_imageCacheKeys.begin(); it != m_imageCacheKeys.end(); ++it)
@@ -1218,6 +1292,7 @@ MythImage *MythUIHelper::LoadCacheImage(QString srcfile, const QString& label,
         if (d->m_imageCache.contains(label) &&
             d->m_cacheTrack[label] + kImageCacheTimeout > now)
         {
+            image_cache_hits("memory")->Add();
             d->m_imageCache[label]->IncrRef();
             return d->m_imageCache[label];
         }
@@ -1227,6 +1302,8 @@ MythImage *MythUIHelper::LoadCacheImage(QString srcfile, const QString& label,
 
     // Check Memory Cache
     ret = GetImageFromCache(label);
+    if (ret)
+        image_cache_hits("memory")->Add();
 
     // If the image is in the memory or we are not ignoring the disk cache
     // then proceed to check whether the source file is newer than our cached
@@ -1292,8 +1369,25 @@ MythImage *MythUIHelper::LoadCacheImage(QString srcfile, const QString& label,
                 {
                     ret = painter->GetFormatImage();
 
-                    // Load file from disk cache to memory cache
-                    if (ret->Load(cachefilepath))
+                    // Load file from the encoded or disk cache to memory cache
+                    QByteArray data;
+                    if (GetEncodedImage(label, data))
+                    {
+                        image_cache_hits("encoded")->Add();
+                    }
+                    else
+                    {
+                        QFile file(cachefilepath);
+                        if (file.open(QIODevice::ReadOnly))
+                            data = file.readAll();
+                        if (!data.isEmpty())
+                        {
+                            image_cache_hits("disk")->Add();
+                            CacheEncodedImage(label, data);
+                        }
+                    }
+
+                    if (ret->Load(data, cachefilepath))
                     {
                         // Add to ram cache, and skip saving to disk since that is
                         // where we found this in the first place.
@@ -13,6 +13,7 @@
 #define FALLBACK_UI_THEME "Terra"
 
 class MythUIHelperPrivate;
+class QByteArray;
 class MThreadPool;
 class MythPainter;
 class MythImage;
@@ -60,6 +61,8 @@ class MUI_PUBLIC MythUIHelper
     QString GetThemeCacheDir(void);
     QString GetCacheDirByUrl(const QString& url);
 
+    void CacheEncodedImage(const QString &url, const QByteArray &data);
+    bool GetEncodedImage(const QString &url, QByteArray &data);
     void IncludeInCacheSize(MythImage *im);
     void ExcludeFromCacheSize(MythImage *im);
 
@@ -274,10 +274,17 @@ class ImageLoader
             image = painter->GetFormatImage();
             bool ok = false;
 
+            // Decode straight to the forced size, unless a reflection or
+            // rotation is applied first and changes the geometry
+            QSize decodeSize;
+            if (bResize && w > 0 && h > 0 &&
+                !imProps.m_isReflected && !imProps.m_isOriented)
+                decodeSize = QSize(w, h);
+
             if (imageReader)
                 ok = image->Load(imageReader);
             else
-                ok = image->Load(filename);
+                ok = image->Load(filename, decodeSize, imProps.m_preserveAspect);
 
             if (!ok)
             {
@@ -496,6 +503,18 @@ class ImageLoadThread : public QRunnable
         bool aborted = false;
         QString filename =  m_imageProperties.m_filename;
 
+        // Don't decode an image the widget no longer wants, e.g. a list row
+        // that was scrolled past and given another image while queued
+        if (!m_parent->WantsImage(m_basefile))
+        {
+            auto *le = new ImageLoadEvent(m_parent,
+                                          static_cast<MythImage *>(nullptr),
+                                          m_basefile, filename,
+                                          m_number, true);
+            QCoreApplication::postEvent(m_parent, le);
+            return;
+        }
+
         // NOTE Do NOT use MythImageReader::supportsAnimation here, it defeats
         // the point of caching remote images
         if (ImageLoader::SupportsAnimation(filename))
@@ -962,6 +981,16 @@ void MythUIImage::SetCropRect(const MythRect &rect)
     SetRedraw();
 }
 
+/**
+ *  \brief Whether a load started for \p basefile is still wanted, called
+ *         from the loading threads.
+ */
+bool MythUIImage::WantsImage(const QString &basefile)
+{
+    QReadLocker updateLocker(&d->m_updateLock);
+    return m_imageProperties.m_filename == basefile;
+}
+
 /**
  *  \brief Load the image(s), wraps ImageLoader::LoadImage()
  */
@@ -1047,7 +1076,11 @@ bool MythUIImage::Load(bool allowLoadInBackground, bool forceStat)
             auto *bImgThread = new ImageLoadThread(this, GetPainter(),
                                     imProps, bFilename, i,
                                     static_cast<ImageCacheMode>(cacheMode2));
-            GetMythUI()->GetImageThreadPool()->start(bImgThread, "ImageLoad");
+            // Lower values run first, so images already on screen are
+            // loaded ahead of those that aren't shown yet
+            int priority = IsVisible(true) ? 0 : 1;
+            GetMythUI()->GetImageThreadPool()->start(bImgThread, "ImageLoad",
+                                                     priority);
         }
         else
         {
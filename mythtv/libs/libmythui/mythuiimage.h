@@ -163,6 +163,7 @@ class MUI_PUBLIC MythUIImage : public MythUIType
     void SetCropRect(const MythRect &rect);
 
     void FindRandomImage(void);
+    bool WantsImage(const QString &basefile);
 
     QString m_filename;
     QString m_origFilename;
@@ -9,9 +9,12 @@
 #include <QFontMetrics>
 #include <QString>
 #include <QHash>
+#include <QCache>
+#include <QMutex>
 #include <QRegularExpression>
 
 #include "mythlogging.h"
+#include "mythmetrics.h"
 
 #include "mythuihelper.h"
 #include "mythpainter.h"
@@ -21,6 +24,108 @@
 
 #include "compat.h"
 
+/** \class MythUITextLayout
+ *  \brief Text laid out by MythUIText::FillCutMessage(), shared by every
+ *         widget showing the same message with the same font, area and flags.
+ *
+ *  Button lists and guide grids set the same strings on their widgets over
+ *  and over as they scroll, so the line breaking, eliding and narrowing is
+ *  done once and the QTextLayouts are reused. Since the painter caches the
+ *  rendered image by font and layout text, the image is reused as well.
+ *
+ *  Cached layouts are never changed. A widget whose text changes lays it
+ *  out into its own QTextLayouts, which then go into the cache.
+ */
+class MythUITextLayout
+{
+  public:
+    ~MythUITextLayout()
+    {
+        for (auto *layout : qAsConst(m_layouts))
+            delete layout;
+    }
+
+    QVector<QTextLayout *> m_layouts;
+    QRectF m_minRect;
+    QSize  m_drawSize;
+    QRect  m_canvas;
+    int    m_ascent       {0};
+    int    m_descent      {0};
+    int    m_leftBearing  {0};
+    int    m_rightBearing {0};
+};
+
+using LayoutPtr = QSharedPointer<MythUITextLayout>;
+
+/// Roughly one unit per short string, long descriptions cost more
+static constexpr int kLayoutCacheCost = 4096;
+
+static QMutex                     s_layoutLock;
+static QCache<QString, LayoutPtr> s_layoutCache(kLayoutCacheCost); // protected by s_layoutLock
+
+static MythMetricCounter *layout_hits(void)
+{
+    static auto *s_hits = MythMetrics::Counter(
+        "mythtv_ui_text_layout_cache_hits_total",
+        "Text layouts reused from the MythUIText layout cache");
+    return s_hits;
+}
+
+static MythMetricCounter *layout_misses(void)
+{
+    static auto *s_misses = MythMetrics::Counter(
+        "mythtv_ui_text_layout_cache_misses_total",
+        "Text layouts not found in the MythUIText layout cache");
+    return s_misses;
+}
+
+static MythMetricGauge *layout_entries(void)
+{
+    static auto *s_entries = MythMetrics::Gauge(
+        "mythtv_ui_text_layout_cache_entries",
+        "Text layouts in the MythUIText layout cache");
+    return s_entries;
+}
+
+static LayoutPtr find_layout(const QString &key)
+{
+    QMutexLocker locker(&s_layoutLock);
+    LayoutPtr *layout = s_layoutCache.object(key);
+    if (layout == nullptr)
+    {
+        layout_misses()->Add();
+        return {};
+    }
+    layout_hits()->Add();
+    return *layout;
+}
+
+static void add_layout(const QString &key, const LayoutPtr &layout)
+{
+    QMutexLocker locker(&s_layoutLock);
+    s_layoutCache.insert(key, new LayoutPtr(layout), 1 + (key.size() / 64));
+    layout_entries()->Set(s_layoutCache.size());
+}
+
+MythUIText::LayoutCacheStats MythUIText::GetLayoutCacheStats(void)
+{
+    LayoutCacheStats stats;
+    stats.m_hits = layout_hits()->Value();
+    stats.m_misses = layout_misses()->Value();
+
+    QMutexLocker locker(&s_layoutLock);
+    stats.m_entries = s_layoutCache.size();
+    return stats;
+}
+
+/// \brief Forgets all cached layouts, e.g. after the theme or fonts change.
+void MythUIText::ClearLayoutCache(void)
+{
+    QMutexLocker locker(&s_layoutLock);
+    s_layoutCache.clear();
+    layout_entries()->Set(0);
+}
+
 MythUIText::MythUIText(MythUIType *parent, const QString &name)
     : MythUIType(parent, name),
       m_font(new MythFontProperties())
@@ -77,8 +182,11 @@ MythUIText::~MythUIText()
     delete m_font;
     m_font = nullptr;
 
-    for (auto *layout : qAsConst(m_layouts))
-        delete layout;
+    if (m_sharedLayout.isNull())
+    {
+        for (auto *layout : qAsConst(m_layouts))
+            delete layout;
+    }
 }
 
 void MythUIText::Reset()
@@ -786,6 +894,58 @@ bool MythUIText::GetNarrowWidth(const QStringList & paragraphs,
     return false;
 }
 
+/**
+ *  \brief Returns the key of the current text in the layout cache.
+ *
+ *  It covers everything the layout depends on: the text after templates
+ *  and case changes, the font, the area and the layout flags. The height
+ *  of the draw rect is included since narrowing and cutting down read it.
+ */
+QString MythUIText::LayoutCacheKey(void) const
+{
+    return m_font->GetHash() +
+        QString("|%1|%2|%3|%4|%5|%6|%7|%8|%9|")
+        .arg(m_area.width()).arg(m_area.height()).arg(m_drawRect.height())
+        .arg(m_justification).arg(static_cast<int>(m_cutdown))
+        .arg(static_cast<int>(m_multiLine))
+        .arg(static_cast<int>(m_shrinkNarrow))
+        .arg(static_cast<int>(m_minSize.isValid())).arg(m_extraLeading) +
+        m_cutMessage;
+}
+
+/// \brief Shows a cached layout, releasing the widget's own layouts.
+void MythUIText::UseLayout(const LayoutPtr &layout, QRectF &min_rect)
+{
+    if (m_sharedLayout.isNull())
+    {
+        for (auto *old : qAsConst(m_layouts))
+            delete old;
+    }
+
+    m_sharedLayout = layout;
+    m_layouts = layout->m_layouts;
+    min_rect = layout->m_minRect;
+    m_drawRect.setWidth(layout->m_drawSize.width());
+    m_drawRect.setHeight(layout->m_drawSize.height());
+    m_canvas.setRect(layout->m_canvas.x(), layout->m_canvas.y(),
+                     layout->m_canvas.width(), layout->m_canvas.height());
+    m_ascent = layout->m_ascent;
+    m_descent = layout->m_descent;
+    m_leftBearing = layout->m_leftBearing;
+    m_rightBearing = layout->m_rightBearing;
+}
+
+/// \brief Stops using a cached layout, so the widget can lay out new text.
+void MythUIText::DetachLayout(void)
+{
+    if (m_sharedLayout.isNull())
+        return;
+
+    // The QTextLayouts belong to the cache entry
+    m_layouts.clear();
+    m_sharedLayout.reset();
+}
+
 void MythUIText::FillCutMessage(void)
 {
     if (m_area.isNull())
@@ -822,6 +982,7 @@ void MythUIText::FillCutMessage(void)
 
     if (m_cutMessage.isEmpty())
     {
+        DetachLayout();
         if (m_layouts.empty())
             m_layouts.push_back(new QTextLayout);
 
@@ -881,46 +1042,84 @@ void MythUIText::FillCutMessage(void)
                 break;
         }
 
-        QTextOption textoption(static_cast<Qt::Alignment>(m_justification));
-        textoption.setWrapMode(QTextOption::WrapAtWordBoundaryOrAnywhere);
+        // Font templates are looked up in this widget's font map, so
+        // another widget may format the same text differently
+        bool cacheable = !m_cutMessage.contains("[font]", Qt::CaseInsensitive);
+        QString key;
+        LayoutPtr cached;
+        if (cacheable)
+        {
+            key = LayoutCacheKey();
+            cached = find_layout(key);
+        }
+
+        if (cached)
+        {
+            UseLayout(cached, min_rect);
+        }
+        else
+        {
+            DetachLayout();
+
+            QTextOption textoption(static_cast<Qt::Alignment>(m_justification));
+            textoption.setWrapMode(QTextOption::WrapAtWordBoundaryOrAnywhere);
 
 #if QT_VERSION < QT_VERSION_CHECK(5,14,0)
-        QStringList paragraphs = m_cutMessage.split('\n',
-                                                    QString::KeepEmptyParts);
+            QStringList paragraphs = m_cutMessage.split('\n',
+                                                        QString::KeepEmptyParts);
 #else
-        QStringList paragraphs = m_cutMessage.split('\n', Qt::KeepEmptyParts);
+            QStringList paragraphs = m_cutMessage.split('\n', Qt::KeepEmptyParts);
 #endif
 
-        for (int idx = m_layouts.size(); idx < paragraphs.size(); ++idx)
-            m_layouts.push_back(new QTextLayout);
+            for (int idx = m_layouts.size(); idx < paragraphs.size(); ++idx)
+                m_layouts.push_back(new QTextLayout);
+            while (m_layouts.size() > paragraphs.size())
+                delete m_layouts.takeLast();
 
-        qreal width = NAN;
-        if (m_multiLine && m_shrinkNarrow &&
-            m_minSize.isValid() && !m_cutMessage.isEmpty())
-            GetNarrowWidth(paragraphs, textoption, width);
-        else
-            width = m_area.width();
-
-        qreal height = 0;
-        m_leftBearing = m_rightBearing = 0;
-        int   num_lines = 0;
-        qreal last_line_width = NAN;
-        LayoutParagraphs(paragraphs, textoption, width, height,
-                         min_rect, last_line_width, num_lines, true);
+            qreal width = NAN;
+            if (m_multiLine && m_shrinkNarrow &&
+                m_minSize.isValid() && !m_cutMessage.isEmpty())
+                GetNarrowWidth(paragraphs, textoption, width);
+            else
+                width = m_area.width();
+
+            qreal height = 0;
+            m_leftBearing = m_rightBearing = 0;
+            int   num_lines = 0;
+            qreal last_line_width = NAN;
+            LayoutParagraphs(paragraphs, textoption, width, height,
+                             min_rect, last_line_width, num_lines, true);
+
+            m_canvas.setRect(0, 0, min_rect.x() + min_rect.width(), height);
+
+            /**
+             * FontMetrics::height() returns a value that is good for spacing
+             * the lines, but may not represent the *full* height.  We need
+             * to make sure we have enough space for the *full* height or
+             * characters could be clipped.
+             */
+            QRect actual = fm.boundingRect(m_cutMessage);
+            m_ascent = -(actual.y() + fm.ascent());
+            m_descent = actual.height() - fm.height();
+
+            if (cacheable)
+            {
+                auto layout = LayoutPtr::create();
+                layout->m_layouts = m_layouts;
+                layout->m_minRect = min_rect;
+                layout->m_drawSize = m_drawRect.size();
+                layout->m_canvas = m_canvas;
+                layout->m_ascent = m_ascent;
+                layout->m_descent = m_descent;
+                layout->m_leftBearing = m_leftBearing;
+                layout->m_rightBearing = m_rightBearing;
+                m_sharedLayout = layout;
+                add_layout(key, layout);
+            }
+        }
 
-        m_canvas.setRect(0, 0, min_rect.x() + min_rect.width(), height);
         m_scrollPause = m_scrollStartDelay; // ????
         m_scrollBounce = false;
-
-        /**
-         * FontMetrics::height() returns a value that is good for spacing
-         * the lines, but may not represent the *full* height.  We need
-         * to make sure we have enough space for the *full* height or
-         * characters could be clipped.
-         */
-        QRect actual = fm.boundingRect(m_cutMessage);
-        m_ascent = -(actual.y() + fm.ascent());
-        m_descent = actual.height() - fm.height();
     }
 
     if (m_scrolling)
@@ -1,9 +1,13 @@
 #ifndef MYTHUI_TEXT_H_
 #define MYTHUI_TEXT_H_
 
+// C++ headers
+#include <cstdint>
+
 // QT headers
 #include <QTextLayout>
 #include <QColor>
+#include <QSharedPointer>
 
 // Mythbase headers
 #include "mythstorage.h"
@@ -14,6 +18,7 @@
 #include "mythmainwindow.h" // for MythMainWindow::drawRefresh
 
 class MythFontProperties;
+class MythUITextLayout;
 
 /**
  *  \class MythUIText
@@ -65,6 +70,16 @@ class MUI_PUBLIC MythUIText : public MythUIType, public StorageUser
     void SetFontState(const QString &state);
     void SetJustification(int just);
 
+    /// Lookups of the layout cache shared by every MythUIText
+    struct LayoutCacheStats
+    {
+        uint64_t m_hits    {0};
+        uint64_t m_misses  {0};
+        int      m_entries {0};
+    };
+    static LayoutCacheStats GetLayoutCacheStats(void);
+    static void ClearLayoutCache(void);
+
   protected:
     void DrawSelf(MythPainter *p, int xoffset, int yoffset,
                           int alphaMod, QRect clipRect) override; // MythUIType
@@ -105,6 +120,10 @@ class MUI_PUBLIC MythUIText : public MythUIType, public StorageUser
     bool GetNarrowWidth(const QStringList & paragraphs,
                         const QTextOption & textoption, qreal & width);
     void FillCutMessage(void);
+    QString LayoutCacheKey(void) const;
+    void UseLayout(const QSharedPointer<MythUITextLayout> &layout,
+                   QRectF &min_rect);
+    void DetachLayout(void);
 
     int      m_justification      {Qt::AlignLeft | Qt::AlignTop};
     MythRect m_origDisplayRect;
@@ -134,6 +153,8 @@ class MUI_PUBLIC MythUIText : public MythUIType, public StorageUser
     int  m_textCursor             {-1};
 
     QVector<QTextLayout *> m_layouts;
+    /// Owns m_layouts when they came from, or were added to, the layout cache
+    QSharedPointer<MythUITextLayout> m_sharedLayout;
 
     MythFontProperties* m_font    {nullptr};
     FontStates          m_fontStates;
@@ -1,4 +1,5 @@
 // C++
+#include <algorithm>
 #include <utility>
 
 // MythTV
@@ -91,3 +92,18 @@ void MythOpenGLPerf::LogSamples(void)
     m_timersRunning = 0;
     reset();
 }
+
+/// \brief Add the draw calls for one frame, logging the average and worst frame periodically
+void MythOpenGLPerf::RecordDrawCalls(uint64_t Count)
+{
+    m_drawCalls += Count;
+    m_maxDrawCalls = std::max(m_maxDrawCalls, Count);
+    if (++m_drawCallFrames < m_totalSamples)
+        return;
+
+    LOG(VB_GPU, LOG_INFO, m_name + QString("Draw calls per frame: average %1 max %2")
+        .arg(static_cast<double>(m_drawCalls) / m_drawCallFrames, 0, 'f', 1).arg(m_maxDrawCalls));
+    m_drawCallFrames = 0;
+    m_drawCalls = 0;
+    m_maxDrawCalls = 0;
+}
@@ -40,6 +40,7 @@ class MUI_PUBLIC MythOpenGLPerf : public QOpenGLTimeMonitor
     MythOpenGLPerf(QString Name, QVector<QString> Names, int SampleCount = 30);
     void RecordSample    (void);
     void LogSamples      (void);
+    void RecordDrawCalls (uint64_t Count);
     int  GetTimersRunning(void) const;
 
   private:
@@ -50,6 +51,9 @@ class MUI_PUBLIC MythOpenGLPerf : public QOpenGLTimeMonitor
     int  m_timersRunning           { 0 };
     QVector<GLuint64> m_timerData  { 0 };
     QVector<QString>  m_timerNames { };
+    int      m_drawCallFrames      { 0 };
+    uint64_t m_drawCalls           { 0 };
+    uint64_t m_maxDrawCalls        { 0 };
 };
 
 #endif // MYTHOPENGLPERF_H
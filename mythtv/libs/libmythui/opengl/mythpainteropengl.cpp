@@ -6,19 +6,30 @@
 #include <QPainter>
 
 // MythTV
+#include "mythmetrics.h"
 #include "mythrenderopengl.h"
+#include "mythopenglperf.h"
 #include "mythpainteropengl.h"
 
+// Std
+#include <algorithm>
+
 using namespace std;
 
+/// Images larger than this in either dimension get a texture of their own
+const int MythOpenGLPainter::kAtlasMaxImageSize = 256;
+const int MythOpenGLPainter::kAtlasMaxPages     = 4;
+/// Edge pixels are repeated into this border around each atlas image
+static constexpr int kAtlasPadding = 1;
+
 MythOpenGLPainter::MythOpenGLPainter(MythRenderOpenGL *Render, QWidget *Parent)
   : MythPainterGPU(Parent),
     m_render(Render)
 {
-    m_mappedTextures.reserve(MAX_BUFFER_POOL);
-
     if (!m_render)
         LOG(VB_GENERAL, LOG_ERR, "OpenGL painter has no render device");
+
+    m_retainEnabled = qEnvironmentVariableIsEmpty("MYTHTV_NO_PARTIAL_REDRAW");
 }
 
 MythOpenGLPainter::~MythOpenGLPainter()
@@ -40,16 +51,11 @@ void MythOpenGLPainter::FreeResources(void)
 {
     OpenGLLocker locker(m_render);
     ClearCache();
+    ClearAtlas();
+    DeleteRetained();
     DeleteTextures();
-    if (m_mappedBufferPoolReady)
-    {
-        for (auto & buf : m_mappedBufferPool)
-        {
-            delete buf;
-            buf = nullptr;
-        }
-        m_mappedBufferPoolReady = false;
-    }
+    delete m_openGLPerf;
+    m_openGLPerf = nullptr;
 
     MythPainterGPU::FreeResources();
 }
@@ -102,14 +108,6 @@ void MythOpenGLPainter::Begin(QPaintDevice *Parent)
         return;
     }
 
-    if (!m_mappedBufferPoolReady)
-    {
-        m_mappedBufferPoolReady = true;
-        // initialise the VBO pool
-        for (auto & buf : m_mappedBufferPool)
-            buf = m_render->CreateVBO(static_cast<int>(MythRenderOpenGL::kVertexSize));
-    }
-
     QSize currentsize = m_widget->size();
 
     // check if we need to adjust cache sizes
@@ -131,24 +129,105 @@ void MythOpenGLPainter::Begin(QPaintDevice *Parent)
         m_render->logDebugMarker("PAINTER_FRAME_START");
 
     DeleteTextures();
+    ReleaseAtlasSlots();
     m_render->makeCurrent();
 
-    // If master (have complete swap control) then bind default framebuffer and clear
+    m_frameCount++;
+    m_frameDrawCalls = m_render->GetDrawCallCount();
+    if (VERBOSE_LEVEL_CHECK(VB_GPU, LOG_INFO) && !m_openGLPerf)
+        m_openGLPerf = new MythOpenGLPerf("GLPaintPerf: ", { "Render:" });
+    if (m_openGLPerf)
+        m_openGLPerf->RecordSample();
+
+    // If using high DPI then scale the viewport
+    if (m_usingHighDPI && m_viewControl.testFlag(Viewport))
+        currentsize *= m_pixelRatio;
+
+    // If master (have complete swap control) then draw into the retained
+    // framebuffer if possible (or the default framebuffer) and clear it unless
+    // only the changed areas are being drawn
+    m_retaining = false;
     if (m_viewControl.testFlag(Framebuffer))
     {
-        m_render->BindFramebuffer(nullptr);
+        if (m_retainEnabled && (!m_retainedFramebuffer || m_retainedFramebuffer->size() != currentsize))
+        {
+            DeleteRetained();
+            m_retainedFramebuffer = m_render->CreateFramebuffer(currentsize);
+            m_retainedTexture = m_render->CreateFramebufferTexture(m_retainedFramebuffer);
+            if (!m_retainedTexture)
+            {
+                LOG(VB_GENERAL, LOG_INFO, "No framebuffer for partial redraws - drawing full frames");
+                DeleteRetained();
+                m_retainEnabled = false;
+            }
+        }
+        m_retaining = m_retainedTexture != nullptr;
+        m_render->BindFramebuffer(m_retaining ? m_retainedFramebuffer : nullptr);
         m_render->SetBackground(0, 0, 0, 255);
-        m_render->ClearFramebuffer();
+        if (!m_retainedValid)
+            m_render->ClearFramebuffer();
+    }
+    else
+    {
+        // Whatever we draw is mixed with video, so nothing can be retained
+        m_retainedValid = false;
     }
 
     // If we have viewport control, set as needed.
     if (m_viewControl.testFlag(Viewport))
-    {
-        // If using high DPI then scale the viewport
-        if (m_usingHighDPI)
-            currentsize *= m_pixelRatio;
         m_render->SetViewPort(QRect(0, 0, currentsize.width(), currentsize.height()));
+}
+
+QRect MythOpenGLPainter::ToScissor(const QRect &Area) const
+{
+    if (m_usingHighDPI && m_viewControl.testFlag(Viewport))
+    {
+        return QRectF(Area.left() * m_pixelRatio, Area.top() * m_pixelRatio,
+                      Area.width() * m_pixelRatio, Area.height() * m_pixelRatio).toAlignedRect();
     }
+    return Area;
+}
+
+/*! \brief Limit drawing to the given area.
+ *
+ * Only used when drawing into the retained framebuffer, where everything
+ * outside of the area is left from the previous frame.
+*/
+void MythOpenGLPainter::SetClipRect(const QRect &Area)
+{
+    if (m_render && m_retaining)
+        m_render->SetScissor(ToScissor(Area));
+}
+
+/// \brief Clear the areas of the retained framebuffer about to be redrawn.
+void MythOpenGLPainter::Clear(QPaintDevice* /*Device*/, const QRegion &Region)
+{
+    if (!m_render || !m_retaining)
+        return;
+
+    for (const QRect &area : Region)
+    {
+        m_render->SetScissor(ToScissor(area));
+        m_render->ClearFramebuffer();
+    }
+    m_render->SetScissor(QRect());
+}
+
+/*! \brief Outline the areas drawn in this frame.
+ *
+ * When drawing into the retained framebuffer the outlines are drawn over the
+ * copy on screen instead, so they don't linger in later frames.
+*/
+void MythOpenGLPainter::DrawRedrawOutlines(const QVector<QRect> &Areas,
+                                           const QColor &Colour)
+{
+    if (!m_retaining)
+    {
+        MythPainterGPU::DrawRedrawOutlines(Areas, Colour);
+        return;
+    }
+    m_redrawOutlines = Areas;
+    m_redrawColour = Colour;
 }
 
 void MythOpenGLPainter::End(void)
@@ -159,6 +238,31 @@ void MythOpenGLPainter::End(void)
         return;
     }
 
+    m_render->FlushBatch();
+
+    // Copy the retained framebuffer to the screen
+    if (m_retaining)
+    {
+        m_render->SetScissor(QRect());
+        m_render->BindFramebuffer(nullptr);
+        QRect area(QPoint(0, 0), m_retainedFramebuffer->size());
+        m_render->SetBlend(false);
+        m_render->DrawBitmap(m_retainedTexture, nullptr, area, area, nullptr);
+        m_render->SetBlend(true);
+        m_retainedValid = true;
+
+        if (!m_redrawOutlines.isEmpty())
+        {
+            m_retaining = false;
+            MythPainterGPU::DrawRedrawOutlines(m_redrawOutlines, m_redrawColour);
+            m_render->FlushBatch();
+            m_redrawOutlines.clear();
+        }
+    }
+
+    if (m_openGLPerf)
+        m_openGLPerf->RecordSample();
+
     if (VERBOSE_LEVEL_CHECK(VB_GPU, LOG_INFO))
         m_render->logDebugMarker("PAINTER_FRAME_END");
 
@@ -167,9 +271,18 @@ void MythOpenGLPainter::End(void)
         m_render->Flush();
         m_render->swapBuffers();
     }
+
+    static auto *s_drawCalls = MythMetrics::Gauge(
+        "mythtv_ui_draw_calls", "OpenGL draw calls in the last UI frame");
+    uint64_t drawcalls = m_render->GetDrawCallCount() - m_frameDrawCalls;
+    s_drawCalls->Set(static_cast<int64_t>(drawcalls));
+    if (m_openGLPerf)
+    {
+        m_openGLPerf->RecordDrawCalls(drawcalls);
+        m_openGLPerf->LogSamples();
+    }
     m_render->doneCurrent();
 
-    m_mappedTextures.clear();
     MythPainterGPU::End();
 }
 
@@ -257,26 +370,191 @@ void MythOpenGLPainter::DrawImage(const QRect &Dest, MythImage *Image,
                            static_cast<int>(Dest.height() * pixelratio));
 #endif
 
-        // Drawing an image multiple times with the same VBO will stall most GPUs as
-        // the VBO is re-mapped whilst still in use. Use a pooled VBO instead.
-        MythGLTexture *texture = GetTextureFromCache(Image);
-        if (texture && m_mappedTextures.contains(texture))
+        // Images are queued rather than drawn, so that consecutive images from
+        // the same texture (or atlas page) become a single draw call
+        QRect source = Source;
+        MythGLTexture *texture = nullptr;
+        if (Image->width() <= kAtlasMaxImageSize && Image->height() <= kAtlasMaxImageSize)
+            texture = GetTextureFromAtlas(Image, source);
+        if (!texture)
+        {
+            source = Source;
+            texture = GetTextureFromCache(Image);
+        }
+        m_render->QueueBitmap(texture, source, DEST, Alpha, pixelratio);
+    }
+}
+
+/*! \brief Return the atlas page holding the given image.
+ *
+ * \param Source Updated from the image's coordinates to the page's.
+ * \return The page texture or nullptr if the image could not be added.
+*/
+MythGLTexture* MythOpenGLPainter::GetTextureFromAtlas(MythImage *Image, QRect &Source)
+{
+    if (!m_render || Image->isNull())
+        return nullptr;
+
+    ReleaseAtlasSlots();
+
+    auto slot = m_atlasSlots.find(Image);
+    if (slot != m_atlasSlots.end() && Image->IsChanged())
+    {
+        QSize padded = Image->size() + QSize(kAtlasPadding * 2, kAtlasPadding * 2);
+        if (slot->m_area.size() == padded)
         {
-            QOpenGLBuffer *vbo = texture->m_vbo;
-            texture->m_vbo = m_mappedBufferPool[m_mappedBufferPoolIdx];
-            texture->m_destination = QRect();
-            m_render->DrawBitmap(texture, nullptr, Source, DEST, nullptr, Alpha, pixelratio);
-            texture->m_destination = QRect();
-            texture->m_vbo = vbo;
-            if (++m_mappedBufferPoolIdx >= MAX_BUFFER_POOL)
-                m_mappedBufferPoolIdx = 0;
+            UploadToAtlas(Image);
         }
         else
         {
-            m_render->DrawBitmap(texture, nullptr, Source, DEST, nullptr, Alpha, pixelratio);
-            m_mappedTextures.append(texture);
+            ReleaseAtlasSlot(Image);
+            slot = m_atlasSlots.end();
         }
     }
+
+    if (slot == m_atlasSlots.end())
+    {
+        // The image may have had a texture of its own before it was resized
+        DeleteImageTexture(Image);
+        if (!AddToAtlas(Image))
+            return nullptr;
+        slot = m_atlasSlots.find(Image);
+    }
+
+    Image->SetChanged(false);
+    AtlasPage &page = m_atlasPages[static_cast<size_t>(slot->m_page)];
+    page.m_lastUsed = m_frameCount;
+    QPoint offset = slot->m_area.topLeft() + QPoint(kAtlasPadding, kAtlasPadding);
+    Source = Source.intersected(QRect(QPoint(0, 0), Image->size())).translated(offset);
+    return page.m_texture;
+}
+
+bool MythOpenGLPainter::AddToAtlas(MythImage *Image)
+{
+    if (!m_atlasPageSize)
+        m_atlasPageSize = min(1024, m_render->GetMaxTextureSize());
+    if (m_atlasPageSize < kAtlasMaxImageSize * 2)
+        return false;
+
+    QSize size = Image->size() + QSize(kAtlasPadding * 2, kAtlasPadding * 2);
+    int page = 0;
+    QRect area;
+    for ( ; page < static_cast<int>(m_atlasPages.size()); ++page)
+    {
+        area = m_atlasPages[static_cast<size_t>(page)].m_packer.Add(size);
+        if (area.isValid())
+            break;
+    }
+
+    if (!area.isValid())
+    {
+        if (static_cast<int>(m_atlasPages.size()) < kAtlasMaxPages)
+        {
+            QImage blank(m_atlasPageSize, m_atlasPageSize, QImage::Format_ARGB32);
+            blank.fill(Qt::transparent);
+            MythGLTexture *texture = m_render->CreateTextureFromQImage(&blank);
+            if (!texture)
+                return false;
+            AtlasPage newpage;
+            newpage.m_texture = texture;
+            newpage.m_packer = MythAtlasPacker(blank.size());
+            m_atlasPages.push_back(newpage);
+            page = static_cast<int>(m_atlasPages.size()) - 1;
+            LOG(VB_GPU, LOG_INFO, QString("Created %1x%1 texture atlas page %2")
+                .arg(m_atlasPageSize).arg(page));
+        }
+        else
+        {
+            // Recycle the least recently used page, unless this frame needs it
+            auto lru = min_element(m_atlasPages.cbegin(), m_atlasPages.cend(),
+                [](const AtlasPage &First, const AtlasPage &Second)
+                { return First.m_lastUsed < Second.m_lastUsed; });
+            if (lru->m_lastUsed == m_frameCount)
+                return false;
+            page = static_cast<int>(lru - m_atlasPages.cbegin());
+            ResetAtlasPage(page);
+        }
+        area = m_atlasPages[static_cast<size_t>(page)].m_packer.Add(size);
+        if (!area.isValid())
+            return false;
+    }
+
+    m_atlasSlots.insert(Image, { page, area });
+    m_atlasPages[static_cast<size_t>(page)].m_images++;
+    CheckFormatImage(Image);
+    UploadToAtlas(Image);
+    return true;
+}
+
+/*! \brief Copy an image into its area of the atlas.
+ *
+ * The edge pixels are repeated into the padding around the image, so that
+ * filtering at its edges never samples its neighbours.
+*/
+void MythOpenGLPainter::UploadToAtlas(MythImage *Image)
+{
+    AtlasSlot slot = m_atlasSlots.value(Image);
+    AtlasPage &page = m_atlasPages[static_cast<size_t>(slot.m_page)];
+
+    // Queued draws may still read the area being replaced
+    if (page.m_lastUsed == m_frameCount)
+        m_render->FlushBatch();
+
+    QImage image = Image->convertToFormat(QImage::Format_RGBA8888);
+    QImage padded(slot.m_area.size(), QImage::Format_RGBA8888);
+    int width  = image.width();
+    int height = image.height();
+    for (int y = 0; y < padded.height(); ++y)
+    {
+        auto *dst = reinterpret_cast<quint32*>(padded.scanLine(y));
+        const auto *src = reinterpret_cast<const quint32*>(
+            image.constScanLine(clamp(y - kAtlasPadding, 0, height - 1)));
+        fill(dst, dst + kAtlasPadding, src[0]);
+        copy(src, src + width, dst + kAtlasPadding);
+        fill(dst + kAtlasPadding + width, dst + padded.width(), src[width - 1]);
+    }
+
+    OpenGLLocker locker(m_render);
+    page.m_texture->m_texture->bind();
+    m_render->glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    m_render->glTexSubImage2D(GL_TEXTURE_2D, 0, slot.m_area.left(), slot.m_area.top(),
+                              padded.width(), padded.height(), GL_RGBA,
+                              GL_UNSIGNED_BYTE, padded.constBits());
+    page.m_texture->m_texture->release();
+}
+
+void MythOpenGLPainter::ResetAtlasPage(int Page)
+{
+    for (auto it = m_atlasSlots.begin(); it != m_atlasSlots.end(); )
+        it = (it->m_page == Page) ? m_atlasSlots.erase(it) : ++it;
+    AtlasPage &page = m_atlasPages[static_cast<size_t>(Page)];
+    page.m_packer.Reset();
+    page.m_images = 0;
+}
+
+void MythOpenGLPainter::DeleteRetained(void)
+{
+    if (m_render)
+    {
+        m_render->DeleteTexture(m_retainedTexture);
+        m_render->DeleteFramebuffer(m_retainedFramebuffer);
+    }
+    m_retainedTexture = nullptr;
+    m_retainedFramebuffer = nullptr;
+    m_retainedValid = false;
+}
+
+void MythOpenGLPainter::ClearAtlas(void)
+{
+    {
+        QMutexLocker locker(&m_textureDeleteLock);
+        m_atlasReleaseList.clear();
+    }
+    m_atlasSlots.clear();
+    for (auto & page : m_atlasPages)
+        m_render->DeleteTexture(page.m_texture);
+    m_atlasPages.clear();
+    m_atlasPageSize = 0;
 }
 
 /*! \brief Draw a rectangle
@@ -314,7 +592,20 @@ void MythOpenGLPainter::DrawRoundRect(const QRect &Area, int CornerRadius,
     MythPainterGPU::DrawRoundRect(Area, CornerRadius, FillBrush, LinePen, Alpha);
 }
 
+/*! \brief Release the image's texture and its area of the atlas.
+ *
+ * This may be called from any thread, with only MythPainter's allocation lock
+ * held, so the atlas area is released later on the UI thread.
+*/
 void MythOpenGLPainter::DeleteFormatImagePriv(MythImage *Image)
+{
+    DeleteImageTexture(Image);
+
+    QMutexLocker locker(&m_textureDeleteLock);
+    m_atlasReleaseList.push_back(Image);
+}
+
+void MythOpenGLPainter::DeleteImageTexture(MythImage *Image)
 {
     if (m_imageToTextureMap.contains(Image))
     {
@@ -325,6 +616,35 @@ void MythOpenGLPainter::DeleteFormatImagePriv(MythImage *Image)
     }
 }
 
+/*! \brief Release the atlas areas of deleted images.
+ *
+ * Done before any atlas lookup, as a new image may have been allocated at the
+ * address of a deleted one.
+*/
+void MythOpenGLPainter::ReleaseAtlasSlots(void)
+{
+    std::list<MythImage*> released;
+    {
+        QMutexLocker locker(&m_textureDeleteLock);
+        released.swap(m_atlasReleaseList);
+    }
+    for (auto * image : released)
+        ReleaseAtlasSlot(image);
+}
+
+void MythOpenGLPainter::ReleaseAtlasSlot(MythImage *Image)
+{
+    auto slot = m_atlasSlots.find(Image);
+    if (slot != m_atlasSlots.end())
+    {
+        // The space is reclaimed once nothing on the page is in use
+        AtlasPage &page = m_atlasPages[static_cast<size_t>(slot->m_page)];
+        m_atlasSlots.erase(slot);
+        if (--page.m_images < 1)
+            page.m_packer.Reset();
+    }
+}
+
 void MythOpenGLPainter::PushTransformation(const UIEffects &Fx, QPointF Center)
 {
     if (m_render)
@@ -2,24 +2,26 @@
 #define MYTHPAINTER_OPENGL_H_
 
 // Qt
+#include <QColor>
+#include <QHash>
 #include <QMutex>
 #include <QQueue>
 
 // MythTV
 #include "mythpaintergpu.h"
 #include "mythimage.h"
+#include "mythatlaspacker.h"
 
 // Std
 #include <list>
+#include <vector>
 
 class QWidget;
 class MythGLTexture;
 class MythRenderOpenGL;
-class QOpenGLBuffer;
+class MythOpenGLPerf;
 class QOpenGLFramebufferObject;
 
-#define MAX_BUFFER_POOL 70
-
 class MUI_PUBLIC MythOpenGLPainter : public MythPainterGPU
 {
     Q_OBJECT
@@ -33,10 +35,13 @@ class MUI_PUBLIC MythOpenGLPainter : public MythPainterGPU
     QString GetName(void) override { return QString("OpenGL"); }
     bool SupportsAnimation(void) override { return true; }
     bool SupportsAlpha(void) override { return true; }
-    bool SupportsClipping(void) override { return false; }
+    bool SupportsClipping(void) override { return m_retainedValid; }
     void FreeResources(void) override;
     void Begin(QPaintDevice *Parent) override;
     void End() override;
+    void SetClipRect(const QRect &Area) override;
+    void Clear(QPaintDevice *Device, const QRegion &Region) override;
+    void DrawRedrawOutlines(const QVector<QRect> &Areas, const QColor &Colour) override;
     void DrawImage(const QRect &Dest, MythImage *Image, const QRect &Source, int Alpha) override;
     void DrawRect(const QRect &Area, const QBrush &FillBrush,
                   const QPen &LinePen, int Alpha) override;
@@ -48,6 +53,16 @@ class MUI_PUBLIC MythOpenGLPainter : public MythPainterGPU
   protected:
     void  ClearCache(void);
     MythGLTexture* GetTextureFromCache(MythImage *Image);
+    MythGLTexture* GetTextureFromAtlas(MythImage *Image, QRect &Source);
+    bool  AddToAtlas(MythImage *Image);
+    void  UploadToAtlas(MythImage *Image);
+    void  ResetAtlasPage(int Page);
+    void  ReleaseAtlasSlot(MythImage *Image);
+    void  ReleaseAtlasSlots(void);
+    void  DeleteImageTexture(MythImage *Image);
+    void  ClearAtlas(void);
+    void  DeleteRetained(void);
+    QRect ToScissor(const QRect &Area) const;
 
     MythImage* GetFormatImagePriv(void) override { return new MythImage(this); }
     void  DeleteFormatImagePriv(MythImage *Image) override;
@@ -58,12 +73,42 @@ class MUI_PUBLIC MythOpenGLPainter : public MythPainterGPU
     QMap<MythImage *, MythGLTexture*> m_imageToTextureMap;
     std::list<MythImage *>     m_imageExpireList;
     std::list<MythGLTexture*>  m_textureDeleteList;
+    std::list<MythImage*>      m_atlasReleaseList; // guarded by m_textureDeleteLock
     QMutex                     m_textureDeleteLock;
 
-    QVector<MythGLTexture*>    m_mappedTextures;
-    std::array<QOpenGLBuffer*,MAX_BUFFER_POOL> m_mappedBufferPool { nullptr };
-    size_t                     m_mappedBufferPoolIdx { 0 };
-    bool                       m_mappedBufferPoolReady { false };
+    // Small images are packed into a few large textures, so that runs of text
+    // and icons can be drawn together. Only used from the UI thread.
+    struct AtlasPage
+    {
+        MythGLTexture  *m_texture  { nullptr };
+        MythAtlasPacker m_packer   { QSize() };
+        int             m_images   { 0 };
+        uint64_t        m_lastUsed { 0 };
+    };
+    struct AtlasSlot
+    {
+        int   m_page { 0 };
+        QRect m_area;
+    };
+    static const int           kAtlasMaxImageSize;
+    static const int           kAtlasMaxPages;
+    std::vector<AtlasPage>     m_atlasPages;
+    QHash<MythImage*,AtlasSlot> m_atlasSlots;
+    int                        m_atlasPageSize { 0 };
+    uint64_t                   m_frameCount    { 0 };
+
+    // The UI is drawn into a framebuffer that is kept between frames, so only
+    // the areas that changed need to be drawn again
+    bool                       m_retainEnabled { true };
+    bool                       m_retainedValid { false };
+    bool                       m_retaining     { false };
+    QOpenGLFramebufferObject  *m_retainedFramebuffer { nullptr };
+    MythGLTexture             *m_retainedTexture     { nullptr };
+    QVector<QRect>             m_redrawOutlines;
+    QColor                     m_redrawColour;
+
+    MythOpenGLPerf            *m_openGLPerf    { nullptr };
+    uint64_t                   m_frameDrawCalls { 0 };
 };
 
 #endif
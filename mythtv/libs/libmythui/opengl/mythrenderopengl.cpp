@@ -38,6 +38,14 @@ static const GLuint kVertexOffset  = 0;
 static const GLuint kTextureOffset = 8 * sizeof(GLfloat);
 const GLuint MythRenderOpenGL::kVertexSize = 16 * sizeof(GLfloat);
 
+// Batched vertices are interleaved position, texture coordinate and color
+static const int    kBatchVertexFloats = MythBitmapBatch::kVertexFloats;
+static_assert(kBatchVertexFloats == VERTEX_SIZE + TEXTURE_SIZE + 4, "Batched vertex layout mismatch");
+static const GLuint kBatchStride       = kBatchVertexFloats * sizeof(GLfloat);
+static const GLuint kBatchTexOffset    = VERTEX_SIZE * sizeof(GLfloat);
+static const GLuint kBatchColorOffset  = (VERTEX_SIZE + TEXTURE_SIZE) * sizeof(GLfloat);
+// Indices are unsigned shorts, so at most 16383 quads
+
 #define MAX_VERTEX_CACHE 500
 
 MythGLTexture::MythGLTexture(QOpenGLTexture *Texture)
@@ -512,6 +520,7 @@ bool MythRenderOpenGL::IsReady(void)
 
 void MythRenderOpenGL::swapBuffers()
 {
+    FlushBatch();
     QOpenGLContext::swapBuffers(m_window);
 }
 
@@ -571,6 +580,7 @@ void MythRenderOpenGL::SetViewPort(const QRect &Rect, bool ViewportOnly)
     if (Rect == m_viewport)
         return;
     makeCurrent();
+    FlushBatch();
     m_viewport = Rect;
     glViewport(m_viewport.left(), m_viewport.top(),
                m_viewport.width(), m_viewport.height());
@@ -581,6 +591,7 @@ void MythRenderOpenGL::SetViewPort(const QRect &Rect, bool ViewportOnly)
 
 void MythRenderOpenGL::Flush(void)
 {
+    FlushBatch();
     if (!m_flushEnabled)
         return;
 
@@ -592,6 +603,7 @@ void MythRenderOpenGL::Flush(void)
 void MythRenderOpenGL::SetBlend(bool Enable)
 {
     makeCurrent();
+    FlushBatch();
     if (Enable && !m_blend)
         glEnable(GL_BLEND);
     else if (!Enable && m_blend)
@@ -600,6 +612,33 @@ void MythRenderOpenGL::SetBlend(bool Enable)
     doneCurrent();
 }
 
+/*! \brief Restrict drawing to the given area of the viewport.
+ *
+ * Rect is in the same top-left based coordinates as the viewport. An empty
+ * rect removes the restriction.
+*/
+void MythRenderOpenGL::SetScissor(const QRect &Rect)
+{
+    if (Rect == m_scissor)
+        return;
+
+    makeCurrent();
+    FlushBatch();
+    if (Rect.isEmpty())
+    {
+        glDisable(GL_SCISSOR_TEST);
+    }
+    else
+    {
+        if (m_scissor.isEmpty())
+            glEnable(GL_SCISSOR_TEST);
+        glScissor(Rect.left(), m_viewport.height() - Rect.top() - Rect.height(),
+                  Rect.width(), Rect.height());
+    }
+    m_scissor = Rect;
+    doneCurrent();
+}
+
 void MythRenderOpenGL::SetBackground(uint8_t Red, uint8_t Green, uint8_t Blue, uint8_t Alpha)
 {
     int32_t tmp = (Red << 24) + (Green << 16) + (Blue << 8) + Alpha;
@@ -704,6 +743,7 @@ void MythRenderOpenGL::DeleteTexture(MythGLTexture *Texture)
         return;
 
     makeCurrent();
+    m_batch.Release(Texture->m_texture ? Texture->m_texture->textureId() : Texture->m_textureId);
     // N.B. Don't delete m_textureId - it is owned externally
     delete Texture->m_texture;
     delete [] Texture->m_data;
@@ -773,6 +813,7 @@ void MythRenderOpenGL::BindFramebuffer(QOpenGLFramebufferObject *Framebuffer)
         return;
 
     makeCurrent();
+    FlushBatch();
     if (Framebuffer == nullptr)
     {
         QOpenGLFramebufferObject::bindDefault();
@@ -789,6 +830,7 @@ void MythRenderOpenGL::BindFramebuffer(QOpenGLFramebufferObject *Framebuffer)
 void MythRenderOpenGL::ClearFramebuffer(void)
 {
     makeCurrent();
+    FlushBatch();
     glClear(GL_COLOR_BUFFER_BIT);
     doneCurrent();
 }
@@ -798,6 +840,7 @@ void MythRenderOpenGL::DrawBitmap(MythGLTexture *Texture, QOpenGLFramebufferObje
                                   QOpenGLShaderProgram *Program, int Alpha, qreal Scale)
 {
     makeCurrent();
+    FlushBatch();
 
     if (!Texture || (Texture && !((Texture->m_texture || Texture->m_textureId) && Texture->m_vbo)))
         return;
@@ -842,7 +885,7 @@ void MythRenderOpenGL::DrawBitmap(MythGLTexture *Texture, QOpenGLFramebufferObje
     glVertexAttribPointerI(VERTEX_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(GLfloat), kVertexOffset);
     glVertexAttrib4f(COLOR_INDEX, 1.0F, 1.0F, 1.0F, Alpha / 255.0F);
     glVertexAttribPointerI(TEXTURE_INDEX, TEXTURE_SIZE, GL_FLOAT, GL_FALSE, TEXTURE_SIZE * sizeof(GLfloat), kTextureOffset);
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    DrawArrays(GL_TRIANGLE_STRIP, 0, 4);
     glDisableVertexAttribArray(TEXTURE_INDEX);
     glDisableVertexAttribArray(VERTEX_INDEX);
     QOpenGLBuffer::release(QOpenGLBuffer::VertexBuffer);
@@ -859,6 +902,7 @@ void MythRenderOpenGL::DrawBitmap(std::vector<MythGLTexture *> &Textures,
         return;
 
     makeCurrent();
+    FlushBatch();
     BindFramebuffer(Target);
 
     if (Program == nullptr)
@@ -908,9 +952,122 @@ void MythRenderOpenGL::DrawBitmap(std::vector<MythGLTexture *> &Textures,
     glVertexAttribPointerI(VERTEX_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(GLfloat), kVertexOffset);
     glVertexAttrib4f(COLOR_INDEX, 1.0, 1.0, 1.0, 1.0);
     glVertexAttribPointerI(TEXTURE_INDEX, TEXTURE_SIZE, GL_FLOAT, GL_FALSE, TEXTURE_SIZE * sizeof(GLfloat), kTextureOffset);
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    DrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    glDisableVertexAttribArray(TEXTURE_INDEX);
+    glDisableVertexAttribArray(VERTEX_INDEX);
+    QOpenGLBuffer::release(QOpenGLBuffer::VertexBuffer);
+    doneCurrent();
+}
+
+/*! \brief Queue a bitmap to be drawn with the default shader
+ *
+ * Consecutive bitmaps from the same texture, e.g. a texture atlas, are
+ * drawn with a single indexed draw call when the batch is flushed. Any
+ * other drawing, or a change of transform or framebuffer, flushes first,
+ * so the order of drawing is preserved.
+*/
+void MythRenderOpenGL::QueueBitmap(MythGLTexture *Texture, const QRect &Source,
+                                   const QRect &Destination, int Alpha, qreal Scale)
+{
+    if (!Texture || !(Texture->m_texture || Texture->m_textureId) || Texture->m_size.isEmpty())
+        return;
+
+    GLuint textureid = Texture->m_texture ? Texture->m_texture->textureId() : Texture->m_textureId;
+
+    // As UpdateTextureVertices, without rotation
+    QSize size = Texture->m_size;
+    int width  = Texture->m_crop ? min(Source.width(),  size.width())  : Source.width();
+    int height = Texture->m_crop ? min(Source.height(), size.height()) : Source.height();
+
+    GLfloat left   = Source.left();
+    GLfloat right  = Source.left() + width;
+    GLfloat top    = Source.top();
+    GLfloat bottom = Source.top() + height;
+    if (Texture->m_target != QOpenGLTexture::TargetRectangle)
+    {
+        left   /= size.width();
+        right  /= size.width();
+        top    /= size.height();
+        bottom /= size.height();
+    }
+    if (!Texture->m_flip)
+        std::swap(top, bottom);
+
+    width  = Texture->m_crop ? min(static_cast<int>(width * Scale), Destination.width())   : Destination.width();
+    height = Texture->m_crop ? min(static_cast<int>(height * Scale), Destination.height()) : Destination.height();
+    auto x1 = static_cast<GLfloat>(Destination.left());
+    auto y1 = static_cast<GLfloat>(Destination.top());
+    auto x2 = static_cast<GLfloat>(Destination.left() + width);
+    auto y2 = static_cast<GLfloat>(Destination.top() + height);
+    GLfloat alpha = Alpha / 255.0F;
+
+    // Same vertex order as the triangle strips
+    const MythBitmapBatch::Quad quad {
+        x1, y1, left,  top,    1.0F, 1.0F, 1.0F, alpha,
+        x1, y2, left,  bottom, 1.0F, 1.0F, 1.0F, alpha,
+        x2, y1, right, top,    1.0F, 1.0F, 1.0F, alpha,
+        x2, y2, right, bottom, 1.0F, 1.0F, 1.0F, alpha };
+    m_batch.Queue(textureid, Texture->m_target, quad);
+}
+
+/// \brief Draw the queued bitmaps
+void MythRenderOpenGL::FlushBatch(void)
+{
+    m_batch.Flush();
+}
+
+void MythRenderOpenGL::DrawBatch(GLuint Texture, GLenum Target, const std::vector<GLfloat> &Vertices)
+{
+    makeCurrent();
+    auto quads = static_cast<int>(Vertices.size() / (4 * kBatchVertexFloats));
+
+    if (!m_batchIBO)
+    {
+        std::vector<GLushort> indices;
+        indices.reserve(static_cast<size_t>(MythBitmapBatch::kMaxQuads) * 6);
+        for (int i = 0; i < MythBitmapBatch::kMaxQuads; ++i)
+        {
+            auto first = static_cast<GLushort>(i * 4);
+            indices.insert(indices.end(), { first, static_cast<GLushort>(first + 1),
+                                            static_cast<GLushort>(first + 2),
+                                            static_cast<GLushort>(first + 2),
+                                            static_cast<GLushort>(first + 1),
+                                            static_cast<GLushort>(first + 3) });
+        }
+        m_batchIBO = new QOpenGLBuffer(QOpenGLBuffer::IndexBuffer);
+        m_batchIBO->create();
+        m_batchIBO->setUsagePattern(QOpenGLBuffer::StaticDraw);
+        m_batchIBO->bind();
+        m_batchIBO->allocate(indices.data(), static_cast<int>(indices.size() * sizeof(GLushort)));
+    }
+    if (!m_batchVBO)
+        m_batchVBO = CreateVBO(MythBitmapBatch::kMaxQuads * 4 * static_cast<int>(kBatchStride), false);
+
+    QOpenGLShaderProgram *program = m_defaultPrograms[kShaderDefault];
+    SetShaderProjection(program);
+    program->setUniformValue("s_texture0", 0);
+    ActiveTexture(GL_TEXTURE0);
+    glBindTexture(Target, Texture);
+
+    // Reallocating orphans the previous contents, so this never waits on
+    // a draw that still uses them
+    m_batchVBO->bind();
+    m_batchVBO->allocate(Vertices.data(),
+                         static_cast<int>(Vertices.size() * sizeof(GLfloat)));
+    m_batchIBO->bind();
+
+    glEnableVertexAttribArray(VERTEX_INDEX);
+    glEnableVertexAttribArray(TEXTURE_INDEX);
+    glEnableVertexAttribArray(COLOR_INDEX);
+    glVertexAttribPointerI(VERTEX_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, kBatchStride, kVertexOffset);
+    glVertexAttribPointerI(TEXTURE_INDEX, TEXTURE_SIZE, GL_FLOAT, GL_FALSE, kBatchStride, kBatchTexOffset);
+    glVertexAttribPointerI(COLOR_INDEX, 4, GL_FLOAT, GL_FALSE, kBatchStride, kBatchColorOffset);
+    glDrawElements(GL_TRIANGLES, quads * 6, GL_UNSIGNED_SHORT, nullptr);
+    m_drawCalls++;
+    glDisableVertexAttribArray(COLOR_INDEX);
     glDisableVertexAttribArray(TEXTURE_INDEX);
     glDisableVertexAttribArray(VERTEX_INDEX);
+    QOpenGLBuffer::release(QOpenGLBuffer::IndexBuffer);
     QOpenGLBuffer::release(QOpenGLBuffer::VertexBuffer);
     doneCurrent();
 }
@@ -922,6 +1079,7 @@ static const float kLimitedRangeScale  = (219.0F / 255.0F);
 void MythRenderOpenGL::ClearRect(QOpenGLFramebufferObject *Target, const QRect &Area, int Color)
 {
     makeCurrent();
+    FlushBatch();
     BindFramebuffer(Target);
     glEnableVertexAttribArray(VERTEX_INDEX);
 
@@ -932,7 +1090,7 @@ void MythRenderOpenGL::ClearRect(QOpenGLFramebufferObject *Target, const QRect &
 
     GetCachedVBO(GL_TRIANGLE_STRIP, Area);
     glVertexAttribPointerI(VERTEX_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(GLfloat), kVertexOffset);
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    DrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 
     QOpenGLBuffer::release(QOpenGLBuffer::VertexBuffer);
     glDisableVertexAttribArray(VERTEX_INDEX);
@@ -952,6 +1110,7 @@ void MythRenderOpenGL::DrawRoundRect(QOpenGLFramebufferObject *Target,
                                      const QPen &LinePen, int Alpha)
 {
     makeCurrent();
+    FlushBatch();
     BindFramebuffer(Target);
 
     int lineWidth = LinePen.width();
@@ -1012,7 +1171,7 @@ void MythRenderOpenGL::DrawRoundRect(QOpenGLFramebufferObject *Target,
         SetShaderProgramParams(elip, m_parameters, "u_parameters");
         GetCachedVBO(GL_TRIANGLE_STRIP, tl);
         glVertexAttribPointerI(VERTEX_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(GLfloat), kVertexOffset);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        DrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 
         // Draw the top right segment
         m_parameters(0,0) = tr.left();
@@ -1020,7 +1179,7 @@ void MythRenderOpenGL::DrawRoundRect(QOpenGLFramebufferObject *Target,
         SetShaderProgramParams(elip, m_parameters, "u_parameters");
         GetCachedVBO(GL_TRIANGLE_STRIP, tr);
         glVertexAttribPointerI(VERTEX_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(GLfloat), kVertexOffset);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        DrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 
         // Draw the bottom left segment
         m_parameters(0,0) = bl.left() + rad;
@@ -1028,7 +1187,7 @@ void MythRenderOpenGL::DrawRoundRect(QOpenGLFramebufferObject *Target,
         SetShaderProgramParams(elip, m_parameters, "u_parameters");
         GetCachedVBO(GL_TRIANGLE_STRIP, bl);
         glVertexAttribPointerI(VERTEX_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(GLfloat), kVertexOffset);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        DrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 
         // Draw the bottom right segment
         m_parameters(0,0) = br.left();
@@ -1036,7 +1195,7 @@ void MythRenderOpenGL::DrawRoundRect(QOpenGLFramebufferObject *Target,
         SetShaderProgramParams(elip, m_parameters, "u_parameters");
         GetCachedVBO(GL_TRIANGLE_STRIP, br);
         glVertexAttribPointerI(VERTEX_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(GLfloat), kVertexOffset);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        DrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 
         // Fill the remaining areas
         QRect main(r.left() + rad, r.top(), r.width() - dia, r.height());
@@ -1047,13 +1206,13 @@ void MythRenderOpenGL::DrawRoundRect(QOpenGLFramebufferObject *Target,
 
         GetCachedVBO(GL_TRIANGLE_STRIP, main);
         glVertexAttribPointerI(VERTEX_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(GLfloat), kVertexOffset);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        DrawArrays(GL_TRIANGLE_STRIP, 0, 4);
         GetCachedVBO(GL_TRIANGLE_STRIP, left);
         glVertexAttribPointerI(VERTEX_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(GLfloat), kVertexOffset);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        DrawArrays(GL_TRIANGLE_STRIP, 0, 4);
         GetCachedVBO(GL_TRIANGLE_STRIP, right);
         glVertexAttribPointerI(VERTEX_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(GLfloat), kVertexOffset);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        DrawArrays(GL_TRIANGLE_STRIP, 0, 4);
         QOpenGLBuffer::release(QOpenGLBuffer::VertexBuffer);
     }
 
@@ -1095,7 +1254,7 @@ void MythRenderOpenGL::DrawRoundRect(QOpenGLFramebufferObject *Target,
         SetShaderProgramParams(edge, m_parameters, "u_parameters");
         GetCachedVBO(GL_TRIANGLE_STRIP, tl);
         glVertexAttribPointerI(VERTEX_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(GLfloat), kVertexOffset);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        DrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 
         // Draw the top right edge segment
         m_parameters(0,0) = tr.left();
@@ -1103,7 +1262,7 @@ void MythRenderOpenGL::DrawRoundRect(QOpenGLFramebufferObject *Target,
         SetShaderProgramParams(edge, m_parameters, "u_parameters");
         GetCachedVBO(GL_TRIANGLE_STRIP, tr);
         glVertexAttribPointerI(VERTEX_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(GLfloat),kVertexOffset);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        DrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 
         // Draw the bottom left edge segment
         m_parameters(0,0) = bl.left() + rad;
@@ -1111,7 +1270,7 @@ void MythRenderOpenGL::DrawRoundRect(QOpenGLFramebufferObject *Target,
         SetShaderProgramParams(edge, m_parameters, "u_parameters");
         GetCachedVBO(GL_TRIANGLE_STRIP, bl);
         glVertexAttribPointerI(VERTEX_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(GLfloat), kVertexOffset);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        DrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 
         // Draw the bottom right edge segment
         m_parameters(0,0) = br.left();
@@ -1119,7 +1278,7 @@ void MythRenderOpenGL::DrawRoundRect(QOpenGLFramebufferObject *Target,
         SetShaderProgramParams(edge, m_parameters, "u_parameters");
         GetCachedVBO(GL_TRIANGLE_STRIP, br);
         glVertexAttribPointerI(VERTEX_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(GLfloat), kVertexOffset);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        DrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 
         // Vertical lines
         SetShaderProjection(vline);
@@ -1132,7 +1291,7 @@ void MythRenderOpenGL::DrawRoundRect(QOpenGLFramebufferObject *Target,
         SetShaderProgramParams(vline, m_parameters, "u_parameters");
         GetCachedVBO(GL_TRIANGLE_STRIP, vl);
         glVertexAttribPointerI(VERTEX_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(GLfloat), kVertexOffset);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        DrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 
         // Draw the right line segment
         vl.translate(r.width() - lineWidth, 0);
@@ -1140,7 +1299,7 @@ void MythRenderOpenGL::DrawRoundRect(QOpenGLFramebufferObject *Target,
         SetShaderProgramParams(vline, m_parameters, "u_parameters");
         GetCachedVBO(GL_TRIANGLE_STRIP, vl);
         glVertexAttribPointerI(VERTEX_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(GLfloat), kVertexOffset);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        DrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 
         // Horizontal lines
         SetShaderProjection(hline);
@@ -1151,7 +1310,7 @@ void MythRenderOpenGL::DrawRoundRect(QOpenGLFramebufferObject *Target,
         SetShaderProgramParams(hline, m_parameters, "u_parameters");
         GetCachedVBO(GL_TRIANGLE_STRIP, hl);
         glVertexAttribPointerI(VERTEX_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(GLfloat), kVertexOffset);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        DrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 
         // Draw the bottom line segment
         hl.translate(0, r.height() - lineWidth);
@@ -1159,13 +1318,19 @@ void MythRenderOpenGL::DrawRoundRect(QOpenGLFramebufferObject *Target,
         SetShaderProgramParams(hline, m_parameters, "u_parameters");
         GetCachedVBO(GL_TRIANGLE_STRIP, hl);
         glVertexAttribPointerI(VERTEX_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(GLfloat), kVertexOffset);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        DrawArrays(GL_TRIANGLE_STRIP, 0, 4);
         QOpenGLBuffer::release(QOpenGLBuffer::VertexBuffer);
     }
     glDisableVertexAttribArray(VERTEX_INDEX);
     doneCurrent();
 }
 
+inline void MythRenderOpenGL::DrawArrays(GLenum Mode, GLint First, GLsizei Count)
+{
+    m_drawCalls++;
+    glDrawArrays(Mode, First, Count);
+}
+
 inline void MythRenderOpenGL::glVertexAttribPointerI(GLuint Index, GLint Size, GLenum Type, GLboolean Normalize,
                                                      GLsizei Stride, const GLuint Value)
 {
@@ -1227,6 +1392,11 @@ void MythRenderOpenGL::ReleaseResources(void)
     OpenGLLocker locker(this);
     if (VERBOSE_LEVEL_CHECK(VB_GPU, LOG_INFO))
         logDebugMarker("RENDER_RELEASE_START");
+    m_batch.Clear();
+    delete m_batchVBO;
+    delete m_batchIBO;
+    m_batchVBO = nullptr;
+    m_batchIBO = nullptr;
     DeleteDefaultShaders();
     ExpireVertices();
     ExpireVBOS();
@@ -1488,6 +1658,7 @@ int MythRenderOpenGL::GetBufferSize(QSize Size, QOpenGLTexture::PixelFormat Form
 
 void MythRenderOpenGL::PushTransformation(const UIEffects &Fx, QPointF &Center)
 {
+    FlushBatch();
     QMatrix4x4 newtop = m_transforms.top();
     if (Fx.m_hzoom != 1.0F || Fx.m_vzoom != 1.0F || Fx.m_angle != 0.0F)
     {
@@ -1501,6 +1672,7 @@ void MythRenderOpenGL::PushTransformation(const UIEffects &Fx, QPointF &Center)
 
 void MythRenderOpenGL::PopTransformation(void)
 {
+    FlushBatch();
     m_transforms.pop();
 }
 
@@ -31,6 +31,7 @@
 // MythTV
 #include "mythuiexp.h"
 #include "mythlogging.h"
+#include "mythbitmapbatch.h"
 #include "mythrender_base.h"
 #include "mythrenderopengldefs.h"
 #include "mythuianimation.h"
@@ -124,6 +125,7 @@ class MUI_PUBLIC MythRenderOpenGL : public QOpenGLContext, public QOpenGLFunctio
     void  PopTransformation(void);
     void  Flush(void);
     void  SetBlend(bool Enable);
+    void  SetScissor(const QRect &Rect);
     void  SetBackground(uint8_t Red, uint8_t Green, uint8_t Blue, uint8_t Alpha);
     QFunctionPointer GetProcAddress(const QString &Proc) const;
 
@@ -159,6 +161,10 @@ class MUI_PUBLIC MythRenderOpenGL : public QOpenGLContext, public QOpenGLFunctio
                      QOpenGLFramebufferObject *Target,
                      const QRect &Source, const QRect &Destination,
                      QOpenGLShaderProgram *Program, int Rotation);
+    void  QueueBitmap(MythGLTexture *Texture, const QRect &Source,
+                      const QRect &Destination, int Alpha = 255, qreal Scale = 1.0);
+    void  FlushBatch(void);
+    uint64_t GetDrawCallCount(void) const { return m_drawCalls; }
     void  DrawRect(QOpenGLFramebufferObject *Target,
                    const QRect &Area, const QBrush &FillBrush,
                    const QPen &LinePen, int Alpha);
@@ -196,6 +202,7 @@ class MUI_PUBLIC MythRenderOpenGL : public QOpenGLContext, public QOpenGLFunctio
     inline void glVertexAttribPointerI(GLuint Index, GLint Size, GLenum Type,
                                        GLboolean Normalize, GLsizei Stride,
                                        GLuint Value);
+    inline void DrawArrays(GLenum Mode, GLint First, GLsizei Count);
 
     bool                         m_ready { false };
 
@@ -215,6 +222,14 @@ class MUI_PUBLIC MythRenderOpenGL : public QOpenGLContext, public QOpenGLFunctio
     QMap<uint64_t,QOpenGLBuffer*>m_cachedVBOS;
     QList<uint64_t>              m_vboExpiry;
 
+    // Batched bitmaps, drawn together by FlushBatch()
+    void  DrawBatch(GLuint Texture, GLenum Target, const std::vector<GLfloat> &Vertices);
+    MythBitmapBatch              m_batch { [this](GLuint Texture, GLenum Target, const std::vector<GLfloat> &Vertices)
+                                           { DrawBatch(Texture, Target, Vertices); } };
+    QOpenGLBuffer*               m_batchVBO     { nullptr };
+    QOpenGLBuffer*               m_batchIBO     { nullptr };
+    uint64_t                     m_drawCalls    { 0 };
+
     // Locking
     QMutex     m_lock { QMutex::Recursive };
     int        m_lockLevel { 0 };
@@ -231,6 +246,7 @@ class MUI_PUBLIC MythRenderOpenGL : public QOpenGLContext, public QOpenGLFunctio
     QRect      m_viewport;
     GLuint     m_activeTexture { 0 };
     bool       m_blend { false };
+    QRect      m_scissor;
     int32_t    m_background { 0x00000000 };
     bool       m_fullRange { true };
     QMatrix4x4 m_projection;
@@ -0,0 +1,75 @@
+/*
+ *  Class TestMythAtlasPacker
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <QtTest/QtTest>
+
+#include "mythatlaspacker.h"
+
+class TestMythAtlasPacker: public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    static void AreasDoNotOverlap(void)
+    {
+        MythAtlasPacker packer(QSize(256, 256));
+        QVector<QRect> areas;
+        for (int i = 0; i < 200; ++i)
+        {
+            QRect area = packer.Add(QSize(5 + (i * 7) % 30, 4 + (i * 13) % 20));
+            if (!area.isValid())
+                continue;
+            QVERIFY(QRect(0, 0, 256, 256).contains(area));
+            for (const auto & other : qAsConst(areas))
+                QVERIFY(!other.intersects(area));
+            areas.append(area);
+        }
+        QVERIFY(areas.size() > 50);
+    }
+
+    static void FullPage(void)
+    {
+        MythAtlasPacker packer(QSize(64, 64));
+        for (int i = 0; i < 16; ++i)
+            QVERIFY(packer.Add(QSize(16, 16)).isValid());
+        QCOMPARE(packer.GetUsed(), 64 * 64);
+        QVERIFY(!packer.Add(QSize(1, 1)).isValid());
+
+        packer.Reset();
+        QCOMPARE(packer.GetUsed(), 0);
+        QCOMPARE(packer.Add(QSize(16, 16)), QRect(0, 0, 16, 16));
+    }
+
+    static void TooLarge(void)
+    {
+        MythAtlasPacker packer(QSize(64, 64));
+        QVERIFY(!packer.Add(QSize(65, 1)).isValid());
+        QVERIFY(!packer.Add(QSize(1, 65)).isValid());
+        QVERIFY(!packer.Add(QSize(0, 0)).isValid());
+    }
+
+    static void ShortAreasShareShelves(void)
+    {
+        // Short areas use the tightest shelf rather than opening new ones
+        MythAtlasPacker packer(QSize(64, 64));
+        QCOMPARE(packer.Add(QSize(10, 20)), QRect(0, 0, 10, 20));
+        QCOMPARE(packer.Add(QSize(10, 12)), QRect(10, 0, 10, 12));
+        QCOMPARE(packer.Add(QSize(10, 8)),  QRect(0, 20, 10, 8));
+        QCOMPARE(packer.Add(QSize(10, 7)),  QRect(10, 20, 10, 7));
+    }
+};
@@ -0,0 +1,140 @@
+/*
+ *  Class TestMythBitmapBatch
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <QtTest/QtTest>
+
+#include "mythbitmapbatch.h"
+
+class TestMythBitmapBatch: public QObject
+{
+    Q_OBJECT
+
+    // One entry per draw call, the texture followed by the x of each quad
+    using DrawLog = std::vector<std::vector<int>>;
+
+    static MythBitmapBatch::DrawFunc Logger(DrawLog &Log)
+    {
+        return [&Log](unsigned int Texture, unsigned int /*Target*/,
+                      const std::vector<float> &Vertices)
+        {
+            std::vector<int> draw { static_cast<int>(Texture) };
+            for (size_t i = 0; i < Vertices.size(); i += MythBitmapBatch::kVertexFloats * 4)
+                draw.push_back(static_cast<int>(Vertices[i]));
+            Log.push_back(draw);
+        };
+    }
+
+    static MythBitmapBatch::Quad QuadAt(int X)
+    {
+        MythBitmapBatch::Quad quad {};
+        quad[0] = static_cast<float>(X);
+        return quad;
+    }
+
+  private slots:
+    static void SameTextureIsOneDraw(void)
+    {
+        DrawLog log;
+        MythBitmapBatch batch(Logger(log));
+        for (int i = 0; i < 10; ++i)
+            batch.Queue(1, 0, QuadAt(i));
+        QVERIFY(log.empty());
+        QCOMPARE(batch.GetQuads(), 10);
+
+        batch.Flush();
+        QCOMPARE(log.size(), static_cast<size_t>(1));
+        QCOMPARE(log[0], std::vector<int>({ 1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+        QVERIFY(batch.IsEmpty());
+
+        // Nothing left to draw
+        batch.Flush();
+        QCOMPARE(log.size(), static_cast<size_t>(1));
+    }
+
+    static void TextureChangeKeepsOrder(void)
+    {
+        DrawLog log;
+        MythBitmapBatch batch(Logger(log));
+        batch.Queue(1, 0, QuadAt(0));
+        batch.Queue(1, 0, QuadAt(1));
+        batch.Queue(2, 0, QuadAt(2));
+        batch.Queue(1, 0, QuadAt(3));
+        batch.Queue(1, 1, QuadAt(4));
+        batch.Flush();
+
+        DrawLog expected { { 1, 0, 1 }, { 2, 2 }, { 1, 3 }, { 1, 4 } };
+        QCOMPARE(log, expected);
+    }
+
+    static void FlushBeforeOtherDrawing(void)
+    {
+        // The renderer flushes before a scissor change or a direct draw, e.g.
+        // of the video, so queued UI images are drawn first and unclipped
+        DrawLog log;
+        MythBitmapBatch batch(Logger(log));
+        batch.Queue(1, 0, QuadAt(0));
+        batch.Queue(1, 0, QuadAt(1));
+        batch.Flush();
+        log.push_back({ -1 }); // the scissored draw
+        batch.Queue(1, 0, QuadAt(2));
+        batch.Flush();
+
+        DrawLog expected { { 1, 0, 1 }, { -1 }, { 1, 2 } };
+        QCOMPARE(log, expected);
+    }
+
+    static void FullBatch(void)
+    {
+        DrawLog log;
+        MythBitmapBatch batch(Logger(log));
+        for (int i = 0; i <= MythBitmapBatch::kMaxQuads; ++i)
+            batch.Queue(1, 0, QuadAt(i));
+        QCOMPARE(log.size(), static_cast<size_t>(1));
+        QCOMPARE(log[0].size(), static_cast<size_t>(MythBitmapBatch::kMaxQuads + 1));
+        QCOMPARE(batch.GetQuads(), 1);
+    }
+
+    static void ReleaseTexture(void)
+    {
+        DrawLog log;
+        MythBitmapBatch batch(Logger(log));
+        batch.Queue(1, 0, QuadAt(0));
+        batch.Release(2);
+        QVERIFY(log.empty());
+        batch.Release(1);
+        DrawLog expected { { 1, 0 } };
+        QCOMPARE(log, expected);
+    }
+
+    static void FlushWhileDrawing(void)
+    {
+        // Drawing may lead back into a flush, which must not draw twice
+        int draws = 0;
+        MythBitmapBatch *self = nullptr;
+        MythBitmapBatch batch([&](unsigned int, unsigned int, const std::vector<float>&)
+        {
+            ++draws;
+            self->Flush();
+        });
+        self = &batch;
+        batch.Queue(1, 0, QuadAt(0));
+        batch.Flush();
+        QCOMPARE(draws, 1);
+        QVERIFY(batch.IsEmpty());
+    }
+};
@@ -0,0 +1,156 @@
+/*
+ *  Class TestMythUIText
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <QtTest/QtTest>
+
+#include "mythcorecontext.h"
+#include "mythfontproperties.h"
+#include "mythuitext.h"
+
+/// A list container that doesn't need a main window for its area
+class TestList : public MythUIType
+{
+  public:
+    TestList() : MythUIType(nullptr, "list") {}
+    void RecalculateArea(bool /*recurse*/ = true) override {}
+};
+
+class TestMythUIText : public QObject
+{
+    Q_OBJECT
+
+    static constexpr int kItems   = 5000;
+    static constexpr int kVisible = 12;
+
+  private slots:
+    static void initTestCase(void)
+    {
+        gCoreContext = new MythCoreContext("test_mythuitext_1.0", nullptr);
+        QMap<QString,int> settings;
+        settings["GUITEXTZOOM"] = 100;
+        gCoreContext->setTestIntSettings(settings);
+    }
+
+    static void init(void)
+    {
+        MythUIText::ClearLayoutCache();
+    }
+
+    static void LayoutsAreShared(void)
+    {
+        TestList list;
+        MythFontProperties font;
+        QRect area(0, 0, 400, 40);
+        MythUIText a("", font, area, area, &list, "a");
+        MythUIText b("", font, area, area, &list, "b");
+
+        a.SetText("The same programme title");
+        MythUIText::LayoutCacheStats before = MythUIText::GetLayoutCacheStats();
+        b.SetText("The same programme title");
+        MythUIText::LayoutCacheStats after = MythUIText::GetLayoutCacheStats();
+
+        QCOMPARE(after.m_hits, before.m_hits + 1);
+        QCOMPARE(after.m_misses, before.m_misses);
+        QCOMPARE(b.GetText(), QString("The same programme title"));
+    }
+
+    static void ChangedTextIsLaidOutAgain(void)
+    {
+        TestList list;
+        MythFontProperties font;
+        QRect area(0, 0, 400, 40);
+        MythUIText a("", font, area, area, &list, "a");
+        MythUIText b("", font, area, area, &list, "b");
+
+        a.SetText("First");
+        b.SetText("First");
+        a.SetText("Second");
+        QCOMPARE(a.GetText(), QString("Second"));
+        QCOMPARE(b.GetText(), QString("First"));
+
+        // b still draws the shared layout of "First", and it is still cached
+        MythUIText::LayoutCacheStats before = MythUIText::GetLayoutCacheStats();
+        a.SetText("First");
+        MythUIText::LayoutCacheStats after = MythUIText::GetLayoutCacheStats();
+        QCOMPARE(after.m_hits, before.m_hits + 1);
+    }
+
+    static void DifferentAreasAreNotShared(void)
+    {
+        TestList list;
+        MythFontProperties font;
+        QRect narrow(0, 0, 100, 40);
+        QRect wide(0, 0, 400, 40);
+        MythUIText a("", font, narrow, narrow, &list, "a");
+        MythUIText b("", font, wide, wide, &list, "b");
+
+        a.SetText("A title long enough to be cut down");
+        MythUIText::LayoutCacheStats before = MythUIText::GetLayoutCacheStats();
+        b.SetText("A title long enough to be cut down");
+        MythUIText::LayoutCacheStats after = MythUIText::GetLayoutCacheStats();
+        QCOMPARE(after.m_hits, before.m_hits);
+    }
+
+    static void ScrollList_data(void)
+    {
+        QTest::addColumn<bool>("cached");
+        QTest::newRow("uncached") << false;
+        QTest::newRow("cached")   << true;
+    }
+
+    /// Scrolls a screenful of text widgets through 5000 items, a step at a time
+    static void ScrollList(void)
+    {
+        QFETCH(bool, cached);
+
+        TestList list;
+        MythFontProperties font;
+        QStringList items;
+        for (int i = 0; i < kItems; ++i)
+            items << QString("Programme %1 - Episode title %2").arg(i).arg(i % 97);
+
+        QVector<MythUIText *> rows;
+        for (int row = 0; row < kVisible; ++row)
+        {
+            QRect area(0, row * 40, 600, 40);
+            rows << new MythUIText("", font, area, area, &list,
+                                   QString("row%1").arg(row));
+        }
+
+        MythUIText::LayoutCacheStats before = MythUIText::GetLayoutCacheStats();
+        QBENCHMARK
+        {
+            for (int top = 0; top + kVisible <= kItems; ++top)
+            {
+                // Without the cache every step lays out all the rows
+                if (!cached)
+                    MythUIText::ClearLayoutCache();
+                for (int row = 0; row < kVisible; ++row)
+                    rows[row]->SetText(items[top + row]);
+            }
+        }
+        MythUIText::LayoutCacheStats after = MythUIText::GetLayoutCacheStats();
+
+        uint64_t hits = after.m_hits - before.m_hits;
+        uint64_t misses = after.m_misses - before.m_misses;
+        qInfo() << "layout cache hit rate"
+                << (100.0 * hits / qMax<uint64_t>(hits + misses, 1)) << "%";
+        if (cached)
+            QVERIFY(hits > misses * (kVisible - 2));
+    }
+};
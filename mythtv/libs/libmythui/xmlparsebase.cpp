@@ -3,11 +3,17 @@
 #include "xmlparsebase.h"
 
 // C++/C headers
+#include <algorithm>
 #include <typeinfo>
 
 // QT headers
+#include <QCache>
+#include <QDateTime>
 #include <QFile>
+#include <QFileInfo>
 #include <QDomDocument>
+#include <QMutex>
+#include <QSet>
 #include <QString>
 #include <QBrush>
 #include <QLinearGradient>
@@ -348,6 +354,93 @@ QString XMLParseBase::parseText(QDomElement &element)
 static MythUIType *globalObjectStore = nullptr;
 static QStringList loadedBaseFiles;
 
+/// The contents of a theme file, kept so that opening a screen again doesn't
+/// read it from disk again
+struct ThemeDocument
+{
+    QByteArray   m_data;
+    QDateTime    m_modified;
+    qint64       m_size {0};
+};
+
+/// Maximum size of the cached theme files, in KB of XML
+static constexpr int kThemeDocumentCacheKB = 4096;
+
+static QMutex                          themeDocumentLock;
+static QCache<QString, ThemeDocument>  themeDocuments(kThemeDocumentCacheKB);
+
+/**
+ *  \brief Parses a theme file, reading it from disk only when it has changed.
+ *
+ *  The file contents are cached rather than the parsed document.  Copying a
+ *  QDomDocument resets every node's line number, and those are needed for
+ *  SetXMLLocation() and VERBOSE_XML.  Each caller parses its own document,
+ *  which is also what screens loaded on several threads at once need, and
+ *  the lock is only held to look up or insert the (implicitly shared) data.
+ */
+static bool load_theme_document(const QString &filename, QDomDocument &doc)
+{
+    QFileInfo fi(filename);
+    if (!fi.isFile())
+        return false;
+
+    QByteArray data;
+    {
+        QMutexLocker locker(&themeDocumentLock);
+        ThemeDocument *cached = themeDocuments.object(filename);
+        if (cached && cached->m_modified == fi.lastModified() &&
+            cached->m_size == fi.size())
+        {
+            data = cached->m_data;
+        }
+    }
+
+    if (data.isNull())
+    {
+        QFile f(filename);
+        if (!f.open(QIODevice::ReadOnly))
+            return false;
+        data = f.readAll();
+
+        auto *entry = new ThemeDocument;
+        entry->m_data = data;
+        entry->m_modified = fi.lastModified();
+        entry->m_size = fi.size();
+
+        QMutexLocker locker(&themeDocumentLock);
+        themeDocuments.insert(filename, entry,
+                              static_cast<int>(std::max(fi.size() / 1024, 1LL)));
+    }
+
+    QString errorMsg;
+    int errorLine = 0;
+    int errorColumn = 0;
+
+    if (!doc.setContent(data, false, &errorMsg, &errorLine, &errorColumn))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Location: '%1' @ %2 column: %3"
+                    "\n\t\t\tError: %4")
+                .arg(qPrintable(filename)).arg(errorLine).arg(errorColumn)
+                .arg(qPrintable(errorMsg)));
+        return false;
+    }
+
+    return true;
+}
+
+/// \brief Returns true for the elements that ParseUIType() creates widgets
+///        for, other than windows.
+static bool is_widget_type(const QString &type)
+{
+    static const QSet<QString> kWidgetTypes {
+        "imagetype", "textarea", "group", "textedit", "button", "buttonlist",
+        "buttonlist2", "buttontree", "spinbox", "checkbox", "statetype",
+        "clock", "progressbar", "scrollbar", "webbrowser", "guidegrid",
+        "shape", "editbar", "video" };
+    return kWidgetTypes.contains(type);
+}
+
 MythUIType *XMLParseBase::GetGlobalObjectStore(void)
 {
     if (!globalObjectStore)
@@ -363,6 +456,12 @@ void XMLParseBase::ClearGlobalObjectStore(void)
 
     // clear any loaded base xml files which will force a reload the next time they are used
     loadedBaseFiles.clear();
+
+    // cached text layouts may use fonts from the old theme
+    MythUIText::ClearLayoutCache();
+
+    QMutexLocker locker(&themeDocumentLock);
+    themeDocuments.clear();
 }
 
 void XMLParseBase::ParseChildren(const QString &filename,
@@ -398,25 +497,7 @@ void XMLParseBase::ParseChildren(const QString &filename,
 
                 delete font;
             }
-            else if (type == "imagetype" ||
-                     type == "textarea" ||
-                     type == "group" ||
-                     type == "textedit" ||
-                     type == "button" ||
-                     type == "buttonlist" ||
-                     type == "buttonlist2" ||
-                     type == "buttontree" ||
-                     type == "spinbox" ||
-                     type == "checkbox" ||
-                     type == "statetype" ||
-                     type == "clock" ||
-                     type == "progressbar" ||
-                     type == "scrollbar" ||
-                     type == "webbrowser" ||
-                     type == "guidegrid" ||
-                     type == "shape" ||
-                     type == "editbar" ||
-                     type == "video")
+            else if (is_widget_type(type))
             {
                 ParseUIType(filename, info, type, parent, nullptr, showWarnings, dependsMap);
             }
@@ -602,25 +683,7 @@ MythUIType *XMLParseBase::ParseUIType(
 
                 delete font;
             }
-            else if (info.tagName() == "imagetype" ||
-                     info.tagName() == "textarea" ||
-                     info.tagName() == "group" ||
-                     info.tagName() == "textedit" ||
-                     info.tagName() == "button" ||
-                     info.tagName() == "buttonlist" ||
-                     info.tagName() == "buttonlist2" ||
-                     info.tagName() == "buttontree" ||
-                     info.tagName() == "spinbox" ||
-                     info.tagName() == "checkbox" ||
-                     info.tagName() == "statetype" ||
-                     info.tagName() == "clock" ||
-                     info.tagName() == "progressbar" ||
-                     info.tagName() == "scrollbar" ||
-                     info.tagName() == "webbrowser" ||
-                     info.tagName() == "guidegrid" ||
-                     info.tagName() == "shape" ||
-                     info.tagName() == "editbar" ||
-                     info.tagName() == "video")
+            else if (is_widget_type(info.tagName()))
             {
                 ParseUIType(filename, info, info.tagName(),
                             uitype, screen, showWarnings, dependsMap);
@@ -645,28 +708,10 @@ bool XMLParseBase::WindowExists(const QString &xmlfile,
     for (const auto & dir : qAsConst(searchpath))
     {
         QString themefile = dir + xmlfile;
-        QFile f(themefile);
-
-        if (!f.open(QIODevice::ReadOnly))
-            continue;
 
         QDomDocument doc;
-        QString errorMsg;
-        int errorLine = 0;
-        int errorColumn = 0;
-
-        if (!doc.setContent(&f, false, &errorMsg, &errorLine, &errorColumn))
-        {
-            LOG(VB_GENERAL, LOG_ERR, LOC +
-                QString("Location: '%1' @ %2 column: %3"
-                        "\n\t\t\tError: %4")
-                    .arg(qPrintable(themefile)).arg(errorLine).arg(errorColumn)
-                    .arg(qPrintable(errorMsg)));
-            f.close();
+        if (!load_theme_document(themefile, doc))
             continue;
-        }
-
-        f.close();
 
         QDomElement docElem = doc.documentElement();
         QDomNode n = docElem.firstChild();
@@ -723,28 +768,9 @@ bool XMLParseBase::doLoad(const QString &windowname,
                           bool showWarnings)
 {
     QDomDocument doc;
-    QFile f(filename);
-
-    if (!f.open(QIODevice::ReadOnly))
+    if (!load_theme_document(filename, doc))
         return false;
 
-    QString errorMsg;
-    int errorLine = 0;
-    int errorColumn = 0;
-
-    if (!doc.setContent(&f, false, &errorMsg, &errorLine, &errorColumn))
-    {
-        LOG(VB_GENERAL, LOG_ERR, LOC +
-            QString("Location: '%1' @ %2 column: %3"
-                    "\n\t\t\tError: %4")
-                .arg(qPrintable(filename)).arg(errorLine).arg(errorColumn)
-                .arg(qPrintable(errorMsg)));
-        f.close();
-        return false;
-    }
-
-    f.close();
-
     QDomElement docElem = doc.documentElement();
     QDomNode n = docElem.firstChild();
     while (!n.isNull())
@@ -797,26 +823,7 @@ bool XMLParseBase::doLoad(const QString &windowname,
                     }
                     delete font;
                 }
-                else if (type == "imagetype" ||
-                         type == "textarea" ||
-                         type == "group" ||
-                         type == "textedit" ||
-                         type == "button" ||
-                         type == "buttonlist" ||
-                         type == "buttonlist2" ||
-                         type == "buttontree" ||
-                         type == "spinbox" ||
-                         type == "checkbox" ||
-                         type == "statetype" ||
-                         type == "window" ||
-                         type == "clock" ||
-                         type == "progressbar" ||
-                         type == "scrollbar" ||
-                         type == "webbrowser" ||
-                         type == "guidegrid" ||
-                         type == "shape" ||
-                         type == "editbar" ||
-                         type == "video")
+                else if (type == "window" || is_widget_type(type))
                 {
 
                     // We don't want widgets in base.xml
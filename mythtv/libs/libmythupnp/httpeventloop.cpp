@@ -0,0 +1,338 @@
+// C++ headers
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <vector>
+
+// POSIX headers
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
+
+// Qt headers
+#include <QDateTime>
+
+// MythTV headers
+#include "httpeventloop.h"
+#include "mythlogging.h"
+
+#define LOC QString("HttpEventLoop: ")
+
+static qint64 now_ms(void)
+{
+    return QDateTime::currentMSecsSinceEpoch();
+}
+
+static bool set_nonblocking(int fd)
+{
+    int flags = fcntl(fd, F_GETFL);
+    return (flags >= 0) && (fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0);
+}
+
+HttpEventLoop::HttpEventLoop(ResumeFunc resume)
+    : MThread("HttpEventLoop"), m_resume(std::move(resume))
+{
+    std::array<int,2> fds {-1, -1};
+    if (pipe(fds.data()) == 0 &&
+        set_nonblocking(fds[0]) && set_nonblocking(fds[1]))
+    {
+        m_wakeRead  = fds[0];
+        m_wakeWrite = fds[1];
+    }
+    else
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "Unable to create wake pipe" + ENO);
+        for (int fd : fds)
+        {
+            if (fd >= 0)
+                close(fd);
+        }
+    }
+}
+
+HttpEventLoop::~HttpEventLoop()
+{
+    Stop();
+    wait();
+
+    if (m_wakeRead >= 0)
+        close(m_wakeRead);
+    if (m_wakeWrite >= 0)
+        close(m_wakeWrite);
+}
+
+/**
+ *  \brief Streams \p length bytes of \p file, from \p start, to \p sock.
+ *
+ *  The response headers must already have been written.  Afterwards the
+ *  connection waits for its next request for up to \p idleTimeoutMs if
+ *  \p keepAlive is set, and is closed otherwise.
+ *
+ *  \return false if the loop isn't running, in which case the caller
+ *          keeps ownership of both descriptors.
+ */
+bool HttpEventLoop::SendFile(int sock, int file, qint64 start, qint64 length,
+                             bool keepAlive, int idleTimeoutMs)
+{
+    Connection conn;
+    conn.m_sock          = sock;
+    conn.m_file          = file;
+    conn.m_offset        = start;
+    conn.m_remaining     = length;
+    conn.m_keepAlive     = keepAlive;
+    conn.m_idleTimeoutMs = idleTimeoutMs;
+    conn.m_deadline      = now_ms() + kSendStallTimeoutMs;
+    return Add(conn);
+}
+
+/**
+ *  \brief Waits for up to \p idleTimeoutMs for the next request on \p sock
+ *  and then passes it to the resume callback.
+ *
+ *  \return false if the loop isn't running, in which case the caller
+ *          keeps ownership of \p sock.
+ */
+bool HttpEventLoop::WaitForRequest(int sock, int idleTimeoutMs)
+{
+    Connection conn;
+    conn.m_sock          = sock;
+    conn.m_keepAlive     = true;
+    conn.m_idleTimeoutMs = idleTimeoutMs;
+    conn.m_deadline      = now_ms() + idleTimeoutMs;
+    return Add(conn);
+}
+
+bool HttpEventLoop::Add(const Connection &conn)
+{
+    {
+        QMutexLocker locker(&m_lock);
+        if (!m_running || m_wakeRead < 0 || !isRunning())
+            return false;
+
+        if (!set_nonblocking(conn.m_sock))
+            return false;
+
+        m_added.append(conn);
+    }
+
+    Wake();
+    return true;
+}
+
+/// \brief Closes all parked connections and stops the loop.
+void HttpEventLoop::Stop(void)
+{
+    {
+        QMutexLocker locker(&m_lock);
+        m_running = false;
+    }
+    Wake();
+}
+
+HttpEventLoopStats HttpEventLoop::GetStats(void)
+{
+    QMutexLocker locker(&m_lock);
+    return m_stats;
+}
+
+void HttpEventLoop::Wake(void)
+{
+    if (m_wakeWrite >= 0)
+    {
+        char byte = 0;
+        // Only fails if the pipe is full, which wakes the loop anyway
+        (void)!write(m_wakeWrite, &byte, 1);
+    }
+}
+
+/// \return false if the connection has failed
+bool HttpEventLoop::Send(Connection &conn)
+{
+    qint64 chunk = std::min(conn.m_remaining, kMaxSendChunk);
+
+#ifdef __linux__
+    off_t offset = conn.m_offset;
+    ssize_t sent = sendfile(conn.m_sock, conn.m_file, &offset, chunk);
+#else
+    std::array<char,65536> buf {};
+    ssize_t sent = pread(conn.m_file, buf.data(),
+                         std::min(chunk, static_cast<qint64>(buf.size())),
+                         conn.m_offset);
+    if (sent > 0)
+        sent = send(conn.m_sock, buf.data(), sent, 0);
+#endif
+
+    if (sent < 0)
+        return (errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR);
+
+    if (sent == 0) // the file is shorter than the Content-Length sent
+        return false;
+
+    conn.m_offset    += sent;
+    conn.m_remaining -= sent;
+
+    QMutexLocker locker(&m_lock);
+    m_stats.m_bytesSent += sent;
+    return true;
+}
+
+void HttpEventLoop::Close(Connection &conn)
+{
+    if (conn.m_file >= 0)
+        close(conn.m_file);
+    if (conn.m_sock >= 0)
+        close(conn.m_sock);
+    conn.m_file = -1;
+    conn.m_sock = -1;
+}
+
+void HttpEventLoop::run(void)
+{
+    RunProlog();
+
+    std::vector<pollfd> fds;
+
+    while (true)
+    {
+        {
+            QMutexLocker locker(&m_lock);
+            if (!m_running)
+                break;
+            for (const auto &conn : qAsConst(m_added))
+                m_connections.insert(conn.m_sock, conn);
+            m_added.clear();
+        }
+
+        qint64 now  = now_ms();
+        qint64 next = now + 1000;
+
+        fds.clear();
+        fds.push_back({m_wakeRead, POLLIN, 0});
+        for (const auto &conn : qAsConst(m_connections))
+        {
+            short events = (conn.m_file >= 0) ? POLLOUT : POLLIN;
+            fds.push_back({conn.m_sock, events, 0});
+            next = std::min(next, conn.m_deadline);
+        }
+
+        int timeout = static_cast<int>(std::max(next - now, qint64(0)));
+        if (poll(fds.data(), fds.size(), timeout) < 0 && errno != EINTR)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC + "poll() failed" + ENO);
+            usleep(100000);
+            continue;
+        }
+
+        if (fds[0].revents & POLLIN)
+        {
+            std::array<char,64> buf {};
+            while (read(m_wakeRead, buf.data(), buf.size()) > 0)
+                ;
+        }
+
+        now = now_ms();
+        HttpEventLoopStats delta;
+        for (size_t i = 1; i < fds.size(); ++i)
+        {
+            auto it = m_connections.find(fds[i].fd);
+            if (it == m_connections.end())
+                continue;
+
+            Connection &conn = *it;
+            short revents = fds[i].revents;
+
+            if (conn.m_file >= 0)
+            {
+                if (revents & (POLLERR | POLLHUP | POLLNVAL))
+                {
+                    delta.m_errors++;
+                    Close(conn);
+                }
+                else if (revents & POLLOUT)
+                {
+                    if (!Send(conn))
+                    {
+                        delta.m_errors++;
+                        Close(conn);
+                    }
+                    else if (conn.m_remaining > 0)
+                    {
+                        conn.m_deadline = now + kSendStallTimeoutMs;
+                    }
+                    else
+                    {
+                        delta.m_filesSent++;
+                        close(conn.m_file);
+                        conn.m_file     = -1;
+                        conn.m_deadline = now + conn.m_idleTimeoutMs;
+                        if (!conn.m_keepAlive)
+                            Close(conn);
+                    }
+                }
+                else if (now >= conn.m_deadline)
+                {
+                    LOG(VB_HTTP, LOG_WARNING, LOC +
+                        QString("Client stopped reading, closing socket %1 "
+                                "with %2 bytes unsent")
+                            .arg(conn.m_sock).arg(conn.m_remaining));
+                    delta.m_timedOut++;
+                    Close(conn);
+                }
+            }
+            else if (revents & POLLIN)
+            {
+                // A new request, or the client closed the connection;
+                // either way a worker handles it now.
+                int sock = conn.m_sock;
+                m_connections.erase(it);
+                delta.m_resumed++;
+                m_resume(sock);
+                continue;
+            }
+            else if (revents & (POLLERR | POLLHUP | POLLNVAL))
+            {
+                Close(conn);
+            }
+            else if (now >= conn.m_deadline)
+            {
+                delta.m_timedOut++;
+                Close(conn);
+            }
+
+            if (conn.m_sock < 0)
+                m_connections.erase(it);
+        }
+
+        QMutexLocker locker(&m_lock);
+        m_stats.m_sending = 0;
+        m_stats.m_idle    = 0;
+        for (const auto &conn : qAsConst(m_connections))
+        {
+            if (conn.m_file >= 0)
+                m_stats.m_sending++;
+            else
+                m_stats.m_idle++;
+        }
+        m_stats.m_filesSent += delta.m_filesSent;
+        m_stats.m_resumed   += delta.m_resumed;
+        m_stats.m_timedOut  += delta.m_timedOut;
+        m_stats.m_errors    += delta.m_errors;
+    }
+
+    QMutexLocker locker(&m_lock);
+    for (auto &conn : m_added)
+        Close(conn);
+    m_added.clear();
+    for (auto &conn : m_connections)
+        Close(conn);
+    m_connections.clear();
+    m_stats.m_sending = 0;
+    m_stats.m_idle    = 0;
+    locker.unlock();
+
+    RunEpilog();
+}
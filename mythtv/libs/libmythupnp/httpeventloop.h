@@ -0,0 +1,90 @@
+#ifndef HTTPEVENTLOOP_H
+#define HTTPEVENTLOOP_H
+
+#include <functional>
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+
+#include "mthread.h"
+#include "upnpexp.h"
+
+/// \brief HttpEventLoop counters, see HttpEventLoop::GetStats()
+struct HttpEventLoopStats
+{
+    int     m_sending      {0}; ///< file bodies being streamed
+    int     m_idle         {0}; ///< keep-alive connections waiting
+    quint64 m_filesSent    {0};
+    quint64 m_bytesSent    {0};
+    quint64 m_resumed      {0}; ///< idle connections handed back
+    quint64 m_timedOut     {0};
+    quint64 m_errors       {0};
+};
+
+/** \class HttpEventLoop
+ *  \brief Serves parked HTTP connections without tying up pool threads.
+ *
+ *  An HttpWorker used to keep its pool thread for as long as its
+ *  connection was open: while it copied a (possibly multi gigabyte) file
+ *  to a slow renderer, and while it waited for the next request on an
+ *  idle keep-alive connection.  Instead, a worker now hands such a plain
+ *  TCP connection to this single thread and returns to the pool.
+ *
+ *  The loop poll()s all parked sockets in non-blocking mode.  File bodies
+ *  are written with sendfile() (a read/write copy elsewhere) as the
+ *  socket drains, and once a body is complete the connection goes idle or
+ *  is closed.  When an idle connection becomes readable it is handed back
+ *  to the resume callback, which starts a new worker for the next request.
+ *
+ *  The loop takes ownership of every descriptor passed to it.
+ */
+class UPNP_PUBLIC HttpEventLoop : public MThread
+{
+  public:
+    using ResumeFunc = std::function<void(int sock)>;
+
+    explicit HttpEventLoop(ResumeFunc resume);
+    ~HttpEventLoop() override;
+
+    bool SendFile(int sock, int file, qint64 start, qint64 length,
+                  bool keepAlive, int idleTimeoutMs);
+    bool WaitForRequest(int sock, int idleTimeoutMs);
+    void Stop(void);
+
+    HttpEventLoopStats GetStats(void);
+
+    static constexpr int    kSendStallTimeoutMs = 30 * 1000;
+    static constexpr qint64 kMaxSendChunk       = 1024 * 1024;
+
+  protected:
+    void run(void) override; // MThread
+
+  private:
+    struct Connection
+    {
+        int    m_sock      {-1};
+        int    m_file      {-1}; ///< -1 when idle
+        qint64 m_offset    {0};
+        qint64 m_remaining {0};
+        bool   m_keepAlive {false};
+        int    m_idleTimeoutMs {0};
+        qint64 m_deadline  {0};  ///< ms since epoch
+    };
+
+    bool Add(const Connection &conn);
+    void Wake(void);
+    bool Send(Connection &conn);
+    void Close(Connection &conn);
+
+    ResumeFunc             m_resume;
+    QMutex                 m_lock;
+    QList<Connection>      m_added;          // protected by m_lock
+    bool                   m_running {true}; // protected by m_lock
+    HttpEventLoopStats     m_stats;          // protected by m_lock
+    int                    m_wakeRead  {-1};
+    int                    m_wakeWrite {-1};
+    QHash<int, Connection> m_connections;    // loop thread only
+};
+
+#endif // HTTPEVENTLOOP_H
@@ -26,6 +26,8 @@
 #define USE_SETSOCKOPT
 #include <sys/sendfile.h>
 #endif
+#include <algorithm>
+#include <array>
 #include <cerrno>
 #include <cstdlib>
 #include <fcntl.h>
@@ -39,6 +41,9 @@
 #endif
 
 #include "upnp.h"
+#ifndef _WIN32
+#include "httpeventloop.h"
+#endif
 
 #include "compat.h"
 #include "mythlogging.h"
@@ -55,10 +60,177 @@
 
 #include <unistd.h> // for gethostname
 
+#include <zlib.h>
+#undef Z_NULL
+#define Z_NULL nullptr
+
 #ifndef O_LARGEFILE
 #define O_LARGEFILE 0
 #endif
 
+// Bodies at least this big are handed to the server's event loop, if any
+static constexpr qint64 kDetachMinBytes = 256 * 1024;
+
+/////////////////////////////////////////////////////////////////////////////
+// Writes a response body of unknown length with the chunked transfer
+// encoding, gzip'd on the fly if the client accepts it.  Output is sent in
+// chunks of about kChunkSize, so the whole body is never held in memory.
+// The device closes itself if the client goes away.
+/////////////////////////////////////////////////////////////////////////////
+
+class HTTPChunkedDevice : public QIODevice
+{
+  public:
+    HTTPChunkedDevice( HTTPRequest *pRequest, bool bGzip );
+    ~HTTPChunkedDevice() override;
+
+    bool    Finish   ();
+    bool    IsComplete() const { return m_bComplete; }
+    qint64  BytesSent() const { return m_nBytesSent; }
+
+    static constexpr int kChunkSize = 32 * 1024;
+
+  protected:
+    qint64  readData ( char */*pData*/, qint64 /*nMaxLen*/ ) override { return -1; }
+    qint64  writeData( const char *pData, qint64 nLen ) override;
+
+  private:
+    bool    Deflate  ( int nFlush );
+    bool    SendChunk( const QByteArray &chunk );
+
+    HTTPRequest *m_pRequest   {nullptr};
+    bool         m_bGzip      {false};
+    z_stream     m_zstream    {};
+    QByteArray   m_buffer;
+    qint64       m_nBytesSent {0};
+    bool         m_bComplete  {false};
+};
+
+HTTPChunkedDevice::HTTPChunkedDevice( HTTPRequest *pRequest, bool bGzip )
+  : m_pRequest(pRequest), m_bGzip(bGzip)
+{
+    if (m_bGzip)
+    {
+        m_zstream.zalloc = Z_NULL;
+        m_zstream.zfree  = Z_NULL;
+        m_zstream.opaque = Z_NULL;
+
+        // 16 + MAX_WBITS writes a gzip rather than a zlib header
+        m_bGzip = deflateInit2( &m_zstream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                                16 + MAX_WBITS, 8,
+                                Z_DEFAULT_STRATEGY ) == Z_OK;
+    }
+
+    m_buffer.reserve( 2 * kChunkSize );
+
+    open( QIODevice::WriteOnly | QIODevice::Unbuffered );
+}
+
+HTTPChunkedDevice::~HTTPChunkedDevice()
+{
+    if (m_bGzip)
+        deflateEnd( &m_zstream );
+}
+
+qint64 HTTPChunkedDevice::writeData( const char *pData, qint64 nLen )
+{
+    if (m_bGzip)
+    {
+        m_zstream.next_in  = reinterpret_cast<Bytef *>(const_cast<char *>(pData));
+        m_zstream.avail_in = static_cast<uInt>(nLen);
+
+        if (!Deflate( Z_NO_FLUSH ))
+        {
+            close();
+            return -1;
+        }
+    }
+    else
+        m_buffer.append( pData, static_cast<int>(nLen) );
+
+    if (m_buffer.size() >= kChunkSize)
+    {
+        if (!SendChunk( m_buffer ))
+        {
+            close();
+            return -1;
+        }
+        m_buffer.clear();
+    }
+
+    return nLen;
+}
+
+bool HTTPChunkedDevice::Deflate( int nFlush )
+{
+    std::array<char,16384> out {};
+
+    do
+    {
+        m_zstream.next_out  = reinterpret_cast<Bytef *>(out.data());
+        m_zstream.avail_out = out.size();
+
+        if (deflate( &m_zstream, nFlush ) == Z_STREAM_ERROR)
+            return false;
+
+        m_buffer.append( out.data(), out.size() - m_zstream.avail_out );
+    }
+    while (m_zstream.avail_out == 0);
+
+    return true;
+}
+
+bool HTTPChunkedDevice::SendChunk( const QByteArray &chunk )
+{
+    QByteArray sChunk = QByteArray::number( chunk.size(), 16 ) + "\r\n" +
+                        chunk + "\r\n";
+
+    if (m_pRequest->WriteBlock( sChunk.constData(), sChunk.size() ) != sChunk.size())
+        return false;
+
+    m_nBytesSent += sChunk.size();
+    return true;
+}
+
+/// \brief Sends whatever is buffered and the terminating empty chunk.
+bool HTTPChunkedDevice::Finish()
+{
+    if (!isOpen())
+        return false;
+
+    if (m_bGzip)
+    {
+        m_zstream.next_in  = Z_NULL;
+        m_zstream.avail_in = 0;
+
+        if (!Deflate( Z_FINISH ))
+            return false;
+    }
+
+    if (!m_buffer.isEmpty() && !SendChunk( m_buffer ))
+        return false;
+    m_buffer.clear();
+
+    // The last chunk has a size of 0 and no trailers
+    if (m_pRequest->WriteBlock( "0\r\n\r\n", 5 ) != 5)
+        return false;
+
+    m_nBytesSent += 5;
+    m_bComplete = true;
+    close();
+
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+HTTPRequest::~HTTPRequest()
+{
+    delete m_pChunkedDevice;
+}
+
 using namespace std;
 
 static std::array<const MIMETypes,63> g_MIMETypes
@@ -242,7 +414,10 @@ QString HTTPRequest::BuildResponseHeader( long long nSize )
             SetResponseHeader("Content-Disposition", QString("inline; filename=\"%2\"").arg(QString(filename.toLatin1())));
         }
 
-        SetResponseHeader("Content-Length", QString::number(nSize));
+        if (m_pChunkedDevice != nullptr)
+            SetResponseHeader("Transfer-Encoding", "chunked");
+        else
+            SetResponseHeader("Content-Length", QString::number(nSize));
 
         // See DLNA  7.4.1.3.11.4.3 Tolerance to unavailable contentFeatures.dlna.org header
         //
@@ -311,6 +486,22 @@ qint64 HTTPRequest::SendResponse( void )
 {
     qint64      nBytes    = 0;
 
+    // A streamed response has already been sent while it was being built.
+    // If it was cut short the connection can't be reused.
+
+    if (m_pChunkedDevice != nullptr)
+    {
+        LOG(VB_HTTP, LOG_INFO,
+            QString("HTTPRequest::SendResponse( Streamed ) :%1 -> %2: %3 bytes")
+                .arg(GetResponseStatus()) .arg(GetPeerAddress())
+                .arg(m_pChunkedDevice->BytesSent()));
+
+        if (!m_pChunkedDevice->IsComplete())
+            return( -1 );
+
+        return( m_pChunkedDevice->BytesSent() );
+    }
+
     switch( m_eResponseType )
     {
         // The following are all eligable for gzip compression
@@ -625,7 +816,16 @@ qint64 HTTPRequest::SendResponseFile( const QString& sFileName )
         QString("SendResponseFile : size = %1, start = %2, end = %3")
             .arg(llSize).arg(llStart).arg(llEnd));
 #endif
-    if (( m_eType != RequestTypeHead ) && (llSize != 0))
+    if (( m_eType != RequestTypeHead ) && (llSize != 0) &&
+        (llSize >= kDetachMinBytes) && (nBytes == sHeader.length()) &&
+        SendFileDetached( tmpFile, llStart, llSize ))
+    {
+        m_bDetached = true;
+        LOG(VB_HTTP, LOG_DEBUG,
+            QString("SendResponseFile( %1 ) Streaming %2 bytes from event loop")
+                .arg(sFileName).arg(llSize));
+    }
+    else if (( m_eType != RequestTypeHead ) && (llSize != 0))
     {
         long long sent = SendFile( tmpFile, llStart, llSize );
 
@@ -781,6 +981,82 @@ void HTTPRequest::FormatActionResponse( Serializer *pSer )
 //
 /////////////////////////////////////////////////////////////////////////////
 
+bool HTTPRequest::CanStreamResponse() const
+{
+    // Chunked transfer encoding needs HTTP/1.1, and HEAD has no body
+    return (m_eType != RequestTypeHead) &&
+           ((m_nMajor > 1) || ((m_nMajor == 1) && (m_nMinor >= 1)));
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Sends the response header, and returns a serializer that writes the body
+// straight to the client.  Returns nullptr if the response can't be streamed,
+// in which case the caller should serialize into m_response as usual.
+/////////////////////////////////////////////////////////////////////////////
+
+Serializer *HTTPRequest::BeginStreamedResponse()
+{
+    if (!CanStreamResponse() || (m_pChunkedDevice != nullptr))
+        return nullptr;
+
+    auto values = m_mapHeaders.values("accept-encoding");
+    bool bGzip  = std::any_of(values.cbegin(), values.cend(),
+                              [](const auto & value)
+                                  {return value.contains( "gzip" ); });
+
+    auto       *pDevice = new HTTPChunkedDevice( this, bGzip );
+    Serializer *pSer    = GetSerializer( pDevice );
+
+    if (!pSer->CanStream())
+    {
+        delete pSer;
+        delete pDevice;
+        return nullptr;
+    }
+
+    m_pChunkedDevice    = pDevice;
+
+    m_eResponseType     = ResponseTypeOther;
+    m_sResponseTypeText = pSer->GetContentType();
+    m_nResponseStatus   = 200;
+
+    // The ETag is a hash of the body, which isn't known until it's sent
+    pSer->AddHeaders( m_mapRespHeaders );
+    m_mapRespHeaders.remove( "ETag" );
+    m_mapRespHeaders[ "Cache-Control" ] = "no-cache";
+
+    if (bGzip)
+        SetResponseHeader( "Content-Encoding", "gzip" );
+
+    QByteArray sHeader = BuildResponseHeader( -1 ).toUtf8();
+
+    if (WriteBlock( sHeader.constData(), sHeader.length() ) < sHeader.length())
+    {
+        LOG( VB_HTTP, LOG_ERR, "HttpRequest::BeginStreamedResponse(): "
+                               "Incomplete write of header");
+        pDevice->close();
+    }
+
+    return pSer;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void HTTPRequest::EndStreamedResponse()
+{
+    if ((m_pChunkedDevice != nullptr) && !m_pChunkedDevice->Finish())
+    {
+        LOG(VB_HTTP, LOG_ERR, "HttpRequest::EndStreamedResponse(): "
+                              "Error occurred while writing response body.");
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
 void HTTPRequest::FormatActionResponse(const NameValues &args)
 {
     m_eResponseType   = ResponseTypeXML;
@@ -1763,13 +2039,16 @@ bool HTTPRequest::ProcessSOAPPayload( const QString &sSOAPAction )
 //
 /////////////////////////////////////////////////////////////////////////////
 
-Serializer *HTTPRequest::GetSerializer()
+Serializer *HTTPRequest::GetSerializer( QIODevice *pDevice )
 {
     Serializer *pSerializer = nullptr;
 
+    if (pDevice == nullptr)
+        pDevice = &m_response;
+
     if (m_bSOAPRequest)
     {
-        pSerializer = (Serializer *)new SoapSerializer(&m_response,
+        pSerializer = (Serializer *)new SoapSerializer(pDevice,
                                                        m_sNameSpace, m_sMethod);
     }
     else
@@ -1779,19 +2058,19 @@ Serializer *HTTPRequest::GetSerializer()
         if (sAccept.contains( "application/json", Qt::CaseInsensitive ) ||
             sAccept.contains( "text/javascript", Qt::CaseInsensitive ))
         {
-            pSerializer = (Serializer *)new JSONSerializer(&m_response,
+            pSerializer = (Serializer *)new JSONSerializer(pDevice,
                                                            m_sMethod);
         }
         else if (sAccept.contains( "text/x-apple-plist+xml", Qt::CaseInsensitive ))
         {
-            pSerializer = (Serializer *)new XmlPListSerializer(&m_response);
+            pSerializer = (Serializer *)new XmlPListSerializer(pDevice);
         }
     }
 
     // Default to XML
 
     if (pSerializer == nullptr)
-        pSerializer = (Serializer *)new XmlSerializer(&m_response, m_sMethod);
+        pSerializer = (Serializer *)new XmlSerializer(pDevice, m_sMethod);
 
     return pSerializer;
 }
@@ -2461,6 +2740,51 @@ qint64 BufferedSocketDeviceRequest::WriteBlock(const char *pData, qint64 nLen)
     return( bytesWritten );
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// Hands the rest of the response to the event loop, which writes it with
+// sendfile() while this thread goes back to the pool.  The loop gets its
+// own descriptors, so closing m_pSocket and the QFile afterwards is safe.
+/////////////////////////////////////////////////////////////////////////////
+
+bool BufferedSocketDeviceRequest::SendFileDetached( QFile &file,
+                                                    qint64 llStart,
+                                                    qint64 llBytes )
+{
+#ifndef _WIN32
+    // A pipelined request already read into the socket's buffer would be
+    // lost along with it.
+    if (!m_pEventLoop || !m_pSocket || (m_pSocket->bytesAvailable() > 0))
+        return false;
+
+    while (m_pSocket->bytesToWrite() > 0)
+    {
+        if (!m_pSocket->waitForBytesWritten())
+            return false;
+    }
+
+    int nSock = dup( m_pSocket->socketDescriptor() );
+    int nFile = dup( file.handle() );
+
+    if ((nSock >= 0) && (nFile >= 0) &&
+        m_pEventLoop->SendFile( nSock, nFile, llStart, llBytes, GetKeepAlive(),
+                                static_cast<int>(GetKeepAliveTimeout()) * 1000 ))
+    {
+        return true;
+    }
+
+    if (nSock >= 0)
+        close( nSock );
+    if (nFile >= 0)
+        close( nFile );
+#else
+    Q_UNUSED(file);
+    Q_UNUSED(llStart);
+    Q_UNUSED(llBytes);
+#endif
+
+    return false;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 //
 /////////////////////////////////////////////////////////////////////////////
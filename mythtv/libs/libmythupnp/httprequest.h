@@ -93,6 +93,9 @@ struct MIMETypes
 
 /////////////////////////////////////////////////////////////////////////////
 
+class HttpEventLoop;
+class HTTPChunkedDevice;
+
 class IPostProcess
 {
     public:
@@ -166,6 +169,9 @@ class UPNP_PUBLIC HTTPRequest
 
     protected:
 
+        bool                m_bDetached         {false};
+        HTTPChunkedDevice  *m_pChunkedDevice    {nullptr}; // streamed body
+
         HttpRequestType SetRequestType      ( const QString &sType  );
         void            SetRequestProtocol  ( const QString &sLine  );
         HttpContentType SetContentType      ( const QString &sType  );
@@ -191,6 +197,8 @@ class UPNP_PUBLIC HTTPRequest
 
         qint64          SendData            ( QIODevice *pDevice, qint64 llStart, qint64 llBytes );
         qint64          SendFile            ( QFile &file, qint64 llStart, qint64 llBytes );
+        virtual bool    SendFileDetached    ( QFile &/*file*/, qint64 /*llStart*/,
+                                              qint64 /*llBytes*/ ) { return false; }
 
         bool            IsProtected         () const { return m_bProtected; }
         bool            IsEncrypted         () const { return m_bEncrypted; }
@@ -206,7 +214,7 @@ class UPNP_PUBLIC HTTPRequest
     public:
 
                         HTTPRequest     () { m_response.open( QIODevice::ReadWrite ); }
-        virtual        ~HTTPRequest     () = default;
+        virtual        ~HTTPRequest     ();
 
         bool            ParseRequest    ();
 
@@ -219,6 +227,10 @@ class UPNP_PUBLIC HTTPRequest
         void            FormatFileResponse  ( const QString &sFileName );
         void            FormatRawResponse   ( const QString &sXML );
 
+        bool            CanStreamResponse   () const;
+        Serializer *    BeginStreamedResponse();
+        void            EndStreamedResponse ();
+
         qint64          SendResponse    ( void );
         qint64          SendResponseFile( const QString& sFileName );
 
@@ -234,7 +246,7 @@ class UPNP_PUBLIC HTTPRequest
 
         bool            GetKeepAlive () const { return m_bKeepAlive; }
 
-        Serializer *    GetSerializer   ();
+        Serializer *    GetSerializer   ( QIODevice *pDevice = nullptr );
 
         QByteArray      GetResponsePage     ( void ); // Static response e.g. 400, 404, 501
 
@@ -253,6 +265,10 @@ class UPNP_PUBLIC HTTPRequest
         static QString  GetETagHash     ( const QByteArray &data );
 
         void            SetKeepAliveTimeout ( int nTimeout ) { m_nKeepAliveTimeout = nTimeout; }
+        uint            GetKeepAliveTimeout () const { return m_nKeepAliveTimeout; }
+
+        /// True once the connection has been handed over to finish a response
+        bool            IsDetached          () const { return m_bDetached; }
 
         static bool            IsUrlProtected      ( const QString &sBaseUrl );
 
@@ -277,12 +293,14 @@ class BufferedSocketDeviceRequest : public HTTPRequest
 {
     public:
 
-        QTcpSocket    *m_pSocket {nullptr};
+        QTcpSocket    *m_pSocket    {nullptr};
+        HttpEventLoop *m_pEventLoop {nullptr}; ///< streams large files if set
 
     public:
 
-        explicit BufferedSocketDeviceRequest( QTcpSocket *pSocket )
-            : m_pSocket(pSocket) {}
+        explicit BufferedSocketDeviceRequest( QTcpSocket *pSocket,
+                                              HttpEventLoop *pEventLoop = nullptr )
+            : m_pSocket(pSocket), m_pEventLoop(pEventLoop) {}
         ~BufferedSocketDeviceRequest() override = default;
 
         QString  ReadLine        ( int msecs ) override; // HTTPRequest
@@ -294,6 +312,9 @@ class BufferedSocketDeviceRequest : public HTTPRequest
         int      getSocketHandle () override // HTTPRequest
             {return( m_pSocket->socketDescriptor() ); }
 
+    protected:
+
+        bool     SendFileDetached( QFile &file, qint64 llStart, qint64 llBytes ) override; // HTTPRequest
 };
 
 /////////////////////////////////////////////////////////////////////////////
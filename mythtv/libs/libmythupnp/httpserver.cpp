@@ -21,6 +21,7 @@
 // POSIX headers
 #ifndef _WIN32
 #include <sys/utsname.h> 
+#include <unistd.h>
 #endif
 
 // Qt headers
@@ -29,6 +30,7 @@
 #include <QSslSocket>
 #include <QSslCipher>
 #include <QSslCertificate>
+#include <QTextStream>
 #include <QUuid>
 
 // MythTV headers
@@ -37,7 +39,11 @@
 #include "compat.h"
 #include "mythdirs.h"
 #include "mythlogging.h"
+#include "mythmetrics.h"
 #include "htmlserver.h"
+#ifndef _WIN32
+#include "httpeventloop.h"
+#endif
 #include "mythversion.h"
 #include "mythcorecontext.h"
 
@@ -161,6 +167,42 @@ HttpServer::HttpServer() :
     RegisterExtension( new RttiServiceHost( m_sSharePath ));
 
     LoadSSLConfig();
+
+#ifndef _WIN32
+    // Idle keep-alive connections and large file bodies are served from
+    // here, so they don't count against maxHttpWorkers
+    m_eventLoop = new HttpEventLoop([this](int sock) { ResumeConnection(sock); });
+    m_eventLoop->start();
+
+    MythMetrics::AddCollector("httpserver", [this](QTextStream &os)
+    {
+        HttpEventLoopStats stats = m_eventLoop->GetStats();
+
+        MythMetrics::PrintFamily(os, "mythtv_http_parked_connections", "gauge",
+                                 "Connections served by the HTTP event loop");
+        os << "mythtv_http_parked_connections{state=\"sending\"} "
+           << stats.m_sending << "\n"
+           << "mythtv_http_parked_connections{state=\"idle\"} "
+           << stats.m_idle << "\n";
+
+        MythMetrics::PrintFamily(os, "mythtv_http_files_sent_total", "counter",
+                                 "File bodies streamed by the HTTP event loop");
+        os << "mythtv_http_files_sent_total " << stats.m_filesSent << "\n";
+
+        MythMetrics::PrintFamily(os, "mythtv_http_file_bytes_sent_total",
+                                 "counter",
+                                 "Data streamed by the HTTP event loop");
+        os << "mythtv_http_file_bytes_sent_total " << stats.m_bytesSent << "\n";
+
+        MythMetrics::PrintFamily(os, "mythtv_http_connections_closed_total",
+                                 "counter",
+                                 "Parked connections closed, by reason");
+        os << "mythtv_http_connections_closed_total{reason=\"timeout\"} "
+           << stats.m_timedOut << "\n"
+           << "mythtv_http_connections_closed_total{reason=\"error\"} "
+           << stats.m_errors << "\n";
+    });
+#endif
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -173,8 +215,20 @@ HttpServer::~HttpServer()
     m_running = false;
     m_rwlock.unlock();
 
+#ifndef _WIN32
+    MythMetrics::RemoveCollector("httpserver");
+
+    // Stop parking connections before the workers are waited for
+    m_eventLoop->Stop();
+#endif
+
     m_threadPool.Stop();
 
+#ifndef _WIN32
+    delete m_eventLoop;
+    m_eventLoop = nullptr;
+#endif
+
     while (!m_extensions.empty())
     {
         delete m_extensions.takeFirst();
@@ -305,6 +359,17 @@ void HttpServer::newTcpConnection(qt_socket_fd_t socket)
     if (server)
         type = server->GetServerType();
 
+#ifndef _WIN32
+    // Until its request starts to arrive, a new client waits in the event
+    // loop, for as long as HttpWorker would wait for it, instead of holding
+    // a worker. SSL connections need a worker for the handshake.
+    if (type == kTCPServer && m_eventLoop &&
+        m_eventLoop->WaitForRequest(static_cast<int>(socket), 5 * 1000))
+    {
+        return;
+    }
+#endif
+
     m_threadPool.startReserved(
         new HttpWorker(*this, socket, type
 #ifndef QT_NO_OPENSSL
@@ -314,6 +379,29 @@ void HttpServer::newTcpConnection(qt_socket_fd_t socket)
         QString("HttpServer%1").arg(socket));
 }
 
+#ifndef _WIN32
+/**
+ * \brief Starts a worker for a new or parked connection that has become
+ *        readable
+ */
+void HttpServer::ResumeConnection(int sock)
+{
+    if (!IsRunning())
+    {
+        close(sock);
+        return;
+    }
+
+    m_threadPool.startReserved(
+        new HttpWorker(*this, sock, kTCPServer
+#ifndef QT_NO_OPENSSL
+                       , m_sslConfig
+#endif
+                       ),
+        QString("HttpServer%1").arg(sock));
+}
+#endif
+
 /////////////////////////////////////////////////////////////////////////////
 //
 /////////////////////////////////////////////////////////////////////////////
@@ -477,6 +565,8 @@ void HttpWorker::run(void)
     HTTPRequest            *pRequest   = nullptr;
     QTcpSocket             *pSocket    = nullptr;
     bool                    bEncrypted = false;
+    bool                    bParked    = false;
+    HttpEventLoop          *pEventLoop = nullptr;
 
     if (m_connectionType == kSSLServer)
     {
@@ -526,6 +616,8 @@ void HttpWorker::run(void)
             return;
         }
 
+        pEventLoop = m_httpServer.GetEventLoop();
+
     }
 
     pSocket->setSocketOption(QAbstractSocket::KeepAliveOption, QVariant(1));
@@ -540,7 +632,32 @@ void HttpWorker::run(void)
             // new clients from connecting - Default at time of writing was
             // 5 seconds for initial connection, then up to 10 seconds of idle
             // time between each subsequent request on the same connection
-            bTimeout = !(pSocket->waitForReadyRead(m_socketTimeout));
+            bool bReady = pSocket->bytesAvailable() > 0;
+
+            // A client that doesn't send its next request straight away
+            // waits in the event loop rather than holding this thread
+            if (!bReady && pEventLoop)
+            {
+                bReady = pSocket->waitForReadyRead(kParkAfterMs);
+                if (!bReady &&
+                    pSocket->error() == QAbstractSocket::SocketTimeoutError &&
+                    pSocket->bytesToWrite() == 0)
+                {
+#ifndef _WIN32
+                    int nSock = dup(pSocket->socketDescriptor());
+                    if (nSock >= 0 &&
+                        pEventLoop->WaitForRequest(nSock, m_socketTimeout))
+                    {
+                        bParked = true;
+                        break;
+                    }
+                    if (nSock >= 0)
+                        close(nSock);
+#endif
+                }
+            }
+
+            bTimeout = !bReady && !(pSocket->waitForReadyRead(m_socketTimeout));
 
             if (bTimeout) // Either client closed the socket or we timed out waiting for new data
                 break;
@@ -555,7 +672,7 @@ void HttpWorker::run(void)
                 // See if this is a valid request
                 // ----------------------------------------------------------
 
-                pRequest = new BufferedSocketDeviceRequest( pSocket );
+                pRequest = new BufferedSocketDeviceRequest( pSocket, pEventLoop );
                 if (pRequest != nullptr)
                 {
                     pRequest->m_bEncrypted = bEncrypted;
@@ -607,6 +724,15 @@ void HttpWorker::run(void)
                     if ( pRequest->m_pPostProcess != nullptr )
                         pRequest->m_pPostProcess->ExecutePostProcess();
 
+                    // -------------------------------------------------------
+                    // The event loop owns the connection from here on
+                    // -------------------------------------------------------
+                    if (pRequest->IsDetached())
+                    {
+                        bParked    = true;
+                        bKeepAlive = false;
+                    }
+
                     delete pRequest;
                     pRequest = nullptr;
                 }
@@ -631,7 +757,8 @@ void HttpWorker::run(void)
 
     delete pRequest;
 
-    if ((pSocket->error() != QAbstractSocket::UnknownSocketError) &&
+    if (!bParked &&
+        (pSocket->error() != QAbstractSocket::UnknownSocketError) &&
         !(bKeepAlive && pSocket->error() == QAbstractSocket::SocketTimeoutError)) // This 'error' isn't an error when keep-alive is active
     {
         LOG(VB_HTTP, LOG_WARNING, QString("HttpWorker(%1): Error %2 (%3)")
@@ -642,7 +769,8 @@ void HttpWorker::run(void)
 
     int writeTimeout = 5000; // 5 Seconds
     // Make sure any data in the buffer is flushed before the socket is closed
-    while (m_httpServer.IsRunning() &&
+    while (!bParked &&
+           m_httpServer.IsRunning() &&
            pSocket->isValid() &&
            pSocket->state() == QAbstractSocket::ConnectedState &&
            pSocket->bytesToWrite() > 0)
@@ -682,9 +810,10 @@ void HttpWorker::run(void)
                                             .arg(pSocket->errorString()));
     }
 
-    LOG(VB_HTTP, LOG_INFO, QString("HttpWorker(%1): Connection %2 closed. %3 requests were handled")
+    LOG(VB_HTTP, LOG_INFO, QString("HttpWorker(%1): Connection %2 %3. %4 requests were handled")
                                         .arg(m_socket)
                                         .arg(pSocket->socketDescriptor())
+                                        .arg(bParked ? "parked" : "closed")
                                         .arg(nRequestsHandled));
 
     pSocket->close();
@@ -45,6 +45,7 @@
 using TaskTime = struct timeval;
 
 class HttpWorkerThread;
+class HttpEventLoop;
 class QScriptEngine;
 class HttpServer;
 #ifndef QT_NO_OPENSSL
@@ -141,6 +142,9 @@ class UPNP_PUBLIC HttpServer : public ServerPool
     static QString GetPlatform(void);
     static QString GetServerVersion(void);
 
+    /// The loop parked plain TCP connections are handed to, may be null
+    HttpEventLoop *GetEventLoop(void) const { return m_eventLoop; }
+
   protected:
     mutable QReadWriteLock  m_rwlock;
     HttpServerExtensionList m_extensions;
@@ -148,6 +152,7 @@ class UPNP_PUBLIC HttpServer : public ServerPool
     QMultiMap< QString, HttpServerExtension* >  m_basePaths;
     QString                 m_sSharePath;
     MThreadPool             m_threadPool;
+    HttpEventLoop          *m_eventLoop  { nullptr };
     bool                    m_running    { true }; // protected by m_rwlock
 
     static QMutex           s_platformLock;
@@ -164,6 +169,9 @@ class UPNP_PUBLIC HttpServer : public ServerPool
 
   private:
     void LoadSSLConfig();
+#ifndef _WIN32
+    void ResumeConnection(int sock);
+#endif
 };
 
 /////////////////////////////////////////////////////////////////////////////
@@ -198,6 +206,8 @@ class HttpWorker : public QRunnable
     int         m_socketTimeout;
     PoolServerType m_connectionType;
 
+    static constexpr int kParkAfterMs = 50;
+
 #ifndef QT_NO_OPENSSL
     QSslConfiguration       m_sslConfig;
 #endif
@@ -13,6 +13,8 @@
 #include "jsonSerializer.h"
 #include "mythdate.h"
 
+#include <algorithm>
+
 #include <QTextCodec>
 #include <QVariant>
 
@@ -92,6 +94,47 @@ void JSONSerializer::AddProperty( const QString       &sName,
     m_bCommaNeeded = true;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// Renders the same as a QVariantList of the cursor's items, but each item is
+// written out and deleted before the next one is fetched.
+//////////////////////////////////////////////////////////////////////////////
+
+void JSONSerializer::AddCursorProperty( const QString       &sName,
+                                        SerializerCursor    *pCursor,
+                                        const QMetaObject   */*pMetaParent*/,
+                                        const QMetaProperty */*pMetaProp*/ )
+{
+    if (m_bCommaNeeded)
+        m_stream << ", ";
+
+    m_stream << "\"" << sName << "\": [";
+
+    bool     bFirst = true;
+    QObject *pItem  = nullptr;
+
+    while ((pItem = pCursor->Next()) != nullptr)
+    {
+        if (bFirst)
+            bFirst = false;
+        else
+            m_stream << ",";
+
+        RenderValue( QVariant::fromValue< QObject* >( pItem ));
+
+        delete pItem;
+
+        m_stream.flush();
+
+        // Stop producing items nobody will receive
+        if ((m_stream.device() != nullptr) && !m_stream.device()->isWritable())
+            break;
+    }
+
+    m_stream << "]";
+
+    m_bCommaNeeded = true;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 //
 //////////////////////////////////////////////////////////////////////////////
@@ -227,24 +270,41 @@ void JSONSerializer::RenderMap( const QVariantMap &map )
 
 QString JSONSerializer::Encode(const QString &sIn)
 {
-    if (sIn.isEmpty())
-        return sIn;
+    // Most values need no escaping, so only copy those that do
 
-    QString sStr = sIn;
+    auto needsEscape = [](QChar ch)
+    {
+        switch (ch.unicode())
+        {
+            case '\\': case '"': case '/':
+            case '\b': case '\f': case '\n': case '\r': case '\t':
+                return true;
+            default:
+                return false;
+        }
+    };
 
-    // -=>TODO: Would it be better to just loop through string once and build 
-    // new string with encoded chars instead of calling replace multiple times?
-    // It might perform better.
+    if (std::none_of(sIn.cbegin(), sIn.cend(), needsEscape))
+        return sIn;
 
-    sStr.replace( '\\', "\\\\" ); // This must be first
-    sStr.replace( '"' , "\\\"" ); 
+    QString sStr;
+    sStr.reserve( sIn.length() + 16 );
 
-    sStr.replace( '\b', "\\b"  );
-    sStr.replace( '\f', "\\f"  );
-    sStr.replace( '\n', "\\n"  );
-    sStr.replace( "\r", "\\r"  );
-    sStr.replace( "\t", "\\t"  );
-    sStr.replace(  "/", "\\/"  );
+    for (QChar ch : sIn)
+    {
+        switch (ch.unicode())
+        {
+            case '\\': sStr += "\\\\"; break;
+            case '"' : sStr += "\\\""; break;
+            case '/' : sStr += "\\/";  break;
+            case '\b': sStr += "\\b";  break;
+            case '\f': sStr += "\\f";  break;
+            case '\n': sStr += "\\n";  break;
+            case '\r': sStr += "\\r";  break;
+            case '\t': sStr += "\\t";  break;
+            default  : sStr += ch;     break;
+        }
+    }
 
     // we don't handle hex values yet...
     /*
@@ -47,6 +47,10 @@ class UPNP_PUBLIC JSONSerializer : public Serializer
                           const QMetaObject   *pMetaParent,
                           const QMetaProperty *pMetaProp ) override; // Serializer
 
+        void AddCursorProperty( const QString       &sName,
+                                SerializerCursor    *pCursor,
+                                const QMetaObject   *pMetaParent,
+                                const QMetaProperty *pMetaProp ) override; // Serializer
 
         void RenderValue     ( const QVariant     &vValue );
 
@@ -63,6 +67,7 @@ class UPNP_PUBLIC JSONSerializer : public Serializer
         virtual ~JSONSerializer() = default;
 
         QString GetContentType() override; // Serializer
+        bool    CanStream     () override { return true; } // Serializer
 
 };
 
@@ -12,8 +12,30 @@
 
 #include "serializer.h"
 
+#include <QMetaClassInfo>
 #include <QMetaObject>
 #include <QMetaProperty>
+#include <QReadWriteLock>
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//////////////////////////////////////////////////////////////////////////////
+
+SerializerCursor *SerializerCursor::Find( const QObject *pObject )
+{
+    if (pObject == nullptr)
+        return nullptr;
+
+    for (QObject *pChild : pObject->children())
+    {
+        auto *pCursor = qobject_cast< SerializerCursor* >( pChild );
+
+        if (pCursor != nullptr)
+            return pCursor;
+    }
+
+    return nullptr;
+}
 
 //////////////////////////////////////////////////////////////////////////////
 //
@@ -52,12 +74,16 @@ void Serializer::Serialize( const QObject *pObject, const QString &_sName )
 
     m_hash.reset();
 
+    m_pCursor = SerializerCursor::Find( pObject );
+
     BeginSerialize( sName );
 
     SerializeObject( pObject, sName );
 
     EndSerialize();
 
+    m_pCursor = nullptr;
+
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -105,44 +131,136 @@ void Serializer::SerializeObjectProperties( const QObject *pObject )
     if (pObject != nullptr)
     {
         const QMetaObject *pMetaObject = pObject->metaObject();
+        const ClassInfo   *pClassInfo  = GetClassInfo( pMetaObject );
 
-        int nCount = pMetaObject->propertyCount();
-
-        for (int nIdx=0; nIdx < nCount; ++nIdx ) 
+        for (const auto &prop : pClassInfo->m_properties)
         {
-            QMetaProperty metaProperty = pMetaObject->property( nIdx );
+            if (!prop.m_metaProp.isDesignable( pObject ))
+                continue;
+
+            if (!prop.m_bTransient)
+                m_hash.addData( prop.m_sNameUtf8 );
+
+            // A list produced by a cursor is only ever on the result itself
+
+            if ((m_pCursor != nullptr) && (m_pCursor->parent() == pObject) &&
+                (m_pCursor->objectName() == prop.m_sName))
+            {
+                AddCursorProperty( prop.m_sName, m_pCursor,
+                                   pMetaObject, &prop.m_metaProp );
+                continue;
+            }
+
+            QVariant value( prop.m_metaProp.read( pObject ) );
 
-            if (metaProperty.isDesignable( pObject ))
+            if (!prop.m_bTransient && !value.canConvert< QObject* >())
             {
-                const char *pszPropName = metaProperty.name();
-                QString     sPropName( pszPropName );
-
-                if ( sPropName.compare( "objectName" ) == 0)
-                    continue;
-                
-                bool bHash = false;
-
-                if (ReadPropertyMetadata( pObject, 
-                                          sPropName,
-                                          "transient").toLower() != "true" )
-                {
-                    bHash = true;
-                    m_hash.addData( sPropName.toUtf8() );
-                }
-
-                QVariant value( pObject->property( pszPropName ) );
-
-                if (bHash && !value.canConvert< QObject* >()) 
-                {
-                    m_hash.addData( value.toString().toUtf8() );
-                }
-
-                AddProperty( sPropName, value, pMetaObject, &metaProperty );
+                m_hash.addData( value.toString().toUtf8() );
             }
+
+            AddProperty( prop.m_sName, value, pMetaObject, &prop.m_metaProp );
         }
     }
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// Default for serializers that can't stream: collect the cursor's items and
+// render them as an ordinary list.
+//////////////////////////////////////////////////////////////////////////////
+
+void Serializer::AddCursorProperty( const QString       &sName,
+                                    SerializerCursor    *pCursor,
+                                    const QMetaObject   *pMetaParent,
+                                    const QMetaProperty *pMetaProp )
+{
+    QVariantList     list;
+    QList<QObject*>  items;
+
+    QObject *pItem = nullptr;
+
+    while ((pItem = pCursor->Next()) != nullptr)
+    {
+        items.append( pItem );
+        list.append( QVariant::fromValue< QObject* >( pItem ));
+    }
+
+    AddProperty( sName, list, pMetaParent, pMetaProp );
+
+    qDeleteAll( items );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//////////////////////////////////////////////////////////////////////////////
+
+const Serializer::ClassInfo *Serializer::GetClassInfo( const QMetaObject *pMetaObject )
+{
+    // QMetaObjects are static, so entries are never removed.
+
+    static QReadWriteLock                               s_lock;
+    static QHash< const QMetaObject*, const ClassInfo* > s_classes;
+
+    {
+        QReadLocker locker( &s_lock );
+
+        const ClassInfo *pInfo = s_classes.value( pMetaObject, nullptr );
+
+        if (pInfo != nullptr)
+            return pInfo;
+    }
+
+    auto *pInfo = new ClassInfo;
+
+    // Options are kept for every Q_CLASSINFO entry, not just properties, as
+    // XmlSerializer::GetContentName() also looks up other names.  Where a
+    // subclass repeats a key, use the entry indexOfClassInfo() would find.
+
+    for (int nIdx = 0; nIdx < pMetaObject->classInfoCount(); ++nIdx)
+    {
+        QMetaClassInfo info = pMetaObject->classInfo( nIdx );
+
+        if (pMetaObject->indexOfClassInfo( info.name() ) == nIdx)
+        {
+            pInfo->m_metadata.insert( QString( info.name() ),
+                                      QString( info.value() ).split( ';' ));
+        }
+    }
+
+    int nCount = pMetaObject->propertyCount();
+
+    for (int nIdx = 0; nIdx < nCount; ++nIdx)
+    {
+        QMetaProperty metaProperty = pMetaObject->property( nIdx );
+        QString       sPropName( metaProperty.name() );
+
+        if ( sPropName.compare( "objectName" ) == 0)
+            continue;
+
+        QStringList options = pInfo->m_metadata.value( sPropName );
+
+        PropertyInfo prop;
+        prop.m_metaProp   = metaProperty;
+        prop.m_sName      = sPropName;
+        prop.m_sNameUtf8  = sPropName.toUtf8();
+        prop.m_bTransient = options.contains( "transient=true", Qt::CaseInsensitive );
+        pInfo->m_properties.append( prop );
+    }
+
+    QWriteLocker locker( &s_lock );
+
+    const ClassInfo *pExisting = s_classes.value( pMetaObject, nullptr );
+
+    if (pExisting != nullptr)
+    {
+        delete pInfo;
+        return pExisting;
+    }
+
+    s_classes.insert( pMetaObject, pInfo );
+
+    return pInfo;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 //
 /////////////////////////////////////////////////////////////////////////////
@@ -151,28 +269,37 @@ QString Serializer::ReadPropertyMetadata( const QObject *pObject,
                                                 const QString&  sPropName,
                                                 const QString&  sKey )
 {
-    const QMetaObject *pMeta = pObject->metaObject();
+    if (pObject == nullptr)
+        return QString();
+
+    return ReadPropertyMetadata( pObject->metaObject(), sPropName, sKey );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+QString Serializer::ReadPropertyMetadata( const QMetaObject *pMetaObject,
+                                          const QString&  sPropName,
+                                          const QString&  sKey )
+{
+    if (pMetaObject == nullptr)
+        return QString();
 
-    int nIdx = -1;
+    const ClassInfo *pClassInfo = GetClassInfo( pMetaObject );
 
-    if (pMeta)
-        nIdx = pMeta->indexOfClassInfo( sPropName.toUtf8());
+    auto it = pClassInfo->m_metadata.constFind( sPropName );
 
-    if (nIdx >=0)
-    {
-        QString     sMetadata = pMeta->classInfo( nIdx ).value();
-        QStringList sOptions  = sMetadata.split( ';' );
+    if (it == pClassInfo->m_metadata.constEnd())
+        return QString();
 
-        QString     sFullKey  = sKey + "=";
+    QString sFullKey = sKey + "=";
 
-        for (nIdx = 0; nIdx < sOptions.size(); ++nIdx)
-        {
-            if (sOptions.at( nIdx ).startsWith( sFullKey ))
-                return sOptions.at( nIdx ).mid( sFullKey.length() );
-        }
+    for (const auto &sOption : *it)
+    {
+        if (sOption.startsWith( sFullKey ))
+            return sOption.mid( sFullKey.length() );
     }
 
     return QString();
 }
-
-
@@ -17,9 +17,48 @@
 #include "upnputil.h"
 
 #include <QList>
+#include <QHash>
+#include <QMetaProperty>
 #include <QMetaType>
+#include <QObject>
+#include <QStringList>
+#include <QVector>
 #include <QCryptographicHash>
 
+//////////////////////////////////////////////////////////////////////////////
+//
+// SerializerCursor - produces the items of a list property on demand.
+//
+// A service method whose result holds thousands of objects can attach a
+// cursor to it in place of filling one of its QVariantList properties.  A
+// serializer that can stream writes each item as soon as Next() returns it
+// and then deletes it, so the complete object graph never exists at once.
+// Other serializers collect the items into a list first.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+class UPNP_PUBLIC SerializerCursor : public QObject
+{
+    Q_OBJECT
+
+    public:
+
+        SerializerCursor() = default;
+        ~SerializerCursor() override = default;
+
+        // The result takes ownership of the cursor
+        void Attach( QObject *pResult, const QString &sProperty )
+        {
+            setParent( pResult );
+            setObjectName( sProperty );
+        }
+
+        // Returns the next item, owned by the caller, or nullptr at the end
+        virtual QObject *Next() = 0;
+
+        static SerializerCursor *Find( const QObject *pObject );
+};
+
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 //
@@ -32,7 +71,27 @@ class UPNP_PUBLIC Serializer
 {
     protected:
 
+        // ------------------------------------------------------------------
+        // What the serializer needs of a class is built once per class
+        // rather than looked up by name for every property of every object.
+        // ------------------------------------------------------------------
+
+        struct PropertyInfo
+        {
+            QMetaProperty   m_metaProp;
+            QString         m_sName;
+            QByteArray      m_sNameUtf8;
+            bool            m_bTransient {false};
+        };
+
+        struct ClassInfo
+        {
+            QVector< PropertyInfo >        m_properties; // without objectName
+            QHash< QString, QStringList >  m_metadata;   // Q_CLASSINFO options
+        };
+
         QCryptographicHash  m_hash;
+        SerializerCursor   *m_pCursor {nullptr};
 
         virtual void BeginSerialize( QString &/*sName*/ ) {}
         virtual void EndSerialize  () {}
@@ -45,14 +104,24 @@ class UPNP_PUBLIC Serializer
                                   const QMetaObject   *pMetaParent,
                                   const QMetaProperty *pMetaProp ) = 0;
 
+        virtual void AddCursorProperty( const QString       &sName,
+                                        SerializerCursor    *pCursor,
+                                        const QMetaObject   *pMetaParent,
+                                        const QMetaProperty *pMetaProp );
+
         //////////////////////////////////////////////////////////////////////
 
         void SerializeObject          ( const QObject *pObject, const QString &sName );
         void SerializeObjectProperties( const QObject *pObject );
 
+        static const ClassInfo *GetClassInfo( const QMetaObject *pMetaObject );
+
         static QString    ReadPropertyMetadata  ( const QObject *pObject, 
                                                  const QString&  sPropName,
                                                  const QString&  sKey );
+        static QString    ReadPropertyMetadata  ( const QMetaObject *pMetaObject,
+                                                  const QString&  sPropName,
+                                                  const QString&  sKey );
 
     public:
 
@@ -66,8 +135,12 @@ class UPNP_PUBLIC Serializer
         virtual QString GetContentType () = 0;
         virtual void    AddHeaders     ( QStringMap &headers );
 
+        // True if list items from a SerializerCursor are written as they
+        // are produced, rather than collected first.
+        virtual bool    CanStream      () { return false; }
 
         inline Serializer();
+        virtual ~Serializer() = default;
 };
 
 Q_DECLARE_METATYPE( QList<QObject*> )
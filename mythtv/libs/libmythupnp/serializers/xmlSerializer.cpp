@@ -133,6 +133,39 @@ void XmlSerializer::AddProperty( const QString       &sName,
     m_pXmlWriter->writeEndElement();
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// Renders the same as a QVariantList of the cursor's items, but each item is
+// written out and deleted before the next one is fetched.
+//////////////////////////////////////////////////////////////////////////////
+
+void XmlSerializer::AddCursorProperty( const QString       &sName,
+                                       SerializerCursor    *pCursor,
+                                       const QMetaObject   *pMetaParent,
+                                       const QMetaProperty *pMetaProp )
+{
+    m_pXmlWriter->writeStartElement( sName );
+
+    QString  sItemName = GetContentName( sName, pMetaParent, pMetaProp );
+    QObject *pItem     = nullptr;
+
+    while ((pItem = pCursor->Next()) != nullptr)
+    {
+        m_pXmlWriter->writeStartElement( sItemName );
+        RenderValue( sItemName, QVariant::fromValue< QObject* >( pItem ));
+        m_pXmlWriter->writeEndElement();
+
+        delete pItem;
+
+        // Stop producing items nobody will receive
+        QIODevice *pDevice = m_pXmlWriter->device();
+
+        if ((pDevice != nullptr) && !pDevice->isWritable())
+            break;
+    }
+
+    m_pXmlWriter->writeEndElement();
+}
+
 //////////////////////////////////////////////////////////////////////////////
 //
 //////////////////////////////////////////////////////////////////////////////
@@ -324,24 +357,13 @@ QString XmlSerializer::GetContentName( const QString        &sName,
 {
     // Try to read Name or TypeName from classinfo metadata.
 
-    int nClassIdx = -1;
+    QString sNameOption = ReadPropertyMetadata( pMetaObject, sName, "name" );
 
-    if ( pMetaObject )
-        nClassIdx = pMetaObject->indexOfClassInfo( sName.toLatin1() );
+    if (sNameOption.isEmpty())
+        sNameOption = ReadPropertyMetadata( pMetaObject, sName, "type" );
 
-    if (nClassIdx >=0 )
-    {
-        QString     sOptionData = pMetaObject->classInfo( nClassIdx ).value();
-        QStringList sOptions    = sOptionData.split( ';' );
-        
-        QString sNameOption = FindOptionValue( sOptions, "name" );
-
-        if (sNameOption.isEmpty())
-            sNameOption = FindOptionValue( sOptions, "type" );
-
-        if (!sNameOption.isEmpty())
-            return GetItemName(  sNameOption );
-    }
+    if (!sNameOption.isEmpty())
+        return GetItemName(  sNameOption );
 
     // Neither found, so lets use the type name (slightly modified).
 
@@ -355,20 +377,3 @@ QString XmlSerializer::GetContentName( const QString        &sName,
 
     return sTypeName;
 }
-
-//////////////////////////////////////////////////////////////////////////////
-//
-//////////////////////////////////////////////////////////////////////////////
-
-QString XmlSerializer::FindOptionValue( const QStringList &sOptions, const QString &sName )
-{
-    QString sKey = sName + "=";
-
-    for (int nIdx = 0; nIdx < sOptions.size(); ++nIdx)
-    {
-        if (sOptions.at( nIdx ).startsWith( sKey ))
-            return sOptions.at( nIdx ).mid( sKey.length() );
-    }
-
-    return QString();
-}
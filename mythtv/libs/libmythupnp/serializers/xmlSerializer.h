@@ -49,6 +49,11 @@ class UPNP_PUBLIC XmlSerializer : public Serializer
                           const QMetaObject   *pMetaParent,
                           const QMetaProperty *pMetaProp ) override; // Serializer
 
+        void AddCursorProperty( const QString       &sName,
+                                SerializerCursor    *pCursor,
+                                const QMetaObject   *pMetaParent,
+                                const QMetaProperty *pMetaProp ) override; // Serializer
+
         void    RenderValue     ( const QString &sName, const QVariant     &vValue );
 
         void    RenderEnum      ( const QString       &sName ,
@@ -66,9 +71,6 @@ class UPNP_PUBLIC XmlSerializer : public Serializer
                                          const QMetaObject   *pMetaObject,
                                          const QMetaProperty *pMetaProp );
 
-        static QString FindOptionValue ( const QStringList &sOptions, 
-                                  const QString &sName );
-
     public:
 
         bool     PropertiesAsAttributes {true};
@@ -77,6 +79,7 @@ class UPNP_PUBLIC XmlSerializer : public Serializer
         virtual ~XmlSerializer();
 
         QString GetContentType() override; // Serializer
+        bool    CanStream     () override { return true; } // Serializer
 
         // Deleted functions should be public.
         XmlSerializer(const XmlSerializer &) = delete;            // not copyable
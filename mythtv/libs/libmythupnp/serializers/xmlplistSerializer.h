@@ -29,6 +29,13 @@ class UPNP_PUBLIC XmlPListSerializer : public XmlSerializer
                              const QMetaObject   *pMetaParent,
                              const QMetaProperty *pMetaProp ) override; // XmlSerializer
 
+        // Lists are rendered as an array or a dict depending on their items
+        void    AddCursorProperty( const QString       &sName,
+                                   SerializerCursor    *pCursor,
+                                   const QMetaObject   *pMetaParent,
+                                   const QMetaProperty *pMetaProp ) override // XmlSerializer
+            { Serializer::AddCursorProperty( sName, pCursor, pMetaParent, pMetaProp ); }
+
         void SerializePListObjectProperties( const QString &sName,
                                              const QObject *pObject,
                                                    bool    needKey );
@@ -39,6 +46,7 @@ class UPNP_PUBLIC XmlPListSerializer : public XmlSerializer
         ~XmlPListSerializer() override = default;
 
         QString GetContentType() override; // XmlSerializer
+        bool    CanStream     () override { return false; } // XmlSerializer
 
 };
 
@@ -399,6 +399,9 @@ bool ServiceHost::ProcessRequest( HTTPRequest *pRequest )
                     pService = 
                         qobject_cast<Service*>(m_oMetaObject.newInstance());
 
+                    if (pService != nullptr)
+                        pService->m_bLazyResults = true;
+
                     QVariant vResult = oInfo.Invoke(pService,
                                                     pRequest->m_mapParams);
 
@@ -452,6 +455,27 @@ bool ServiceHost::FormatResponse( HTTPRequest *pRequest, QObject *pResults )
 {
     if (pResults != nullptr)
     {
+        // ------------------------------------------------------------------
+        // Results produced by a cursor are sent while they are being built
+        // ------------------------------------------------------------------
+
+        if (SerializerCursor::Find( pResults ) != nullptr)
+        {
+            Serializer *pSer = pRequest->BeginStreamedResponse();
+
+            if (pSer != nullptr)
+            {
+                pSer->Serialize( pResults );
+
+                pRequest->EndStreamedResponse();
+
+                delete pSer;
+                delete pResults;
+
+                return true;
+            }
+        }
+
         Serializer *pSer = pRequest->GetSerializer();
 
         pSer->Serialize( pResults );
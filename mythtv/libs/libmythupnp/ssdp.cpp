@@ -604,14 +604,16 @@ bool SSDP::ProcessSearchResponse( const QStringMap &headers )
     QString sST      = GetHeaderValue( headers, "ST"            , "" );
     QString sUSN     = GetHeaderValue( headers, "USN"           , "" );
     QString sCache   = GetHeaderValue( headers, "CACHE-CONTROL" , "" );
+    QString sBootId  = GetHeaderValue( headers, "BOOTID.UPNP.ORG", "" );
 
     LOG(VB_UPNP, LOG_DEBUG,
         QString( "SSDP::ProcessSearchResponse ...\n"
                  "DescURL=%1\n"
                  "ST     =%2\n"
                  "USN    =%3\n"
-                 "Cache  =%4")
-             .arg(sDescURL).arg(sST).arg(sUSN).arg(sCache));
+                 "Cache  =%4\n"
+                 "BootId =%5")
+             .arg(sDescURL).arg(sST).arg(sUSN).arg(sCache).arg(sBootId));
 
     int nPos = sCache.indexOf("max-age", 0, Qt::CaseInsensitive);
 
@@ -623,7 +625,7 @@ bool SSDP::ProcessSearchResponse( const QStringMap &headers )
 
     int nSecs = sCache.midRef( nPos+1 ).toInt();
 
-    SSDPCache::Instance()->Add( sST, sUSN, sDescURL, nSecs );
+    SSDPCache::Instance()->Add( sST, sUSN, sDescURL, nSecs, sBootId );
 
     return true;
 }
@@ -639,6 +641,7 @@ bool SSDP::ProcessNotify( const QStringMap &headers )
     QString sNT      = GetHeaderValue( headers, "NT"            , "" );
     QString sUSN     = GetHeaderValue( headers, "USN"           , "" );
     QString sCache   = GetHeaderValue( headers, "CACHE-CONTROL" , "" );
+    QString sBootId  = GetHeaderValue( headers, "BOOTID.UPNP.ORG", "" );
 
     LOG(VB_UPNP, LOG_DEBUG,
         QString( "SSDP::ProcessNotify ...\n"
@@ -646,8 +649,10 @@ bool SSDP::ProcessNotify( const QStringMap &headers )
                  "NTS    =%2\n"
                  "NT     =%3\n"
                  "USN    =%4\n"
-                 "Cache  =%5" )
-            .arg(sDescURL).arg(sNTS).arg(sNT).arg(sUSN).arg(sCache));
+                 "Cache  =%5\n"
+                 "BootId =%6" )
+            .arg(sDescURL).arg(sNTS).arg(sNT).arg(sUSN).arg(sCache)
+            .arg(sBootId));
 
     if (sNTS.contains( "ssdp:alive"))
     {
@@ -661,7 +666,7 @@ bool SSDP::ProcessNotify( const QStringMap &headers )
 
         int nSecs = sCache.midRef( nPos+1 ).toInt();
 
-        SSDPCache::Instance()->Add( sNT, sUSN, sDescURL, nSecs );
+        SSDPCache::Instance()->Add( sNT, sUSN, sDescURL, nSecs, sBootId );
 
         return true;
     }
@@ -331,7 +331,8 @@ DeviceLocation *SSDPCache::Find(const QString &sURI, const QString &sUSN)
 void SSDPCache::Add( const QString &sURI,
                      const QString &sUSN,
                      const QString &sLocation,
-                     long           sExpiresInSecs )
+                     long           sExpiresInSecs,
+                     const QString &sBootId )
 {    
     // --------------------------------------------------------------
     // Calculate when this cache entry should expire.
@@ -391,9 +392,10 @@ void SSDPCache::Add( const QString &sURI,
             // Only add if the device can be connected
             if (isGoodUrl)
             {
-                pEntry = new DeviceLocation(sURI, sUSN, sLocation, ttExpires);
+                pEntry = new DeviceLocation(sURI, sUSN, sLocation, ttExpires,
+                                            sBootId);
                 pEntries->Insert(sUSN, pEntry);
-                NotifyAdd(sURI, sUSN, sLocation);
+                NotifyAdd(sURI, sUSN, sLocation, sBootId);
             }
         }
     }
@@ -401,7 +403,25 @@ void SSDPCache::Add( const QString &sURI,
     {
         // Only accept locations that have been tested when added.
         if (pEntry->m_sLocation == sLocation)
+        {
             pEntry->m_ttExpires = ttExpires;
+
+            // A new boot id means the device has restarted, and its
+            // description may have changed.  Replace the entry rather than
+            // its description, which others may be using.
+            if (!sBootId.isEmpty() && pEntry->m_sBootId != sBootId)
+            {
+                LOG(VB_UPNP, LOG_INFO,
+                    QString("SSDP Cache USN: %1 rebooted (boot id %2)")
+                        .arg(sUSN).arg(sBootId));
+
+                pEntry->DecrRef();
+                pEntry = new DeviceLocation(sURI, sUSN, sLocation, ttExpires,
+                                            sBootId);
+                pEntries->Insert(sUSN, pEntry);
+                NotifyAdd(sURI, sUSN, sLocation, sBootId);
+            }
+        }
     }
 
     if (pEntry)
@@ -517,13 +537,15 @@ int SSDPCache::RemoveStale()
 
 void SSDPCache::NotifyAdd( const QString &sURI,
                            const QString &sUSN,
-                           const QString &sLocation )
+                           const QString &sLocation,
+                           const QString &sBootId )
 {
     QStringList values;
 
     values.append( sURI );
     values.append( sUSN );
     values.append( sLocation );
+    values.append( sBootId );
 
     MythEvent me( "SSDP_ADD", values );
 
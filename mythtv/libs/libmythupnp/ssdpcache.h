@@ -95,7 +95,8 @@ class UPNP_PUBLIC SSDPCache : public QObject,
 
         void NotifyAdd   ( const QString &sURI,
                            const QString &sUSN,
-                           const QString &sLocation );
+                           const QString &sLocation,
+                           const QString &sBootId );
         void NotifyRemove( const QString &sURI, const QString &sUSN );
 
     private:
@@ -124,7 +125,8 @@ class UPNP_PUBLIC SSDPCache : public QObject,
         void Add        ( const QString &sURI,
                           const QString &sUSN,
                           const QString &sLocation,
-                          long           sExpiresInSecs );
+                          long           sExpiresInSecs,
+                          const QString &sBootId = QString() );
 
         void Remove     ( const QString &sURI, const QString &sUSN );
         int  RemoveStale( );
@@ -0,0 +1,395 @@
+/*
+ *  Class TestHttpEventLoop
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <csignal>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "test_httpeventloop.h"
+
+static constexpr int kClients  = 500;
+static constexpr int kFileSize = 8 * 1024 * 1024;
+static constexpr int kConnectBatch = 32; // below the listen() backlog
+
+struct Client
+{
+    int        m_sock   {-1}; ///< the "browser" end of the connection
+    qint64     m_start  {0};
+    qint64     m_length {0};
+    QByteArray m_request;
+    QByteArray m_received;
+    bool       m_eof    {false};
+};
+
+/// Raises the open file limit to \p wanted, if the hard limit allows it
+static bool raise_file_limit(rlim_t wanted)
+{
+    rlimit limit {};
+    getrlimit(RLIMIT_NOFILE, &limit);
+    if (limit.rlim_cur < wanted)
+    {
+        limit.rlim_cur = std::min(wanted, limit.rlim_max);
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+    return limit.rlim_cur >= wanted;
+}
+
+/**
+ * Connects every client to \p addr and sends its request, kConnectBatch
+ * at a time so the server's listen() backlog never overflows and drops
+ * connection attempts.
+ */
+static bool connect_and_send(std::vector<Client> &clients,
+                             const sockaddr_in &addr, int timeoutMs)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    for (size_t first = 0; first < clients.size(); first += kConnectBatch)
+    {
+        // Accept the previous batch before starting the next
+        QCoreApplication::processEvents();
+
+        size_t last = std::min(first + kConnectBatch, clients.size());
+        std::vector<pollfd> fds;
+        for (size_t i = first; i < last; ++i)
+        {
+            Client &client = clients[i];
+            client.m_sock = socket(AF_INET, SOCK_STREAM, 0);
+            if (client.m_sock < 0)
+                return false;
+            fcntl(client.m_sock, F_SETFL, O_NONBLOCK);
+            if (::connect(client.m_sock,
+                          reinterpret_cast<const sockaddr*>(&addr),
+                          sizeof(addr)) != 0 && errno != EINPROGRESS)
+            {
+                return false;
+            }
+            fds.push_back({client.m_sock, POLLOUT, 0});
+        }
+
+        // Write each request once its connection is up
+        size_t sent = 0;
+        while (sent < fds.size())
+        {
+            if (timer.elapsed() > timeoutMs)
+                return false;
+
+            // HttpServer accepts connections from this thread's event loop
+            QCoreApplication::processEvents();
+
+            if (poll(fds.data(), fds.size(), 10) <= 0)
+                continue;
+
+            for (size_t i = 0; i < fds.size(); ++i)
+            {
+                if (!fds[i].revents)
+                    continue;
+                const QByteArray &request = clients[first + i].m_request;
+                if (write(fds[i].fd, request.constData(), request.size()) !=
+                    static_cast<ssize_t>(request.size()))
+                {
+                    return false;
+                }
+                fds[i].fd = -1; // poll() skips it from now on
+                sent++;
+            }
+        }
+    }
+
+    QCoreApplication::processEvents();
+    return true;
+}
+
+/// Reads all clients until every one has seen EOF, or \p timeoutMs passes
+static bool read_until_eof(std::vector<Client> &clients, int timeoutMs)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    std::vector<pollfd> fds;
+    std::vector<Client*> open;
+    std::array<char,65536> buf {};
+
+    while (timer.elapsed() < timeoutMs)
+    {
+        fds.clear();
+        open.clear();
+        for (auto &client : clients)
+        {
+            if (!client.m_eof)
+            {
+                fds.push_back({client.m_sock, POLLIN, 0});
+                open.push_back(&client);
+            }
+        }
+        if (fds.empty())
+            return true;
+
+        // HttpServer accepts connections from this thread's event loop
+        QCoreApplication::processEvents();
+
+        if (poll(fds.data(), fds.size(), 10) <= 0)
+            continue;
+
+        for (size_t i = 0; i < fds.size(); ++i)
+        {
+            if (!fds[i].revents)
+                continue;
+            ssize_t len = read(fds[i].fd, buf.data(), buf.size());
+            if (len > 0)
+                open[i]->m_received.append(buf.data(), len);
+            else if (len == 0 || (errno != EAGAIN && errno != EINTR))
+                open[i]->m_eof = true;
+        }
+    }
+    return false;
+}
+
+void TestHttpEventLoop::initTestCase(void)
+{
+    // The loop relies on the application ignoring SIGPIPE, as MythTV does
+    signal(SIGPIPE, SIG_IGN);
+
+    m_data.resize(kFileSize);
+    for (int i = 0; i < kFileSize; ++i)
+        m_data[i] = static_cast<char>((i * 31) ^ (i >> 11));
+
+    QVERIFY(m_file.open());
+    QCOMPARE(m_file.write(m_data), static_cast<qint64>(kFileSize));
+    QVERIFY(m_file.flush());
+}
+
+/**
+ * Serves a different range of the file to each of kClients connections
+ * at once, as a browser seeking in several videos would request them.
+ */
+void TestHttpEventLoop::test_concurrent_ranges(void)
+{
+    // Each client needs two sockets and a file descriptor
+    if (!raise_file_limit((kClients * 3) + 64))
+        QSKIP("Not enough file descriptors available");
+
+    HttpEventLoop loop([](int sock) { close(sock); });
+    loop.start();
+    while (!loop.isRunning())
+        usleep(1000);
+
+    std::vector<Client> clients(kClients);
+    for (int i = 0; i < kClients; ++i)
+    {
+        std::array<int,2> pair {-1, -1};
+        QCOMPARE(socketpair(AF_UNIX, SOCK_STREAM, 0, pair.data()), 0);
+
+        Client &client = clients[i];
+        client.m_sock   = pair[0];
+        client.m_start  = (i * 104729LL) % (kFileSize / 2);
+        client.m_length = 4096 + ((i * 7919LL) % (kFileSize / 4));
+        fcntl(client.m_sock, F_SETFL, O_NONBLOCK);
+
+        int file = dup(m_file.handle());
+        QVERIFY(file >= 0);
+        QVERIFY(loop.SendFile(pair[1], file, client.m_start, client.m_length,
+                              false, 0));
+    }
+
+    QVERIFY(read_until_eof(clients, 60 * 1000));
+
+    qint64 total = 0;
+    for (int i = 0; i < kClients; ++i)
+    {
+        const Client &client = clients[i];
+        QVERIFY2(client.m_received ==
+                 m_data.mid(client.m_start, client.m_length),
+                 qPrintable(QString("client %1").arg(i)));
+        total += client.m_length;
+        close(client.m_sock);
+    }
+
+    // The counters are merged after each pass of the loop
+    QTRY_COMPARE(loop.GetStats().m_filesSent, static_cast<quint64>(kClients));
+    HttpEventLoopStats stats = loop.GetStats();
+    QCOMPARE(stats.m_bytesSent, static_cast<quint64>(total));
+    QCOMPARE(stats.m_errors,    static_cast<quint64>(0));
+    QCOMPARE(stats.m_sending,   0);
+
+    loop.Stop();
+}
+
+void TestHttpEventLoop::test_keepalive_resume(void)
+{
+    QMutex     lock;
+    QList<int> resumed;
+    HttpEventLoop loop([&](int sock)
+    {
+        QMutexLocker locker(&lock);
+        resumed.append(sock);
+    });
+    loop.start();
+    while (!loop.isRunning())
+        usleep(1000);
+
+    std::array<int,2> pair {-1, -1};
+    QCOMPARE(socketpair(AF_UNIX, SOCK_STREAM, 0, pair.data()), 0);
+    fcntl(pair[0], F_SETFL, O_NONBLOCK);
+
+    QVERIFY(loop.SendFile(pair[1], dup(m_file.handle()), 100, 300000,
+                          true, 10000));
+
+    // The body arrives but the connection stays open ...
+    QByteArray body;
+    std::array<char,65536> buf {};
+    QElapsedTimer timer;
+    timer.start();
+    while (body.size() < 300000 && timer.elapsed() < 10000)
+    {
+        pollfd pfd {pair[0], POLLIN, 0};
+        if (poll(&pfd, 1, 100) > 0)
+        {
+            ssize_t len = read(pair[0], buf.data(), buf.size());
+            QVERIFY(len > 0);
+            body.append(buf.data(), len);
+        }
+    }
+    QCOMPARE(body, m_data.mid(100, 300000));
+    QTRY_COMPARE(loop.GetStats().m_idle, 1);
+
+    // ... and is handed back as soon as the next request comes in
+    QCOMPARE(write(pair[0], "GET / HTTP/1.1\r\n", 16), 16L);
+    QTRY_COMPARE(resumed.size(), 1);
+    QCOMPARE(resumed.first(), pair[1]);
+    QCOMPARE(loop.GetStats().m_resumed, static_cast<quint64>(1));
+
+    close(pair[0]);
+    close(pair[1]);
+    loop.Stop();
+}
+
+void TestHttpEventLoop::test_idle_timeout(void)
+{
+    HttpEventLoop loop([](int sock) { close(sock); });
+    loop.start();
+    while (!loop.isRunning())
+        usleep(1000);
+
+    std::array<int,2> pair {-1, -1};
+    QCOMPARE(socketpair(AF_UNIX, SOCK_STREAM, 0, pair.data()), 0);
+
+    QElapsedTimer timer;
+    timer.start();
+    QVERIFY(loop.WaitForRequest(pair[1], 200));
+
+    // The client sees the connection closed once the timeout expires
+    char byte = 0;
+    QCOMPARE(read(pair[0], &byte, 1), 0L);
+    QVERIFY(timer.elapsed() >= 150);
+    QTRY_COMPARE(loop.GetStats().m_timedOut, static_cast<quint64>(1));
+
+    close(pair[0]);
+    loop.Stop();
+
+    // Nothing can be parked once the loop has stopped
+    loop.wait();
+    QCOMPARE(socketpair(AF_UNIX, SOCK_STREAM, 0, pair.data()), 0);
+    QVERIFY(!loop.WaitForRequest(pair[1], 200));
+    close(pair[0]);
+    close(pair[1]);
+}
+
+/**
+ * Sends kClients range requests through a real HttpServer at once. Each
+ * body is large enough for the worker to hand it to the event loop.
+ */
+void TestHttpEventLoop::test_server_ranges(void)
+{
+    // Each client needs a socket at both ends and a file descriptor
+    if (!raise_file_limit((kClients * 3) + 64))
+        QSKIP("Not enough file descriptors available");
+
+    if (gCoreContext == nullptr)
+        gCoreContext = new MythCoreContext("bin_version", nullptr);
+
+    HttpServer server;
+    server.RegisterExtension(new TestFileExtension(m_file.fileName()));
+    QVERIFY(server.listen(QList<QHostAddress>() << QHostAddress::LocalHost,
+                          0, false));
+    quint16 port = server.serverPort();
+    QVERIFY(port != 0);
+
+    sockaddr_in addr {};
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    std::vector<Client> clients(kClients);
+    for (int i = 0; i < kClients; ++i)
+    {
+        Client &client = clients[i];
+        client.m_start   = (i * 104729LL) % (kFileSize / 2);
+        client.m_length  = (256 * 1024) + ((i * 7919LL) % (kFileSize / 4));
+        client.m_request =
+            QString("GET /loadtest/file%1 HTTP/1.1\r\n"
+                    "Host: 127.0.0.1:%2\r\n"
+                    "Range: bytes=%3-%4\r\n"
+                    "Connection: close\r\n\r\n")
+                .arg(i).arg(port).arg(client.m_start)
+                .arg(client.m_start + client.m_length - 1).toLatin1();
+    }
+
+    QVERIFY(connect_and_send(clients, addr, 60 * 1000));
+    QVERIFY(read_until_eof(clients, 120 * 1000));
+
+    for (int i = 0; i < kClients; ++i)
+    {
+        const Client &client = clients[i];
+        int split = client.m_received.indexOf("\r\n\r\n");
+        QVERIFY2(split > 0, qPrintable(QString("client %1").arg(i)));
+
+        QByteArray header = client.m_received.left(split);
+        QVERIFY2(header.startsWith("HTTP/1.1 206"), header.constData());
+        QVERIFY2(header.contains(
+                     QString("Content-Range: bytes %1-%2/%3")
+                         .arg(client.m_start)
+                         .arg(client.m_start + client.m_length - 1)
+                         .arg(kFileSize).toLatin1()),
+                 header.constData());
+        QVERIFY2(client.m_received.mid(split + 4) ==
+                 m_data.mid(client.m_start, client.m_length),
+                 qPrintable(QString("client %1").arg(i)));
+        close(client.m_sock);
+    }
+
+    // Every body went out through the event loop, not a worker thread
+    HttpEventLoop *loop = server.GetEventLoop();
+    QVERIFY(loop != nullptr);
+    QTRY_COMPARE(loop->GetStats().m_filesSent,
+                 static_cast<quint64>(kClients));
+    QCOMPARE(loop->GetStats().m_errors, static_cast<quint64>(0));
+}
+
+QTEST_GUILESS_MAIN(TestHttpEventLoop)
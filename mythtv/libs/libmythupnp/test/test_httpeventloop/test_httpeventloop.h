@@ -0,0 +1,62 @@
+/*
+ *  Class TestHttpEventLoop
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <QtTest/QtTest>
+#include <QTemporaryFile>
+
+#include "mythcorecontext.h"
+#include "httpeventloop.h"
+#include "httpserver.h"
+
+/// Serves the test file for any request under /loadtest
+class TestFileExtension : public HttpServerExtension
+{
+  public:
+    explicit TestFileExtension(QString sFileName)
+        : HttpServerExtension("TestFile", QString()),
+          m_sFileName(std::move(sFileName)) {}
+
+    QStringList GetBasePaths() override { return QStringList("/loadtest"); }
+
+    bool ProcessRequest(HTTPRequest *pRequest) override
+    {
+        if (pRequest->m_sBaseUrl != "/loadtest")
+            return false;
+        pRequest->FormatFileResponse(m_sFileName);
+        return true;
+    }
+
+  private:
+    QString m_sFileName;
+};
+
+class TestHttpEventLoop : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase(void);
+    void test_concurrent_ranges(void);
+    void test_keepalive_resume(void);
+    void test_idle_timeout(void);
+    void test_server_ranges(void);
+
+private:
+    QTemporaryFile m_file;
+    QByteArray     m_data;
+};
@@ -0,0 +1,151 @@
+/*
+ *  Class TestSerializer
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <functional>
+
+#include "test_serializer.h"
+
+#include "serializers/jsonSerializer.h"
+#include "serializers/xmlSerializer.h"
+#include "serializers/xmlplistSerializer.h"
+
+int TestItem::s_live = 0;
+
+static constexpr int kItems = 50;
+
+static QString item_title(int nId)
+{
+    return QString("Item \"%1\" & <friends>").arg(nId);
+}
+
+class TestCursor : public SerializerCursor
+{
+  public:
+    QObject *Next(void) override
+    {
+        if (m_nNext >= kItems)
+            return nullptr;
+        int nId = m_nNext++;
+        return new TestItem(nId, item_title(nId));
+    }
+
+    int m_nNext {0};
+};
+
+using MakeSerializer = std::function<Serializer *(QIODevice *)>;
+
+/// Serializes the same result filled in and with a cursor, and compares
+static void compare_cursor(const MakeSerializer &make)
+{
+    TestResult full("Test", "now");
+    for (int i = 0; i < kItems; ++i)
+        full.AddItem(i, item_title(i));
+
+    QBuffer fullBuffer;
+    fullBuffer.open(QIODevice::WriteOnly);
+    Serializer *pSer = make(&fullBuffer);
+    pSer->Serialize(&full);
+    delete pSer;
+
+    int nLive = TestItem::s_live;
+
+    auto *pLazy   = new TestResult("Test", "now");
+    auto *pCursor = new TestCursor();
+    pCursor->Attach(pLazy, "Items");
+    QCOMPARE(SerializerCursor::Find(pLazy), pCursor);
+
+    QBuffer lazyBuffer;
+    lazyBuffer.open(QIODevice::WriteOnly);
+    pSer = make(&lazyBuffer);
+    pSer->Serialize(pLazy);
+    delete pSer;
+
+    // Every item was produced, and none were left behind
+    QCOMPARE(pCursor->m_nNext, kItems);
+    QCOMPARE(TestItem::s_live, nLive);
+
+    QCOMPARE(QString(lazyBuffer.data()), QString(fullBuffer.data()));
+
+    delete pLazy;
+}
+
+void TestSerializer::test_json_cursor(void)
+{
+    compare_cursor([](QIODevice *pDevice)
+        { return new JSONSerializer(pDevice, "Test"); });
+}
+
+void TestSerializer::test_xml_cursor(void)
+{
+    compare_cursor([](QIODevice *pDevice)
+        { return new XmlSerializer(pDevice, "Test"); });
+}
+
+void TestSerializer::test_plist_cursor(void)
+{
+    compare_cursor([](QIODevice *pDevice)
+        { return new XmlPListSerializer(pDevice); });
+}
+
+void TestSerializer::test_json_encode(void)
+{
+    TestResult result("Test", "now");
+    result.AddItem(1, "a\"b/c\\d\n\te");
+
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    JSONSerializer ser(&buffer, "Test");
+    ser.Serialize(&result);
+
+    QVERIFY2(buffer.data().contains(R"("Title": "a\"b\/c\\d\n\te")"),
+             buffer.data().constData());
+    QVERIFY(buffer.data().contains(R"("Name": "Test")"));
+}
+
+void TestSerializer::test_transient_hash(void)
+{
+    // The ETag must not change with properties marked transient ...
+    QStringMap headers1;
+    QStringMap headers2;
+    QStringMap headers3;
+
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+
+    TestResult result1("Test", "10:00");
+    XmlSerializer ser1(&buffer, "Test");
+    ser1.Serialize(&result1);
+    ser1.AddHeaders(headers1);
+
+    TestResult result2("Test", "11:00");
+    XmlSerializer ser2(&buffer, "Test");
+    ser2.Serialize(&result2);
+    ser2.AddHeaders(headers2);
+
+    QCOMPARE(headers1["ETag"], headers2["ETag"]);
+
+    // ... but must with any others
+    TestResult result3("Other", "10:00");
+    XmlSerializer ser3(&buffer, "Test");
+    ser3.Serialize(&result3);
+    ser3.AddHeaders(headers3);
+
+    QVERIFY(headers1["ETag"] != headers3["ETag"]);
+}
+
+QTEST_APPLESS_MAIN(TestSerializer)
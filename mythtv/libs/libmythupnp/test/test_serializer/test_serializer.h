@@ -0,0 +1,91 @@
+/*
+ *  Class TestSerializer
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <utility>
+
+#include <QtTest/QtTest>
+
+#include "serializers/serializer.h"
+
+// A data contract shaped like the DTC:: classes
+
+class TestItem : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY( int     Id    READ Id    )
+    Q_PROPERTY( QString Title READ Title )
+
+  public:
+    TestItem(int nId, QString sTitle, QObject *parent = nullptr)
+        : QObject(parent), m_nId(nId), m_sTitle(std::move(sTitle))
+        { s_live++; }
+    ~TestItem() override { s_live--; }
+
+    int     Id()    const { return m_nId;    }
+    QString Title() const { return m_sTitle; }
+
+    static int s_live;
+
+  private:
+    int     m_nId;
+    QString m_sTitle;
+};
+
+class TestResult : public QObject
+{
+    Q_OBJECT
+
+    Q_CLASSINFO( "Items", "type=TestItem" )
+    Q_CLASSINFO( "AsOf",  "transient=true" )
+
+    Q_PROPERTY( QString      Name  READ Name  )
+    Q_PROPERTY( QVariantList Items READ Items )
+    Q_PROPERTY( QString      AsOf  READ AsOf  )
+
+  public:
+    TestResult(QString sName, QString sAsOf)
+        : m_sName(std::move(sName)), m_sAsOf(std::move(sAsOf)) {}
+
+    QString      Name()  const { return m_sName;  }
+    QVariantList Items() const { return m_items;  }
+    QString      AsOf()  const { return m_sAsOf;  }
+
+    void AddItem(int nId, const QString &sTitle)
+    {
+        m_items.append(QVariant::fromValue<QObject *>(
+                           new TestItem(nId, sTitle, this)));
+    }
+
+  private:
+    QString      m_sName;
+    QVariantList m_items;
+    QString      m_sAsOf;
+};
+
+class TestSerializer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    static void test_json_cursor(void);
+    static void test_xml_cursor(void);
+    static void test_plist_cursor(void);
+    static void test_json_encode(void);
+    static void test_transient_hash(void);
+};
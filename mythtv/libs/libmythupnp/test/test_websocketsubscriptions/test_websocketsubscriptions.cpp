@@ -0,0 +1,223 @@
+/*
+ *  Class TestWebSocketSubscriptions
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <vector>
+
+#include <QJsonDocument>
+#include <QThread>
+
+#include "test_websocketsubscriptions.h"
+
+static constexpr int kSubscribers = 200;
+static constexpr int kThreads     = 8;
+static constexpr int kItems       = 500;
+static constexpr int kRounds      = 200;
+
+TestClient::TestClient()
+  : m_extension(new WebSocketSubscriptions())
+{
+    m_extension->setParent(this);
+    connect(m_extension, SIGNAL(SendTextMessage(const QString &)),
+            this,        SLOT(Received(const QString &)));
+}
+
+void TestClient::Send(const QString &text)
+{
+    WebSocketFrame frame;
+    frame.m_payload = text.toUtf8();
+    m_extension->HandleTextFrame(frame);
+}
+
+void TestClient::Received(const QString &message)
+{
+    m_last = message;
+    m_messages++;
+
+    QVariantMap reply = QJsonDocument::fromJson(message.toUtf8()).toVariant().toMap();
+    quint64 seq = reply["Seq"].toULongLong();
+
+    if (reply.contains("Error"))
+    {
+        m_errors.append(reply["Topic"].toString());
+    }
+    else if (reply.contains("Snapshot"))
+    {
+        if (m_haveSnapshot)
+            m_errors.append("second snapshot");
+        m_state = reply["Snapshot"].toMap();
+        m_haveSnapshot = true;
+        m_seq = seq;
+    }
+    else if (reply.contains("Seq"))
+    {
+        if (!m_haveSnapshot)
+            m_errors.append("delta before the snapshot");
+        if (seq != m_seq + 1)
+            m_errors.append(QString("expected %1, got %2").arg(m_seq + 1).arg(seq));
+
+        QVariantMap changed = reply["Changed"].toMap();
+        for (auto it = changed.cbegin(); it != changed.cend(); ++it)
+            m_state.insert(it.key(), *it);
+        const QVariantList removed = reply["Removed"].toList();
+        for (const auto &key : removed)
+            m_state.remove(key.toString());
+        m_seq = seq;
+    }
+}
+
+void TestWebSocketSubscriptions::test_commands(void)
+{
+    WebSocketTopics::Add("Commands");
+
+    TestClient client;
+
+    client.Send("WS_TOPICS");
+    QVERIFY(client.m_last.contains("Commands"));
+
+    client.Send("WS_SUBSCRIBE NoSuchTopic");
+    QCOMPARE(client.m_errors, QStringList("NoSuchTopic"));
+
+    // Commands of other extensions are left to them
+    WebSocketSubscriptions extension;
+    WebSocketFrame frame;
+    frame.m_payload = "WS_EVENT_ENABLE";
+    QVERIFY(!extension.HandleTextFrame(frame));
+    frame.m_payload = "WS_UNSUBSCRIBE ALL";
+    QVERIFY(extension.HandleTextFrame(frame));
+}
+
+void TestWebSocketSubscriptions::test_deltas(void)
+{
+    WebSocketTopic *topic = WebSocketTopics::Add("Deltas");
+
+    QVariantMap state;
+    state["a"] = "1";
+    state["b"] = "2";
+    QVERIFY(topic->Publish(state));
+    QVERIFY(!topic->Publish(state));
+    QVERIFY(!topic->HasSubscribers());
+
+    TestClient client;
+    client.Send("WS_SUBSCRIBE Deltas");
+    QVERIFY(topic->HasSubscribers());
+    QCOMPARE(client.m_seq.load(), 1ULL);
+    QCOMPARE(client.m_state, state);
+
+    state.remove("b");
+    state["a"] = "3";
+    state["c"] = "4";
+    QVERIFY(topic->Publish(state));
+    QTRY_COMPARE(client.m_seq.load(), 2ULL);
+    QCOMPARE(client.m_state, state);
+    QVERIFY(client.m_last.contains(R"("Removed":["b"])"));
+
+    client.Send("WS_UNSUBSCRIBE ALL");
+    QVERIFY(!topic->HasSubscribers());
+    state["a"] = "5";
+    QVERIFY(topic->Publish(state));
+    QTest::qWait(50);
+    QCOMPARE(client.m_seq.load(), 2ULL);
+
+    QVERIFY(client.m_errors.isEmpty());
+}
+
+void TestWebSocketSubscriptions::test_load(void)
+{
+    WebSocketTopic *topic = WebSocketTopics::Add("Load");
+
+    QVariantMap state;
+    for (int i = 0; i < kItems; ++i)
+    {
+        QVariantMap item;
+        item["Title"] = QString("Item %1").arg(i);
+        item["Round"] = "0";
+        state.insert(QString::number(i), item);
+    }
+    topic->Publish(state);
+
+    std::vector<QThread *>    threads;
+    std::vector<TestClient *> clients;
+
+    for (int i = 0; i < kThreads; ++i)
+    {
+        threads.push_back(new QThread());
+        threads.back()->start();
+    }
+
+    // Subscribe while the state keeps changing, each client on a connection
+    // thread, to check that no delta is lost or repeated after the snapshot
+    for (int i = 0; i < kSubscribers; ++i)
+    {
+        auto *client = new TestClient();
+        client->moveToThread(threads[i % kThreads]);
+        QMetaObject::invokeMethod(client, "Send", Qt::QueuedConnection,
+                                  Q_ARG(QString, "WS_SUBSCRIBE Load"));
+        clients.push_back(client);
+    }
+
+    for (int round = 1; round <= kRounds; ++round)
+    {
+        for (int k = 0; k < 5; ++k)
+        {
+            QString key = QString::number((round * 7 + k * 97) % kItems);
+            QVariantMap item = state[key].toMap();
+            item["Round"] = QString::number(round);
+            state[key] = item;
+        }
+        state.remove(state.firstKey());
+        QVariantMap item;
+        item["Title"] = QString("New %1").arg(round);
+        state.insert(QString("new%1").arg(round), item);
+
+        QVERIFY(topic->Publish(state));
+    }
+
+    quint64 seq = 0;
+    topic->Snapshot(seq);
+    QCOMPARE(seq, static_cast<quint64>(kRounds + 1));
+
+    auto delivered = [&clients, seq]()
+    {
+        for (auto *client : clients)
+        {
+            if (client->m_seq != seq)
+                return false;
+        }
+        return true;
+    };
+    QTRY_VERIFY_WITH_TIMEOUT(delivered(), 30000);
+
+    for (auto *thread : threads)
+    {
+        thread->quit();
+        thread->wait();
+        delete thread;
+    }
+
+    for (auto *client : clients)
+    {
+        QVERIFY2(client->m_errors.isEmpty(),
+                 qPrintable(client->m_errors.join(", ")));
+        QCOMPARE(client->m_state, state);
+        // One snapshot, then only the deltas it didn't include
+        QVERIFY(client->m_messages <= kRounds + 1);
+        delete client;
+    }
+}
+
+QTEST_GUILESS_MAIN(TestWebSocketSubscriptions)
@@ -0,0 +1,57 @@
+/*
+ *  Class TestWebSocketSubscriptions
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <atomic>
+
+#include <QtTest/QtTest>
+#include <QVariantMap>
+
+#include "websocket_extensions/websocket_subscriptions.h"
+
+/// The client end of a connection: applies what the extension sends
+class TestClient : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestClient();
+
+    QVariantMap          m_state;
+    QStringList          m_errors;
+    QString              m_last;
+    std::atomic<quint64> m_seq      {0};
+    std::atomic<int>     m_messages {0};
+
+  public slots:
+    void Send(const QString &text);
+    void Received(const QString &message);
+
+  private:
+    WebSocketSubscriptions *m_extension;
+    bool                    m_haveSnapshot {false};
+};
+
+class TestWebSocketSubscriptions : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    static void test_commands(void);
+    static void test_deltas(void);
+    static void test_load(void);
+};
@@ -57,12 +57,96 @@ void UPnpCDSExtensionResults::Add( const CDSObjects& objects )
 QString UPnpCDSExtensionResults::GetResultXML(FilterMap &filter,
                                               bool ignoreChildren)
 {
-    QString sXML;
+    return GetResultFragments(filter, ignoreChildren).join("");
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+QStringList UPnpCDSExtensionResults::GetResultFragments(FilterMap &filter,
+                                                        bool ignoreChildren)
+{
+    QStringList fragments;
+    fragments.reserve(m_List.size());
 
     for (auto *item : qAsConst(m_List))
-        sXML += item->toXml(filter, ignoreChildren);
+        fragments.append(item->toXml(filter, ignoreChildren));
+
+    return fragments;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+bool UPnpCDSCache::Lookup( const QString &sKey, UPnpCDSCacheEntry &entry )
+{
+    QMutexLocker locker(&m_lock);
+
+    UPnpCDSCacheEntry *pEntry = m_cache.object(sKey);
+    if (pEntry == nullptr)
+        return false;
+
+    entry = *pEntry;
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void UPnpCDSCache::Insert( const QString &sKey, const UPnpCDSCacheEntry &entry )
+{
+    int nBytes = 0;
+    for (const auto & fragment : qAsConst(entry.m_fragments))
+        nBytes += fragment.size() * static_cast<int>(sizeof(QChar));
+
+    QMutexLocker locker(&m_lock);
+    m_cache.insert(sKey, new UPnpCDSCacheEntry(entry), 1 + (nBytes / 1024));
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void UPnpCDSCache::Remove( const QString &sExtensionId )
+{
+    QMutexLocker locker(&m_lock);
+
+    QList<QString> keys = m_cache.keys();
+    for (const auto & sKey : qAsConst(keys))
+    {
+        UPnpCDSCacheEntry *pEntry = m_cache.object(sKey);
+        if (pEntry && pEntry->m_sExtensionId == sExtensionId)
+            m_cache.remove(sKey);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void UPnpCDSCache::Clear( )
+{
+    QMutexLocker locker(&m_lock);
+    m_cache.clear();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
 
-    return sXML;
+QString UPnpCDSCache::MakeKey( const UPnpCDSRequest *pRequest )
+{
+    return QString("%1\n%2\n%3\n%4\n%5\n%6\n%7")
+        .arg(pRequest->m_sObjectId)
+        .arg(pRequest->m_eBrowseFlag)
+        .arg(pRequest->m_nStartingIndex)
+        .arg(pRequest->m_nRequestedCount)
+        .arg(pRequest->m_sFilter)
+        .arg(pRequest->m_sSortCriteria)
+        .arg(pRequest->m_eClient);
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -210,6 +294,35 @@ void UPnpCDS::RegisterFeature(UPnPFeature* feature)
     m_features.AddFeature(feature); // m_features takes ownership
 }
 
+/**
+ *  \brief Drops the cached results of any extension whose content is changed
+ *         by the MythEvent \p sMessage, and tells subscribers to re-browse.
+ */
+void UPnpCDS::ContentChanged( const QString &sMessage )
+{
+    QString sEvent   = sMessage.section(' ', 0, 0);
+    bool    bChanged = false;
+
+    for (auto *pExtension : qAsConst(m_extensions))
+    {
+        if (pExtension->m_changeEvents.contains(sEvent))
+        {
+            LOG(VB_UPNP, LOG_DEBUG,
+                QString("UPnpCDS: %1 changed content of %2")
+                    .arg(sEvent).arg(pExtension->m_sExtensionId));
+
+            m_cache.Remove(pExtension->m_sExtensionId);
+            bChanged = true;
+        }
+    }
+
+    if (bChanged)
+    {
+        auto nId = GetValue<uint16_t>("SystemUpdateID");
+        SetValue<uint16_t>("SystemUpdateID", nId + 1);
+    }
+}
+
 /////////////////////////////////////////////////////////////////////////////
 //
 /////////////////////////////////////////////////////////////////////////////
@@ -473,34 +586,67 @@ void UPnpCDS::HandleBrowse( HTTPRequest *pRequest )
         // Look for a CDS Extension that knows how to handle this ObjectID
         // ------------------------------------------------------------------
 
-        UPnpCDSExtensionList::iterator it = m_extensions.begin();
-        for (; (it != m_extensions.end()) && !pResult; ++it)
-        {
-            LOG(VB_UPNP, LOG_INFO,
-                QString("UPNP Browse : Searching for : %1  / ObjectID : %2")
-                    .arg((*it)->m_sExtensionId).arg(request.m_sObjectId));
+        // The extensions may rewrite the request, so key on it as received
+        QString           sCacheKey = UPnpCDSCache::MakeKey(&request);
+        UPnpCDSCacheEntry entry;
 
-            pResult = (*it)->Browse(&request);
+        if (m_cache.Lookup(sCacheKey, entry))
+        {
+            LOG(VB_UPNP, LOG_DEBUG,
+                QString("UPNP Browse : Cached result for ObjectID : %1")
+                    .arg(request.m_sObjectId));
+
+            eErrorCode      = UPnPResult_Success;
+            nNumberReturned = entry.m_fragments.count();
+            nTotalMatches   = entry.m_nTotalMatches;
+            nUpdateID       = entry.m_nUpdateID;
+            sResultXML      = entry.m_fragments.join("");
         }
-
-        if (pResult != nullptr)
+        else
         {
-            eErrorCode  = pResult->m_eErrorCode;
-            sErrorDesc  = pResult->m_sErrorDesc;
+            UPnpCDSExtension *pExtension = nullptr;
 
-            if (eErrorCode == UPnPResult_Success)
+            for (auto *pCandidate : qAsConst(m_extensions))
             {
-                nNumberReturned = pResult->m_List.count();
-                nTotalMatches   = pResult->m_nTotalMatches;
-                nUpdateID       = pResult->m_nUpdateID;
-                if (request.m_eBrowseFlag == CDS_BrowseMetadata)
-                    sResultXML      = pResult->GetResultXML(filter, true); // Ignore children
-                else
-                    sResultXML      = pResult->GetResultXML(filter);
+                LOG(VB_UPNP, LOG_INFO,
+                    QString("UPNP Browse : Searching for : %1  / ObjectID : %2")
+                        .arg(pCandidate->m_sExtensionId).arg(request.m_sObjectId));
+
+                pResult = pCandidate->Browse(&request);
+                if (pResult != nullptr)
+                {
+                    pExtension = pCandidate;
+                    break;
+                }
             }
 
-            delete pResult;
-            pResult = nullptr;
+            if (pResult != nullptr)
+            {
+                eErrorCode  = pResult->m_eErrorCode;
+                sErrorDesc  = pResult->m_sErrorDesc;
+
+                if (eErrorCode == UPnPResult_Success)
+                {
+                    // Ignore children of the object itself for metadata
+                    bool bIgnoreChildren =
+                        (request.m_eBrowseFlag == CDS_BrowseMetadata);
+
+                    entry.m_sExtensionId  = pExtension->m_sExtensionId;
+                    entry.m_fragments     =
+                        pResult->GetResultFragments(filter, bIgnoreChildren);
+                    entry.m_nTotalMatches = pResult->m_nTotalMatches;
+                    entry.m_nUpdateID     = pResult->m_nUpdateID;
+                    m_cache.Insert(sCacheKey, entry);
+
+                    nNumberReturned = entry.m_fragments.count();
+                    nTotalMatches   = entry.m_nTotalMatches;
+                    nUpdateID       = entry.m_nUpdateID;
+                    sResultXML      = entry.m_fragments.join("");
+                }
+
+                delete pResult;
+                pResult = nullptr;
+            }
         }
     }
 
@@ -1091,6 +1237,26 @@ CDSObject* UPnpCDSExtension::GetRoot()
     return m_pRoot;
 }
 
+/**
+ *  \brief Adds the requested page of the root container's children
+ *
+ *  The root is built once, so unlike the database backed containers its
+ *  children are paged here.
+ */
+void UPnpCDSExtension::LoadRootChildren(const UPnpCDSRequest *pRequest,
+                                        UPnpCDSExtensionResults *pResults)
+{
+    CDSObjects children = GetRoot()->GetChildren();
+    int nStart = pRequest->m_nStartingIndex;
+    int nEnd   = std::min(nStart + static_cast<int>(pRequest->m_nRequestedCount),
+                          static_cast<int>(children.size()));
+
+    for (int i = nStart; i < nEnd; ++i)
+        pResults->Add(children[i]);
+
+    pResults->m_nTotalMatches = GetRoot()->GetChildCount();
+}
+
 /////////////////////////////////////////////////////////////////////////////
 //
 /////////////////////////////////////////////////////////////////////////////
@@ -17,10 +17,13 @@
 #include <utility>
 
 // QT headers
+#include <QCache>
 #include <QList>
 #include <QMap>
+#include <QMutex>
 #include <QObject>
 #include <QString>
+#include <QStringList>
 
 #include "upnp.h"
 #include "upnpcdsobjects.h"
@@ -127,6 +130,54 @@ class UPNP_PUBLIC UPnpCDSExtensionResults
         void    Add         ( CDSObject *pObject );
         void    Add         ( const CDSObjects& objects );
         QString GetResultXML(FilterMap &filter, bool ignoreChildren = false);
+        QStringList GetResultFragments(FilterMap &filter,
+                                       bool ignoreChildren = false);
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * \brief Browse results, already rendered as one DIDL-Lite fragment per object
+ */
+
+class UPNP_PUBLIC UPnpCDSCacheEntry
+{
+    public:
+
+        QString                 m_sExtensionId;
+        QStringList             m_fragments;
+
+        uint16_t                m_nTotalMatches {0};
+        uint16_t                m_nUpdateID     {0};
+};
+
+/**
+ * \brief Caches Browse results by request until the content they came from
+ *        changes.
+ *
+ * The cost of each entry is the size of its fragments in KB.
+ */
+
+class UPNP_PUBLIC UPnpCDSCache
+{
+    public:
+
+        explicit UPnpCDSCache( int nMaxKB = kDefaultMaxKB )
+            : m_cache(nMaxKB) {}
+
+        bool    Lookup ( const QString &sKey, UPnpCDSCacheEntry &entry );
+        void    Insert ( const QString &sKey, const UPnpCDSCacheEntry &entry );
+        void    Remove ( const QString &sExtensionId );
+        void    Clear  ( );
+
+        static QString MakeKey ( const UPnpCDSRequest *pRequest );
+
+        static constexpr int kDefaultMaxKB { 8 * 1024 };
+
+    private:
+
+        QMutex                                   m_lock;
+        QCache<QString, UPnpCDSCacheEntry>       m_cache;
 };
 
 //////////////////////////////////////////////////////////////////////////////
@@ -209,6 +260,10 @@ class UPNP_PUBLIC UPnpCDSExtension
 
         CDSShortCutList m_shortcuts;
 
+        // MythEvent messages that change our content, and so invalidate
+        // any cached results
+        QStringList     m_changeEvents;
+
     protected:
 
         static QString RemoveToken ( const QString &sToken, const QString &sStr, int num );
@@ -226,6 +281,9 @@ class UPNP_PUBLIC UPnpCDSExtension
 
         virtual void CreateRoot ( );
 
+        void LoadRootChildren ( const UPnpCDSRequest *pRequest,
+                                UPnpCDSExtensionResults *pResults );
+
         virtual bool LoadMetadata ( const UPnpCDSRequest *pRequest,
                                     UPnpCDSExtensionResults *pResults,
                                     const IDTokenMap& tokens,
@@ -293,6 +351,8 @@ class UPNP_PUBLIC UPnpCDS : public Eventing
         UPnPFeatureList        m_features;
         UPnPShortcutFeature   *m_pShortCuts {nullptr};
 
+        UPnpCDSCache           m_cache;
+
     private:
 
         static UPnpCDSMethod       GetMethod              ( const QString &sURI  );
@@ -333,6 +393,8 @@ class UPNP_PUBLIC UPnpCDS : public Eventing
                                       const QString &objectID );
         void     RegisterFeature    ( UPnPFeature *feature );
 
+        void     ContentChanged     ( const QString &sMessage );
+
         QStringList GetBasePaths() override; // Eventing
         
         bool ProcessRequest( HTTPRequest *pRequest ) override; // Eventing
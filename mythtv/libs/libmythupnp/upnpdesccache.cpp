@@ -0,0 +1,136 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: upnpdesccache.cpp
+// Created     : Oct. 19, 2026
+//
+// Purpose     : On disk cache of UPnP device descriptions
+//
+// Licensed under the GPL v2 or later, see COPYING for details
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include "upnpdesccache.h"
+#include "mythdirs.h"
+#include "mythlogging.h"
+
+#define LOC QString("UPnpDescCache: ")
+
+static QString cache_dir(void)
+{
+    return GetCacheDir() + "/upnp";
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+QString UPnpDescCache::FileName( const QString &sLocation,
+                                 const QString &sBootId )
+{
+    QByteArray key = (sLocation + '\n' + sBootId).toUtf8();
+
+    return QString("%1/%2.xml")
+        .arg(cache_dir())
+        .arg(QString(QCryptographicHash::hash(key, QCryptographicHash::Md5)
+                         .toHex()));
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+bool UPnpDescCache::Load( const QString &sLocation, const QString &sBootId,
+                          QByteArray &xml )
+{
+    if (sBootId.isEmpty())
+        return false;
+
+    QString   sFileName = FileName(sLocation, sBootId);
+    QFileInfo info(sFileName);
+
+    if (!info.exists())
+        return false;
+
+    if (info.lastModified().secsTo(QDateTime::currentDateTime()) > kMaxAgeSecs)
+    {
+        QFile::remove(sFileName);
+        return false;
+    }
+
+    QFile file(sFileName);
+
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    xml = file.readAll();
+
+    LOG(VB_UPNP, LOG_DEBUG, LOC + QString("Loaded %1 (boot %2)")
+        .arg(sLocation).arg(sBootId));
+
+    return !xml.isEmpty();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void UPnpDescCache::Save( const QString &sLocation, const QString &sBootId,
+                          const QByteArray &xml )
+{
+    if (sBootId.isEmpty() || xml.isEmpty())
+        return;
+
+    QDir dir;
+    if (!dir.mkpath(cache_dir()))
+    {
+        LOG(VB_UPNP, LOG_ERR, LOC + QString("Unable to create %1")
+            .arg(cache_dir()));
+        return;
+    }
+
+    Prune();
+
+    // Written to a temporary file and renamed, so a reader never sees a
+    // partial description
+    QSaveFile file(FileName(sLocation, sBootId));
+
+    if (!file.open(QIODevice::WriteOnly) ||
+        file.write(xml) != xml.size() || !file.commit())
+    {
+        LOG(VB_UPNP, LOG_ERR, LOC + QString("Unable to save %1")
+            .arg(sLocation));
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void UPnpDescCache::Remove( const QString &sLocation, const QString &sBootId )
+{
+    QFile::remove(FileName(sLocation, sBootId));
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Removes descriptions nobody has saved for a long time, such as those of
+// devices which have since rebooted or left the network.
+/////////////////////////////////////////////////////////////////////////////
+
+void UPnpDescCache::Prune( void )
+{
+    QDateTime     now   = QDateTime::currentDateTime();
+    QFileInfoList files = QDir(cache_dir()).entryInfoList(
+        QStringList("*.xml"), QDir::Files);
+
+    for (const auto &info : qAsConst(files))
+    {
+        if (info.lastModified().secsTo(now) > kMaxAgeSecs)
+            QFile::remove(info.absoluteFilePath());
+    }
+}
@@ -0,0 +1,48 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: upnpdesccache.h
+// Created     : Oct. 19, 2026
+//
+// Purpose     : On disk cache of UPnP device descriptions
+//
+// Licensed under the GPL v2 or later, see COPYING for details
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef UPNPDESCCACHE_H
+#define UPNPDESCCACHE_H
+
+#include <QByteArray>
+#include <QString>
+
+#include "upnpexp.h"
+
+/////////////////////////////////////////////////////////////////////////////
+//
+// Device descriptions rarely change, but fetching them from every device
+// on the network delays discovery at each start.  They are kept on disk,
+// keyed by the description's location and the device's BOOTID.UPNP.ORG,
+// which a UPnP 1.1 device changes whenever its description may have.
+//
+// UPnP 1.0 devices send no BOOTID, so there is no way to tell whether
+// their description changed and they are never cached.
+//
+/////////////////////////////////////////////////////////////////////////////
+
+class UPNP_PUBLIC UPnpDescCache
+{
+  public:
+    static bool Load  ( const QString &sLocation, const QString &sBootId,
+                        QByteArray &xml );
+    static void Save  ( const QString &sLocation, const QString &sBootId,
+                        const QByteArray &xml );
+    static void Remove( const QString &sLocation, const QString &sBootId );
+
+    static constexpr int kMaxAgeSecs { 30 * 24 * 60 * 60 };
+
+  private:
+    static QString FileName( const QString &sLocation,
+                             const QString &sBootId );
+    static void    Prune   ( void );
+};
+
+#endif // UPNPDESCCACHE_H
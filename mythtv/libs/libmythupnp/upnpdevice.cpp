@@ -12,6 +12,7 @@
 
 #include "upnp.h"
 #include "upnpdevice.h"
+#include "upnpdesccache.h"
 #include "mythdownloadmanager.h"
 #include "mythlogging.h"
 #include "mythversion.h"  // for MYTH_BINARY_VERSION
@@ -619,7 +620,8 @@ UPnpDevice *UPnpDeviceDesc::FindDevice( UPnpDevice    *pDevice,
 //
 /////////////////////////////////////////////////////////////////////////////
 
-UPnpDeviceDesc *UPnpDeviceDesc::Retrieve( QString &sURL )
+UPnpDeviceDesc *UPnpDeviceDesc::Retrieve( QString &sURL,
+                                          const QString &sBootId )
 {
     UPnpDeviceDesc *pDevice = nullptr;
 
@@ -628,7 +630,12 @@ UPnpDeviceDesc *UPnpDeviceDesc::Retrieve( QString &sURL )
 
     QByteArray buffer;
 
-    bool ok = GetMythDownloadManager()->download(sURL, &buffer);
+    // Only devices which announce a boot id are served from the disk cache
+    // here.  Without one, a MythTV backend upgraded since the description
+    // was saved would be reported with its old protocol version.
+    bool cached = !sBootId.isEmpty() &&
+                  UPnpDescCache::Load(sURL, sBootId, buffer);
+    bool ok     = cached || GetMythDownloadManager()->download(sURL, &buffer);
 
     QString sXml(buffer);
 
@@ -644,9 +651,15 @@ UPnpDeviceDesc *UPnpDeviceDesc::Retrieve( QString &sURL )
             pDevice->Load( xml );
             pDevice->m_hostUrl   = sURL;
             pDevice->m_sHostName = pDevice->m_hostUrl.host();
+
+            if (!cached && !sBootId.isEmpty())
+                UPnpDescCache::Save(sURL, sBootId, buffer);
         }
         else
         {
+            if (cached)
+                UPnpDescCache::Remove(sURL, sBootId);
+
             LOG(VB_UPNP, LOG_ERR,
                 QString("Error parsing device description xml [%1]")
                      .arg(sErrorMsg));
@@ -191,7 +191,8 @@ class UPNP_PUBLIC UPnpDeviceDesc
         UPnpDevice *FindDevice( const QString &sURI );
 
         static UPnpDevice     *FindDevice( UPnpDevice *pDevice, const QString &sURI );
-        static UPnpDeviceDesc *Retrieve  ( QString &sURL );
+        static UPnpDeviceDesc *Retrieve  ( QString &sURL,
+                                           const QString &sBootId = QString() );
 
         void toMap(InfoMap &map) const
         {
@@ -233,6 +234,7 @@ class UPNP_PUBLIC DeviceLocation : public ReferenceCounter
         QString     m_sLocation;      // URL to Device Description
         TaskTime    m_ttExpires;
         QString     m_sSecurityPin;   // Use for MythXML methods needed pin
+        QString     m_sBootId;        // BOOTID.UPNP.ORG, if the device sent one
 
     public:
 
@@ -241,13 +243,15 @@ class UPNP_PUBLIC DeviceLocation : public ReferenceCounter
         DeviceLocation( QString sURI,
                         QString sUSN,
                         QString sLocation,
-                        TaskTime       ttExpires ) : ReferenceCounter(
+                        TaskTime       ttExpires,
+                        QString sBootId = QString() ) : ReferenceCounter(
                                                          "DeviceLocation"     ),
                                                      m_pDeviceDesc( nullptr   ),
                                                      m_sURI       (std::move( sURI      )),
                                                      m_sUSN       (std::move( sUSN      )),
                                                      m_sLocation  (std::move( sLocation )),
-                                                     m_ttExpires  ( ttExpires )
+                                                     m_ttExpires  ( ttExpires ),
+                                                     m_sBootId    (std::move( sBootId   ))
         {
             // Should be atomic increment
             g_nAllocated++;
@@ -268,7 +272,7 @@ class UPNP_PUBLIC DeviceLocation : public ReferenceCounter
         UPnpDeviceDesc *GetDeviceDesc(void)
         {
             if (m_pDeviceDesc == nullptr)
-                m_pDeviceDesc = UPnpDeviceDesc::Retrieve( m_sLocation );
+                m_pDeviceDesc = UPnpDeviceDesc::Retrieve( m_sLocation, m_sBootId );
 
             return m_pDeviceDesc;
         }
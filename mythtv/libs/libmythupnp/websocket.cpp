@@ -8,6 +8,7 @@
 #include "mythevent.h"
 #include "codecutil.h"
 #include "websocket_extensions/websocket_mythevent.h"
+#include "websocket_extensions/websocket_subscriptions.h"
 
 // QT headers
 #include <QThread>
@@ -117,8 +118,9 @@ WebSocketWorker::WebSocketWorker(WebSocketServer& webSocketServer,
     LOG(VB_HTTP, LOG_INFO, QString("WebSocketWorker(%1): New connection")
                                         .arg(m_socketFD));
 
-    // For now, until it's refactored, register the only extension here
+    // For now, until it's refactored, register the extensions here
     RegisterExtension(new WebSocketMythEvent());
+    RegisterExtension(new WebSocketSubscriptions());
 
     SetupSocket();
 
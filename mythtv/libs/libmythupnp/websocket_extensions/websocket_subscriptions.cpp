@@ -0,0 +1,234 @@
+
+#include "websocket_subscriptions.h"
+#include "mythlogging.h"
+
+#include <QJsonDocument>
+#include <QVariantList>
+
+#define LOC QString("WebSocketSubscriptions: ")
+
+static QString to_json(const QVariantMap &message)
+{
+    return QString::fromUtf8(
+        QJsonDocument::fromVariant(message).toJson(QJsonDocument::Compact));
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+WebSocketTopic::WebSocketTopic(const QString &name)
+{
+    setObjectName(name);
+}
+
+/**
+ *  \brief Replaces the state of the topic with \p items and sends the
+ *         difference to the subscribers.
+ *
+ *  \return false if nothing changed, and so nothing was sent
+ */
+bool WebSocketTopic::Publish(const QVariantMap &items)
+{
+    QMutexLocker locker(&m_lock);
+
+    QVariantMap  changed;
+    QVariantList removed;
+
+    for (auto it = items.cbegin(); it != items.cend(); ++it)
+    {
+        auto old = m_items.constFind(it.key());
+        if (old == m_items.cend() || *old != *it)
+            changed.insert(it.key(), *it);
+    }
+
+    for (auto it = m_items.cbegin(); it != m_items.cend(); ++it)
+    {
+        if (!items.contains(it.key()))
+            removed.append(it.key());
+    }
+
+    if (changed.isEmpty() && removed.isEmpty())
+        return false;
+
+    m_items = items;
+    m_seq++;
+
+    QVariantMap message;
+    message["Topic"] = Name();
+    message["Seq"]   = m_seq;
+    if (!changed.isEmpty())
+        message["Changed"] = changed;
+    if (!removed.isEmpty())
+        message["Removed"] = removed;
+
+    // Subscribers are queued connections, so emitting with the lock held
+    // delivers the deltas to each of them in sequence order.
+    emit Changed(m_seq, to_json(message).toUtf8());
+
+    return true;
+}
+
+/// \brief Returns the whole state as a message, and its sequence number
+QByteArray WebSocketTopic::Snapshot(quint64 &seq) const
+{
+    QMutexLocker locker(&m_lock);
+
+    QVariantMap message;
+    message["Topic"]    = Name();
+    message["Seq"]      = m_seq;
+    message["Snapshot"] = m_items;
+
+    seq = m_seq;
+    return to_json(message).toUtf8();
+}
+
+bool WebSocketTopic::HasSubscribers(void) const
+{
+    return receivers(SIGNAL(Changed(quint64,QByteArray))) > 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+QMutex                          WebSocketTopics::s_lock;
+QMap<QString, WebSocketTopic*>  WebSocketTopics::s_topics;
+
+/// \brief Returns the topic called \p name, creating it if necessary
+WebSocketTopic *WebSocketTopics::Add(const QString &name)
+{
+    QMutexLocker locker(&s_lock);
+
+    WebSocketTopic *topic = s_topics.value(name, nullptr);
+    if (topic == nullptr)
+    {
+        topic = new WebSocketTopic(name);
+        s_topics.insert(name, topic);
+    }
+    return topic;
+}
+
+WebSocketTopic *WebSocketTopics::Find(const QString &name)
+{
+    QMutexLocker locker(&s_lock);
+    return s_topics.value(name, nullptr);
+}
+
+QStringList WebSocketTopics::Names(void)
+{
+    QMutexLocker locker(&s_lock);
+    return s_topics.keys();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+WebSocketSubscriptions::WebSocketSubscriptions()
+{
+    setObjectName("WebSocketSubscriptions");
+}
+
+bool WebSocketSubscriptions::HandleTextFrame(const WebSocketFrame &frame)
+{
+    QString message = QString(frame.m_payload);
+
+#if QT_VERSION < QT_VERSION_CHECK(5,14,0)
+    QStringList tokens = message.split(" ", QString::SkipEmptyParts);
+#else
+    QStringList tokens = message.split(" ", Qt::SkipEmptyParts);
+#endif
+
+    if (tokens.isEmpty())
+        return false;
+
+    if (tokens[0] == "WS_TOPICS")
+    {
+        QVariantMap reply;
+        reply["Topics"] = WebSocketTopics::Names();
+        emit SendTextMessage(to_json(reply));
+    }
+    else if (tokens[0] == "WS_SUBSCRIBE")
+    {
+        for (int i = 1; i < tokens.size(); ++i)
+            Subscribe(tokens[i]);
+    }
+    else if (tokens[0] == "WS_UNSUBSCRIBE")
+    {
+        QStringList names = tokens.mid(1);
+        if (names.contains("ALL"))
+            names = m_subscriptions.keys();
+        for (const QString &name : qAsConst(names))
+            Unsubscribe(name);
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void WebSocketSubscriptions::Subscribe(const QString &name)
+{
+    if (m_subscriptions.contains(name))
+        return;
+
+    WebSocketTopic *topic = WebSocketTopics::Find(name);
+    if (topic == nullptr)
+    {
+        QVariantMap reply;
+        reply["Topic"] = name;
+        reply["Error"] = "Unknown topic";
+        emit SendTextMessage(to_json(reply));
+        return;
+    }
+
+    // Connect before taking the snapshot, so no later delta can be missed.
+    // TopicChanged() drops those the snapshot already includes.
+    connect(topic, &WebSocketTopic::Changed,
+            this,  &WebSocketSubscriptions::TopicChanged,
+            Qt::QueuedConnection);
+
+    quint64 seq = 0;
+    QByteArray snapshot = topic->Snapshot(seq);
+    m_subscriptions[name] = seq;
+
+    LOG(VB_HTTP, LOG_NOTICE, LOC + QString("Subscribed to %1").arg(name));
+
+    emit SendTextMessage(QString::fromUtf8(snapshot));
+    emit topic->Subscribed(name);
+}
+
+void WebSocketSubscriptions::Unsubscribe(const QString &name)
+{
+    if (!m_subscriptions.contains(name))
+        return;
+
+    WebSocketTopic *topic = WebSocketTopics::Find(name);
+    if (topic != nullptr)
+    {
+        disconnect(topic, &WebSocketTopic::Changed,
+                   this,  &WebSocketSubscriptions::TopicChanged);
+    }
+    m_subscriptions.remove(name);
+
+    LOG(VB_HTTP, LOG_NOTICE, LOC + QString("Unsubscribed from %1").arg(name));
+}
+
+void WebSocketSubscriptions::TopicChanged(quint64 seq,
+                                          const QByteArray &message)
+{
+    auto *topic = qobject_cast<WebSocketTopic *>(sender());
+    if (topic == nullptr)
+        return;
+
+    // Deltas may still be queued after unsubscribing
+    auto it = m_subscriptions.find(topic->Name());
+    if (it == m_subscriptions.end() || seq <= *it)
+        return;
+
+    *it = seq;
+    emit SendTextMessage(QString::fromUtf8(message));
+}
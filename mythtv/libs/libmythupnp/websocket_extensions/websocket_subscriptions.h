@@ -0,0 +1,111 @@
+#ifndef WEBSOCKET_SUBSCRIPTIONS_H_
+#define WEBSOCKET_SUBSCRIPTIONS_H_
+
+#include "upnpexp.h"
+#include "websocket.h"
+
+#include <QByteArray>
+#include <QMap>
+#include <QMutex>
+#include <QStringList>
+#include <QVariantMap>
+
+/** \class WebSocketTopic
+ *
+ *  \brief A named piece of backend state which clients can subscribe to
+ *
+ * The producer publishes the complete state, a map of item keys to item
+ * values, whenever it may have changed.  The topic compares it with the
+ * previous state and, if anything differs, sends one JSON message listing
+ * the changed and removed items to every subscriber.  The message is
+ * serialized once however many clients are subscribed.
+ *
+ * Messages are numbered.  A subscriber first receives the whole state as a
+ * snapshot and then every delta with a higher sequence number:
+ *
+ *   {"Topic":"Upcoming","Seq":12,"Snapshot":{"<key>":{...},...}}
+ *   {"Topic":"Upcoming","Seq":13,"Changed":{"<key>":{...}},"Removed":["<key>"]}
+ *
+ * \ingroup WebSocket_Extensions
+ */
+class UPNP_PUBLIC WebSocketTopic : public QObject
+{
+  Q_OBJECT
+
+  public:
+    explicit WebSocketTopic(const QString &name);
+    ~WebSocketTopic() override = default;
+
+    QString Name(void) const { return objectName(); }
+
+    bool Publish(const QVariantMap &items);
+    QByteArray Snapshot(quint64 &seq) const;
+    bool HasSubscribers(void) const;
+
+  signals:
+    /// A delta, \p seq is the sequence number in \p message
+    void Changed(quint64 seq, const QByteArray &message);
+    /// A client subscribed, the producer may want to refresh the state
+    void Subscribed(const QString &name);
+
+  private:
+    mutable QMutex m_lock;
+    QVariantMap    m_items; // protected by m_lock
+    quint64        m_seq   {0};
+};
+
+/** \class WebSocketTopics
+ *
+ *  \brief The registry of topics offered by WebSocketSubscriptions
+ *
+ * Topics are created by their producers and live until the process exits.
+ *
+ * \ingroup WebSocket_Extensions
+ */
+class UPNP_PUBLIC WebSocketTopics
+{
+  public:
+    static WebSocketTopic *Add(const QString &name);
+    static WebSocketTopic *Find(const QString &name);
+    static QStringList Names(void);
+
+  private:
+    static QMutex                         s_lock;
+    static QMap<QString, WebSocketTopic*> s_topics;
+};
+
+/** \class WebSocketSubscriptions
+ *
+ *  \brief Extension for subscribing to WebSocketTopic state over
+ *         WebSocketServer
+ *
+ * Commands:
+ *
+ *   WS_TOPICS                      Lists the available topics
+ *   WS_SUBSCRIBE <topic> ...       Sends a snapshot of each topic, then deltas
+ *   WS_UNSUBSCRIBE <topic|ALL> ... Stops sending deltas
+ *
+ * \ingroup WebSocket_Extensions
+ */
+class UPNP_PUBLIC WebSocketSubscriptions : public WebSocketExtension
+{
+  Q_OBJECT
+
+  public:
+    WebSocketSubscriptions();
+    ~WebSocketSubscriptions() override = default;
+
+    bool HandleTextFrame(const WebSocketFrame &frame) override; // WebSocketExtension
+
+  private slots:
+    void TopicChanged(quint64 seq, const QByteArray &message);
+
+  private:
+    void Subscribe(const QString &name);
+    void Unsubscribe(const QString &name);
+
+    /// The sequence number of the last message sent for each topic
+    QMap<QString, quint64> m_subscriptions;
+};
+
+#endif
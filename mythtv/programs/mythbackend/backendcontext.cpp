@@ -8,6 +8,8 @@ QMap<int, EncoderLink *> tvList;
 AutoExpire  *expirer      = nullptr;
 JobQueue    *jobqueue     = nullptr;
 HouseKeeper *housekeeping = nullptr;
+StateTopics *stateTopics  = nullptr;
+HttpStatus  *httpStatus   = nullptr;
 MediaServer *g_pUPnp      = nullptr;
 BackendContext *gBackendContext = nullptr;
 QString      pidfile;
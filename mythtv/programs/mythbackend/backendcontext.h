@@ -13,6 +13,8 @@ class Scheduler;
 class JobQueue;
 class HouseKeeper;
 class MediaServer;
+class StateTopics;
+class HttpStatus;
 class BackendContext;
 
 extern QMap<int, EncoderLink *> tvList;
@@ -20,6 +22,8 @@ extern AutoExpire  *expirer;
 extern JobQueue    *jobqueue;
 extern HouseKeeper *housekeeping;
 extern MediaServer *g_pUPnp;
+extern StateTopics *stateTopics;
+extern HttpStatus  *httpStatus;
 extern BackendContext *gBackendContext;
 extern QString      pidfile;
 extern QString      logfile;
@@ -6,7 +6,9 @@
 #include "filetransfer.h"
 #include "io/mythmediabuffer.h"
 #include "mythdate.h"
+#include "mythmetrics.h"
 #include "mythsocket.h"
+#include "mythtimer.h"
 #include "programinfo.h"
 #include "mythlogging.h"
 
@@ -119,8 +121,18 @@ void FileTransfer::Unpause(void)
         m_pginfo->UpdateInUseMark();
 }
 
+static const QString kBlockHelp("Time taken to serve a file transfer block");
+static const QString kBytesHelp("Data transferred by file transfer sockets");
+
 int FileTransfer::RequestBlock(int size)
 {
+    static auto *s_latency = MythMetrics::Histogram(
+        "mythtv_filetransfer_block_seconds", kBlockHelp,
+        MythMetrics::Label("direction", "read"));
+    static auto *s_bytes = MythMetrics::Counter(
+        "mythtv_filetransfer_bytes_total", kBytesHelp,
+        MythMetrics::Label("direction", "read"));
+
     if (!m_readthreadlive || !m_rbuffer)
         return -1;
 
@@ -131,6 +143,9 @@ int FileTransfer::RequestBlock(int size)
     while (m_readsLocked)
         m_readsUnlockedCond.wait(&m_lock, 100 /*ms*/);
 
+    MythTimer timer;
+    timer.start();
+
     m_requestBuffer.resize(max((size_t)max(size,0) + 128, m_requestBuffer.size()));
     char *buf = &m_requestBuffer[0];
     while (tot < size && !m_rbuffer->GetStopReads() && m_readthreadlive)
@@ -153,6 +168,10 @@ int FileTransfer::RequestBlock(int size)
             break; // we hit eof
     }
 
+    s_latency->Record(timer.nsecsElapsed() / 1000);
+    if (tot > 0)
+        s_bytes->Add(tot);
+
     if (m_pginfo)
         m_pginfo->UpdateInUseMark();
 
@@ -161,6 +180,13 @@ int FileTransfer::RequestBlock(int size)
 
 int FileTransfer::WriteBlock(int size)
 {
+    static auto *s_latency = MythMetrics::Histogram(
+        "mythtv_filetransfer_block_seconds", kBlockHelp,
+        MythMetrics::Label("direction", "write"));
+    static auto *s_bytes = MythMetrics::Counter(
+        "mythtv_filetransfer_bytes_total", kBytesHelp,
+        MythMetrics::Label("direction", "write"));
+
     if (!m_writemode || !m_rbuffer)
         return -1;
 
@@ -173,6 +199,9 @@ int FileTransfer::WriteBlock(int size)
     char *buf = &m_requestBuffer[0];
     int attempts = 0;
 
+    MythTimer timer;
+    timer.start();
+
     while (tot < size)
     {
         int request = size - tot;
@@ -214,6 +243,10 @@ int FileTransfer::WriteBlock(int size)
         tot += received;
     }
 
+    s_latency->Record(timer.nsecsElapsed() / 1000);
+    if (tot > 0)
+        s_bytes->Add(tot);
+
     if (m_pginfo)
         m_pginfo->UpdateInUseMark();
 
@@ -0,0 +1,176 @@
+// C++ headers
+#include <algorithm>
+
+// Qt headers
+#include <QCoreApplication>
+#include <QStringList>
+
+// MythTV headers
+#include "guidecache.h"
+#include "mythcorecontext.h"
+#include "mythdbcon.h"
+#include "mythdate.h"
+#include "mythevent.h"
+#include "mythlogging.h"
+
+#define LOC QString("GuideCache: ")
+
+GuideCache *GuideCache::GetInstance(void)
+{
+    static QMutex s_lock;
+    static GuideCache *s_instance = nullptr;
+
+    QMutexLocker locker(&s_lock);
+    if (s_instance == nullptr)
+    {
+        // Callers are service threads without an event loop, so the change
+        // events are delivered on the main thread instead.
+        s_instance = new GuideCache();
+        s_instance->moveToThread(QCoreApplication::instance()->thread());
+        gCoreContext->addListener(s_instance);
+    }
+    return s_instance;
+}
+
+GuideCache::GuideCache()
+{
+    setObjectName("GuideCache");
+}
+
+GuideCache::~GuideCache()
+{
+    gCoreContext->removeListener(this);
+}
+
+/**
+ *  \brief Returns the programs of \p sourceId starting on the UTC \p day,
+ *         loading them if they aren't cached.
+ *
+ *  The result stays valid after the day is dropped from the cache.
+ */
+GuideCacheDayPtr GuideCache::GetDay(uint sourceId, const QDate &day)
+{
+    quint64 key = Key(sourceId, day);
+    uint    generation = 0;
+
+    {
+        QMutexLocker locker(&m_lock);
+        GuideCacheDayPtr *cached = m_days.object(key);
+        if (cached != nullptr)
+            return *cached;
+        generation = m_generation;
+    }
+
+    GuideCacheDayPtr loaded(Load(sourceId, day));
+
+    QMutexLocker locker(&m_lock);
+    // Listings that changed while we were loading may not be in the result
+    if (generation == m_generation)
+    {
+        m_days.insert(key, new GuideCacheDayPtr(loaded),
+                      std::max(loaded->size(), 1));
+    }
+    return loaded;
+}
+
+/// \brief Drops the cached days of \p sourceId, or of all sources if 0.
+void GuideCache::Invalidate(uint sourceId)
+{
+    QMutexLocker locker(&m_lock);
+
+    m_generation++;
+
+    if (sourceId == 0)
+    {
+        m_days.clear();
+        return;
+    }
+
+    const QList<quint64> keys = m_days.keys();
+    for (quint64 key : keys)
+    {
+        if ((key >> 32) == sourceId)
+            m_days.remove(key);
+    }
+}
+
+void GuideCache::customEvent(QEvent *e)
+{
+    if (e->type() != MythEvent::MythEventMessage)
+        return;
+
+    auto *me = dynamic_cast<MythEvent *>(e);
+    if (me == nullptr)
+        return;
+
+    const QString &message = me->Message();
+
+    if (message.startsWith("SYSTEM_EVENT MYTHFILLDATABASE_RAN"))
+    {
+        LOG(VB_GENERAL, LOG_DEBUG, LOC + "Listings updated");
+        Invalidate();
+    }
+    else if (message == "RESCHEDULE_RECORDINGS" && me->ExtraDataCount() > 0)
+    {
+        // MATCH <recordid> <sourceid> <mplexid> <maxstarttime> <why>
+        // A rematch of every rule means the listings have changed.
+        QStringList tokens = me->ExtraData(0).split(' ');
+        if (tokens.size() >= 3 && tokens[0] == "MATCH" &&
+            tokens[1].toUInt() == 0)
+        {
+            LOG(VB_GENERAL, LOG_DEBUG, LOC +
+                QString("Listings of source %1 updated").arg(tokens[2]));
+            Invalidate(tokens[2].toUInt());
+        }
+    }
+}
+
+GuideCacheDay *GuideCache::Load(uint sourceId, const QDate &day)
+{
+    auto *programs = new GuideCacheDay();
+
+    QDateTime dayStart(day, QTime(0, 0), Qt::UTC);
+
+    MSqlQuery query(MSqlQuery::InitCon());
+    query.prepare("SELECT program.chanid, program.starttime, "
+                  "       program.endtime, program.title, "
+                  "       program.subtitle, program.category "
+                  "FROM program "
+                  "JOIN channel ON program.chanid = channel.chanid "
+                  "WHERE channel.sourceid = :SOURCEID "
+                  "  AND program.starttime >= :DAYSTART "
+                  "  AND program.starttime < :DAYEND "
+                  "  AND program.manualid = 0 "
+                  "ORDER BY program.chanid, program.starttime");
+    query.bindValue(":SOURCEID", sourceId);
+    query.bindValue(":DAYSTART", dayStart);
+    query.bindValue(":DAYEND",   dayStart.addDays(1));
+
+    if (!query.exec())
+    {
+        MythDB::DBError("GuideCache::Load", query);
+        return programs;
+    }
+
+    programs->reserve(query.size());
+    while (query.next())
+    {
+        GuideCacheProgram program;
+        program.m_chanId    = query.value(0).toUInt();
+        program.m_startTime =
+            MythDate::as_utc(query.value(1).toDateTime()).toSecsSinceEpoch();
+        program.m_endTime   =
+            MythDate::as_utc(query.value(2).toDateTime()).toSecsSinceEpoch();
+        program.m_title     = query.value(3).toString();
+        program.m_subtitle  = query.value(4).toString();
+        program.m_category  = query.value(5).toString();
+        programs->append(program);
+    }
+
+    LOG(VB_GENERAL, LOG_DEBUG, LOC +
+        QString("Loaded %1 programs of source %2 for %3")
+            .arg(programs->size()).arg(sourceId)
+            .arg(day.toString(Qt::ISODate)));
+
+    return programs;
+}
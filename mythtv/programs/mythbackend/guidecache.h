@@ -0,0 +1,64 @@
+// -*- Mode: c++ -*-
+
+#ifndef GUIDECACHE_H
+#define GUIDECACHE_H
+
+#include <QCache>
+#include <QDate>
+#include <QMutex>
+#include <QObject>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+/// One row of the program table, as the compact guide needs it
+struct GuideCacheProgram
+{
+    uint      m_chanId    {0};
+    qint64    m_startTime {0}; ///< seconds since the epoch
+    qint64    m_endTime   {0}; ///< seconds since the epoch
+    QString   m_title;
+    QString   m_subtitle;
+    QString   m_category;
+};
+
+/// The programs starting on one UTC day, ordered by chanid and start time
+using GuideCacheDay    = QVector<GuideCacheProgram>;
+using GuideCacheDayPtr = QSharedPointer<const GuideCacheDay>;
+
+/** \class GuideCache
+ *  \brief Keeps the listings of recently requested (source, day) pairs in
+ *         memory for the guide services.
+ *
+ *  A source's days are dropped when EIT asks the scheduler to rematch it,
+ *  and all days are dropped when mythfilldatabase has run.  Recording
+ *  status is not cached; it changes far more often than the listings.
+ */
+class GuideCache : public QObject
+{
+  public:
+    static GuideCache *GetInstance(void);
+
+    GuideCacheDayPtr GetDay(uint sourceId, const QDate &day);
+    void Invalidate(uint sourceId = 0);
+
+  protected:
+    void customEvent(QEvent *e) override;
+
+  private:
+    GuideCache();
+    ~GuideCache() override;
+
+    static GuideCacheDay *Load(uint sourceId, const QDate &day);
+    static quint64 Key(uint sourceId, const QDate &day)
+        { return (static_cast<quint64>(sourceId) << 32) | day.toJulianDay(); }
+
+    /// At most this many programs are kept, about two weeks of 300 channels
+    static constexpr int kMaxPrograms { 300 * 14 * 40 };
+
+    QMutex                             m_lock;
+    QCache<quint64, GuideCacheDayPtr>  m_days       { kMaxPrograms };
+    uint                               m_generation { 0 };
+};
+
+#endif // GUIDECACHE_H
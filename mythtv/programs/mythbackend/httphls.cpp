@@ -0,0 +1,127 @@
+// Qt headers
+#include <QUrl>
+
+// MythTV headers
+#include "httphls.h"
+#include "requesthandler/fileserverutil.h"
+#include "mythcorecontext.h"
+#include "mythlogging.h"
+
+HttpHLS::HttpHLS(const QString &sSharePath)
+    : HttpServerExtension("HttpHLS", sSharePath)
+{
+}
+
+QStringList HttpHLS::GetBasePaths()
+{
+    return QStringList("/HLS");
+}
+
+bool HttpHLS::ProcessRequest(HTTPRequest *pRequest)
+{
+    if (!pRequest || pRequest->m_sBaseUrl != "/HLS")
+        return false;
+
+    LOG(VB_HTTP, LOG_INFO, QString("HttpHLS::ProcessRequest: %1 : %2")
+        .arg(pRequest->m_sMethod).arg(pRequest->m_sRawRequest));
+
+    if (pRequest->m_sMethod == "GetPlaylist")
+    {
+        GetPlaylist(pRequest);
+        return true;
+    }
+
+    if (pRequest->m_sMethod == "GetSegment")
+    {
+        GetSegment(pRequest);
+        return true;
+    }
+
+    return false;
+}
+
+/// Finds the recording named by the request, or sets an error response.
+bool HttpHLS::LoadRecording(HTTPRequest *pRequest, ProgramInfo &pginfo,
+                            QString &filename)
+{
+    uint recordedid = pRequest->m_mapParams["RecordedId"].toUInt();
+    if (recordedid)
+        pginfo = ProgramInfo(recordedid);
+
+    if (!recordedid || !pginfo.GetChanID())
+    {
+        pRequest->m_nResponseStatus = 404;
+        return false;
+    }
+
+    if (pginfo.GetHostname().toLower() != gCoreContext->GetHostName().toLower())
+    {
+        LOG(VB_HTTP, LOG_ERR,
+            QString("HttpHLS: Recording %1 is stored on '%2', not here")
+                .arg(recordedid).arg(pginfo.GetHostname()));
+        pRequest->m_nResponseStatus = 404;
+        return false;
+    }
+
+    filename = GetPlaybackURL(&pginfo);
+    if (!HLSPackager::CanPackage(filename))
+    {
+        // Needs a transcode, see Content/AddRecordingLiveStream
+        pRequest->m_nResponseStatus = 415;
+        return false;
+    }
+
+    return true;
+}
+
+void HttpHLS::GetPlaylist(HTTPRequest *pRequest)
+{
+    pRequest->m_eResponseType = ResponseTypeHeader;
+
+    ProgramInfo pginfo;
+    QString filename;
+    if (!LoadRecording(pRequest, pginfo, filename))
+        return;
+
+    QString segmentUrl = QString("GetSegment?RecordedId=%1&Segment=")
+        .arg(pginfo.GetRecordingID()) + "%1";
+
+    QByteArray playlist =
+        m_packager.GetPlaylist(pginfo, filename, segmentUrl);
+    if (playlist.isEmpty())
+    {
+        pRequest->m_nResponseStatus = 404;
+        return;
+    }
+
+    pRequest->m_eResponseType     = ResponseTypeOther;
+    pRequest->m_sResponseTypeText = "application/vnd.apple.mpegurl";
+    pRequest->m_mapRespHeaders[ "Cache-Control" ] = "no-cache";
+    pRequest->m_response.write(playlist);
+}
+
+void HttpHLS::GetSegment(HTTPRequest *pRequest)
+{
+    pRequest->m_eResponseType = ResponseTypeHeader;
+
+    ProgramInfo pginfo;
+    QString filename;
+    if (!LoadRecording(pRequest, pginfo, filename))
+        return;
+
+    bool ok = false;
+    uint segment = pRequest->m_mapParams["Segment"].toUInt(&ok);
+    QByteArray data;
+    if (ok)
+        data = m_packager.GetSegment(pginfo, filename, segment);
+    if (data.isEmpty())
+    {
+        pRequest->m_nResponseStatus = 404;
+        return;
+    }
+
+    pRequest->m_eResponseType     = ResponseTypeOther;
+    pRequest->m_sResponseTypeText = "video/mp2t";
+    pRequest->m_mapRespHeaders[ "Cache-Control" ] = "max-age=3600";
+    pRequest->m_response.write(data);
+}
@@ -0,0 +1,36 @@
+// -*- Mode: c++ -*-
+
+#ifndef HTTPHLS_H
+#define HTTPHLS_H
+
+#include "httpserver.h"
+#include "HLS/hlspackager.h"
+#include "programinfo.h"
+
+/** \class HttpHLS
+ *  \brief Serves recordings as HLS using HLSPackager.
+ *
+ *  /HLS/GetPlaylist?RecordedId=N returns the playlist of a recording and
+ *  /HLS/GetSegment?RecordedId=N&Segment=M its segments.  Only recordings
+ *  stored on this backend are served.
+ */
+class HttpHLS : public HttpServerExtension
+{
+  public:
+    explicit HttpHLS(const QString &sSharePath);
+    ~HttpHLS() override = default;
+
+    QStringList GetBasePaths() override; // HttpServerExtension
+
+    bool ProcessRequest(HTTPRequest *pRequest) override; // HttpServerExtension
+
+  private:
+    void GetPlaylist(HTTPRequest *pRequest);
+    void GetSegment(HTTPRequest *pRequest);
+    static bool LoadRecording(HTTPRequest *pRequest, ProgramInfo &pginfo,
+                              QString &filename);
+
+    HLSPackager m_packager;
+};
+
+#endif // HTTPHLS_H
@@ -12,11 +12,13 @@
 #include <unistd.h>
 
 // ANSI C headers
+#include <array>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
 
 // Qt headers
+#include <QElapsedTimer>
 #include <QTextStream>
 #include <QRegExp>
 
@@ -26,6 +28,7 @@
 #include "mythcorecontext.h"
 #include "mythversion.h"
 #include "mythdbcon.h"
+#include "mythmetrics.h"
 #include "compat.h"
 #include "mythconfig.h"
 #include "autoexpire.h"
@@ -40,12 +43,24 @@
 #include "jobqueue.h"
 #include "upnp.h"
 #include "mythdate.h"
+#include "mythevent.h"
 #include "tv_rec.h"
 
 /////////////////////////////////////////////////////////////////////////////
 //
 /////////////////////////////////////////////////////////////////////////////
 
+void HttpStatusThread::run(void)
+{
+    RunProlog();
+    m_parent->RunSnapshot();
+    RunEpilog();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
 HttpStatus::HttpStatus( QMap<int, EncoderLink *> *tvList, Scheduler *sched,
                         AutoExpire *expirer, bool bIsMaster )
           : HttpServerExtension( "HttpStatus" , QString())
@@ -58,6 +73,176 @@ HttpStatus::HttpStatus( QMap<int, EncoderLink *> *tvList, Scheduler *sched,
     m_nPreRollSeconds = gCoreContext->GetNumSetting("RecordPreRoll", 0);
 
     m_pMainServer = nullptr;
+
+    gCoreContext->addListener(this);
+
+    m_snapshotRunning = true;
+    m_snapshotThread = new HttpStatusThread(this);
+    m_snapshotThread->start();
+}
+
+HttpStatus::~HttpStatus()
+{
+    StopSnapshot();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void HttpStatus::SetMainServer(MainServer *mainServer)
+{
+    {
+        QMutexLocker locker(&m_buildLock);
+        m_pMainServer = mainServer;
+    }
+
+    // The storage information comes from the main server
+    QMutexLocker locker(&m_snapshotLock);
+    m_snapshotDirty = true;
+    m_snapshotWait.wakeAll();
+}
+
+/**
+ *  \brief Stops maintaining the status snapshot.
+ *
+ *  Must be called before the scheduler, the encoders or the main server
+ *  are deleted. Requests after this build their status synchronously.
+ */
+void HttpStatus::StopSnapshot(void)
+{
+    if (m_snapshotThread == nullptr)
+        return;
+
+    gCoreContext->removeListener(this);
+
+    {
+        QMutexLocker locker(&m_snapshotLock);
+        m_snapshotRunning = false;
+        m_snapshotWait.wakeAll();
+    }
+
+    delete m_snapshotThread;
+    m_snapshotThread = nullptr;
+
+    QMutexLocker locker(&m_snapshotLock);
+    m_snapshot = HttpStatusSnapshot();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void HttpStatus::customEvent(QEvent *e)
+{
+    if (e->type() != MythEvent::MythEventMessage)
+        return;
+
+    auto *me = dynamic_cast<MythEvent *>(e);
+    if (me == nullptr)
+        return;
+
+    const QString &message = me->Message();
+
+    // Recordings starting and stopping, jobs being queued, frontends and
+    // slaves coming and going all send a system event.
+    if (message == "SCHEDULE_CHANGE" ||
+        message.startsWith("RECORDING_LIST_CHANGE") ||
+        message.startsWith("SYSTEM_EVENT ") ||
+        message.startsWith("LOCAL_JOB"))
+    {
+        QMutexLocker locker(&m_snapshotLock);
+        m_snapshotDirty = true;
+        m_snapshotWait.wakeAll();
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void HttpStatus::RunSnapshot(void)
+{
+    QElapsedTimer sinceBuild;
+
+    QMutexLocker locker(&m_snapshotLock);
+    while (m_snapshotRunning)
+    {
+        // Without events, rebuild anyway for the load, storage and jobs
+        if (!m_snapshotDirty)
+            m_snapshotWait.wait(&m_snapshotLock, kSnapshotMaxAgeMs);
+
+        // Let a burst of events settle into a single rebuild
+        while (m_snapshotRunning && sinceBuild.isValid() &&
+               sinceBuild.elapsed() < kSnapshotMinIntervalMs)
+        {
+            m_snapshotWait.wait(&m_snapshotLock,
+                                kSnapshotMinIntervalMs - sinceBuild.elapsed());
+        }
+
+        if (!m_snapshotRunning)
+            break;
+
+        m_snapshotDirty = false;
+
+        locker.unlock();
+        BuildSnapshot();
+        sinceBuild.start();
+        locker.relock();
+    }
+}
+
+void HttpStatus::BuildSnapshot(void)
+{
+    QMutexLocker buildLocker(&m_buildLock);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QDomDocument doc( "Status" );
+
+    FillStatusXML( &doc );
+
+    HttpStatusSnapshot snapshot;
+
+    {
+        QTextStream stream( &snapshot.m_html );
+        PrintStatus( stream, &doc );
+    }
+
+    snapshot.m_metrics = PrintMetrics( &doc );
+
+    // UTF-8 is the default, but good practice to specify it anyway
+    QDomProcessingInstruction encoding =
+        doc.createProcessingInstruction("xml",
+                                        R"(version="1.0" encoding="UTF-8")");
+    doc.insertBefore(encoding, doc.documentElement());
+
+    snapshot.m_xml     = doc.toString().toUtf8();
+    snapshot.m_built   = MythDate::current();
+    snapshot.m_buildMs = timer.elapsed();
+
+    LOG(VB_HTTP, LOG_DEBUG,
+        QString("HttpStatus: Status snapshot built in %1 ms")
+            .arg(snapshot.m_buildMs));
+
+    QMutexLocker locker(&m_snapshotLock);
+    m_snapshot = snapshot;
+}
+
+/// \brief Returns the latest snapshot, building one if there is none yet.
+HttpStatusSnapshot HttpStatus::GetSnapshot(void)
+{
+    {
+        QMutexLocker locker(&m_snapshotLock);
+        if (m_snapshot.m_built.isValid())
+            return m_snapshot;
+    }
+
+    BuildSnapshot();
+
+    QMutexLocker locker(&m_snapshotLock);
+    return m_snapshot;
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -70,6 +255,8 @@ HttpStatusMethod HttpStatus::GetMethod( const QString &sURI )
     if (sURI == "GetStatusHTML"        ) return( HSM_GetStatusHTML   );
     if (sURI == "GetStatus"            ) return( HSM_GetStatusXML    );
     if (sURI == "xml"                  ) return( HSM_GetStatusXML    );
+    if (sURI == "GetMetrics"           ) return( HSM_GetMetrics      );
+    if (sURI == "metrics"              ) return( HSM_GetMetrics      );
 
     return( HSM_Unknown );
 }
@@ -80,7 +267,8 @@ HttpStatusMethod HttpStatus::GetMethod( const QString &sURI )
 
 QStringList HttpStatus::GetBasePaths()
 {
-    return QStringList( "/Status" );
+    // "/" so Prometheus can scrape the conventional /metrics
+    return QStringList() << "/Status" << "/";
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -93,6 +281,12 @@ bool HttpStatus::ProcessRequest( HTTPRequest *pRequest )
     {
         if (pRequest)
         {
+            if (pRequest->m_sResourceUrl == "/metrics")
+            {
+                GetMetrics( pRequest );
+                return true;
+            }
+
             if ((pRequest->m_sBaseUrl     != "/Status" ) &&
                 (pRequest->m_sResourceUrl != "/Status" ))
             {
@@ -103,6 +297,7 @@ bool HttpStatus::ProcessRequest( HTTPRequest *pRequest )
             {
                 case HSM_GetStatusXML   : GetStatusXML   ( pRequest ); return true;
                 case HSM_GetStatusHTML  : GetStatusHTML  ( pRequest ); return true;
+                case HSM_GetMetrics     : GetMetrics     ( pRequest ); return true;
 
                 default:
                 {
@@ -129,22 +324,12 @@ bool HttpStatus::ProcessRequest( HTTPRequest *pRequest )
 
 void HttpStatus::GetStatusXML( HTTPRequest *pRequest )
 {
-    QDomDocument doc( "Status" );
-
-    // UTF-8 is the default, but good practice to specify it anyway
-    QDomProcessingInstruction encoding =
-        doc.createProcessingInstruction("xml",
-                                        R"(version="1.0" encoding="UTF-8")");
-    doc.appendChild(encoding);
-
-    FillStatusXML( &doc );
+    HttpStatusSnapshot snapshot = GetSnapshot();
 
     pRequest->m_eResponseType   = ResponseTypeXML;
     pRequest->m_mapRespHeaders[ "Cache-Control" ] = "no-cache=\"Ext\", max-age = 5000";
 
-    QTextStream stream( &pRequest->m_response );
-    stream.setCodec("UTF-8");   // Otherwise locale default is used.
-    stream << doc.toString();
+    pRequest->m_response.write( snapshot.m_xml );
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -153,15 +338,45 @@ void HttpStatus::GetStatusXML( HTTPRequest *pRequest )
 
 void HttpStatus::GetStatusHTML( HTTPRequest *pRequest )
 {
+    HttpStatusSnapshot snapshot = GetSnapshot();
+
     pRequest->m_eResponseType = ResponseTypeHTML;
     pRequest->m_mapRespHeaders[ "Cache-Control" ] = "no-cache=\"Ext\", max-age = 5000";
 
-    QDomDocument doc( "Status" );
+    pRequest->m_response.write( snapshot.m_html );
+}
 
-    FillStatusXML( &doc );
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void HttpStatus::GetMetrics( HTTPRequest *pRequest )
+{
+    HttpStatusSnapshot snapshot = GetSnapshot();
+
+    pRequest->m_eResponseType     = ResponseTypeOther;
+    pRequest->m_sResponseTypeText = "text/plain; version=0.0.4; charset=utf-8";
+    pRequest->m_mapRespHeaders[ "Cache-Control" ] = "no-cache";
+
+    qint64 age = snapshot.m_built.msecsTo(MythDate::current());
+
+    pRequest->m_response.write( snapshot.m_metrics );
 
     QTextStream stream( &pRequest->m_response );
-    PrintStatus( stream, &doc );
+    stream.setCodec("UTF-8");
+    stream << "# HELP mythtv_status_snapshot_age_seconds "
+              "Age of the status these metrics were taken from\n"
+           << "# TYPE mythtv_status_snapshot_age_seconds gauge\n"
+           << "mythtv_status_snapshot_age_seconds " << (age / 1000.0) << "\n"
+           << "# HELP mythtv_status_snapshot_build_seconds "
+              "Time taken to collect the status\n"
+           << "# TYPE mythtv_status_snapshot_build_seconds gauge\n"
+           << "mythtv_status_snapshot_build_seconds "
+           << (snapshot.m_buildMs / 1000.0) << "\n";
+    stream.flush();
+
+    // Live instrumentation, not part of the snapshot
+    pRequest->m_response.write( MythMetrics::Export() );
 }
 
 static QString setting_to_localtime(const char *setting)
@@ -278,6 +493,24 @@ void HttpStatus::FillStatusXML( QDomDocument *pDoc )
         }
     }
 
+    // Totals for the metrics, over the whole schedule
+    int willRecord = 0;
+    int recording  = 0;
+    int conflicts  = 0;
+
+    for (auto *pInfo : recordingList)
+    {
+        RecStatus::Type status = pInfo->GetRecordingStatus();
+
+        if (status == RecStatus::WillRecord)
+            willRecord++;
+        else if (status == RecStatus::Recording || status == RecStatus::Tuning)
+            recording++;
+        else if (status == RecStatus::Conflict &&
+                 pInfo->GetRecordingEndTime() > qdtNow)
+            conflicts++;
+    }
+
     while (!recordingList.empty())
     {
         ProgramInfo *pginfo = recordingList.back();
@@ -286,6 +519,9 @@ void HttpStatus::FillStatusXML( QDomDocument *pDoc )
     }
 
     scheduled.setAttribute("count", iNumRecordings);
+    scheduled.setAttribute("willRecord", willRecord);
+    scheduled.setAttribute("recording" , recording );
+    scheduled.setAttribute("conflicts" , conflicts );
 
     // Add known frontends
 
@@ -618,6 +854,209 @@ void HttpStatus::FillStatusXML( QDomDocument *pDoc )
     }
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// Prometheus text exposition
+/////////////////////////////////////////////////////////////////////////////
+
+static QString metric_label(QString value)
+{
+    value.replace("\\", "\\\\");
+    value.replace("\"", "\\\"");
+    value.replace("\n", "\\n");
+    return "\"" + value + "\"";
+}
+
+static void metric_family(QTextStream &os, const char *name,
+                          const char *type, const char *help)
+{
+    os << "# HELP " << name << " " << help << "\n"
+       << "# TYPE " << name << " " << type << "\n";
+}
+
+static QList<QDomElement> child_elements(const QDomElement &parent,
+                                         const QString &tagName)
+{
+    QList<QDomElement> list;
+    for (QDomElement e = parent.firstChildElement(tagName); !e.isNull();
+         e = e.nextSiblingElement(tagName))
+    {
+        list << e;
+    }
+    return list;
+}
+
+QByteArray HttpStatus::PrintMetrics( QDomDocument *pDoc )
+{
+    QByteArray metrics;
+    QTextStream os( &metrics );
+    os.setCodec("UTF-8");
+
+    QDomElement docElem = pDoc->documentElement();
+
+    metric_family(os, "mythtv_info", "gauge", "Version of the backend");
+    os << "mythtv_info{version=" << metric_label(docElem.attribute("version"))
+       << ",protocol=" << metric_label(docElem.attribute("protoVer"))
+       << "} 1\n";
+
+    // Encoders -------------------------------
+
+    QList<QDomElement> encoders =
+        child_elements(docElem.firstChildElement("Encoders"), "Encoder");
+
+    auto encoder_labels = [](const QDomElement &e)
+    {
+        return QString("{input=%1,hostname=%2,devlabel=%3}")
+            .arg(metric_label(e.attribute("id")),
+                 metric_label(e.attribute("hostname")),
+                 metric_label(e.attribute("devlabel")));
+    };
+
+    metric_family(os, "mythtv_encoder_connected", "gauge",
+                  "Whether the backend of the encoder is connected");
+    for (const auto &e : qAsConst(encoders))
+        os << "mythtv_encoder_connected" << encoder_labels(e) << " "
+           << e.attribute("connected", "0") << "\n";
+
+    metric_family(os, "mythtv_encoder_state", "gauge",
+                  "TVState of the encoder, 0 when idle");
+    for (const auto &e : qAsConst(encoders))
+        os << "mythtv_encoder_state" << encoder_labels(e) << " "
+           << e.attribute("state", "0") << "\n";
+
+    metric_family(os, "mythtv_encoder_recording", "gauge",
+                  "Whether the encoder is recording");
+    for (const auto &e : qAsConst(encoders))
+        os << "mythtv_encoder_recording" << encoder_labels(e) << " "
+           << (e.firstChildElement("Program").isNull() ? 0 : 1) << "\n";
+
+    metric_family(os, "mythtv_encoder_sleep_status", "gauge",
+                  "SleepStatus of the backend of the encoder");
+    for (const auto &e : qAsConst(encoders))
+        os << "mythtv_encoder_sleep_status" << encoder_labels(e) << " "
+           << e.attribute("sleepstatus", "0") << "\n";
+
+    // Scheduler ------------------------------
+
+    QDomElement scheduled = docElem.firstChildElement("Scheduled");
+
+    metric_family(os, "mythtv_scheduler_will_record", "gauge",
+                  "Upcoming recordings that will be recorded");
+    os << "mythtv_scheduler_will_record "
+       << scheduled.attribute("willRecord", "0") << "\n";
+
+    metric_family(os, "mythtv_scheduler_recording", "gauge",
+                  "Recordings in progress");
+    os << "mythtv_scheduler_recording "
+       << scheduled.attribute("recording", "0") << "\n";
+
+    metric_family(os, "mythtv_scheduler_conflicts", "gauge",
+                  "Upcoming recordings in conflict");
+    os << "mythtv_scheduler_conflicts "
+       << scheduled.attribute("conflicts", "0") << "\n";
+
+    // Frontends and backends -----------------
+
+    metric_family(os, "mythtv_frontends", "gauge", "Known frontends");
+    os << "mythtv_frontends "
+       << docElem.firstChildElement("Frontends").attribute("count", "0")
+       << "\n";
+
+    metric_family(os, "mythtv_backends", "gauge", "Other known backends");
+    os << "mythtv_backends "
+       << docElem.firstChildElement("Backends").attribute("count", "0")
+       << "\n";
+
+    // Job queue ------------------------------
+
+    QMap<int, int> jobCounts;
+    QList<QDomElement> jobs =
+        child_elements(docElem.firstChildElement("JobQueue"), "Job");
+    for (const auto &e : qAsConst(jobs))
+        jobCounts[e.attribute("status").toInt()]++;
+
+    metric_family(os, "mythtv_jobqueue_jobs", "gauge",
+                  "Jobs that are queued, running, failed or recently "
+                  "finished, by status");
+    for (auto it = jobCounts.cbegin(); it != jobCounts.cend(); ++it)
+    {
+        os << "mythtv_jobqueue_jobs{status=" << metric_label(QString::number(it.key()))
+           << ",name=" << metric_label(JobQueue::StatusText(it.key()))
+           << "} " << *it << "\n";
+    }
+
+    // Storage --------------------------------
+
+    QDomElement mInfo   = docElem.firstChildElement("MachineInfo");
+    QList<QDomElement> groups =
+        child_elements(mInfo.firstChildElement("Storage"), "Group");
+
+    auto group_labels = [](const QDomElement &e)
+    {
+        return QString("{fsid=%1,dir=%2}")
+            .arg(metric_label(e.attribute("id")),
+                 metric_label(e.attribute("dir")));
+    };
+
+    // The status has the sizes in MiB
+    const std::array<std::pair<const char *, const char *>,3> sizes
+    {{
+        { "total", "Size of the storage group file system"           },
+        { "used" , "Space used on the storage group file system"     },
+        { "free" , "Space free on the storage group file system"     },
+    }};
+
+    for (const auto &size : sizes)
+    {
+        QString name = QString("mythtv_storage_%1_bytes").arg(size.first);
+        metric_family(os, name.toLatin1().constData(), "gauge", size.second);
+        for (const auto &e : qAsConst(groups))
+        {
+            os << name << group_labels(e) << " "
+               << (e.attribute(size.first).toLongLong() << 20) << "\n";
+        }
+    }
+
+    metric_family(os, "mythtv_storage_recordings_bytes", "gauge",
+                  "Space used by LiveTV, deleted and expirable recordings");
+    for (const auto &e : qAsConst(groups))
+    {
+        if (e.attribute("id") != "total")
+            continue;
+        for (const auto *kind : { "livetv", "deleted", "expirable" })
+        {
+            long long value = e.attribute(kind, "-1").toLongLong();
+            if (value >= 0)
+            {
+                os << "mythtv_storage_recordings_bytes{kind="
+                   << metric_label(kind) << "} " << (value << 20) << "\n";
+            }
+        }
+    }
+
+    // Load and guide data --------------------
+
+    QDomElement load = mInfo.firstChildElement("Load");
+    if (load.hasAttribute("avg1"))
+    {
+        metric_family(os, "mythtv_load_average", "gauge",
+                      "Load average of the backend host");
+        os << "mythtv_load_average{period=\"1m\"} "  << load.attribute("avg1") << "\n"
+           << "mythtv_load_average{period=\"5m\"} "  << load.attribute("avg2") << "\n"
+           << "mythtv_load_average{period=\"15m\"} " << load.attribute("avg3") << "\n";
+    }
+
+    QDomElement guide = mInfo.firstChildElement("Guide");
+    if (guide.hasAttribute("guideDays"))
+    {
+        metric_family(os, "mythtv_guide_days", "gauge",
+                      "Days of guide data left");
+        os << "mythtv_guide_days " << guide.attribute("guideDays") << "\n";
+    }
+
+    os.flush();
+    return metrics;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 //
 /////////////////////////////////////////////////////////////////////////////
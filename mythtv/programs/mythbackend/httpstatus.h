@@ -11,18 +11,22 @@
 #ifndef HTTPSTATUS_H_
 #define HTTPSTATUS_H_
 
+#include <QDateTime>
 #include <QDomDocument>
 #include <QMutex>
 #include <QMap>
+#include <QWaitCondition>
 
 #include "httpserver.h"
+#include "mthread.h"
 #include "programinfo.h"
 
 enum HttpStatusMethod
 {
     HSM_Unknown         =  0,
     HSM_GetStatusHTML   =  1,
-    HSM_GetStatusXML    =  2
+    HSM_GetStatusXML    =  2,
+    HSM_GetMetrics      =  3
 
 };
 
@@ -38,9 +42,34 @@ class Scheduler;
 class AutoExpire;
 class EncoderLink;
 class MainServer;
+class HttpStatus;
+
+class HttpStatusThread : public MThread
+{
+  public:
+    explicit HttpStatusThread(HttpStatus *p) : MThread("HttpStatus"), m_parent(p) {}
+    ~HttpStatusThread() override { wait(); }
+    void run(void) override; // MThread
+  private:
+    HttpStatus *m_parent;
+};
+
+/// \brief One rendering of the status, shared by every request until the
+///        next one replaces it.
+class HttpStatusSnapshot
+{
+  public:
+    QByteArray    m_xml;
+    QByteArray    m_html;
+    QByteArray    m_metrics;
+    QDateTime     m_built;
+    qint64        m_buildMs  { 0 };
+};
 
 class HttpStatus : public HttpServerExtension
 {
+    friend class HttpStatusThread;
+
     private:
 
         Scheduler                   *m_pSched;
@@ -51,14 +80,35 @@ class HttpStatus : public HttpServerExtension
         int                          m_nPreRollSeconds;
         QMutex                       m_settingLock;
 
+        // Status snapshot, rebuilt in the background
+        HttpStatusThread            *m_snapshotThread  { nullptr };
+        QMutex                       m_snapshotLock;
+        QWaitCondition               m_snapshotWait;
+        HttpStatusSnapshot           m_snapshot;        // protected by m_snapshotLock
+        bool                         m_snapshotDirty   { true };
+        bool                         m_snapshotRunning { false };
+        QMutex                       m_buildLock;
+
+        /// Rebuild at least this often, for load, storage and job changes
+        static constexpr int kSnapshotMaxAgeMs      = 30000;
+        /// Coalesce bursts of events into one rebuild
+        static constexpr int kSnapshotMinIntervalMs = 1000;
+
     private:
 
         static HttpStatusMethod GetMethod( const QString &sURI );
 
         void    GetStatusXML      ( HTTPRequest *pRequest );
         void    GetStatusHTML     ( HTTPRequest *pRequest );
+        void    GetMetrics        ( HTTPRequest *pRequest );
+
+        HttpStatusSnapshot GetSnapshot ( void );
+        void    BuildSnapshot     ( void );
+        void    RunSnapshot       ( void );
 
         void    FillStatusXML     ( QDomDocument *pDoc);
+
+        static QByteArray PrintMetrics ( QDomDocument *pDoc );
     
         static void    PrintStatus       ( QTextStream &os, QDomDocument *pDoc );
         static int     PrintEncoderStatus( QTextStream &os, const QDomElement& encoders );
@@ -83,14 +133,18 @@ class HttpStatus : public HttpServerExtension
     public:
                  HttpStatus( QMap<int, EncoderLink *> *tvList, Scheduler *sched,
                              AutoExpire *expirer, bool bIsMaster );
-        ~HttpStatus() override = default;
+        ~HttpStatus() override;
 
-        void     SetMainServer(MainServer *mainServer)
-                    { m_pMainServer = mainServer; }
+        void     SetMainServer(MainServer *mainServer);
+        void     StopSnapshot(void);
 
         QStringList GetBasePaths() override; // HttpServerExtension
         
         bool     ProcessRequest( HTTPRequest *pRequest ) override; // HttpServerExtension
+
+    protected:
+
+        void     customEvent( QEvent *e ) override; // QObject
 };
 
 #endif
@@ -59,6 +59,7 @@
 
 #include "mediaserver.h"
 #include "httpstatus.h"
+#include "statetopics.h"
 #include "mythlogging.h"
 
 #define LOC      QString("MythBackend: ")
@@ -259,6 +260,13 @@ void cleanup(void)
     delete housekeeping;
     housekeeping = nullptr;
 
+    delete stateTopics;
+    stateTopics = nullptr;
+
+    // Owned by the HTTP server, but reads from the scheduler and encoders
+    if (httpStatus)
+        httpStatus->StopSnapshot();
+
     if (gCoreContext)
     {
         delete gCoreContext->GetScheduler();
@@ -273,6 +281,7 @@ void cleanup(void)
 
     delete g_pUPnp;
     g_pUPnp = nullptr;
+    httpStatus = nullptr;
 
     if (SSDP::Instance())
     {
@@ -710,7 +719,6 @@ int run_backend(MythBackendCommandLineParser &cmdline)
     // Setup status server
     // ----------------------------------------------------------------------
 
-    HttpStatus *httpStatus = nullptr;
     HttpServer *pHS = g_pUPnp->GetHttpServer();
 
     if (pHS)
@@ -738,6 +746,9 @@ int run_backend(MythBackendCommandLineParser &cmdline)
     if (httpStatus && mainServer)
         httpStatus->SetMainServer(mainServer);
 
+    be_sd_notify("STATUS=Publishing WebSocket topics");
+    stateTopics = new StateTopics(&tvList, sched);
+
     be_sd_notify("STATUS=Check all storage groups");
     StorageGroup::CheckAllStorageGroupDirs();
 
@@ -10,8 +10,11 @@
 
 #include "mediaserver.h"
 #include "httpconfig.h"
+#include "httphls.h"
 #include "internetContent.h"
 #include "mythdirs.h"
+#include "mythcorecontext.h"
+#include "mythevent.h"
 #include "htmlserver.h"
 
 #include "upnpcdstv.h"
@@ -134,6 +137,7 @@ void MediaServer::Init(bool bIsMaster, bool bDisableUPnp /* = false */)
         new HtmlServerExtension(m_sSharePath + "html", "backend_");
     pHttpServer->RegisterExtension( pHtmlServer );
     pHttpServer->RegisterExtension( new HttpConfig() );
+    pHttpServer->RegisterExtension( new HttpHLS           ( m_sSharePath ));
     pHttpServer->RegisterExtension( new InternetContent   ( m_sSharePath ));
 
     pHttpServer->RegisterExtension( new MythServiceHost   ( m_sSharePath ));
@@ -254,11 +258,14 @@ void MediaServer::Init(bool bIsMaster, bool bDisableUPnp /* = false */)
             RegisterExtension(new UPnpCDSVideo());
         }
 
-#if 0
-        LOG(VB_UPNP, LOG_INFO, "MediaServer::Adding Context Listener");
+        // Changes to recordings, videos and music invalidate what the
+        // ContentDirectory has cached
+        if (m_pUPnpCDS != nullptr)
+        {
+            LOG(VB_UPNP, LOG_INFO, "MediaServer::Adding Context Listener");
 
-        gCoreContext->addListener( this );
-#endif
+            gCoreContext->addListener( this );
+        }
 
         Start();
 
@@ -289,9 +296,8 @@ MediaServer::~MediaServer()
 {
     // -=>TODO: Need to check to see if calling this more than once is ok.
 
-#if 0
-    gCoreContext->removeListener(this);
-#endif
+    if (m_pUPnpCDS != nullptr)
+        gCoreContext->removeListener(this);
 
     delete m_webSocketServer;
     delete m_pHttpServer;
@@ -304,18 +310,19 @@ MediaServer::~MediaServer()
 //////////////////////////////////////////////////////////////////////////////
 //
 //////////////////////////////////////////////////////////////////////////////
-#if 0
+
 void MediaServer::customEvent( QEvent *e )
 {
-    if (MythEvent::Type(e->type()) == MythEvent::MythEventMessage)
+    if (e->type() == MythEvent::MythEventMessage && m_pUPnpCDS != nullptr)
     {
-        MythEvent *me = static_cast<MythEvent *>(e);
-        QString message = me->Message();
+        auto *me = dynamic_cast<MythEvent *>(e);
+        if (me == nullptr)
+            return;
 
-        //-=>TODO: Need to handle events to notify clients of changes
+        m_pUPnpCDS->ContentChanged(me->Message());
     }
 }
-#endif
+
 //////////////////////////////////////////////////////////////////////////////
 //
 //////////////////////////////////////////////////////////////////////////////
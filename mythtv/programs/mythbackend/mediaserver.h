@@ -54,6 +54,10 @@ class MediaServer : public UPnp
         void     RegisterExtension  ( UPnpCDSExtension    *pExtension );
         void     UnregisterExtension( UPnpCDSExtension    *pExtension );
 
+    protected:
+
+        void     customEvent        ( QEvent *e ) override;
+
 };
 
 #endif // MEDIASERVER_H
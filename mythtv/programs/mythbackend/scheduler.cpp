@@ -46,6 +46,7 @@ using namespace std;
 #include "mythdb.h"
 #include "mythsystemevent.h"
 #include "mythlogging.h"
+#include "mythmetrics.h"
 #include "tv_rec.h"
 #include "jobqueue.h"
 
@@ -2438,6 +2439,24 @@ bool Scheduler::HandleReschedule(void)
         .arg(placeTime, 0, 'f', 2);
     LOG(VB_GENERAL, LOG_INFO, msg);
 
+    static const QString kRunHelp("Time taken by each phase of a reschedule");
+    static auto *s_matchTime = MythMetrics::Histogram(
+        "mythtv_scheduler_run_seconds", kRunHelp,
+        MythMetrics::Label("phase", "match"));
+    static auto *s_checkTime = MythMetrics::Histogram(
+        "mythtv_scheduler_run_seconds", kRunHelp,
+        MythMetrics::Label("phase", "check"));
+    static auto *s_placeTime = MythMetrics::Histogram(
+        "mythtv_scheduler_run_seconds", kRunHelp,
+        MythMetrics::Label("phase", "place"));
+    static auto *s_items = MythMetrics::Gauge(
+        "mythtv_scheduler_items", "Items placed by the last reschedule");
+
+    s_matchTime->Record(static_cast<uint64_t>(matchTime * 1000000));
+    s_checkTime->Record(static_cast<uint64_t>(checkTime * 1000000));
+    s_placeTime->Record(static_cast<uint64_t>(placeTime * 1000000));
+    s_items->Set(m_recList.size());
+
     // Write changed entries to oldrecorded.
     for (auto *p : m_recList)
     {
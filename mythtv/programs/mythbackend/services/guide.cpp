@@ -24,6 +24,8 @@
 //////////////////////////////////////////////////////////////////////////////
 
 #include <cmath>
+#include <utility>
+#include <vector>
 
 #include "guide.h"
 
@@ -37,10 +39,91 @@
 #include "storagegroup.h"
 
 #include "mythlogging.h"
+#include "serializers/serializer.h"
+#include "guidecache.h"
 
 extern AutoExpire  *expirer;
 extern Scheduler   *sched;
 
+/////////////////////////////////////////////////////////////////////////////
+// Builds the guide one channel at a time.  When the guide is only going to
+// be serialized this is attached to it as a cursor, so only one channel's
+// programs are in memory at once however long the guide is.
+/////////////////////////////////////////////////////////////////////////////
+
+class ProgramGuideCursor : public SerializerCursor
+{
+  public:
+    ProgramGuideCursor( ChannelInfoList chanList,
+                        const QDateTime &dtStartTime,
+                        const QDateTime &dtEndTime,
+                        bool bDetails )
+        : m_chanList(std::move(chanList)), m_bDetails(bDetails)
+    {
+        m_bindings[":STARTDATE"     ] = dtStartTime;
+        m_bindings[":STARTDATELIMIT"] = dtStartTime.addDays(-1);
+        m_bindings[":ENDDATE"       ] = dtEndTime;
+
+        // NOTE: Fetching this information directly from the schedule is
+        //       significantly faster than using ProgramInfo::LoadFromScheduler()
+        auto *scheduler = dynamic_cast<Scheduler*>(gCoreContext->GetScheduler());
+        if (scheduler)
+            scheduler->GetAllPending(m_schedList);
+    }
+
+    bool AtEnd(void) const { return m_nNext >= m_chanList.size(); }
+
+    void FillNext( DTC::ChannelInfo *pChannel )
+    {
+        const ChannelInfo &chan = m_chanList[m_nNext++];
+
+        FillChannelInfo( pChannel, chan, m_bDetails );
+
+        // Load the list of programmes for this channel
+        ProgramList  progList;
+        m_bindings[":CHANID"] = chan.m_chanId;
+        LoadFromProgram( progList, kWhere, kOrderBy, kOrderBy, m_bindings,
+                         m_schedList );
+
+        // Create Program objects and add them to the channel object
+        ProgramList::iterator progIt;
+        for( progIt = progList.begin(); progIt != progList.end(); ++progIt)
+        {
+            DTC::Program *pProgram = pChannel->AddNewProgram();
+            FillProgramInfo( pProgram, *progIt, false, m_bDetails, false ); // No cast info
+        }
+    }
+
+    QObject *Next(void) override // SerializerCursor
+    {
+        if (AtEnd())
+            return nullptr;
+
+        auto *pChannel = new DTC::ChannelInfo();
+        FillNext( pChannel );
+        return pChannel;
+    }
+
+  private:
+    static const QString kWhere;
+    static const QString kOrderBy;
+
+    ChannelInfoList m_chanList;
+    size_t          m_nNext    {0};
+    bool            m_bDetails {false};
+    MSqlBindings    m_bindings;
+    ProgramList     m_schedList;
+};
+
+const QString ProgramGuideCursor::kWhere =
+    "program.chanid = :CHANID "
+    "AND program.endtime >= :STARTDATE "
+    "AND program.starttime < :ENDDATE "
+    "AND program.starttime >= :STARTDATELIMIT "
+    "AND program.manualid = 0"; // Omit 'manual' recordings scheds
+
+const QString ProgramGuideCursor::kOrderBy = "program.starttime";
+
 /////////////////////////////////////////////////////////////////////////////
 //
 /////////////////////////////////////////////////////////////////////////////
@@ -85,64 +168,181 @@ DTC::ProgramGuide *Guide::GetProgramGuide( const QDateTime &rawStartTime,
                                                          nChannelGroupId);
 
     // ----------------------------------------------------------------------
-    // Build SQL statement for Program Listing
+    // Build Response
     // ----------------------------------------------------------------------
 
-    ProgramList  schedList;
-    MSqlBindings bindings;
+    auto *pGuide    = new DTC::ProgramGuide();
+    int   nChannels = chanList.size();
+    auto *pCursor   = new ProgramGuideCursor( std::move(chanList), dtStartTime,
+                                              dtEndTime, bDetails );
+
+    if (m_bLazyResults)
+        pCursor->Attach( pGuide, "Channels" );
+    else
+    {
+        while (!pCursor->AtEnd())
+            pCursor->FillNext( pGuide->AddNewChannel() );
 
-    QString sWhere   = "program.chanid = :CHANID "
-                       "AND program.endtime >= :STARTDATE "
-                       "AND program.starttime < :ENDDATE "
-                       "AND program.starttime >= :STARTDATELIMIT "
-                       "AND program.manualid = 0"; // Omit 'manual' recordings scheds
+        delete pCursor;
+    }
 
-#if 0
-    QString sGroupBy = "program.starttime, channel.channum,"
-                       "channel.callsign, program.title";
-#endif
+    // ----------------------------------------------------------------------
 
-    QString sOrderBy = "program.starttime";
+    pGuide->setStartTime    ( dtStartTime   );
+    pGuide->setEndTime      ( dtEndTime     );
+    pGuide->setDetails      ( bDetails      );
 
-    bindings[":STARTDATE"     ] = dtStartTime;
-    bindings[":STARTDATELIMIT"] = dtStartTime.addDays(-1);
-    bindings[":ENDDATE"       ] = dtEndTime;
+    pGuide->setStartIndex    ( nStartIndex     );
+    pGuide->setCount         ( nChannels       );
+    pGuide->setTotalAvailable( nTotalAvailable );
+    pGuide->setAsOf          ( MythDate::current() );
+
+    pGuide->setVersion      ( MYTH_BINARY_VERSION );
+    pGuide->setProtoVer     ( MYTH_PROTO_VERSION  );
+
+    return pGuide;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// The same channels and programs as GetProgramGuide without details, as
+// columns of numbers and string indexes.  The listings come from the
+// GuideCache, so only the channel list and recording status are read for
+// each request.
+/////////////////////////////////////////////////////////////////////////////
+
+DTC::CompactGuide *Guide::GetCompactGuide( const QDateTime &rawStartTime,
+                                           const QDateTime &rawEndTime,
+                                           int              nChannelGroupId,
+                                           bool             bWithInvisible)
+{
+    if (!rawStartTime.isValid())
+        throw QString( "StartTime is invalid" );
+
+    if (!rawEndTime.isValid())
+        throw QString( "EndTime is invalid" );
+
+    QDateTime dtStartTime = rawStartTime.toUTC();
+    QDateTime dtEndTime = rawEndTime.toUTC();
+
+    if (dtEndTime < dtStartTime)
+        throw QString( "EndTime is before StartTime");
+
+    qint64 nStart = dtStartTime.toSecsSinceEpoch();
+    qint64 nEnd   = dtEndTime.toSecsSinceEpoch();
+
+    uint nTotalAvailable = 0;
+    ChannelInfoList chanList = ChannelUtil::LoadChannels(0, 0,
+                                                         nTotalAvailable,
+                                                         !bWithInvisible,
+                                                         ChannelUtil::kChanOrderByChanNum,
+                                                         ChannelUtil::kChanGroupByCallsign,
+                                                         0,
+                                                         nChannelGroupId);
+
+    auto *pGuide = new DTC::CompactGuide();
+
+    QHash<QString, int> strings;
+    auto intern = [&strings, pGuide](const QString &str)
+    {
+        auto it = strings.constFind(str);
+        if (it != strings.constEnd())
+            return *it;
+        int index = pGuide->Strings().size();
+        pGuide->Strings().append(str);
+        strings.insert(str, index);
+        return index;
+    };
 
     // ----------------------------------------------------------------------
-    // Get all Pending Scheduled Programs
+    // Channel columns
     // ----------------------------------------------------------------------
 
-    // NOTE: Fetching this information directly from the schedule is
-    //       significantly faster than using ProgramInfo::LoadFromScheduler()
-    auto *scheduler = dynamic_cast<Scheduler*>(gCoreContext->GetScheduler());
-    if (scheduler)
-        scheduler->GetAllPending(schedList);
+    QHash<uint, int> chanIndex;
+    QMap<uint, bool> sources;
+
+    for (const auto & chan : qAsConst(chanList))
+    {
+        chanIndex.insert(chan.m_chanId, pGuide->ChanIds().size());
+        sources.insert(chan.m_sourceId, true);
+
+        pGuide->ChanIds()      .append(chan.m_chanId);
+        pGuide->ChanNums()     .append(intern(chan.m_chanNum));
+        pGuide->ChanCallSigns().append(intern(chan.m_callSign));
+        pGuide->ChanNames()    .append(intern(chan.m_name));
+    }
 
     // ----------------------------------------------------------------------
-    // Build Response
+    // Gather each channel's programs.  Like GetProgramGuide, programs that
+    // started more than a day before StartTime are left out.
     // ----------------------------------------------------------------------
 
-    auto *pGuide = new DTC::ProgramGuide();
+    std::vector<std::vector<const GuideCacheProgram *>> programs(chanList.size());
+    QList<GuideCacheDayPtr> days; // keeps the programs alive
 
-    ChannelInfoList::iterator chan_it;
-    for (chan_it = chanList.begin(); chan_it != chanList.end(); ++chan_it)
+    QDate firstDay = dtStartTime.addDays(-1).date();
+    QDate lastDay  = dtEndTime.date();
+
+    for (auto it = sources.cbegin(); it != sources.cend(); ++it)
     {
-        // Create ChannelInfo Object
-        DTC::ChannelInfo *pChannel = pGuide->AddNewChannel();
-        FillChannelInfo( pChannel, (*chan_it), bDetails );
+        for (QDate day = firstDay; day <= lastDay; day = day.addDays(1))
+        {
+            GuideCacheDayPtr pDay = GuideCache::GetInstance()->GetDay(it.key(), day);
+            days.append(pDay);
+
+            for (const auto & program : *pDay)
+            {
+                if (program.m_endTime < nStart || program.m_startTime >= nEnd ||
+                    program.m_startTime < nStart - (24 * 60 * 60))
+                    continue;
+
+                auto chan = chanIndex.constFind(program.m_chanId);
+                if (chan != chanIndex.constEnd())
+                    programs[*chan].push_back(&program);
+            }
+        }
+    }
 
-        // Load the list of programmes for this channel
-        ProgramList  progList;
-        bindings[":CHANID"] = (*chan_it).m_chanId;
-        LoadFromProgram( progList, sWhere, sOrderBy, sOrderBy, bindings,
-                         schedList );
+    // ----------------------------------------------------------------------
+    // Recording status isn't cached, it changes with every reschedule
+    // ----------------------------------------------------------------------
 
-        // Create Program objects and add them to the channel object
-        ProgramList::iterator progIt;
-        for( progIt = progList.begin(); progIt != progList.end(); ++progIt)
+    QHash<QPair<uint, qint64>, int> recStatus;
+    ProgramList schedList;
+    auto *scheduler = dynamic_cast<Scheduler*>(gCoreContext->GetScheduler());
+    if (scheduler)
+        scheduler->GetAllPending(schedList);
+
+    for (const auto *pInfo : schedList)
+    {
+        qint64 nSchedStart = pInfo->GetScheduledStartTime().toSecsSinceEpoch();
+        if (nSchedStart < nEnd &&
+            pInfo->GetScheduledEndTime().toSecsSinceEpoch() >= nStart)
         {
-            DTC::Program *pProgram = pChannel->AddNewProgram();
-            FillProgramInfo( pProgram, *progIt, false, bDetails, false ); // No cast info
+            recStatus.insert(qMakePair(pInfo->GetChanID(), nSchedStart),
+                             pInfo->GetRecordingStatus());
+        }
+    }
+
+    // ----------------------------------------------------------------------
+    // Program columns, channel by channel in start time order
+    // ----------------------------------------------------------------------
+
+    for (size_t i = 0; i < programs.size(); ++i)
+    {
+        for (const auto *pProgram : programs[i])
+        {
+            pGuide->ProgChannels() .append(static_cast<int>(i));
+            pGuide->ProgStarts()   .append(
+                static_cast<int>(pProgram->m_startTime - nStart));
+            pGuide->ProgDurations().append(
+                static_cast<int>(pProgram->m_endTime - pProgram->m_startTime));
+            pGuide->ProgTitles()   .append(intern(pProgram->m_title));
+            pGuide->ProgSubTitles().append(intern(pProgram->m_subtitle));
+            pGuide->ProgCategories().append(intern(pProgram->m_category));
+            pGuide->ProgRecStatus().append(
+                recStatus.value(qMakePair(pProgram->m_chanId,
+                                          pProgram->m_startTime),
+                                RecStatus::Unknown));
         }
     }
 
@@ -150,12 +350,9 @@ DTC::ProgramGuide *Guide::GetProgramGuide( const QDateTime &rawStartTime,
 
     pGuide->setStartTime    ( dtStartTime   );
     pGuide->setEndTime      ( dtEndTime     );
-    pGuide->setDetails      ( bDetails      );
-
-    pGuide->setStartIndex    ( nStartIndex     );
-    pGuide->setCount         ( chanList.size() );
-    pGuide->setTotalAvailable( nTotalAvailable );
-    pGuide->setAsOf          ( MythDate::current() );
+    pGuide->setChannelCount ( pGuide->ChanIds().size()      );
+    pGuide->setProgramCount ( pGuide->ProgChannels().size() );
+    pGuide->setAsOf         ( MythDate::current() );
 
     pGuide->setVersion      ( MYTH_BINARY_VERSION );
     pGuide->setProtoVer     ( MYTH_PROTO_VERSION  );
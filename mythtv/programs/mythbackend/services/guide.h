@@ -56,6 +56,11 @@ class Guide : public GuideServices
                                                   int              Count,
                                                   bool             WithInvisible) override; // GuideServices
 
+        DTC::CompactGuide*  GetCompactGuide     ( const QDateTime &StartTime  ,
+                                                  const QDateTime &EndTime    ,
+                                                  int              ChannelGroupId,
+                                                  bool             WithInvisible) override; // GuideServices
+
         DTC::ProgramList*   GetProgramList      ( int              StartIndex,
                                                   int              Count,
                                                   const QDateTime &StartTime  ,
@@ -139,6 +144,17 @@ class ScriptableGuide : public QObject
             )
         }
 
+        QObject* GetCompactGuide( const QDateTime &StartTime  ,
+                                  const QDateTime &EndTime    ,
+                                  int              ChannelGroupId,
+                                  bool             WithInvisible)
+        {
+            SCRIPT_CATCH_EXCEPTION( nullptr,
+                return m_obj.GetCompactGuide( StartTime, EndTime,
+                                              ChannelGroupId, WithInvisible );
+            )
+        }
+
         QObject* GetProgramList(int              StartIndex,
                                 int              Count,
                                 const QDateTime &StartTime,
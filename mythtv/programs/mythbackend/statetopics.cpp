@@ -0,0 +1,252 @@
+// Qt headers
+#include <QVariantMap>
+
+// MythTV headers
+#include "statetopics.h"
+#include "encoderlink.h"
+#include "mythcorecontext.h"
+#include "mythdate.h"
+#include "mythevent.h"
+#include "mythlogging.h"
+#include "scheduler.h"
+#include "tv_rec.h"
+#include "websocket_extensions/websocket_subscriptions.h"
+
+#define LOC QString("StateTopics: ")
+
+StateTopics::StateTopics(QMap<int, EncoderLink *> *tvList, Scheduler *sched)
+    : MThread("StateTopics"),
+      m_tvList(tvList), m_sched(sched)
+{
+    setObjectName("StateTopics");
+
+    if (m_sched)
+    {
+        m_upcoming  = WebSocketTopics::Add("Upcoming");
+        m_scheduler = WebSocketTopics::Add("Scheduler");
+    }
+    m_encoders = WebSocketTopics::Add("Encoders");
+    m_progress = WebSocketTopics::Add("RecordingProgress");
+
+    for (auto *topic : { m_upcoming, m_scheduler, m_encoders, m_progress })
+    {
+        if (topic == nullptr)
+            continue;
+        // Called on the subscriber's thread, which only needs to wake us
+        bool schedule = (topic == m_upcoming || topic == m_scheduler);
+        connect(topic, &WebSocketTopic::Subscribed, this,
+                [this, schedule]() { Wake(schedule, !schedule); },
+                Qt::DirectConnection);
+    }
+
+    gCoreContext->addListener(this);
+    start();
+}
+
+StateTopics::~StateTopics()
+{
+    gCoreContext->removeListener(this);
+
+    for (auto *topic : { m_upcoming, m_scheduler, m_encoders, m_progress })
+    {
+        if (topic != nullptr)
+            disconnect(topic, nullptr, this, nullptr);
+    }
+
+    {
+        QMutexLocker locker(&m_lock);
+        m_running = false;
+        m_wait.wakeAll();
+    }
+    wait();
+}
+
+void StateTopics::Wake(bool schedule, bool encoders)
+{
+    QMutexLocker locker(&m_lock);
+    m_scheduleChanged |= schedule;
+    m_encodersChanged |= encoders;
+    m_wait.wakeAll();
+}
+
+void StateTopics::customEvent(QEvent *e)
+{
+    if (e->type() != MythEvent::MythEventMessage)
+        return;
+
+    auto *me = dynamic_cast<MythEvent *>(e);
+    if (me == nullptr)
+        return;
+
+    const QString &message = me->Message();
+
+    if (message == "SCHEDULE_CHANGE")
+        Wake(true, false);
+    else if (message.startsWith("RECORDING_LIST_CHANGE") ||
+             message.startsWith("SYSTEM_EVENT REC_") ||
+             message.startsWith("SYSTEM_EVENT LIVETV_"))
+        Wake(false, true);
+}
+
+void StateTopics::run(void)
+{
+    RunProlog();
+
+    QMutexLocker locker(&m_lock);
+    while (m_running)
+    {
+        // The encoder topics are also polled, for recording progress and
+        // for slaves going to sleep, which send no events.
+        if (!m_scheduleChanged && !m_encodersChanged)
+            m_wait.wait(&m_lock, kPollIntervalMs);
+
+        if (!m_running)
+            break;
+
+        bool schedule = m_scheduleChanged;
+        m_scheduleChanged = false;
+        m_encodersChanged = false;
+
+        locker.unlock();
+        if (schedule)
+            PublishSchedule();
+        PublishEncoders();
+        locker.relock();
+    }
+    locker.unlock();
+
+    RunEpilog();
+}
+
+void StateTopics::PublishSchedule(void)
+{
+    if (m_sched == nullptr ||
+        (!m_upcoming->HasSubscribers() && !m_scheduler->HasSubscribers()))
+        return;
+
+    RecList recordingList;
+    m_sched->GetAllPending(recordingList);
+
+    QDateTime now = MythDate::current();
+    QVariantMap upcoming;
+    int willRecord = 0;
+    int recording  = 0;
+    int conflicts  = 0;
+    QDateTime next;
+
+    for (auto *pInfo : recordingList)
+    {
+        RecStatus::Type status = pInfo->GetRecordingStatus();
+        QDateTime start = pInfo->GetRecordingStartTime();
+
+        // The same selection as Dvr/GetUpcomingList
+        if (((status >= RecStatus::Pending && status <= RecStatus::WillRecord) ||
+             status == RecStatus::Recorded || status == RecStatus::Conflict) &&
+            pInfo->GetRecordingEndTime() > now)
+        {
+            QVariantMap item;
+            item["ChanId"]    = pInfo->GetChanID();
+            item["StartTime"] = start.toString(Qt::ISODate);
+            item["EndTime"]   = pInfo->GetRecordingEndTime().toString(Qt::ISODate);
+            item["Title"]     = pInfo->GetTitle();
+            item["SubTitle"]  = pInfo->GetSubtitle();
+            item["RecordId"]  = pInfo->GetRecordingRuleID();
+            item["InputId"]   = pInfo->GetInputID();
+            item["Priority"]  = pInfo->GetRecordingPriority();
+            item["Status"]    = static_cast<int>(status);
+
+            upcoming.insert(QString("%1_%2").arg(pInfo->GetChanID())
+                            .arg(start.toString(Qt::ISODate)), item);
+        }
+
+        if (status == RecStatus::WillRecord)
+        {
+            willRecord++;
+            if (!next.isValid() || start < next)
+                next = start;
+        }
+        else if (status == RecStatus::Recording || status == RecStatus::Tuning)
+        {
+            recording++;
+        }
+        else if (status == RecStatus::Conflict && pInfo->GetRecordingEndTime() > now)
+        {
+            conflicts++;
+        }
+
+        delete pInfo;
+    }
+
+    QVariantMap summary;
+    summary["WillRecord"]    = willRecord;
+    summary["Recording"]     = recording;
+    summary["Conflicts"]     = conflicts;
+    summary["NextRecording"] = next.toString(Qt::ISODate);
+
+    QVariantMap scheduler;
+    scheduler["Summary"] = summary;
+
+    m_upcoming->Publish(upcoming);
+    m_scheduler->Publish(scheduler);
+}
+
+void StateTopics::PublishEncoders(void)
+{
+    if (!m_encoders->HasSubscribers() && !m_progress->HasSubscribers())
+        return;
+
+    QVariantMap encoders;
+    QVariantMap progress;
+
+    TVRec::s_inputsLock.lockForRead();
+
+    for (auto *elink : qAsConst(*m_tvList))
+    {
+        if (elink == nullptr)
+            continue;
+
+        TVState state = elink->GetState();
+        QString key   = QString::number(elink->GetInputID());
+
+        QVariantMap encoder;
+        encoder["InputId"]     = elink->GetInputID();
+        encoder["HostName"]    = elink->IsLocal() ? gCoreContext->GetHostName()
+                                                  : elink->GetHostName();
+        encoder["Connected"]   = elink->IsConnected();
+        encoder["State"]       = static_cast<int>(state);
+        encoder["SleepStatus"] = static_cast<int>(elink->GetSleepStatus());
+
+        if (state == kState_WatchingLiveTV || state == kState_RecordingOnly ||
+            state == kState_WatchingRecording)
+        {
+            ProgramInfo *pInfo = elink->GetRecording();
+            if (pInfo)
+            {
+                encoder["ChanId"]    = pInfo->GetChanID();
+                encoder["StartTime"] =
+                    pInfo->GetRecordingStartTime().toString(Qt::ISODate);
+                encoder["Title"]     = pInfo->GetTitle();
+
+                QVariantMap item;
+                item["RecordedId"]    = pInfo->GetRecordingID();
+                item["ChanId"]        = pInfo->GetChanID();
+                item["StartTime"]     = encoder["StartTime"];
+                item["EndTime"]       =
+                    pInfo->GetRecordingEndTime().toString(Qt::ISODate);
+                item["Title"]         = pInfo->GetTitle();
+                item["FilePosition"]  = elink->GetFilePosition();
+                item["FramesWritten"] = elink->GetFramesWritten();
+                progress.insert(key, item);
+
+                delete pInfo;
+            }
+        }
+
+        encoders.insert(key, encoder);
+    }
+
+    TVRec::s_inputsLock.unlock();
+
+    m_encoders->Publish(encoders);
+    m_progress->Publish(progress);
+}
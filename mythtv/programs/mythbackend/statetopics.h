@@ -0,0 +1,66 @@
+// -*- Mode: c++ -*-
+
+#ifndef STATETOPICS_H
+#define STATETOPICS_H
+
+#include <QMap>
+#include <QMutex>
+#include <QObject>
+#include <QWaitCondition>
+
+#include "mthread.h"
+
+class EncoderLink;
+class Scheduler;
+class WebSocketTopic;
+
+/** \class StateTopics
+ *  \brief Publishes the backend state that clients used to poll for as
+ *         WebSocket topics.
+ *
+ *  Topics:
+ *
+ *   - Upcoming: the recordings Dvr/GetUpcomingList returns, keyed by
+ *     "<chanid>_<recording start time>".
+ *   - Scheduler: a summary of the last scheduler run.
+ *   - Encoders: the state of each encoder, keyed by input id.
+ *   - RecordingProgress: the progress of each recording, keyed by input id.
+ *
+ *  The schedule topics are refreshed when the scheduler has run, the
+ *  encoder topics when a recording starts or stops and every few seconds.
+ *  Nothing is refreshed while a topic has no subscribers; a new subscriber
+ *  triggers a refresh, so the snapshot it gets is corrected straight away.
+ */
+class StateTopics : public QObject, public MThread
+{
+  public:
+    StateTopics(QMap<int, EncoderLink *> *tvList, Scheduler *sched);
+    ~StateTopics() override;
+
+    static constexpr int kPollIntervalMs = 5000;
+
+  protected:
+    void run(void) override; // MThread
+    void customEvent(QEvent *e) override; // QObject
+
+  private:
+    void Wake(bool schedule, bool encoders);
+    void PublishSchedule(void);
+    void PublishEncoders(void);
+
+    QMap<int, EncoderLink *> *m_tvList;
+    Scheduler                *m_sched;
+
+    WebSocketTopic *m_upcoming  {nullptr};
+    WebSocketTopic *m_scheduler {nullptr};
+    WebSocketTopic *m_encoders  {nullptr};
+    WebSocketTopic *m_progress  {nullptr};
+
+    QMutex          m_lock;
+    QWaitCondition  m_wait;
+    bool            m_running         {true};  // protected by m_lock
+    bool            m_scheduleChanged {true};  // protected by m_lock
+    bool            m_encodersChanged {true};  // protected by m_lock
+};
+
+#endif // STATETOPICS_H
@@ -71,6 +71,9 @@ UPnpCDSMusic::UPnpCDSMusic()
     m_shortcuts.insert(UPnPShortcutFeature::MUSIC_ALBUMS, "Music/Album");
     m_shortcuts.insert(UPnPShortcutFeature::MUSIC_ARTISTS, "Music/Artist");
     m_shortcuts.insert(UPnPShortcutFeature::MUSIC_GENRES, "Music/Genre");
+
+    // Events that change what we list
+    m_changeEvents << "MUSIC_SCANNER_FINISHED" << "MUSIC_METADATA_CHANGED";
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -328,8 +331,7 @@ bool UPnpCDSMusic::LoadChildren(const UPnpCDSRequest* pRequest,
     if (currentToken.isEmpty() || currentToken == m_sExtensionId.toLower())
     {
         // Root
-        pResults->Add(GetRoot()->GetChildren());
-        pResults->m_nTotalMatches = GetRoot()->GetChildCount();
+        LoadRootChildren(pRequest, pResults);
         return true;
     }
     if (currentToken == "track")
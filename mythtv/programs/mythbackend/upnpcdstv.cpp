@@ -142,6 +142,9 @@ UPnpCDSTv::UPnpCDSTv()
 
     // ShortCuts
     m_shortcuts.insert(UPnPShortcutFeature::VIDEOS_RECORDINGS, "Recordings");
+
+    // Events that change what we list
+    m_changeEvents << "RECORDING_LIST_CHANGE";
 }
 
 void UPnpCDSTv::CreateRoot()
@@ -357,8 +360,7 @@ bool UPnpCDSTv::LoadChildren(const UPnpCDSRequest* pRequest,
     if (currentToken.isEmpty() || currentToken == m_sExtensionId.toLower())
     {
         // Root
-        pResults->Add(GetRoot()->GetChildren());
-        pResults->m_nTotalMatches = GetRoot()->GetChildCount();
+        LoadRootChildren(pRequest, pResults);
         return true;
     }
     if (currentToken == "title")
@@ -38,6 +38,9 @@ UPnpCDSVideo::UPnpCDSVideo()
     m_shortcuts.insert(UPnPShortcutFeature::VIDEOS, "Videos");
     m_shortcuts.insert(UPnPShortcutFeature::VIDEOS_ALL, "Videos/Video");
     m_shortcuts.insert(UPnPShortcutFeature::VIDEOS_GENRES, "Videos/Genre");
+
+    // Events that change what we list
+    m_changeEvents << "VIDEO_LIST_CHANGE";
 }
 
 void UPnpCDSVideo::CreateRoot()
@@ -326,8 +329,7 @@ bool UPnpCDSVideo::LoadChildren(const UPnpCDSRequest* pRequest,
     if (currentToken.isEmpty() || currentToken == m_sExtensionId.toLower())
     {
         // Root
-        pResults->Add(GetRoot()->GetChildren());
-        pResults->m_nTotalMatches = GetRoot()->GetChildCount();
+        LoadRootChildren(pRequest, pResults);
         return true;
     }
     if (currentToken == "series")
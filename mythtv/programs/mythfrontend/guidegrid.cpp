@@ -277,6 +277,15 @@ public:
             return false;
         }
 
+        // Load the rows that aren't cached with a single query
+        QVector<int> missing;
+        for (unsigned int i = 0; i < m_numRows; ++i)
+        {
+            if (!m_proglists[i])
+                missing.push_back(m_chanNums[i]);
+        }
+        m_guide->cacheProgramLists(missing);
+
         for (unsigned int i = 0; i < m_numRows; ++i)
         {
             unsigned int row = i + m_firstRow;
@@ -343,6 +352,32 @@ public:
     QVector<bool> m_unavailables;
 };
 
+class GuidePrefetch : public GuideUpdaterBase
+{
+public:
+    GuidePrefetch(GuideGrid *guide, uint startChan,
+                  QDateTime startTime, QDateTime endTime)
+        : GuideUpdaterBase(guide), m_currentStartChannel(startChan),
+          m_currentStartTime(std::move(startTime)),
+          m_currentEndTime(std::move(endTime)) {}
+    bool ExecuteNonUI(void) override // GuideUpdaterBase
+    {
+        if (m_currentStartChannel == m_guide->GetCurrentStartChannel() &&
+            m_currentStartTime == m_guide->GetCurrentStartTime())
+        {
+            m_guide->prefetchProgramLists(m_currentStartChannel,
+                                          m_currentStartTime,
+                                          m_currentEndTime);
+        }
+        // Nothing to show, the programs are waiting in the cache
+        return false;
+    }
+    void ExecuteUI(void) override {} // GuideUpdaterBase
+    const uint m_currentStartChannel;
+    const QDateTime m_currentStartTime;
+    const QDateTime m_currentEndTime;
+};
+
 class UpdateGuideEvent : public QEvent
 {
 public:
@@ -586,6 +621,7 @@ void GuideGrid::Load(void)
     setStartChannel((int)(m_currentStartChannel) - (m_channelCount / 2));
     m_channelCount = min(m_channelCount, maxchannel + 1);
 
+    QVector<int> chanNums;
     for (int y = 0; y < m_channelCount; ++y)
     {
         int chanNum = y + m_currentStartChannel;
@@ -597,8 +633,14 @@ void GuideGrid::Load(void)
         if (chanNum < 0)
             chanNum = 0;
 
+        chanNums.push_back(chanNum);
+    }
+    cacheProgramLists(chanNums);
+
+    for (int y = 0; y < chanNums.size(); ++y)
+    {
         delete m_programs[y];
-        m_programs[y] = getProgramListFromProgram(chanNum);
+        m_programs[y] = getProgramListFromProgram(chanNums[y]);
     }
 }
 
@@ -1530,9 +1572,221 @@ void GuideGrid::fillProgramInfos(bool useExistingData)
     fillProgramRowInfos(-1, useExistingData);
 }
 
-ProgramList *GuideGrid::getProgramListFromProgram(int chanNum)
+/// \brief Returns a copy of the cached programs on \p chanid between \p start
+///        and \p end, or nullptr when they haven't been loaded.
+ProgramList *GuideProgramCache::Find(uint chanid, const QDateTime &start,
+                                     const QDateTime &end)
 {
+    QMutexLocker locker(&m_lock);
+
+    Entry *entry = FindEntry(chanid, start, end);
+    if (!entry)
+        return nullptr;
+
+    // The same programs the database would return for this window,
+    // copied since the guide marks them up for its layout
     auto *proglist = new ProgramList();
+    QDateTime startLimit = start.addDays(-1);
+    for (auto *pi : entry->m_programs)
+    {
+        if (pi->GetScheduledEndTime() >= start &&
+            pi->GetScheduledStartTime() <= end &&
+            pi->GetScheduledStartTime() >= startLimit)
+        {
+            proglist->push_back(new ProgramInfo(*pi));
+        }
+    }
+    return proglist;
+}
+
+bool GuideProgramCache::Contains(uint chanid, const QDateTime &start,
+                                 const QDateTime &end)
+{
+    QMutexLocker locker(&m_lock);
+    return FindEntry(chanid, start, end) != nullptr;
+}
+
+GuideProgramCache::Entry *GuideProgramCache::FindEntry(
+    uint chanid, const QDateTime &start, const QDateTime &end)
+{
+    Entry *entry = m_entries.object(chanid);
+    if (!entry || start < entry->m_start || end > entry->m_end ||
+        entry->m_loaded.secsTo(MythDate::current()) > kMaxAgeSecs)
+    {
+        return nullptr;
+    }
+    return entry;
+}
+
+/**
+ *  \brief Loads the programs on \p chanids with a single query, for the
+ *         times from \p start to \p end widened by some hours, most of them
+ *         in \p timeDirection.
+ */
+void GuideProgramCache::Load(const QVector<uint> &chanids,
+                             const QDateTime &start, const QDateTime &end,
+                             int timeDirection, const ProgramList &schedList)
+{
+    if (chanids.empty())
+        return;
+
+    int before = (timeDirection < 0) ? kHoursAhead : kHoursBehind;
+    int after  = (timeDirection < 0) ? kHoursBehind : kHoursAhead;
+    QDateTime windowStart = start.addSecs(-60LL * 60 * before);
+    QDateTime windowEnd   = end.addSecs(60LL * 60 * after);
+
+    m_lock.lock();
+    uint generation = m_generation;
+    m_lock.unlock();
+
+    MSqlBindings bindings;
+    QStringList placeholders;
+    for (int i = 0; i < chanids.size(); ++i)
+    {
+        placeholders << QString(":CHANID%1").arg(i, 3, 10, QChar('0'));
+        bindings[placeholders.back()] = chanids[i];
+    }
+    QString where = QString(
+        "program.chanid IN (%1)            AND "
+        "program.endtime   >= :STARTTS      AND "
+        "program.starttime <= :ENDTS        AND "
+        "program.starttime >= :STARTLIMITTS AND "
+        "program.manualid   = 0 ").arg(placeholders.join(","));
+    bindings[":STARTTS"] = windowStart;
+    bindings[":STARTLIMITTS"] = windowStart.addDays(-1);
+    bindings[":ENDTS"] = windowEnd;
+
+    // Grouped like the single channel query, so each channel gets the
+    // same programs it would have on its own
+    ProgramList programs(false);
+    LoadFromProgram(programs, where,
+                    "program.chanid, program.starttime, program.title",
+                    "program.chanid, program.starttime",
+                    bindings, schedList);
+
+    QHash<uint, Entry *> loaded;
+    QDateTime now = MythDate::current();
+    for (uint chanid : chanids)
+    {
+        auto *entry = new Entry;
+        entry->m_start  = windowStart;
+        entry->m_end    = windowEnd;
+        entry->m_loaded = now;
+        loaded[chanid]  = entry;
+    }
+    for (auto *pi : programs)
+    {
+        Entry *entry = loaded.value(pi->GetChanID());
+        if (entry)
+            entry->m_programs.push_back(pi);
+        else
+            delete pi;
+    }
+
+    QMutexLocker locker(&m_lock);
+    for (auto it = loaded.cbegin(); it != loaded.cend(); ++it)
+    {
+        // Loaded with the old schedule, Clear() was called meanwhile
+        if (generation != m_generation)
+            delete it.value();
+        else
+            m_entries.insert(it.key(), it.value(),
+                             1 + static_cast<int>(it.value()->m_programs.size()));
+    }
+}
+
+/// \brief Drops everything, e.g. when the recording schedule changed
+void GuideProgramCache::Clear(void)
+{
+    QMutexLocker locker(&m_lock);
+    m_entries.clear();
+    ++m_generation;
+}
+
+/// \brief Loads the programs of the channels \p chanNums that aren't cached
+///        for the visible times, with a single query.
+void GuideGrid::cacheProgramLists(const QVector<int> &chanNums)
+{
+    QDateTime starttime = m_currentStartTime.addSecs(0 - m_currentStartTime.time().second());
+    QDateTime endtime = m_currentEndTime.addSecs(0 - m_currentEndTime.time().second());
+
+    QVector<uint> chanids;
+    for (int chanNum : chanNums)
+    {
+        uint chanid = GetChannelInfo(chanNum)->m_chanId;
+        if (!m_programCache.Contains(chanid, starttime, endtime))
+            chanids.push_back(chanid);
+    }
+
+    m_programCache.Load(chanids, starttime, endtime, m_timeDirection,
+                        m_recList);
+}
+
+/**
+ *  \brief Loads the page of channels beyond the viewport in the direction
+ *         of the last move and, after a move in time, the next page of
+ *         times for the visible channels.
+ */
+void GuideGrid::prefetchProgramLists(uint startChannel, const QDateTime &start,
+                                     const QDateTime &end)
+{
+    int count = (int)GetChannelCount();
+    if (count == 0)
+        return;
+
+    QDateTime starttime = start.addSecs(0 - start.time().second());
+    QDateTime endtime = end.addSecs(0 - end.time().second());
+    int rows = min(m_channelCount, count);
+
+    QVector<uint> chanids;
+    int first = (int)startChannel + ((m_channelDirection < 0) ? -rows : rows);
+    for (int i = 0; i < rows; ++i)
+    {
+        int chanNum = (((first + i) % count) + count) % count;
+        uint chanid = GetChannelInfo(chanNum)->m_chanId;
+        if (!m_programCache.Contains(chanid, starttime, endtime))
+            chanids.push_back(chanid);
+    }
+    m_programCache.Load(chanids, starttime, endtime, m_timeDirection,
+                        m_recList);
+
+    if (m_timeDirection == 0)
+        return;
+
+    qint64 span = starttime.secsTo(endtime) * m_timeDirection;
+    QDateTime nextStart = starttime.addSecs(span);
+    QDateTime nextEnd = endtime.addSecs(span);
+
+    chanids.clear();
+    for (int i = 0; i < rows; ++i)
+    {
+        int chanNum = ((int)startChannel + i) % count;
+        uint chanid = GetChannelInfo(chanNum)->m_chanId;
+        if (!m_programCache.Contains(chanid, nextStart, nextEnd))
+            chanids.push_back(chanid);
+    }
+    m_programCache.Load(chanids, min(starttime, nextStart),
+                        max(endtime, nextEnd), m_timeDirection, m_recList);
+}
+
+ProgramList *GuideGrid::getProgramListFromProgram(int chanNum)
+{
+    QDateTime starttime = m_currentStartTime.addSecs(0 - m_currentStartTime.time().second());
+    QDateTime endtime = m_currentEndTime.addSecs(0 - m_currentEndTime.time().second());
+    uint chanid = GetChannelInfo(chanNum)->m_chanId;
+
+    ProgramList *proglist = m_programCache.Find(chanid, starttime, endtime);
+    if (!proglist)
+    {
+        m_programCache.Load({chanid}, starttime, endtime, m_timeDirection,
+                            m_recList);
+        proglist = m_programCache.Find(chanid, starttime, endtime);
+    }
+    if (proglist)
+        return proglist;
+
+    // Not cached, e.g. the schedule changed while loading
+    proglist = new ProgramList();
 
     if (proglist)
     {
@@ -1866,6 +2120,7 @@ void GuideGrid::customEvent(QEvent *event)
         if (message == "SCHEDULE_CHANGE")
         {
             GuideHelper::Wait(this);
+            m_programCache.Clear();
             LoadFromScheduler(m_recList);
             fillProgramInfos();
         }
@@ -2053,6 +2308,15 @@ void GuideGrid::updateProgramsUI(unsigned int firstRow, unsigned int numRows,
             m_programs[row] = proglists[i];
         }
     }
+
+    // Whole pages are followed by loading the next one into the cache
+    if (numRows > 1)
+    {
+        auto *prefetch = new GuidePrefetch(this, m_currentStartChannel,
+                                           m_currentStartTime,
+                                           m_currentEndTime);
+        m_threadPool.start(new GuideHelper(this, prefetch), "GuideHelper");
+    }
     m_guideGrid->SetProgPast(progPast);
     for (const auto & r : elements)
     {
@@ -2247,6 +2511,10 @@ void GuideGrid::generateListings()
     m_currentStartChannel = 0;
     m_currentRow = 0;
 
+    // Background prefetches read the channel list and the recording list
+    GuideHelper::Wait(this);
+    m_programCache.Clear();
+
     int maxchannel = 0;
     fillChannelInfos();
     maxchannel = max((int)GetChannelCount() - 1, 0);
@@ -2459,6 +2727,18 @@ void GuideGrid::moveLeftRight(MoveVector movement)
             break;
     }
 
+    switch (movement)
+    {
+        case kScrollLeft :
+        case kPageLeft :
+        case kDayLeft :
+            m_timeDirection = -1;
+            break;
+        default :
+            m_timeDirection = 1;
+            break;
+    }
+
     fillTimeInfos();
     fillProgramInfos();
     updateDateText();
@@ -2484,6 +2764,9 @@ void GuideGrid::moveUpDown(MoveVector movement)
             break;
     }
 
+    m_channelDirection =
+        (movement == kScrollUp || movement == kPageUp) ? -1 : 1;
+
     fillProgramInfos();
     updateChannels();
 }
@@ -10,9 +10,11 @@ using namespace std;
 
 // qt
 #include <QString>
+#include <QCache>
 #include <QDateTime>
 #include <QEvent>
 #include <QLinkedList>
+#include <QMutex>
 
 // myth
 #include "mythscreentype.h"
@@ -102,6 +104,48 @@ public:
     const bool m_selected;
 };
 
+// GuideProgramCache keeps the programs of the channels around the
+// viewport for a window of hours around the visible times, so paging
+// through the guide doesn't wait on the database. It is loaded in the
+// background, one query for many channels, ahead of the viewport in the
+// direction the guide was last moved.
+class GuideProgramCache
+{
+  public:
+    ProgramList *Find(uint chanid, const QDateTime &start,
+                      const QDateTime &end);
+    bool Contains(uint chanid, const QDateTime &start,
+                  const QDateTime &end);
+    void Load(const QVector<uint> &chanids, const QDateTime &start,
+              const QDateTime &end, int timeDirection,
+              const ProgramList &schedList);
+    void Clear(void);
+
+  private:
+    class Entry
+    {
+      public:
+        QDateTime   m_start;
+        QDateTime   m_end;
+        QDateTime   m_loaded;
+        ProgramList m_programs;
+    };
+
+    Entry *FindEntry(uint chanid, const QDateTime &start,
+                     const QDateTime &end);
+
+    /// Hours loaded beyond the viewport in the direction of travel
+    static constexpr int kHoursAhead  = 6;
+    /// Hours loaded beyond the viewport behind it
+    static constexpr int kHoursBehind = 2;
+    /// Reload entries older than this, for new listings
+    static constexpr int kMaxAgeSecs  = 15 * 60;
+
+    QMutex               m_lock;
+    QCache<uint, Entry>  m_entries   {20000}; // cost is the program count
+    uint                 m_generation {0};
+};
+
 class GuideGrid : public ScheduleCommon, public JumpToChannelListener
 {
     Q_OBJECT;
@@ -216,6 +260,9 @@ class GuideGrid : public ScheduleCommon, public JumpToChannelListener
 public:
     // These need to be public so that the helper classes can operate.
     ProgramList *getProgramListFromProgram(int chanNum);
+    void cacheProgramLists(const QVector<int> &chanNums);
+    void prefetchProgramLists(uint startChannel, const QDateTime &start,
+                              const QDateTime &end);
     void updateProgramsUI(unsigned int firstRow, unsigned int numRows,
                           int progPast,
                           const QVector<ProgramList*> &proglists,
@@ -248,11 +295,15 @@ private:
     vector<ProgramList*> m_programs;
     ProgInfoGuideArray m_programInfos {};
     ProgramList  m_recList;
+    GuideProgramCache m_programCache;
 
     QDateTime m_originalStartTime;
     QDateTime m_currentStartTime;
     QDateTime m_currentEndTime;
     uint      m_currentStartChannel       {0};
+    // Sign of the last move, to prefetch in that direction
+    int       m_channelDirection          {0};
+    int       m_timeDirection             {0};
     uint      m_startChanID;
     QString   m_startChanNum;
 
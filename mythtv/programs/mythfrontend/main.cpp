@@ -495,8 +495,11 @@ static void startSearchTime(void)
 static void startManaged(void)
 {
     MythScreenStack *mainStack = GetMythMainWindow()->GetMainStack();
+    if (mainStack->ShowCachedScreen("ViewScheduled"))
+        return;
 
     auto *viewsched = new ViewScheduled(mainStack);
+    viewsched->SetCacheable(true);
 
     if (viewsched->Create())
         mainStack->AddScreen(viewsched);
@@ -543,6 +546,8 @@ static void startCustomPriority(void)
 static void startPlaybackWithGroup(const QString& recGroup = "")
 {
     MythScreenStack *mainStack = GetMythMainWindow()->GetMainStack();
+    if (recGroup.isEmpty() && mainStack->ShowCachedScreen("playbackbox"))
+        return;
 
     auto *pbb = new PlaybackBox(mainStack, "playbackbox");
 
@@ -550,6 +555,8 @@ static void startPlaybackWithGroup(const QString& recGroup = "")
     {
         if (!recGroup.isEmpty())
             pbb->setInitialRecGroup(recGroup);
+        else
+            pbb->SetCacheable(true);
 
         mainStack->AddScreen(pbb);
     }
@@ -1224,7 +1231,14 @@ static bool RunMenu(const QString& themedir, const QString& themename)
         LOG(VB_GENERAL, LOG_NOTICE, QString("Found mainmenu.xml for theme '%1'")
                 .arg(themename));
         g_menu->setCallback(TVMenuCallback, gContext);
-        GetMythMainWindow()->GetMainStack()->AddScreen(g_menu);
+        MythScreenStack *mainStack = GetMythMainWindow()->GetMainStack();
+        mainStack->AddScreen(g_menu);
+
+        // Screens worth loading while the menu sits idle
+        mainStack->RegisterPreload("playbackbox", [](MythScreenStack *stack)
+            -> MythScreenType * { return new PlaybackBox(stack, "playbackbox"); });
+        mainStack->RegisterPreload("ViewScheduled", [](MythScreenStack *stack)
+            -> MythScreenType * { return new ViewScheduled(stack); });
         return true;
     }
 
@@ -1524,6 +1538,15 @@ static void setDebugShowNames(void)
         GetMythMainWindow()->GetMainStack()->GetTopScreen()->SetRedraw();
 }
 
+static void setDebugShowRedraws(void)
+{
+    MythPainter *p = GetMythPainter();
+    p->SetShowRedraws(!p->ShowRedraws());
+
+    if (GetMythMainWindow()->GetMainStack()->GetTopScreen())
+        GetMythMainWindow()->GetMainStack()->GetTopScreen()->SetRedraw();
+}
+
 static void InitJumpPoints(void)
 {
      REG_JUMP(QT_TRANSLATE_NOOP("MythControls", "Reload Theme"),
@@ -1578,6 +1601,8 @@ static void InitJumpPoints(void)
          "", "", setDebugShowBorders, false);
      REG_JUMPEX(QT_TRANSLATE_NOOP("MythControls", "Toggle Show Widget Names"),
          "", "", setDebugShowNames, false);
+     REG_JUMPEX(QT_TRANSLATE_NOOP("MythControls", "Toggle Show Redraw Regions"),
+         "", "", setDebugShowRedraws, false);
      REG_JUMPEX(QT_TRANSLATE_NOOP("MythControls", "Reset All Keys"),
          QT_TRANSLATE_NOOP("MythControls", "Reset all keys to defaults"),
          "", resetAllKeys, false);
@@ -31,7 +31,7 @@ QMAKE_CLEAN += $(TARGET)
 HEADERS += playbackbox.h viewscheduled.h globalsettings.h audiogeneralsettings.h
 HEADERS += manualschedule.h programrecpriority.h channelrecpriority.h
 HEADERS += statusbox.h networkcontrol.h custompriority.h
-HEADERS += mediarenderer.h mythfexml.h playbackboxlistitem.h
+HEADERS += mediarenderer.h mythfexml.h
 HEADERS += exitprompt.h
 HEADERS += action.h mythcontrols.h keybindings.h keygrabber.h
 HEADERS += progfind.h guidegrid.h customedit.h
@@ -57,7 +57,7 @@ HEADERS += settingshelper.h
 SOURCES += main.cpp playbackbox.cpp viewscheduled.cpp audiogeneralsettings.cpp
 SOURCES += globalsettings.cpp manualschedule.cpp programrecpriority.cpp
 SOURCES += channelrecpriority.cpp statusbox.cpp networkcontrol.cpp
-SOURCES += mediarenderer.cpp mythfexml.cpp playbackboxlistitem.cpp
+SOURCES += mediarenderer.cpp mythfexml.cpp
 SOURCES += custompriority.cpp exitprompt.cpp
 SOURCES += action.cpp actionset.cpp  mythcontrols.cpp keybindings.cpp
 SOURCES += keygrabber.cpp progfind.cpp guidegrid.cpp
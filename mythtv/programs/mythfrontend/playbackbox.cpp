@@ -1,6 +1,7 @@
 #include "playbackbox.h"
 
 // C++
+#include <algorithm>
 #include <array>
 
 // QT
@@ -47,9 +48,6 @@
 #  include "compat.h"                   // for random
 #endif
 
-//  Mythfrontend
-#include "playbackboxlistitem.h"
-
 #define LOC      QString("PlaybackBox: ")
 #define LOC_WARN QString("PlaybackBox Warning: ")
 #define LOC_ERR  QString("PlaybackBox Error: ")
@@ -201,6 +199,36 @@ static bool comp_season_rev_less_than(
     return comp_season_rev(a, b) < 0;
 }
 
+using ProgramLessThan = bool (*)(const ProgramInfo *, const ProgramInfo *);
+
+/// Returns the episode order of the "PlayBoxEpisodeSort" setting, or nullptr
+/// if the episodes are left in recording order
+static ProgramLessThan episode_sort_less_than(
+    const QString &episodeSort, int listOrder)
+{
+    if (episodeSort == "OrigAirDate")
+    {
+        return (listOrder == 0) ? comp_originalAirDate_rev_less_than :
+                                  comp_originalAirDate_less_than;
+    }
+    if (episodeSort == "Id")
+    {
+        return (listOrder == 0) ? comp_programid_rev_less_than :
+                                  comp_programid_less_than;
+    }
+    if (episodeSort == "Date")
+    {
+        return (listOrder == 0) ? comp_recordDate_rev_less_than :
+                                  comp_recordDate_less_than;
+    }
+    if (episodeSort == "Season")
+    {
+        return (listOrder == 0) ? comp_season_rev_less_than :
+                                  comp_season_less_than;
+    }
+    return nullptr;
+}
+
 static const std::array<const uint,3> s_artDelay
     { kArtworkFanTimeout, kArtworkBannerTimeout, kArtworkCoverTimeout,};
 
@@ -535,8 +563,6 @@ bool PlaybackBox::Create()
             SLOT(PlayFromBookmarkOrProgStart(MythUIButtonListItem*)));
     connect(m_recordingList, SIGNAL(itemVisible(MythUIButtonListItem*)),
             SLOT(ItemVisible(MythUIButtonListItem*)));
-    connect(m_recordingList, SIGNAL(itemLoaded(MythUIButtonListItem*)),
-            SLOT(ItemLoaded(MythUIButtonListItem*)));
 
     // connect up timers...
     connect(m_artTimer[kArtworkFanart],   SIGNAL(timeout()), SLOT(fanartLoad()));
@@ -1015,6 +1041,12 @@ void PlaybackBox::ItemLoaded(MythUIButtonListItem *item)
 
 }
 
+void PlaybackBox::FillItem(MythUIButtonListItem *item, int /*index*/)
+{
+    // The row's ProgramInfo was set by updateRecList()
+    ItemLoaded(item);
+}
+
 void PlaybackBox::ItemVisible(MythUIButtonListItem *item)
 {
     auto *pginfo = item->GetData().value<ProgramInfo*>();
@@ -1482,15 +1514,18 @@ void PlaybackBox::updateRecList(MythUIButtonListItem *sel_item)
 
     ProgramList &progList = *pmit;
 
+    QVariantList rows;
     for (auto & prog : progList)
     {
         if (prog->GetAvailableStatus() == asPendingDelete ||
             prog->GetAvailableStatus() == asDeleted)
             continue;
 
-        new PlaybackBoxListItem(this, m_recordingList, prog);
+        rows.append(QVariant::fromValue(prog));
     }
-    m_recordingList->LoadInBackground();
+
+    // Rows are filled by FillItem() as they are shown
+    m_recordingList->SetProvider(this, rows);
 
     if (m_noRecordingsText)
     {
@@ -1528,15 +1563,13 @@ static bool save_position(
     int curPos = recordingList->GetCurrentPos();
     for (int i = curPos; (i >= 0) && (i < recordingList->GetCount()); i++)
     {
-        MythUIButtonListItem *item = recordingList->GetItemAt(i);
-        auto *pginfo = item->GetData().value<ProgramInfo*>();
+        auto *pginfo = recordingList->GetDataAt(i).value<ProgramInfo*>();
         itemSelPref.push_back(groupSelPref.front());
         itemSelPref.push_back(QString::number(pginfo->GetRecordingID()));
     }
     for (int i = curPos; (i >= 0) && (i < recordingList->GetCount()); i--)
     {
-        MythUIButtonListItem *item = recordingList->GetItemAt(i);
-        auto *pginfo = item->GetData().value<ProgramInfo*>();
+        auto *pginfo = recordingList->GetDataAt(i).value<ProgramInfo*>();
         itemSelPref.push_back(groupSelPref.front());
         itemSelPref.push_back(QString::number(pginfo->GetRecordingID()));
     }
@@ -1546,8 +1579,7 @@ static bool save_position(
     {
         if (i >= 0 && i < recordingList->GetCount())
         {
-            MythUIButtonListItem *item = recordingList->GetItemAt(i);
-            auto *pginfo = item->GetData().value<ProgramInfo*>();
+            auto *pginfo = recordingList->GetDataAt(i).value<ProgramInfo*>();
             if (i == topPos)
             {
                 itemTopPref.push_front(QString::number(pginfo->GetRecordingID()));
@@ -1592,8 +1624,7 @@ static void restore_position(
         uint recordingID = itemSelPref[i+1].toUInt();
         for (uint j = 0; j < (uint)recordingList->GetCount(); j++)
         {
-            MythUIButtonListItem *item = recordingList->GetItemAt(j);
-            auto *pginfo = item->GetData().value<ProgramInfo*>();
+            auto *pginfo = recordingList->GetDataAt(j).value<ProgramInfo*>();
             if (pginfo && (pginfo->GetRecordingID() == recordingID))
             {
                 sel = j;
@@ -1613,8 +1644,7 @@ static void restore_position(
         uint recordingID = itemTopPref[i+1].toUInt();
         for (uint j = 0; j < (uint)recordingList->GetCount(); j++)
         {
-            MythUIButtonListItem *item = recordingList->GetItemAt(j);
-            auto *pginfo = item->GetData().value<ProgramInfo*>();
+            auto *pginfo = recordingList->GetDataAt(j).value<ProgramInfo*>();
             if (pginfo && (pginfo->GetRecordingID() == recordingID))
             {
                 top = j;
@@ -1641,9 +1671,46 @@ static void restore_position(
     }
 }
 
+/// True if \p pginfo is shown in the current recording group and view
+bool PlaybackBox::IsInView(const ProgramInfo &pginfo)
+{
+    const QString& pRecgroup(pginfo.GetRecordingGroup());
+
+    // Never show anything from unauthorised passworded groups
+    QString password = getRecGroupPassword(pRecgroup);
+    if (m_curGroupPassword != password && !password.isEmpty())
+        return false;
+
+    // Filter nothing from Deleted group
+    // Never show Deleted recs anywhere else
+    if (pRecgroup == "Deleted")
+        return m_recGroup == "Deleted";
+
+    // Optionally ignore LiveTV programs if not viewing LiveTV group
+    if (!(m_viewMask & VIEW_LIVETVGRP) &&
+        m_recGroup != "LiveTV" && pRecgroup == "LiveTV")
+        return false;
+
+    // Optionally ignore watched
+    if (!(m_viewMask & VIEW_WATCHED) && pginfo.IsWatched())
+        return false;
+
+    // Filter by category
+    if (m_recGroupType.value(m_recGroup) == "category")
+    {
+        if (m_recGroup == tr("Unknown"))
+            return pginfo.GetCategory().isEmpty();
+        return pginfo.GetCategory() == m_recGroup;
+    }
+
+    // Filter by recgroup
+    return m_recGroup == "All Programs" || pRecgroup == m_recGroup;
+}
+
 bool PlaybackBox::UpdateUILists(void)
 {
     m_isFilling = true;
+    m_rebuildUILists = false;
 
     // Save selection, including next few items & groups
     QStringList groupSelPref;
@@ -1714,9 +1781,6 @@ bool PlaybackBox::UpdateUILists(void)
             }
         }
 
-        bool isCategoryFilter  = (m_recGroupType[m_recGroup] == "category");
-        bool isUnknownCategory = (m_recGroup == tr("Unknown"));
-        bool isDeletedGroup    = (m_recGroup == "Deleted");
         bool isLiveTvGroup     = (m_recGroup == "LiveTV");
 
         vector<ProgramInfo*> list;
@@ -1732,38 +1796,7 @@ bool PlaybackBox::UpdateUILists(void)
             const QString& pRecgroup(p->GetRecordingGroup());
             const bool     isLiveTVProg(pRecgroup == "LiveTV");
 
-            // Never show anything from unauthorised passworded groups
-            QString password = getRecGroupPassword(pRecgroup);
-            if (m_curGroupPassword != password && !password.isEmpty())
-                continue;
-
-            if (pRecgroup == "Deleted")
-            {
-                // Filter nothing from Deleted group
-                // Never show Deleted recs anywhere else
-                if (!isDeletedGroup)
-                    continue;
-            }
-            // Optionally ignore LiveTV programs if not viewing LiveTV group
-            else if (!(m_viewMask & VIEW_LIVETVGRP) &&
-                     !isLiveTvGroup && isLiveTVProg)
-            {   // NOLINT(bugprone-branch-clone)
-                continue;
-            }
-            // Optionally ignore watched
-            else if (!(m_viewMask & VIEW_WATCHED) && p->IsWatched())
-            {
-                continue;
-            }
-            else if (isCategoryFilter)
-            {
-                // Filter by category
-                if (isUnknownCategory ? !p->GetCategory().isEmpty()
-                                      : p->GetCategory() != m_recGroup)
-                    continue;
-            }
-            // Filter by recgroup
-            else if (!isAllProgsGroup && pRecgroup != m_recGroup)
+            if (!IsInView(*p))
                 continue;
 
             if (p->GetTitle().isEmpty())
@@ -1888,60 +1921,15 @@ bool PlaybackBox::UpdateUILists(void)
 
     QString episodeSort = gCoreContext->GetSetting("PlayBoxEpisodeSort", "Date");
 
-    if (episodeSort == "OrigAirDate")
-    {
-        QMap<QString, ProgramList>::Iterator Iprog;
-        for (Iprog = m_progLists.begin(); Iprog != m_progLists.end(); ++Iprog)
-        {
-            if (!Iprog.key().isEmpty())
-            {
-                std::stable_sort((*Iprog).begin(), (*Iprog).end(),
-                                 (m_listOrder == 0) ?
-                                 comp_originalAirDate_rev_less_than :
-                                 comp_originalAirDate_less_than);
-            }
-        }
-    }
-    else if (episodeSort == "Id")
-    {
-        QMap<QString, ProgramList>::Iterator Iprog;
-        for (Iprog = m_progLists.begin(); Iprog != m_progLists.end(); ++Iprog)
-        {
-            if (!Iprog.key().isEmpty())
-            {
-                std::stable_sort((*Iprog).begin(), (*Iprog).end(),
-                                 (m_listOrder == 0) ?
-                                 comp_programid_rev_less_than :
-                                 comp_programid_less_than);
-            }
-        }
-    }
-    else if (episodeSort == "Date")
+    ProgramLessThan lessThan =
+        episode_sort_less_than(episodeSort, m_listOrder);
+    if (lessThan)
     {
         QMap<QString, ProgramList>::iterator it;
         for (it = m_progLists.begin(); it != m_progLists.end(); ++it)
         {
             if (!it.key().isEmpty())
-            {
-                std::stable_sort((*it).begin(), (*it).end(),
-                                 (!m_listOrder) ?
-                                 comp_recordDate_rev_less_than :
-                                 comp_recordDate_less_than);
-            }
-        }
-    }
-    else if (episodeSort == "Season")
-    {
-        QMap<QString, ProgramList>::iterator it;
-        for (it = m_progLists.begin(); it != m_progLists.end(); ++it)
-        {
-            if (!it.key().isEmpty())
-            {
-                std::stable_sort((*it).begin(), (*it).end(),
-                                 (!m_listOrder) ?
-                                 comp_season_rev_less_than :
-                                 comp_season_less_than);
-            }
+                std::stable_sort((*it).begin(), (*it).end(), lessThan);
         }
     }
 
@@ -2566,7 +2554,6 @@ bool PlaybackBox::Play(
     ProgramInfo tvrec(rec);
 
     m_playingSomething = true;
-    int initIndex = m_recordingList->StopLoad();
 
     if (!gCoreContext->GetBoolSetting("UseProgStartMark", false))
         ignoreProgStart = true;
@@ -2581,7 +2568,6 @@ bool PlaybackBox::Play(
     playCompleted = TV::StartTV(&tvrec, flags);
 
     m_playingSomething = false;
-    m_recordingList->LoadInBackground(initIndex);
 
     if (inPlaylist && !m_playListPlay.empty())
     {
@@ -4162,7 +4148,7 @@ void PlaybackBox::customEvent(QEvent *event)
                 m_needUpdate = true;
             else
             {
-                UpdateUILists();
+                ApplyCacheChanges();
                 m_helper.ForceFreeSpaceUpdate();
             }
         }
@@ -4407,6 +4393,55 @@ void PlaybackBox::HandleRecordingRemoveEvent(uint recordingID)
         return;
     }
 
+    RemoveFromUILists(recordingID);
+    m_helper.ForceFreeSpaceUpdate();
+}
+
+/** \brief Applies the changes in the program info cache to the UI lists.
+ *
+ *  Recordings are added, updated and removed in place. The lists are only
+ *  rebuilt with UpdateUILists() if a recording would move to another group,
+ *  AddToUILists() can't place a new one, or a rebuild was asked for with
+ *  ScheduleUpdateUIList().
+ */
+void PlaybackBox::ApplyCacheChanges(void)
+{
+    if (m_rebuildUILists || m_progLists.isEmpty())
+    {
+        UpdateUILists();
+        return;
+    }
+
+    ProgramInfoCache::Changes changes = m_programInfoCache.Refresh();
+
+    if (changes.NeedsRegroup())
+    {
+        UpdateUILists();
+        return;
+    }
+
+    for (uint recordingID : changes.m_removed)
+        RemoveFromUILists(recordingID);
+
+    for (uint recordingID : changes.m_updated)
+    {
+        UpdateUIListItem(m_programInfoCache.GetRecordingInfo(recordingID),
+                         false);
+    }
+
+    for (uint recordingID : changes.m_added)
+    {
+        ProgramInfo *pginfo = m_programInfoCache.GetRecordingInfo(recordingID);
+        if (pginfo && !AddToUILists(pginfo))
+        {
+            UpdateUILists();
+            return;
+        }
+    }
+}
+
+void PlaybackBox::RemoveFromUILists(uint recordingID)
+{
     MythUIButtonListItem *sel_item = m_groupList->GetItemCurrent();
     QString groupname;
     if (sel_item)
@@ -4469,14 +4504,138 @@ void PlaybackBox::HandleRecordingRemoveEvent(uint recordingID)
             ++git;
         }
     }
+}
 
-    m_helper.ForceFreeSpaceUpdate();
+/** \brief Inserts a new recording into the UI lists of its groups.
+ *
+ *  This is the counterpart of RemoveFromUILists(). The recording goes into
+ *  the all programs list and its title, recording group and category lists
+ *  at the position UpdateUILists() would sort it to.
+ *
+ *  \return false if the lists must be rebuilt with UpdateUILists() instead,
+ *          because the recording starts a new group or the view has groups
+ *          that depend on the other recordings (watch list, search rules).
+ */
+bool PlaybackBox::AddToUILists(ProgramInfo *pginfo)
+{
+    if (pginfo->IsDeletePending())
+        return true;
+
+    if ((m_viewMask & (VIEW_WATCHLIST | VIEW_SEARCHES)) != 0)
+        return false;
+
+    QString episodeSort = gCoreContext->GetSetting("PlayBoxEpisodeSort", "Date");
+    ProgramLessThan lessThan = episode_sort_less_than(episodeSort, m_listOrder);
+    if (!lessThan)
+        return false;
+
+    m_progsInDB++;
+
+    if (!IsInView(*pginfo))
+        return true;
+
+    const QString& pRecgroup(pginfo->GetRecordingGroup());
+    const bool isLiveTVProg(pRecgroup == "LiveTV");
+    const bool isLiveTvGroup(m_recGroup == "LiveTV");
+
+    if (pginfo->GetTitle().isEmpty())
+        pginfo->SetTitle(tr("_NO_TITLE_"));
+
+    QStringList groups;
+    if (!isLiveTvGroup && isLiveTVProg && (m_viewMask & VIEW_LIVETVGRP))
+    {
+        groups << tr("Live TV").toLower();
+    }
+    else
+    {
+        if ((m_viewMask & VIEW_TITLES) && (!isLiveTVProg || isLiveTvGroup))
+            groups << pginfo->GetTitle().toLower();
+        if ((m_viewMask & VIEW_RECGROUPS) &&
+            !pRecgroup.isEmpty() && !isLiveTVProg)
+            groups << pRecgroup.toLower();
+        if (((m_viewMask & VIEW_CATEGORIES) != 0) &&
+            !pginfo->GetCategory().isEmpty())
+            groups << pginfo->GetCategory().toLower();
+    }
+
+    // A new group has to be sorted into the group list
+    for (const QString &group : qAsConst(groups))
+    {
+        if (!m_progLists.contains(group))
+            return false;
+    }
+
+    pginfo->SetAvailableStatus(asAvailable, "AddToUILists");
+
+    if (m_viewMask != VIEW_NONE && (!isLiveTVProg || isLiveTvGroup))
+    {
+        // The all programs list is kept in start time order
+        auto allLessThan = [this](const ProgramInfo *a, const ProgramInfo *b)
+        {
+            if (m_allOrder != 0)
+                std::swap(a, b);
+            if (a->GetRecordingStartTime() == b->GetRecordingStartTime())
+            {
+                if (a->GetChanID() == b->GetChanID())
+                    return a->GetRecordingID() < b->GetRecordingID();
+                return a->GetChanID() < b->GetChanID();
+            }
+            return a->GetRecordingStartTime() < b->GetRecordingStartTime();
+        };
+        ProgramList &all = m_progLists[""];
+        all.insert(std::upper_bound(all.begin(), all.end(), pginfo,
+                                    allLessThan), pginfo);
+        groups << "";
+    }
+
+    for (const QString &group : qAsConst(groups))
+    {
+        if (group.isEmpty())
+            continue;
+        ProgramList &list = m_progLists[group];
+        list.insert(std::upper_bound(list.begin(), list.end(), pginfo,
+                                     lessThan), pginfo);
+    }
+
+    for (int i = 0; i < m_groupList->GetCount(); ++i)
+    {
+        MythUIButtonListItem *item = m_groupList->GetItemAt(i);
+        QString group = item->GetData().toString();
+        if (groups.contains(group))
+        {
+            item->SetText(QString::number(m_progLists[group].size()),
+                          "reccount");
+        }
+    }
+
+    // Show the new recording if its group is on screen, keeping the
+    // selected recording
+    MythUIButtonListItem *sel_group = m_groupList->GetItemCurrent();
+    if (sel_group && groups.contains(sel_group->GetData().toString()))
+    {
+        QVariant selected;
+        MythUIButtonListItem *sel_item = m_recordingList->GetItemCurrent();
+        if (sel_item)
+            selected = sel_item->GetData();
+
+        m_needUpdate = true;
+        updateRecList(sel_group);
+
+        MythUIButtonListItem *item = selected.isValid() ?
+            m_recordingList->GetItemByData(selected) : nullptr;
+        if (item)
+            m_recordingList->SetItemCurrent(item);
+    }
+
+    return true;
 }
 
 void PlaybackBox::HandleRecordingAddEvent(const ProgramInfo &evinfo)
 {
     m_programInfoCache.Add(evinfo);
-    ScheduleUpdateUIList();
+    // The new recording is added by ApplyCacheChanges()
+    if (!m_programInfoCache.IsLoadInProgress())
+        QCoreApplication::postEvent(this, new MythEvent("UPDATE_UI_LIST"));
 }
 
 void PlaybackBox::HandleUpdateProgramInfoEvent(const ProgramInfo &evinfo)
@@ -4512,6 +4671,7 @@ void PlaybackBox::HandleUpdateProgramInfoFileSizeEvent(uint recordingID,
 
 void PlaybackBox::ScheduleUpdateUIList(void)
 {
+    m_rebuildUILists = true;
     if (!m_programInfoCache.IsLoadInProgress())
         QCoreApplication::postEvent(this, new MythEvent("UPDATE_UI_LIST"));
 }
@@ -22,6 +22,7 @@ using namespace std;
 #include "tv_play.h"
 
 #include "mythscreentype.h"
+#include "mythuibuttonlist.h"
 #include "metadatafactory.h"
 
 // mythfrontend
@@ -56,10 +57,9 @@ enum {
     kArtworkCoverTimeout  = 50,
 };
 
-class PlaybackBox : public ScheduleCommon
+class PlaybackBox : public ScheduleCommon, public MythUIButtonListProvider
 {
     Q_OBJECT
-    friend class PlaybackBoxListItem;
 
   public:
     // ViewType values cannot change; they are stored in the database.
@@ -125,6 +125,7 @@ class PlaybackBox : public ScheduleCommon
     void Init(void) override; // MythScreenType
     bool keyPressEvent(QKeyEvent *event) override; // MythScreenType
     void customEvent(QEvent *event) override; // ScheduleCommon
+    void FillItem(MythUIButtonListItem *item, int index) override; // MythUIButtonListProvider
 
     void setInitialRecGroup(const QString& initialGroup) { m_recGroup = initialGroup; }
     static void * RunPlaybackBox(void *player, bool showTV);
@@ -266,6 +267,7 @@ class PlaybackBox : public ScheduleCommon
 
   private:
     bool UpdateUILists(void);
+    bool IsInView(const ProgramInfo &pginfo);
     void UpdateUIGroupList(const QStringList &groupPreferences);
     void UpdateUIRecGroupList(void);
     void SelectNextRecGroup(void);
@@ -321,6 +323,9 @@ class PlaybackBox : public ScheduleCommon
 
     void HandlePreviewEvent(const QStringList &list);
     void HandleRecordingRemoveEvent(uint recordingID);
+    void RemoveFromUILists(uint recordingID);
+    bool AddToUILists(ProgramInfo *pginfo);
+    void ApplyCacheChanges(void);
     void HandleRecordingAddEvent(const ProgramInfo &evinfo);
     void HandleUpdateProgramInfoEvent(const ProgramInfo &evinfo);
     void HandleUpdateProgramInfoFileSizeEvent(uint recordingID, uint64_t filesize);
@@ -427,6 +432,8 @@ class PlaybackBox : public ScheduleCommon
 
     /// Does the recording list need to be refilled
     bool                m_needUpdate          {false};
+    /// Must the lists be rebuilt rather than updated from the cache changes
+    bool                m_rebuildUILists      {false};
 
     // Selection state variables
     bool                m_haveGroupInfoSet    {false};
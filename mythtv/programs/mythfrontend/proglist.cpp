@@ -116,12 +116,6 @@ bool ProgLister::Create()
     connect(m_progList, SIGNAL(itemSelected(MythUIButtonListItem*)),
             this,       SLOT(  HandleSelected(  MythUIButtonListItem*)));
 
-    connect(m_progList, SIGNAL(itemVisible(MythUIButtonListItem*)),
-            this,       SLOT(  HandleVisible(  MythUIButtonListItem*)));
-
-    connect(m_progList, SIGNAL(itemLoaded(MythUIButtonListItem*)),
-            this,       SLOT(  HandleVisible(  MythUIButtonListItem*)));
-
     if (m_type == plPreviouslyRecorded)
     {
         connect(m_progList, SIGNAL(itemClicked(MythUIButtonListItem*)),
@@ -1506,44 +1500,38 @@ void ProgLister::RestoreSelection(const ProgramInfo *selected,
     m_progList->SetItemCurrent(i + 1, i + 1 - selectedOffset);
 }
 
-void ProgLister::HandleVisible(MythUIButtonListItem *item)
+void ProgLister::FillItem(MythUIButtonListItem *item, int index)
 {
-    auto *pginfo = item->GetData().value<ProgramInfo*>();
+    ProgramInfo *pginfo = m_itemList[index];
+    item->SetData(QVariant::fromValue(pginfo));
 
-    if (item->GetText("is_item_initialized").isNull())
-    {
-        InfoMap infoMap;
-        pginfo->ToMap(infoMap);
+    InfoMap infoMap;
+    pginfo->ToMap(infoMap);
 
-        QString state = RecStatus::toUIState(pginfo->GetRecordingStatus());
-        if ((state == "warning") && (plPreviouslyRecorded == m_type))
-            state = "disabled";
+    QString state = RecStatus::toUIState(pginfo->GetRecordingStatus());
+    if ((state == "warning") && (plPreviouslyRecorded == m_type))
+        state = "disabled";
 
-        item->SetTextFromMap(infoMap, state);
+    item->SetTextFromMap(infoMap, state);
 
-        if (m_type == plTitle)
-        {
-            QString tempSubTitle = pginfo->GetSubtitle();
-            if (tempSubTitle.trimmed().isEmpty())
-                tempSubTitle = pginfo->GetTitle();
-            item->SetText(tempSubTitle, "titlesubtitle", state);
-        }
-
-        item->DisplayState(QString::number(pginfo->GetStars(10)),
-                           "ratingstate");
+    if (m_type == plTitle)
+    {
+        QString tempSubTitle = pginfo->GetSubtitle();
+        if (tempSubTitle.trimmed().isEmpty())
+            tempSubTitle = pginfo->GetTitle();
+        item->SetText(tempSubTitle, "titlesubtitle", state);
+    }
 
-        item->DisplayState(state, "status");
+    item->DisplayState(QString::number(pginfo->GetStars(10)),
+                       "ratingstate");
 
-        // Mark this button list item as initialized.
-        item->SetText("yes", "is_item_initialized");
-    }
+    item->DisplayState(state, "status");
 }
 
 void ProgLister::UpdateButtonList(void)
 {
-    for (auto *it : m_itemList)
-        new MythUIButtonListItem(m_progList, "", QVariant::fromValue(it));
-    m_progList->LoadInBackground();
+    // Rows are filled by FillItem() as they are shown
+    m_progList->SetProvider(this, static_cast<int>(m_itemList.size()));
 
     if (m_positionText)
     {
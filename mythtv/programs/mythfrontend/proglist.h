@@ -6,6 +6,7 @@
 #include <QString>
 
 // MythTV headers
+#include "mythuibuttonlist.h"
 #include "programinfo.h" // for ProgramList
 #include "schedulecommon.h"
 #include "proglist_helpers.h"
@@ -28,7 +29,7 @@ enum ProgListType {
     plPreviouslyRecorded
 };
 
-class ProgLister : public ScheduleCommon
+class ProgLister : public ScheduleCommon, public MythUIButtonListProvider
 {
     friend class PhrasePopup;
     friend class TimePopup;
@@ -48,10 +49,10 @@ class ProgLister : public ScheduleCommon
     bool Create(void) override; // MythScreenType
     bool keyPressEvent(QKeyEvent *event) override; // MythScreenType
     void customEvent(QEvent *event) override; // ScheduleCommon
+    void FillItem(MythUIButtonListItem *item, int index) override; // MythUIButtonListProvider
 
   protected slots:
     void HandleSelected(MythUIButtonListItem *item);
-    void HandleVisible(MythUIButtonListItem *item);
 
     void DeleteOldEpisode(bool ok);
     void DeleteOldSeries(bool ok);
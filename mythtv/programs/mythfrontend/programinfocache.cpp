@@ -13,9 +13,12 @@
 
 #include <QCoreApplication>
 #include <QRunnable>
+#include <QSet>
 
 #include <algorithm>
 
+#define LOC QString("ProgramInfoCache: ")
+
 using VPI_ptr = vector<ProgramInfo *> *;
 static void free_vec(VPI_ptr &v)
 {
@@ -103,46 +106,174 @@ void ProgramInfoCache::WaitForLoadToComplete(void) const
         m_loadWait.wait(&m_lock);
 }
 
-/** \brief Refreshed the cache.
+// helper functions that are used only in this file
+namespace {
+    // Sorting functions for ProgramInfoCache::GetOrdered()
+    bool PISort(const ProgramInfo *a, const ProgramInfo *b)
+    {
+        if (a->GetRecordingStartTime() == b->GetRecordingStartTime())
+        {
+            if (a->GetChanID() == b->GetChanID())
+                return a->GetRecordingID() < b->GetRecordingID();
+            return a->GetChanID() < b->GetChanID();
+        }
+        return (a->GetRecordingStartTime() < b->GetRecordingStartTime());
+    }
+
+    // True if a change between the two would move the recording to another
+    // group or position in the recordings screen
+    bool SameGrouping(const ProgramInfo &a, const ProgramInfo &b)
+    {
+        return a.GetRecordingStartTime() == b.GetRecordingStartTime() &&
+            a.GetChanID()             == b.GetChanID() &&
+            a.GetRecordingGroup()     == b.GetRecordingGroup() &&
+            a.GetTitle()              == b.GetTitle() &&
+            a.GetSortTitle()          == b.GetSortTitle() &&
+            a.GetCategory()           == b.GetCategory() &&
+            a.GetRecordingRuleID()    == b.GetRecordingRuleID() &&
+            a.GetOriginalAirDate()    == b.GetOriginalAirDate() &&
+            a.GetProgramID()          == b.GetProgramID() &&
+            a.GetSeason()             == b.GetSeason() &&
+            a.GetEpisode()            == b.GetEpisode() &&
+            a.IsWatched()             == b.IsWatched() &&
+            a.IsAutoExpirable()       == b.IsAutoExpirable() &&
+            a.IsDeletePending()       == b.IsDeletePending();
+    }
+
+    // True if nothing shown in the recordings screen differs between the two
+    bool SameProgram(const ProgramInfo &a, const ProgramInfo &b)
+    {
+        return SameGrouping(a, b) &&
+            a.GetFilesize()            == b.GetFilesize() &&
+            a.GetLastModifiedTime()    == b.GetLastModifiedTime() &&
+            a.GetBookmarkUpdate()      == b.GetBookmarkUpdate() &&
+            a.GetRecordingEndTime()    == b.GetRecordingEndTime() &&
+            a.GetScheduledStartTime()  == b.GetScheduledStartTime() &&
+            a.GetScheduledEndTime()    == b.GetScheduledEndTime() &&
+            a.GetRecordingStatus()     == b.GetRecordingStatus() &&
+            a.GetProgramFlags()        == b.GetProgramFlags() &&
+            a.GetVideoProperties()     == b.GetVideoProperties() &&
+            a.GetAudioProperties()     == b.GetAudioProperties() &&
+            a.GetSubtitleType()        == b.GetSubtitleType() &&
+            a.GetRecordingPriority()   == b.GetRecordingPriority() &&
+            a.GetSubtitle()            == b.GetSubtitle() &&
+            a.GetDescription()         == b.GetDescription() &&
+            a.GetEpisodeTotal()        == b.GetEpisodeTotal() &&
+            a.GetStars()               == b.GetStars() &&
+            a.GetYearOfInitialRelease() == b.GetYearOfInitialRelease() &&
+            a.GetInetRef()             == b.GetInetRef() &&
+            a.GetSeriesID()            == b.GetSeriesID() &&
+            a.GetPathname()            == b.GetPathname() &&
+            a.GetHostname()            == b.GetHostname() &&
+            a.GetStorageGroup()        == b.GetStorageGroup() &&
+            a.GetPlaybackGroup()       == b.GetPlaybackGroup() &&
+            a.GetInputName()           == b.GetInputName();
+    }
+}
+
+/** \brief Applies the changes made since the last refresh.
  *
- *  If a new list has been loaded this fills the cache with that list
- *  if not, this simply removes list items marked for deletion from the
- *  the list.
+ *  If a new list has been loaded it is merged into the cache, so that
+ *  recordings which are still present keep their ProgramInfo. Recordings
+ *  marked for deletion by Remove() are freed.
  *
  *  \note This must only be called from the UI thread.
- *  \note All references to the ProgramInfo pointers should be cleared
- *        before this is called.
+ *  \note All references to ProgramInfo pointers removed from the cache
+ *        before the previous call should be cleared before this is called.
+ *  \return The recordings added, updated and removed since the last call.
+ *          Removed recordings stay in the cache, marked as deleted, until
+ *          the next call.
  */
-void ProgramInfoCache::Refresh(void)
+ProgramInfoCache::Changes ProgramInfoCache::Refresh(void)
 {
-    QMutexLocker locker(&m_lock);
-    if (m_nextCache)
+    for (uint recordingID : m_pendingRemoval)
     {
-        Clear();
-        for (auto & it : *m_nextCache)
+        Cache::iterator it = m_cache.find(recordingID);
+        if (it != m_cache.end() && (*it)->GetAvailableStatus() == asDeleted)
         {
-            if (!it->GetChanID())
-                continue;
-
-            m_cache[it->GetRecordingID()] = it;
+            RemoveOrdered(*it);
+            delete (*it);
+            m_cache.erase(it);
         }
-        delete m_nextCache;
-        m_nextCache = nullptr;
-        return;
     }
+    m_pendingRemoval.clear();
+
+    QMutexLocker locker(&m_lock);
+    vector<ProgramInfo*> *next = m_nextCache;
+    m_nextCache = nullptr;
     locker.unlock();
 
-    Cache::iterator it = m_cache.begin();
-    Cache::iterator nit = it;
-    for (; it != m_cache.end(); it = nit)
+    if (next)
     {
-        nit = it;
-        ++nit;
+        Merge(*next);
+        delete next;
+    }
+
+    Changes changes;
+    std::swap(changes, m_changes);
 
-        if ((*it)->GetAvailableStatus() == asDeleted)
+    LOG(VB_GUI, LOG_DEBUG, LOC +
+        QString("%1 added, %2 updated, %3 removed%4")
+            .arg(changes.m_added.size()).arg(changes.m_updated.size())
+            .arg(changes.m_removed.size())
+            .arg(changes.m_regroup ? ", regrouping" : ""));
+
+    return changes;
+}
+
+/** \brief Merges a list loaded from the backend into the cache.
+ *
+ *  Takes ownership of the ProgramInfo's in \p list.
+ */
+void ProgramInfoCache::Merge(vector<ProgramInfo*> &list)
+{
+    QSet<uint> seen;
+    seen.reserve(static_cast<int>(list.size()));
+
+    for (auto *pginfo : list)
+    {
+        if (!pginfo->GetChanID())
         {
-            delete (*it);
-            m_cache.erase(it);
+            delete pginfo;
+            continue;
+        }
+
+        uint recordingID = pginfo->GetRecordingID();
+        seen.insert(recordingID);
+
+        Cache::iterator it = m_cache.find(recordingID);
+        if (it == m_cache.end())
+        {
+            m_cache[recordingID] = pginfo;
+            InsertOrdered(pginfo);
+            m_changes.m_added.push_back(recordingID);
+            continue;
+        }
+
+        ProgramInfo *old = *it;
+        if (!SameProgram(*old, *pginfo))
+        {
+            bool regroup = !SameGrouping(*old, *pginfo);
+            if (regroup)
+                RemoveOrdered(old);
+            old->clone(*pginfo, true);
+            if (regroup)
+                InsertOrdered(old);
+            m_changes.m_regroup |= regroup;
+            m_changes.m_updated.push_back(recordingID);
+        }
+        delete pginfo;
+    }
+    list.clear();
+
+    for (auto *pginfo : qAsConst(m_cache))
+    {
+        if (!seen.contains(pginfo->GetRecordingID()) &&
+            pginfo->GetAvailableStatus() != asDeleted)
+        {
+            pginfo->SetAvailableStatus(asDeleted, "PIC::Merge");
+            m_pendingRemoval.push_back(pginfo->GetRecordingID());
+            m_changes.m_removed.push_back(pginfo->GetRecordingID());
         }
     }
 }
@@ -158,7 +289,15 @@ bool ProgramInfoCache::Update(const ProgramInfo &pginfo)
     Cache::iterator it = m_cache.find(pginfo.GetRecordingID());
 
     if (it != m_cache.end())
+    {
+        bool regroup = !SameGrouping(**it, pginfo);
+        if (regroup)
+            RemoveOrdered(*it);
         (*it)->clone(pginfo, true);
+        if (regroup)
+            InsertOrdered(*it);
+        m_changes.m_regroup |= regroup;
+    }
 
     return it != m_cache.end();
 }
@@ -207,7 +346,10 @@ void ProgramInfoCache::Add(const ProgramInfo &pginfo)
     if (!pginfo.GetRecordingID() || Update(pginfo))
         return;
 
-    m_cache[pginfo.GetRecordingID()] = new ProgramInfo(pginfo);
+    auto *added = new ProgramInfo(pginfo);
+    m_cache[pginfo.GetRecordingID()] = added;
+    InsertOrdered(added);
+    m_changes.m_added.push_back(pginfo.GetRecordingID());
 }
 
 /** \brief Marks a ProgramInfo in the cache for deletion on the next
@@ -220,39 +362,21 @@ bool ProgramInfoCache::Remove(uint recordingID)
     Cache::iterator it = m_cache.find(recordingID);
 
     if (it != m_cache.end())
-        (*it)->SetAvailableStatus(asDeleted, "PIC::Remove");
-
-    return it != m_cache.end();
-}
-
-// two helper functions that are used only in this file
-namespace {
-    // Sorting functions for ProgramInfoCache::GetOrdered()
-    bool PISort(const ProgramInfo *a, const ProgramInfo *b)
     {
-        if (a->GetRecordingStartTime() == b->GetRecordingStartTime())
-            return a->GetChanID() < b->GetChanID();
-        return (a->GetRecordingStartTime() < b->GetRecordingStartTime());
+        (*it)->SetAvailableStatus(asDeleted, "PIC::Remove");
+        m_pendingRemoval.push_back(recordingID);
     }
 
-    bool reversePISort(const ProgramInfo *a, const ProgramInfo *b)
-    {
-        if (a->GetRecordingStartTime() == b->GetRecordingStartTime())
-            return a->GetChanID() > b->GetChanID();
-        return (a->GetRecordingStartTime() > b->GetRecordingStartTime());
-    }
+    return it != m_cache.end();
 }
 
 void ProgramInfoCache::GetOrdered(vector<ProgramInfo*> &list, bool newest_first)
 {
-    for (const auto & pi : qAsConst(m_cache))
-        list.push_back(pi);
-
+    list.reserve(list.size() + m_ordered.size());
     if (newest_first)
-        std::sort(list.begin(), list.end(), reversePISort);
+        list.insert(list.end(), m_ordered.rbegin(), m_ordered.rend());
     else
-        std::sort(list.begin(), list.end(), PISort);
-
+        list.insert(list.end(), m_ordered.begin(), m_ordered.end());
 }
 
 ProgramInfo *ProgramInfoCache::GetRecordingInfo(uint recordingID) const
@@ -265,10 +389,31 @@ ProgramInfo *ProgramInfoCache::GetRecordingInfo(uint recordingID) const
     return nullptr;
 }
 
+/// Adds a ProgramInfo to the sorted list at its place.
+void ProgramInfoCache::InsertOrdered(ProgramInfo *pginfo)
+{
+    m_ordered.insert(std::upper_bound(m_ordered.begin(), m_ordered.end(),
+                                      pginfo, PISort), pginfo);
+}
+
+/// Removes a ProgramInfo from the sorted list, it must not have been
+/// changed since it was inserted.
+void ProgramInfoCache::RemoveOrdered(ProgramInfo *pginfo)
+{
+    auto range = std::equal_range(m_ordered.begin(), m_ordered.end(),
+                                  pginfo, PISort);
+    auto it = std::find(range.first, range.second, pginfo);
+    if (it != range.second)
+        m_ordered.erase(it);
+}
+
 /// Clears the cache, m_lock must be held when this is called.
 void ProgramInfoCache::Clear(void)
 {
     for (const auto & pi : qAsConst(m_cache))
         delete pi;
     m_cache.clear();
+    m_ordered.clear();
+    m_pendingRemoval.clear();
+    m_changes = Changes();
 }
@@ -30,8 +30,20 @@ class ProgramInfoCache
     bool IsLoadInProgress(void) const;
     void WaitForLoadToComplete(void) const;
 
+    /// Recordings that changed since the last call to Refresh()
+    struct Changes
+    {
+        vector<uint> m_added;
+        vector<uint> m_updated;
+        vector<uint> m_removed;
+        /// An update changed how a recording is grouped or sorted
+        bool         m_regroup  {false};
+
+        bool NeedsRegroup(void) const { return m_regroup; }
+    };
+
     // All the following public methods must only be called from the UI Thread.
-    void Refresh(void);
+    Changes Refresh(void);
     void Add(const ProgramInfo &pginfo);
     bool Remove(uint recordingID);
     bool Update(const ProgramInfo &pginfo);
@@ -45,17 +57,21 @@ class ProgramInfoCache
   private:
     void Load(bool updateUI = true);
     void Clear(void);
+    void Merge(vector<ProgramInfo*> &list);
+    void InsertOrdered(ProgramInfo *pginfo);
+    void RemoveOrdered(ProgramInfo *pginfo);
 
   private:
-    // NOTE: Hash would be faster for lookups and updates, but we need a sorted
-    // list for to rebuild the full list. Question is, which is done more?
-    // We could store a hash, but sort the vector in GetOrdered which might
-    // be a suitable compromise, fractionally slower initial load but faster
-    // scrolling and updates
+    // The hash is used for lookups and updates, the vector keeps the same
+    // recordings sorted by start time so the full list never has to be
+    // sorted again. Both are kept up to date as each change arrives.
     using Cache = QHash<uint,ProgramInfo*>;
 
     mutable QMutex          m_lock;
     Cache                   m_cache;
+    vector<ProgramInfo*>    m_ordered;
+    vector<uint>            m_pendingRemoval;
+    Changes                 m_changes;
     vector<ProgramInfo*>   *m_nextCache         {nullptr};
     QObject                *m_listener          {nullptr};
     bool                    m_loadIsQueued      {false};
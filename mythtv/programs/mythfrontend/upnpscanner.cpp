@@ -4,6 +4,7 @@
 #include "mythcorecontext.h"
 #include "mythlogging.h"
 #include "ssdp.h"
+#include "upnpdesccache.h"
 #include "upnpscanner.h"
 
 #include <chrono> // for milliseconds
@@ -14,7 +15,16 @@
 #define ERR QString("UPnPScan error: ")
 
 #define MAX_ATTEMPTS 5
-#define MAX_REQUESTS 1
+#define MAX_REQUESTS 8
+
+// QNetworkRequest::setTransferTimeout() needs Qt 5.15, so slow devices are
+// aborted by a timer instead
+#define DESCRIPTION_TIMEOUT_MS 5000
+#define BROWSE_TIMEOUT_MS      30000
+
+// Large containers are browsed a page at a time, so the first items can be
+// shown while the rest arrive
+#define BROWSE_PAGE_SIZE 100
 
 QString MediaServerItem::NextUnbrowsed(void)
 {
@@ -70,6 +80,7 @@ void MediaServerItem::Reset(void)
 {
     m_children.clear();
     m_scanned = false;
+    m_partial = false;
 }
 
 /**
@@ -85,10 +96,10 @@ class MediaServer : public MediaServerItem
        m_friendlyName(QString("Unknown"))
     {
     }
-    explicit MediaServer(QUrl URL)
+    MediaServer(QUrl URL, QString bootid)
      : MediaServerItem(QString("0"), QString(), QString(), QString()),
-       m_url(std::move(URL)), m_eventSubPath(QString()),
-       m_friendlyName(QString("Unknown"))
+       m_url(std::move(URL)), m_bootId(std::move(bootid)),
+       m_eventSubPath(QString()), m_friendlyName(QString("Unknown"))
     {
     }
 
@@ -105,6 +116,7 @@ class MediaServer : public MediaServerItem
     }
 
     QUrl    m_url;
+    QString m_bootId;
     int     m_connectionAttempts {0};
     QUrl    m_controlURL;
     QUrl    m_eventSubURL;
@@ -289,19 +301,31 @@ bool UPNPScanner::GetMetadata(QVariant &data)
     QString usn = list[0];
     QString object = list[1];
 
+    // A container is refreshed until it has been browsed, and then while
+    // its remaining pages arrive
     m_lock.lock();
     bool valid = m_servers.contains(usn);
+    bool browse = false;
+    int  before = 0;
     if (valid)
     {
         MediaServerItem* item = m_servers[usn]->Find(object);
-        valid = item ? !item->m_scanned : false;
+        valid = item ? (!item->m_scanned || item->m_partial) : false;
+        if (valid)
+        {
+            browse = !item->m_scanned;
+            before = item->m_children.size();
+        }
     }
     m_lock.unlock();
     if (!valid)
         return false;
 
-    auto *me = new MythEvent("UPNP_BROWSEOBJECT", list);
-    qApp->postEvent(this, me);
+    if (browse)
+    {
+        auto *me = new MythEvent("UPNP_BROWSEOBJECT", list);
+        qApp->postEvent(this, me);
+    }
 
     int count = 0;
     bool found = false;
@@ -315,7 +339,12 @@ bool UPNPScanner::GetMetadata(QVariant &data)
             MediaServerItem *item = m_servers[usn]->Find(object);
             if (item)
             {
-                found = item->m_scanned;
+                // return as soon as there is something new to show, or
+                // once the rest of a partly browsed container has failed
+                if (item->m_scanned)
+                    found = !item->m_partial || item->m_children.size() > before;
+                else
+                    found = !browse;
             }
             else
             {
@@ -372,6 +401,23 @@ void UPNPScanner::GetServerContent(QString &usn,
             it.next();
             GetServerContent(usn, &it.value(), list, container.get());
         }
+
+        // the rest of the container is still arriving, selecting this shows
+        // whatever has arrived since
+        if (content->m_partial)
+        {
+            smart_dir_node more = container->addSubDir(tr("More..."));
+
+            QStringList data;
+            data << usn;
+            data << content->m_id;
+            more->SetData(data);
+
+            VideoMetadataListManager::VideoMetadataPtr item(new VideoMetadata(QString()));
+            item->SetTitle(QString("Dummy"));
+            list->push_back(item);
+            more->addEntry(smart_meta_node(new meta_data_node(item.get())));
+        }
         return;
     }
 
@@ -500,7 +546,8 @@ void UPNPScanner::Stop(void)
 /**
  * \fn UPNPScanner::Update(void)
  *  Iterates through the list of known servers and initialises a connection by
- *  requesting the device description.
+ *  requesting the device description. Descriptions are read from the disk
+ *  cache when possible, and up to MAX_REQUESTS are fetched at once.
  */
 void UPNPScanner::Update(void)
 {
@@ -515,6 +562,14 @@ void UPNPScanner::Update(void)
     // if our network queue is full, then we may need to come back later
     bool reschedule = false;
 
+    struct CachedDescription
+    {
+        QUrl       m_url;
+        QString    m_bootId;
+        QByteArray m_data;
+    };
+    QList<CachedDescription> cached;
+
     QHashIterator<QString,MediaServer*> it(m_servers);
     while (it.hasNext())
     {
@@ -524,14 +579,30 @@ void UPNPScanner::Update(void)
         {
             bool sent = false;
             QUrl url = it.value()->m_url;
+            QString bootid = it.value()->m_bootId;
+
+            // first try the description saved the last time we saw it,
+            // unless the server has no boot id to tell us it is still valid
+            QByteArray data;
+            if (it.value()->m_connectionAttempts == 0 && !bootid.isEmpty() &&
+                UPnpDescCache::Load(url.toString(), bootid, data))
+            {
+                it.value()->m_connectionAttempts++;
+                cached.append({url, bootid, data});
+                continue;
+            }
+
             if (!m_descriptionRequests.contains(url) &&
-                (m_descriptionRequests.empty()) &&
+                (m_descriptionRequests.size() < MAX_REQUESTS) &&
                 url.isValid())
             {
                 QNetworkReply *reply = m_network->get(QNetworkRequest(url));
                 if (reply)
                 {
                     sent = true;
+                    reply->setProperty("bootid", bootid);
+                    QTimer::singleShot(DESCRIPTION_TIMEOUT_MS, reply,
+                                       &QNetworkReply::abort);
                     m_descriptionRequests.insert(url, reply);
                     it.value()->m_connectionAttempts++;
                 }
@@ -544,6 +615,16 @@ void UPNPScanner::Update(void)
     if (reschedule)
         ScheduleUpdate();
     m_lock.unlock();
+
+    // parsed outside the loop, as parsing subscribes to the server's events
+    for (const auto &desc : qAsConst(cached))
+    {
+        if (!ParseDescription(desc.m_url, desc.m_data))
+        {
+            UPnpDescCache::Remove(desc.m_url.toString(), desc.m_bootId);
+            ScheduleUpdate();
+        }
+    }
 }
 
 /**
@@ -610,21 +691,33 @@ void UPNPScanner::replyFinished(QNetworkReply *reply)
     }
     m_lock.unlock();
 
-    if (browse && valid)
+    if (browse)
     {
-        ParseBrowse(url, reply);
-        if (m_fullscan)
-            BrowseNextContainer();
+        if (valid && ParseBrowse(url, reply))
+        {
+            if (m_fullscan)
+                BrowseNextContainer();
+        }
+        else
+        {
+            BrowseFailed(url, reply);
+        }
     }
     else if (description)
     {
-        if (!valid || !ParseDescription(url, reply))
+        QByteArray data = valid ? reply->readAll() : QByteArray();
+        if (!valid || !ParseDescription(url, data))
         {
             // if there will be no more attempts, update the logs
             CheckFailure(url);
             // try again
             ScheduleUpdate();
         }
+        else
+        {
+            UPnpDescCache::Save(url.toString(),
+                                reply->property("bootid").toString(), data);
+        }
     }
     else
         LOG(VB_UPNP, LOG_ERR, LOC + "Received unknown reply");
@@ -709,7 +802,9 @@ void UPNPScanner::customEvent(QEvent *event)
     if (uri == "urn:schemas-upnp-org:device:MediaServer:1")
     {
         QString url = (ev == "SSDP_ADD") ? me->ExtraData(2) : QString();
-        AddServer(usn, url);
+        QString bootid = (ev == "SSDP_ADD" && me->ExtraDataCount() > 3) ?
+            me->ExtraData(3) : QString();
+        AddServer(usn, url, bootid);
     }
 }
 
@@ -862,11 +957,13 @@ void UPNPScanner::BrowseNextContainer(void)
 }
 
 /**
- * \fn UPNPScanner::SendBrowseRequest(const QUrl&, const QString&)
+ * \fn UPNPScanner::SendBrowseRequest(const QUrl&, const QString&, uint)
  *  Formulates and sends a ContentDirectory Service Browse Request to the given
- *  control URL, requesting data for the object identified by objectid.
+ *  control URL, requesting one page of data for the object identified by
+ *  objectid, starting at index start.
  */
-void UPNPScanner::SendBrowseRequest(const QUrl &url, const QString &objectid)
+void UPNPScanner::SendBrowseRequest(const QUrl &url, const QString &objectid,
+                                    uint start)
 {
     QNetworkRequest req = QNetworkRequest(url);
     req.setRawHeader("CONTENT-TYPE", "text/xml; charset=\"utf-8\"");
@@ -888,8 +985,8 @@ void UPNPScanner::SendBrowseRequest(const QUrl &url, const QString &objectid)
     data << "      <ObjectID>" << objectid.toUtf8() << "</ObjectID>\r\n";
     data << "      <BrowseFlag>BrowseDirectChildren</BrowseFlag>\r\n";
     data << "      <Filter>*</Filter>\r\n";
-    data << "      <StartingIndex>0</StartingIndex>\r\n";
-    data << "      <RequestedCount>0</RequestedCount>\r\n";
+    data << "      <StartingIndex>" << start << "</StartingIndex>\r\n";
+    data << "      <RequestedCount>" << BROWSE_PAGE_SIZE << "</RequestedCount>\r\n";
     data << "      <SortCriteria></SortCriteria>\r\n";
     data << "    </u:Browse>\r\n";
     data << "  </s:Body>\r\n";
@@ -899,16 +996,22 @@ void UPNPScanner::SendBrowseRequest(const QUrl &url, const QString &objectid)
     m_lock.lock();
     QNetworkReply *reply = m_network->post(req, body);
     if (reply)
+    {
+        reply->setProperty("objectid", objectid);
+        reply->setProperty("start", start);
+        QTimer::singleShot(BROWSE_TIMEOUT_MS, reply, &QNetworkReply::abort);
         m_browseRequests.insert(url, reply);
+    }
     m_lock.unlock();
 }
 
 /**
- * \fn UPNPScanner::AddServer(const QString&, const QString&)
+ * \fn UPNPScanner::AddServer(const QString&, const QString&, const QString&)
  *  Adds the server identified by usn and reachable via url to the list of
  *  known media servers and schedules an update to initiate a connection.
  */
-void UPNPScanner::AddServer(const QString &usn, const QString &url)
+void UPNPScanner::AddServer(const QString &usn, const QString &url,
+                            const QString &bootid)
 {
     if (url.isEmpty())
     {
@@ -930,10 +1033,18 @@ void UPNPScanner::AddServer(const QString &usn, const QString &url)
         return;
     }
 
+    // a server announcing a new boot id has restarted, and its description
+    // and content may have changed
     m_lock.lock();
+    if (!bootid.isEmpty() && m_servers.contains(usn) &&
+        m_servers[usn]->m_bootId != bootid)
+    {
+        RemoveServer(usn);
+    }
+
     if (!m_servers.contains(usn))
     {
-        m_servers.insert(usn, new MediaServer(url));
+        m_servers.insert(usn, new MediaServer(url, bootid));
         LOG(VB_GENERAL, LOG_INFO, LOC + QString("Adding: %1").arg(usn));
         ScheduleUpdate();
     }
@@ -983,13 +1094,15 @@ void UPNPScanner::ScheduleRenewal(const QString &usn, int timeout)
 
 /**
  * \fn UPNPScanner::ParseBrowse(const QUrl&, QNetworkReply*)
- *  Parse the XML returned from Content Directory Service browse request.
+ *  Parse the XML returned from Content Directory Service browse request and
+ *  request the next page of the container, if there is one.
+ *  \return false if the reply was empty or could not be parsed.
  */
-void UPNPScanner::ParseBrowse(const QUrl &url, QNetworkReply *reply)
+bool UPNPScanner::ParseBrowse(const QUrl &url, QNetworkReply *reply)
 {
     QByteArray data = reply->readAll();
     if (data.isEmpty())
-        return;
+        return false;
 
     // Open the response for parsing
     auto *parent = new QDomDocument();
@@ -1003,7 +1116,7 @@ void UPNPScanner::ParseBrowse(const QUrl &url, QNetworkReply *reply)
             QString("DIDL Parse error, Line: %1 Col: %2 Error: '%3'")
                 .arg(errorLine).arg(errorColumn).arg(errorMessage));
         delete parent;
-        return;
+        return false;
     }
 
     LOG(VB_UPNP, LOG_INFO, "\n\n" + parent->toString(4) + "\n\n");
@@ -1023,7 +1136,8 @@ void UPNPScanner::ParseBrowse(const QUrl &url, QNetworkReply *reply)
     {
         LOG(VB_GENERAL, LOG_ERR, LOC +
             QString("Failed to find result for %1") .arg(url.toString()));
-        return;
+        delete result;
+        return false;
     }
 
     // determine the 'server' which requested the browse
@@ -1047,7 +1161,8 @@ void UPNPScanner::ParseBrowse(const QUrl &url, QNetworkReply *reply)
         m_lock.unlock();
         LOG(VB_GENERAL, LOG_ERR, LOC +
             QString("Received unknown response for %1").arg(url.toString()));
-        return;
+        delete result;
+        return true;
     }
 
     // check the update ID
@@ -1064,8 +1179,10 @@ void UPNPScanner::ParseBrowse(const QUrl &url, QNetworkReply *reply)
     }
 
     // find containers (directories) and actual items and add them and reset
-    // the parent when we have found the first item
-    bool reset = true;
+    // the parent when we have found the first item of the first page
+    uint    start    = reply->property("start").toUInt();
+    QString objectid = reply->property("objectid").toString();
+    bool reset = (start == 0);
     docElem = result->documentElement();
     n = docElem.firstChild();
     while (!n.isNull())
@@ -1075,7 +1192,52 @@ void UPNPScanner::ParseBrowse(const QUrl &url, QNetworkReply *reply)
     }
     delete result;
 
+    // ask for the next page, unless the container went away with a change
+    // of update ID
+    bool more = false;
+    MediaServerItem *container = server->Find(objectid);
+    if (container)
+    {
+        more = (start + num < total);
+        container->m_partial = more;
+    }
+
     m_lock.unlock();
+
+    if (more)
+        SendBrowseRequest(url, objectid, start + num);
+    return true;
+}
+
+/**
+ * \fn UPNPScanner::BrowseFailed(const QUrl&, QNetworkReply*)
+ *  Marks the container of a failed or empty browse reply as not scanned, so
+ *  that it is browsed again from the first page when it is next visited
+ *  rather than being left partly browsed.
+ */
+void UPNPScanner::BrowseFailed(const QUrl &url, QNetworkReply *reply)
+{
+    QString objectid = reply->property("objectid").toString();
+
+    QMutexLocker locker(&m_lock);
+    QHashIterator<QString,MediaServer*> it(m_servers);
+    while (it.hasNext())
+    {
+        it.next();
+        if (url != it.value()->m_controlURL)
+            continue;
+
+        MediaServerItem *container = it.value()->Find(objectid);
+        if (container)
+        {
+            LOG(VB_UPNP, LOG_WARNING, LOC +
+                QString("Browse of %1 on %2 failed, it will be browsed again")
+                    .arg(objectid).arg(it.value()->m_friendlyName));
+            container->m_partial = false;
+            container->m_scanned = false;
+        }
+        break;
+    }
 }
 
 void UPNPScanner::FindItems(const QDomNode &n, MediaServerItem &content,
@@ -1202,15 +1364,14 @@ QDomDocument* UPNPScanner::FindResult(const QDomNode &n, uint &num,
 }
 
 /**
- * \fn UPNPScanner::ParseDescription(const QUrl&, QNetworkReply*)
+ * \fn UPNPScanner::ParseDescription(const QUrl&, const QByteArray&)
  *  Parse the device description XML return my a media server.
  */
-bool UPNPScanner::ParseDescription(const QUrl &url, QNetworkReply *reply)
+bool UPNPScanner::ParseDescription(const QUrl &url, const QByteArray &data)
 {
-    if (url.isEmpty() || !reply)
+    if (url.isEmpty())
         return false;
 
-    QByteArray data = reply->readAll();
     if (data.isEmpty())
     {
         LOG(VB_GENERAL, LOG_ERR, LOC +
@@ -39,6 +39,7 @@ class MediaServerItem
     QString m_name;
     QString m_url;
     bool    m_scanned {false};
+    bool    m_partial {false}; ///< more children are still being browsed
     QMap<QString, MediaServerItem> m_children;
 };
 
@@ -78,20 +79,23 @@ class UPNPScanner : public QObject
     void CheckFailure(const QUrl &url);
     void Debug(void);
     void BrowseNextContainer(void);
-    void SendBrowseRequest(const QUrl &url, const QString &objectid);
-    void AddServer(const QString &usn, const QString &url);
+    void SendBrowseRequest(const QUrl &url, const QString &objectid,
+                           uint start = 0);
+    void AddServer(const QString &usn, const QString &url,
+                   const QString &bootid);
     void RemoveServer(const QString &usn);
     void ScheduleRenewal(const QString &usn, int timeout);
 
     // xml parsing of browse requests
-    void ParseBrowse(const QUrl &url, QNetworkReply *reply);
+    bool ParseBrowse(const QUrl &url, QNetworkReply *reply);
+    void BrowseFailed(const QUrl &url, QNetworkReply *reply);
     void FindItems(const QDomNode &n, MediaServerItem &content,
                    bool &resetparent);
     QDomDocument* FindResult(const QDomNode &n, uint &num,
                              uint &total, uint &updateid);
 
     // xml parsing of device description
-    bool ParseDescription(const QUrl &url, QNetworkReply *reply);
+    bool ParseDescription(const QUrl &url, const QByteArray &data);
     static void ParseDevice(QDomElement &element, QString &controlURL,
                             QString &eventURL, QString &friendlyName);
     static void ParseServiceList(QDomElement &element, QString &controlURL,
@@ -1192,27 +1192,42 @@ void VideoDialog::loadData()
         using MGTreeChildList = QList<MythGenericTree *>;
         MGTreeChildList *lchildren = m_d->m_currentNode->getAllChildren();
 
+        QVariantList rows;
+        int selected = -1;
+
         for (auto * child : qAsConst(*lchildren))
         {
             if (child != nullptr)
             {
-                auto *item =
-                        new MythUIButtonListItem(m_videoButtonList, QString(), nullptr,
-                                true, MythUIButtonListItem::NotChecked);
-
-                item->SetData(QVariant::fromValue(child));
-
-                UpdateItem(item);
-
                 if (child == selectedNode)
-                    m_videoButtonList->SetItemCurrent(item);
+                    selected = rows.size();
+                rows.append(QVariant::fromValue(child));
             }
         }
+
+        // UpdateItem() looks for artwork on disk, so rows are only filled
+        // by FillItem() as they are shown
+        m_videoButtonList->SetProvider(this, rows);
+
+        if (selected >= 0)
+            m_videoButtonList->SetItemCurrent(selected);
     }
 
     UpdatePosition();
 }
 
+/** \fn VideoDialog::FillItem(MythUIButtonListItem *item, int)
+ *  \brief Fill in an empty row of the button list, as it is needed.
+ *  \return void.
+ */
+void VideoDialog::FillItem(MythUIButtonListItem *item, int /*index*/)
+{
+    // The row's node was set by loadData()
+    item->setCheckable(true);
+    item->setChecked(MythUIButtonListItem::NotChecked);
+    UpdateItem(item);
+}
+
 /** \fn VideoDialog::UpdateItem(MythUIButtonListItem *item)
  *  \brief Update the visible representation of a MythUIButtonListItem.
  *  \return void.
@@ -5,6 +5,7 @@
 #include <QStringList>
 
 #include "mythscreentype.h"
+#include "mythuibuttonlist.h"
 #include "metadatacommon.h"
 
 #include "parentalcontrols.h"
@@ -28,7 +29,7 @@ class QUrl;
 
 enum ImageDownloadErrorState { esOK, esError, esTimeout };
 
-class VideoDialog : public MythScreenType
+class VideoDialog : public MythScreenType, public MythUIButtonListProvider
 {
     Q_OBJECT
 
@@ -143,6 +144,7 @@ class VideoDialog : public MythScreenType
 
   protected:
     void customEvent(QEvent *levent) override; // MythUIType
+    void FillItem(MythUIButtonListItem *item, int index) override; // MythUIButtonListProvider
 
     virtual MythUIButtonListItem *GetItemCurrent();
     virtual MythUIButtonListItem *GetItemByMetadata(VideoMetadata *metadata);
@@ -110,7 +110,14 @@ void ViewScheduled::Load(void)
 
 void ViewScheduled::Init()
 {
-    LoadList(true);
+    // A change may have arrived while loading in the screen cache
+    LoadList(!m_needFill);
+}
+
+void ViewScheduled::Refresh(void)
+{
+    if (m_needFill)
+        LoadList();
 }
 
 void ViewScheduled::Close()
@@ -585,7 +592,8 @@ void ViewScheduled::customEvent(QEvent *event)
 
         m_needFill = true;
 
-        if (m_inEvent)
+        // Reloaded by Refresh() when shown again
+        if (m_inEvent || IsCached() || !IsInitialized())
             return;
 
         m_inEvent = true;
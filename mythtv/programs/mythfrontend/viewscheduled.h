@@ -49,6 +49,7 @@ class ViewScheduled : public ScheduleCommon
   protected:
     void Load(void) override; // MythScreenType
     void Init(void) override; // MythScreenType
+    void Refresh(void) override; // MythScreenType
     ProgramInfo *GetCurrentProgram(void) const override; // ScheduleCommon
 
   private:
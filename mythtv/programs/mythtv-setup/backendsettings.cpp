@@ -285,6 +285,18 @@ static GlobalCheckBoxSetting *DeletesFollowLinks()
     return gc;
 };
 
+static GlobalCheckBoxSetting *SeekIndexSidecar()
+{
+    auto *gc = new GlobalCheckBoxSetting("SeekIndexSidecar");
+    gc->setLabel(QObject::tr("Write seek index files"));
+    gc->setValue(false);
+    gc->setHelpText(QObject::tr("If enabled, recorders also write a compact "
+                    "keyframe index file next to each recording. Players "
+                    "use it to seek without loading the seek table from "
+                    "the database."));
+    return gc;
+};
+
 static GlobalSpinBoxSetting *HDRingbufferSize()
 {
     auto *bs = new GlobalSpinBoxSetting(
@@ -391,6 +403,18 @@ static GlobalSpinBoxSetting *EITCrawIdleStart()
     return gc;
 }
 
+static GlobalCheckBoxSetting *LiveTVPreTune()
+{
+    auto *gc = new GlobalCheckBoxSetting("LiveTVPreTune");
+    gc->setLabel(QObject::tr("Pre-tune idle tuners for Live TV"));
+    gc->setValue(false);
+    gc->setHelpText(QObject::tr("If enabled, idle tuners on the same video "
+                    "source are tuned to the previous and adjacent channels "
+                    "while Live TV is watched, so changing to them is faster. "
+                    "The EIT scanner skips those tuners meanwhile."));
+    return gc;
+}
+
 static GlobalSpinBoxSetting *WOLbackendReconnectWaitTime()
 {
     auto *gc = new GlobalSpinBoxSetting("WOLbackendReconnectWaitTime", 0, 1200, 5);
@@ -928,6 +952,7 @@ BackendSettings::BackendSettings()
     fm->addChild(DeletesFollowLinks());
     fm->addChild(TruncateDeletes());
     fm->addChild(HDRingbufferSize());
+    fm->addChild(SeekIndexSidecar());
     fm->addChild(StorageScheduler());
     group2->addChild(fm);
     auto* upnp = new GroupSetting();
@@ -944,6 +969,7 @@ BackendSettings::BackendSettings()
     group2a1->setLabel(QObject::tr("EIT Scanner Options"));
     group2a1->addChild(EITTransportTimeout());
     group2a1->addChild(EITCrawIdleStart());
+    group2a1->addChild(LiveTVPreTune());
     addChild(group2a1);
 
     auto* group3 = new GroupSetting();
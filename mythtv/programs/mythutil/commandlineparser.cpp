@@ -73,6 +73,20 @@ void MythUtilCommandLineParser::LoadArguments(void)
                 "Clear the seek table.", "")
                 ->SetGroup("Recording Markup")
                 ->SetParentOf(ChanidStartimeVideo)
+        << add("--exportseekindex", "exportseekindex", false,
+                "Write the seek table from the database to a seek index "
+                "file.", "Unless --outfile is given, the index is written "
+                "next to the recording, where playback will find it.")
+                ->SetGroup("Recording Markup")
+                ->SetParentOf(ChanidStartimeVideo)
+                ->SetChild("outfile")
+        << add("--importseekindex", "importseekindex", false,
+                "Replace the seek table in the database with the contents "
+                "of a seek index file.", "Unless --infile is given, the "
+                "index next to the recording is read.")
+                ->SetGroup("Recording Markup")
+                ->SetParentOf(ChanidStartimeVideo)
+                ->SetChild("infile")
         << add("--clearbookmarks", "clearbookmarks", false,
                 "Clear all bookmarks.", "This command will reset the playback "
                 "start to the very beginning of the recording file.")
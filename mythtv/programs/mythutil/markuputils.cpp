@@ -12,6 +12,7 @@ using std::cout;
 // libmyth* includes
 #include "exitcodes.h"
 #include "mythlogging.h"
+#include "seekindex.h"
 
 // Local includes
 #include "markuputils.h"
@@ -206,6 +207,102 @@ static int ClearSeekTable(const MythUtilCommandLineParser &cmdline)
     return GENERIC_EXIT_OK;
 }
 
+static QString SeekIndexName(const MythUtilCommandLineParser &cmdline,
+                             const ProgramInfo &pginfo, const QString &arg)
+{
+    if (!cmdline.toString(arg).isEmpty())
+        return cmdline.toString(arg);
+    return SeekIndexFile::IndexFilename(pginfo.GetPlaybackURL(false, true));
+}
+
+static int ExportSeekIndex(const MythUtilCommandLineParser &cmdline)
+{
+    ProgramInfo pginfo;
+    if (!GetProgramInfo(cmdline, pginfo))
+        return GENERIC_EXIT_NO_RECORDING_DATA;
+
+    // Same preference order as the player uses
+    frm_pos_map_t posMap;
+    MarkTypes type = MARK_UNSET;
+    for (MarkTypes t : { MARK_GOP_BYFRAME, MARK_GOP_START, MARK_KEYFRAME })
+    {
+        pginfo.QueryPositionMap(posMap, t);
+        if (!posMap.isEmpty())
+        {
+            type = t;
+            break;
+        }
+    }
+    if (type == MARK_UNSET)
+    {
+        LOG(VB_STDIO|VB_FLUSH, LOG_ERR, "Recording has no seek table\n");
+        return GENERIC_EXIT_NO_RECORDING_DATA;
+    }
+
+    QString filename = SeekIndexName(cmdline, pginfo, "outfile");
+    if (filename.startsWith("myth://"))
+    {
+        LOG(VB_STDIO|VB_FLUSH, LOG_ERR,
+            "Recording is not local, please specify --outfile\n");
+        return GENERIC_EXIT_INVALID_CMDLINE;
+    }
+
+    SeekIndexFile index;
+    if (!index.Create(filename, type) || !index.Append(posMap))
+    {
+        LOG(VB_STDIO|VB_FLUSH, LOG_ERR,
+            QString("Couldn't write seek index %1\n").arg(filename));
+        return GENERIC_EXIT_NOT_OK;
+    }
+
+    cout << QString("Wrote %1 seek table entries to %2\n")
+        .arg(index.GetEntryCount()).arg(filename).toLocal8Bit().constData();
+
+    return GENERIC_EXIT_OK;
+}
+
+static int ImportSeekIndex(const MythUtilCommandLineParser &cmdline)
+{
+    ProgramInfo pginfo;
+    if (!GetProgramInfo(cmdline, pginfo))
+        return GENERIC_EXIT_NO_RECORDING_DATA;
+
+    QString filename = SeekIndexName(cmdline, pginfo, "infile");
+    SeekIndexFile index;
+    if (!index.Open(filename))
+    {
+        LOG(VB_STDIO|VB_FLUSH, LOG_ERR,
+            QString("Couldn't read seek index %1\n").arg(filename));
+        return GENERIC_EXIT_INVALID_CMDLINE;
+    }
+
+    frm_pos_vec_t posVec;
+    index.ReadAll(posVec);
+    frm_pos_map_t posMap;
+    for (const auto &entry : posVec)
+        posMap.insert(entry.first, entry.second);
+
+    MarkTypes type = index.GetMarkType();
+    index.Close();
+    pginfo.SavePositionMap(posMap, type);
+
+    // Saving the seek table deletes the recording's own sidecar, put it
+    // back if that is what was imported.
+    if (filename == SeekIndexFile::IndexFilename(
+            pginfo.GetPlaybackURL(false, true)) &&
+        !filename.startsWith("myth://") &&
+        (!index.Create(filename, type) || !index.Append(posMap)))
+    {
+        LOG(VB_STDIO|VB_FLUSH, LOG_ERR,
+            QString("Couldn't rewrite seek index %1\n").arg(filename));
+    }
+
+    cout << QString("Imported %1 seek table entries from %2\n")
+        .arg(posMap.size()).arg(filename).toLocal8Bit().constData();
+
+    return GENERIC_EXIT_OK;
+}
+
 static int ClearBookmarks(const MythUtilCommandLineParser &cmdline)
 {
     ProgramInfo pginfo;
@@ -381,6 +478,8 @@ void registerMarkupUtils(UtilMap &utilMap)
     utilMap["setskiplist"]            = &SetSkipList;
     utilMap["clearskiplist"]          = &ClearSkipList;
     utilMap["clearseektable"]         = &ClearSeekTable;
+    utilMap["exportseekindex"]        = &ExportSeekIndex;
+    utilMap["importseekindex"]        = &ImportSeekIndex;
     utilMap["clearbookmarks"]         = &ClearBookmarks;
     utilMap["getmarkup"]              = &GetMarkup;
     utilMap["setmarkup"]              = &SetMarkup;